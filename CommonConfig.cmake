@@ -308,6 +308,48 @@ if (TEST_FRAMEWORK_NS)
 	add_definitions(-DTEST_FRAMEWORK_NS)
 endif()
 
+#Run the benchmark suites of the services after the non-secure tests. The
+#operation mix (BENCH_ITERATIONS, BENCH_ITS_SIZES...) can be changed by
+#defining the macros of test/framework/bench_framework.h.
+option(TFM_BENCHMARKS "Run the non-secure benchmark suites" OFF)
+if (TFM_BENCHMARKS)
+	if (NOT TEST_FRAMEWORK_NS)
+		message(FATAL_ERROR "TFM_BENCHMARKS needs the non-secure test framework, set REGRESSION to run it.")
+	endif()
+	add_definitions(-DTFM_BENCHMARKS)
+endif()
+
+#Record timestamped SPM events (SVC entry and exit, PSA call stages, context
+#switches) into a ring buffer, read out through the platform service. See
+#tools/spm_trace_decode.py.
+option(TFM_SPM_TRACE "Trace the SPM into a ring buffer" OFF)
+if (TFM_SPM_TRACE)
+	if (NOT TFM_PSA_API)
+		message(FATAL_ERROR "TFM_SPM_TRACE is only supported in the IPC model.")
+	endif()
+	add_definitions(-DTFM_SPM_TRACE)
+endif()
+
+#Paint the partition stacks at boot, and keep the high-water marks of the
+#stacks and of the crypto and ITS scratch buffers, read out through the
+#platform service with tfm_platform_mem_profile_read().
+option(TFM_MEM_PROFILE "Measure the peak memory usage of the partitions" OFF)
+if (TFM_MEM_PROFILE)
+	if (NOT TFM_PSA_API)
+		message(FATAL_ERROR "TFM_MEM_PROFILE is only supported in the IPC model.")
+	endif()
+	add_definitions(-DTFM_MEM_PROFILE)
+endif()
+
+#Timestamp the boot phases, from BL2 to the start of the non-secure image,
+#including the initialization of each partition. The profile is written to
+#the secure log, and read with tfm_platform_boot_profile_read() in the IPC
+#model.
+option(TFM_BOOT_PROFILE "Measure the boot phases" OFF)
+if (TFM_BOOT_PROFILE)
+	add_definitions(-DTFM_BOOT_PROFILE)
+endif()
+
 if (CORE_IPC)
 	set(TFM_PARTITION_AUDIT_LOG OFF)
 endif()
@@ -487,6 +529,24 @@ if (NOT DEFINED ITS_RAM_FS)
 	set (ITS_RAM_FS OFF)
 endif()
 
+#Default TF-M audit logging flags.
+#Documentation about these flags can be found in the TF-M audit integration guide
+if (NOT DEFINED AUDIT_PERSISTENT_LOG)
+	set (AUDIT_PERSISTENT_LOG OFF)
+endif()
+
+if (NOT DEFINED AUDIT_PERSISTENT_LOG_RAM_FS)
+	set (AUDIT_PERSISTENT_LOG_RAM_FS OFF)
+endif()
+
+if (NOT DEFINED AUDIT_PERSISTENT_LOG_FLUSH_EACH_RECORD)
+	set (AUDIT_PERSISTENT_LOG_FLUSH_EACH_RECORD ON)
+endif()
+
+if (NOT DEFINED AUDIT_RECORD_MAC)
+	set (AUDIT_RECORD_MAC OFF)
+endif()
+
 if (NOT DEFINED MBEDCRYPTO_DEBUG)
 	set(MBEDCRYPTO_DEBUG OFF)
 endif()
@@ -521,6 +581,18 @@ if (NOT DEFINED ATTEST_CLAIM_VALUE_CHECK)
 	set(ATTEST_CLAIM_VALUE_CHECK OFF)
 endif()
 
+if (NOT DEFINED ATTEST_RESIDENT_KEY)
+	set(ATTEST_RESIDENT_KEY OFF)
+endif()
+
+if (NOT DEFINED ATTEST_STATIC_CLAIMS_CACHE)
+	set(ATTEST_STATIC_CLAIMS_CACHE OFF)
+endif()
+
+if (NOT DEFINED ATTEST_STREAM_TOKEN)
+	set(ATTEST_STREAM_TOKEN OFF)
+endif()
+
 ##Set mbedTLS compiler flags for BL2 bootloader
 set(MBEDCRYPTO_C_FLAGS_BL2 "${CMSE_FLAGS} -D__thumb2__ ${COMMON_COMPILE_FLAGS_STR} -DMBEDTLS_CONFIG_FILE=\\\\\\\"config-rsa.h\\\\\\\" -I${CMAKE_CURRENT_LIST_DIR}/bl2/ext/mcuboot/include")
 if (MCUBOOT_SIGNATURE_TYPE STREQUAL "RSA-3072")
@@ -16,6 +16,9 @@
 
 #include "tfm_integ_test.h"
 #include "test/framework/test_framework_integ_test.h"
+#ifdef TFM_BENCHMARKS
+#include "test/framework/bench_framework.h"
+#endif
 #ifdef TFM_PSA_API
 #include "psa_manifest/sid.h"
 #endif
@@ -431,6 +434,9 @@ void test_app(void *argument)
 #endif
 #ifdef TEST_FRAMEWORK_NS
     tfm_non_secure_client_run_tests();
+#endif
+#ifdef TFM_BENCHMARKS
+    tfm_non_secure_client_run_benchmarks();
 #endif
     /* End of test */
     for (;;) {
@@ -39,6 +39,16 @@ if (BL2)
 
 	set(MCUBOOT_HW_KEY On CACHE BOOL "Configure to use HW key for image verification. Otherwise key is embedded in MCUBoot image.")
 
+	set(MCUBOOT_VALIDATE_FROM_XIP Off CACHE BOOL "Configure to hash the images directly from the memory-mapped flash instead of reading them through a RAM buffer.")
+
+	set(MCUBOOT_VALIDATION_CACHE Off CACHE BOOL "Configure to store an authenticated validation record of the active image and skip its full validation on later boots.")
+
+	set(MCUBOOT_COPY_BUF_SIZE 1024 CACHE STRING "Size in bytes of the RAM buffer used by MCUBoot to copy image data between flash areas during an upgrade.")
+
+	set(MCUBOOT_DELTA_UPDATE Off CACHE BOOL "Configure to accept delta images, which are rebuilt from the image in the primary slot before the upgrade.")
+
+	set(MCUBOOT_DECOMPRESS_IMAGES Off CACHE BOOL "Configure to accept compressed images, which are decompressed into the primary slot or into SRAM.")
+
 	set(MCUBOOT_LOG_LEVEL "LOG_LEVEL_INFO" CACHE STRING "Configure the level of logging in MCUBoot.")
 	set_property(CACHE MCUBOOT_LOG_LEVEL PROPERTY STRINGS "LOG_LEVEL_OFF;LOG_LEVEL_ERROR;LOG_LEVEL_WARNING;LOG_LEVEL_INFO;LOG_LEVEL_DEBUG")
 	if (NOT CMAKE_BUILD_TYPE STREQUAL "debug")
@@ -71,12 +81,22 @@ else() #BL2 is turned off
 		DEFINED MCUBOOT_UPGRADE_STRATEGY OR
 		DEFINED MCUBOOT_SIGNATURE_TYPE OR
 		DEFINED MCUBOOT_HW_KEY OR
+		DEFINED MCUBOOT_VALIDATE_FROM_XIP OR
+		DEFINED MCUBOOT_VALIDATION_CACHE OR
+		DEFINED MCUBOOT_COPY_BUF_SIZE OR
+		DEFINED MCUBOOT_DELTA_UPDATE OR
+		DEFINED MCUBOOT_DECOMPRESS_IMAGES OR
 		DEFINED MCUBOOT_LOG_LEVEL)
 			message(WARNING "Ignoring the values of MCUBOOT_* variables as BL2 option is set to False.")
 			set(MCUBOOT_IMAGE_NUMBER "")
 			set(MCUBOOT_UPGRADE_STRATEGY "")
 			set(MCUBOOT_SIGNATURE_TYPE "")
 			set(MCUBOOT_HW_KEY "")
+			set(MCUBOOT_VALIDATE_FROM_XIP "")
+			set(MCUBOOT_VALIDATION_CACHE "")
+			set(MCUBOOT_COPY_BUF_SIZE "")
+			set(MCUBOOT_DELTA_UPDATE "")
+			set(MCUBOOT_DECOMPRESS_IMAGES "")
 			set(MCUBOOT_LOG_LEVEL "")
 	endif()
 
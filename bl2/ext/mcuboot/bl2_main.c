@@ -27,6 +27,7 @@
 #include "bootutil/bootutil.h"
 #include "flash_map_backend/flash_map_backend.h"
 #include "boot_record.h"
+#include "boot_profile.h"
 #include "security_cnt.h"
 #include "boot_hal.h"
 #include "region.h"
@@ -107,6 +108,8 @@ int main(void)
     __set_MSPLIM(msp_stack_bottom);
 #endif
 
+    BOOT_PROFILE_INIT();
+
     /* Perform platform specific initialization */
     if (boot_platform_init() != 0) {
         while (1)
@@ -139,6 +142,8 @@ int main(void)
             ;
     }
 
+    BOOT_PROFILE_RECORD(TFM_BOOT_PHASE_BL2_INIT);
+
     rc = boot_go(&rsp);
     if (rc != 0) {
         BOOT_LOG_ERR("Unable to find bootable image");
@@ -146,6 +151,8 @@ int main(void)
             ;
     }
 
+    BOOT_PROFILE_RECORD(TFM_BOOT_PHASE_BL2_VALIDATE);
+
 #ifdef CRYPTO_HW_ACCELERATOR
     rc = crypto_hw_accelerator_finish();
     if (rc) {
@@ -175,6 +182,7 @@ int main(void)
     BOOT_LOG_INF("Bootloader chainload address offset: 0x%x",
                  rsp.br_image_off);
     BOOT_LOG_INF("Jumping to the first image slot");
+    BOOT_PROFILE_SAVE();
     do_boot(&rsp);
 
     BOOT_LOG_ERR("Never should get here");
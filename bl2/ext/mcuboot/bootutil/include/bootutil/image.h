@@ -55,6 +55,16 @@ struct flash_area;
  * ih_load_addr field of the header.
  */
 #define IMAGE_F_RAM_LOAD                 0x00000020
+/*
+ * Indicates that the payload is a patch against the image in the primary
+ * slot, see IMAGE_TLV_DELTA_BASE.
+ */
+#define IMAGE_F_DELTA                    0x00000040
+/*
+ * Indicates that the payload is a compressed signed image, which has to be
+ * decompressed before it can be booted, see IMAGE_TLV_DECOMP_SIZE.
+ */
+#define IMAGE_F_COMPRESSED               0x00000080
 
 /*
  * Image trailer TLV types.
@@ -74,6 +84,9 @@ struct flash_area;
 #define IMAGE_TLV_DEPENDENCY        0x40   /* Image depends on other image */
 #define IMAGE_TLV_SEC_CNT           0x50   /* security counter */
 #define IMAGE_TLV_BOOT_RECORD       0x60   /* measured boot record */
+#define IMAGE_TLV_DELTA_BASE        0x70   /* base image hash of a delta */
+#define IMAGE_TLV_DECOMP_SIZE       0x71   /* size of decompressed image */
+#define IMAGE_TLV_DECOMP_SHA256     0x72   /* SHA256 of decompressed image */
 #define IMAGE_TLV_ANY               0xff   /* Used to iterate over all TLV */
 
 #define IMAGE_VER_MAJOR_LENGTH      8
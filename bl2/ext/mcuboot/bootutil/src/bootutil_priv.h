@@ -368,7 +368,16 @@ boot_img_sector_off(const struct boot_loader_state *state, size_t slot,
 
 #endif  /* !defined(MCUBOOT_USE_FLASH_AREA_GET_SECTORS) */
 
-#ifdef MCUBOOT_RAM_LOADING
+#if defined(MCUBOOT_RAM_LOADING) && defined(MCUBOOT_DECOMPRESS_IMAGES)
+/* A compressed image is validated in flash, before it is decompressed to its
+ * load address, the image it carries is then validated in RAM.
+ */
+#define LOAD_IMAGE_DATA(hdr, fap, start, output, size)       \
+    (((hdr)->ih_flags & IMAGE_F_COMPRESSED) ?                \
+    flash_area_read((fap), (start), (output), (size)) :      \
+    (memcpy((output),(void*)((hdr)->ih_load_addr + (start)), \
+    (size)) != (output)))
+#elif defined(MCUBOOT_RAM_LOADING)
 #define LOAD_IMAGE_DATA(hdr, fap, start, output, size)       \
     (memcpy((output),(void*)((hdr)->ih_load_addr + (start)), \
     (size)) != (output))
@@ -30,6 +30,7 @@
 #include <string.h>
 
 #include "flash_map/flash_map.h"
+#include "flash_map_backend/flash_map_backend.h"
 #include "bootutil/image.h"
 #include "bootutil/sha256.h"
 #include "bootutil/sign_key.h"
@@ -49,6 +50,89 @@
 #include "platform/include/tfm_plat_crypto_keys.h"
 #endif
 
+#if (!defined(MCUBOOT_RAM_LOADING) && !defined(MCUBOOT_VALIDATE_FROM_XIP)) || \
+    (defined(MCUBOOT_RAM_LOADING) && defined(MCUBOOT_DECOMPRESS_IMAGES))
+/*
+ * Feed the first size bytes of a flash area into the SHA256 context.
+ *
+ * If the flash driver can read asynchronously then tmp_buf is split into two
+ * halves: the next chunk is fetched into one half while the current chunk is
+ * being hashed from the other, so the flash latency is hidden behind the
+ * hash computation.
+ */
+static int
+bootutil_img_hash_flash(bootutil_sha256_context *sha256_ctx,
+                        const struct flash_area *fap, uint32_t size,
+                        uint8_t *tmp_buf, uint32_t tmp_buf_sz)
+{
+    uint8_t *cur_buf;
+    uint8_t *next_buf;
+    uint8_t *swap_buf;
+    uint32_t blk_sz;
+    uint32_t next_sz;
+    uint32_t off;
+    int rc;
+
+    if (!flash_area_read_is_async(fap) || (tmp_buf_sz < 2)) {
+        for (off = 0; off < size; off += blk_sz) {
+            blk_sz = size - off;
+            if (blk_sz > tmp_buf_sz) {
+                blk_sz = tmp_buf_sz;
+            }
+            rc = flash_area_read(fap, off, tmp_buf, blk_sz);
+            if (rc) {
+                return rc;
+            }
+            bootutil_sha256_update(sha256_ctx, tmp_buf, blk_sz);
+        }
+
+        return 0;
+    }
+
+    tmp_buf_sz /= 2;
+    cur_buf = tmp_buf;
+    next_buf = tmp_buf + tmp_buf_sz;
+
+    off = 0;
+    blk_sz = (size < tmp_buf_sz) ? size : tmp_buf_sz;
+    if (blk_sz > 0) {
+        rc = flash_area_read_start(fap, off, cur_buf, blk_sz);
+        if (rc) {
+            return rc;
+        }
+    }
+
+    while (blk_sz > 0) {
+        rc = flash_area_read_wait(fap);
+        if (rc) {
+            return rc;
+        }
+
+        /* Start fetching the next chunk before hashing the current one. */
+        next_sz = size - (off + blk_sz);
+        if (next_sz > tmp_buf_sz) {
+            next_sz = tmp_buf_sz;
+        }
+        if (next_sz > 0) {
+            rc = flash_area_read_start(fap, off + blk_sz, next_buf, next_sz);
+            if (rc) {
+                return rc;
+            }
+        }
+
+        bootutil_sha256_update(sha256_ctx, cur_buf, blk_sz);
+
+        swap_buf = cur_buf;
+        cur_buf = next_buf;
+        next_buf = swap_buf;
+        off += blk_sz;
+        blk_sz = next_sz;
+    }
+
+    return 0;
+}
+#endif /* Hashing from flash */
+
 /*
  * Compute SHA256 over the image.
  */
@@ -60,11 +144,12 @@ bootutil_img_hash(int image_index,
 {
     bootutil_sha256_context sha256_ctx;
     uint32_t size;
-#ifndef MCUBOOT_RAM_LOADING
-    uint32_t blk_sz;
-    uint32_t off;
+#if defined(MCUBOOT_VALIDATE_FROM_XIP)
+    uintptr_t flash_base;
+#endif
+#if !defined(MCUBOOT_RAM_LOADING) || defined(MCUBOOT_DECOMPRESS_IMAGES)
     int rc;
-#endif /* MCUBOOT_RAM_LOADING */
+#endif
 
     (void)image_index;
 
@@ -82,19 +167,34 @@ bootutil_img_hash(int image_index,
     /* If protected TLVs are present they are also hashed. */
     size += hdr->ih_protect_tlv_size;
 
-#ifdef MCUBOOT_RAM_LOADING
-    bootutil_sha256_update(&sha256_ctx,(void*)(hdr->ih_load_addr), size);
-#else
-    for (off = 0; off < size; off += blk_sz) {
-        blk_sz = size - off;
-        if (blk_sz > tmp_buf_sz) {
-            blk_sz = tmp_buf_sz;
-        }
-        rc = flash_area_read(fap, off, tmp_buf, blk_sz);
+#if defined(MCUBOOT_RAM_LOADING) && defined(MCUBOOT_DECOMPRESS_IMAGES)
+    /* A compressed image is hashed in flash, before it is decompressed. */
+    if (hdr->ih_flags & IMAGE_F_COMPRESSED) {
+        rc = bootutil_img_hash_flash(&sha256_ctx, fap, size, tmp_buf,
+                                     tmp_buf_sz);
         if (rc) {
             return rc;
         }
-        bootutil_sha256_update(&sha256_ctx, tmp_buf, blk_sz);
+    } else {
+        bootutil_sha256_update(&sha256_ctx, (void *)(hdr->ih_load_addr), size);
+    }
+#elif defined(MCUBOOT_RAM_LOADING)
+    bootutil_sha256_update(&sha256_ctx,(void*)(hdr->ih_load_addr), size);
+#elif defined(MCUBOOT_VALIDATE_FROM_XIP)
+    (void)tmp_buf;
+    (void)tmp_buf_sz;
+
+    /* The image is hashed in place through the memory-mapped flash. */
+    rc = flash_device_base(fap->fa_device_id, &flash_base);
+    if (rc) {
+        return rc;
+    }
+    bootutil_sha256_update(&sha256_ctx,
+                           (void *)(flash_base + fap->fa_off), size);
+#else
+    rc = bootutil_img_hash_flash(&sha256_ctx, fap, size, tmp_buf, tmp_buf_sz);
+    if (rc) {
+        return rc;
     }
 #endif
     bootutil_sha256_finish(&sha256_ctx, hash_result);
@@ -44,9 +44,26 @@
 #include "bootutil/bootutil_log.h"
 #include "bl2/include/tfm_boot_status.h"
 #include "bl2/include/boot_record.h"
+#ifdef MCUBOOT_VALIDATION_CACHE
+#include "bl2/include/validation_cache.h"
+#endif
+#ifdef MCUBOOT_DELTA_UPDATE
+#include "bl2/include/delta_update.h"
+#endif
+#ifdef MCUBOOT_DECOMPRESS_IMAGES
+#include "bl2/include/decompress.h"
+#endif
 #include "security_cnt.h"
 #include "mcuboot_config/mcuboot_config.h"
 
+#ifndef MCUBOOT_COPY_BUF_SIZE
+#define MCUBOOT_COPY_BUF_SIZE 1024
+#endif
+
+#if (MCUBOOT_COPY_BUF_SIZE % BOOT_MAX_ALIGN) != 0
+#error "MCUBOOT_COPY_BUF_SIZE must be a multiple of BOOT_MAX_ALIGN"
+#endif
+
 static struct boot_loader_state boot_data;
 
 #if (BOOT_IMAGE_NUMBER > 1)
@@ -382,6 +399,10 @@ boot_image_check(struct boot_loader_state *state, struct image_header *hdr,
 {
     static uint8_t tmpbuf[BOOT_TMPBUF_SZ];
     uint8_t image_index;
+#ifdef MCUBOOT_VALIDATION_CACHE
+    uint8_t hash[32];
+    bool is_primary_slot;
+#endif
 
 #if (BOOT_IMAGE_NUMBER == 1)
     (void)state;
@@ -391,10 +412,36 @@ boot_image_check(struct boot_loader_state *state, struct image_header *hdr,
 
     image_index = BOOT_CURR_IMG(state);
 
+#ifdef MCUBOOT_VALIDATION_CACHE
+    /* Skip the full validation of the active image if it has already been
+     * validated on a previous boot and its manifest has not changed since.
+     */
+    is_primary_slot = (fap->fa_id == FLASH_AREA_IMAGE_PRIMARY(image_index));
+    if (is_primary_slot &&
+        (boot_validation_cache_check(image_index, hdr, fap, tmpbuf,
+                                     BOOT_TMPBUF_SZ) == VALIDATION_CACHE_HIT)) {
+        BOOT_LOG_INF("Image %d: validation record found", image_index);
+        return 0;
+    }
+
+    if (bootutil_img_validate(image_index, hdr, fap, tmpbuf,
+                              BOOT_TMPBUF_SZ, NULL, 0, hash)) {
+        return BOOT_EBADIMAGE;
+    }
+
+    if (is_primary_slot &&
+        (boot_validation_cache_store(image_index, hdr, fap, hash, tmpbuf,
+                                     BOOT_TMPBUF_SZ) != 0)) {
+        /* Not fatal, the image is validated in full on the next boot. */
+        BOOT_LOG_WRN("Image %d: failed to store validation record",
+                     image_index);
+    }
+#else
     if (bootutil_img_validate(image_index, hdr, fap, tmpbuf,
                               BOOT_TMPBUF_SZ, NULL, 0, NULL)) {
         return BOOT_EBADIMAGE;
     }
+#endif /* MCUBOOT_VALIDATION_CACHE */
 
     return 0;
 }
@@ -442,6 +489,83 @@ boot_check_header_erased(struct boot_loader_state *state, int slot)
     return 0;
 }
 
+#ifdef MCUBOOT_DELTA_UPDATE
+/*
+ * Rebuilds the full image in the secondary slot from the delta image stored
+ * there and from the image in the primary slot, then reloads the header of
+ * the secondary slot.
+ *
+ * @returns 0 on success, nonzero otherwise.
+ */
+static int
+boot_rebuild_delta_image(struct boot_loader_state *state,
+                         const struct flash_area *fap_secondary_slot)
+{
+    const struct flash_area *fap_primary_slot;
+    const struct flash_area *fap_scratch;
+    int rc;
+
+    if (!BOOT_IMG_HDR_IS_VALID(state, BOOT_PRIMARY_SLOT)) {
+        return -1;
+    }
+
+    rc = flash_area_open(FLASH_AREA_IMAGE_PRIMARY(BOOT_CURR_IMG(state)),
+                         &fap_primary_slot);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    rc = flash_area_open(FLASH_AREA_IMAGE_SCRATCH, &fap_scratch);
+    if (rc != 0) {
+        flash_area_close(fap_primary_slot);
+        return BOOT_EFLASH;
+    }
+
+    rc = boot_delta_apply(BOOT_CURR_IMG(state),
+                          boot_img_hdr(state, BOOT_SECONDARY_SLOT),
+                          boot_img_hdr(state, BOOT_PRIMARY_SLOT),
+                          fap_primary_slot, fap_secondary_slot, fap_scratch);
+    if (rc == 0) {
+        rc = boot_read_image_header(state, BOOT_SECONDARY_SLOT,
+                                    boot_img_hdr(state, BOOT_SECONDARY_SLOT));
+    }
+
+    flash_area_close(fap_scratch);
+    flash_area_close(fap_primary_slot);
+
+    return rc;
+}
+#endif /* MCUBOOT_DELTA_UPDATE */
+
+/*
+ * Checks whether a compressed image can be used from the given slot. Images
+ * decompressed into the primary slot are checked by decompressing them once
+ * without writing the result, so that the primary slot is only erased for an
+ * image which is known to decompress correctly.
+ *
+ * @returns 0 if the image is not compressed or it can be used, nonzero
+ *          otherwise.
+ */
+static int
+boot_check_compressed_image(int slot, const struct image_header *hdr,
+                            const struct flash_area *fap)
+{
+    if (!(hdr->ih_flags & IMAGE_F_COMPRESSED)) {
+        return 0;
+    }
+
+#if defined(MCUBOOT_DECOMPRESS_IMAGES) && !defined(MCUBOOT_RAM_LOADING)
+    if (slot != BOOT_SECONDARY_SLOT) {
+        return -1;
+    }
+    return boot_decompress_check(hdr, fap);
+#else
+    (void)slot;
+    (void)fap;
+    return -1;
+#endif
+}
+
 /*
  * Check that there is a valid image in a slot
  *
@@ -473,8 +597,22 @@ boot_validate_slot(struct boot_loader_state *state, int slot,
         goto out;
     }
 
+#ifdef MCUBOOT_DELTA_UPDATE
+    if ((slot == BOOT_SECONDARY_SLOT) && BOOT_IMG_HDR_IS_VALID(state, slot) &&
+        (hdr->ih_flags & IMAGE_F_DELTA)) {
+        /* The full image must be rebuilt before it can be validated. */
+        if (boot_rebuild_delta_image(state, fap) != 0) {
+            flash_area_erase(fap, 0, fap->fa_size);
+            BOOT_LOG_ERR("Delta image in the secondary slot is not valid!");
+            rc = -1;
+            goto out;
+        }
+    }
+#endif
+
     if ((!BOOT_IMG_HDR_IS_VALID(state, slot)) ||
-         (boot_image_check(state, hdr, fap, bs) != 0)) {
+         (boot_image_check(state, hdr, fap, bs) != 0) ||
+         (boot_check_compressed_image(slot, hdr, fap) != 0)) {
         if (slot != BOOT_PRIMARY_SLOT) {
             flash_area_erase(fap, 0, fap->fa_size);
             /* Image in the secondary slot is invalid. Erase the image and
@@ -1074,6 +1212,9 @@ boot_erase_region(const struct flash_area *fap, uint32_t off, uint32_t sz)
     return flash_area_erase(fap, off, sz);
 }
 
+/* Buffer used to move image data between flash areas. */
+static uint8_t boot_copy_buf[MCUBOOT_COPY_BUF_SIZE];
+
 /**
  * Copies the contents of one flash region to another.  You must erase the
  * destination region prior to calling this function.
@@ -1098,24 +1239,24 @@ boot_copy_region(struct boot_loader_state *state,
     int chunk_sz;
     int rc;
 
-    static uint8_t buf[1024];
-
     (void)state;
 
     bytes_copied = 0;
     while (bytes_copied < sz) {
-        if (sz - bytes_copied > sizeof(buf)) {
-            chunk_sz = sizeof(buf);
+        if (sz - bytes_copied > sizeof(boot_copy_buf)) {
+            chunk_sz = sizeof(boot_copy_buf);
         } else {
             chunk_sz = sz - bytes_copied;
         }
 
-        rc = flash_area_read(fap_src, off_src + bytes_copied, buf, chunk_sz);
+        rc = flash_area_read(fap_src, off_src + bytes_copied, boot_copy_buf,
+                             chunk_sz);
         if (rc != 0) {
             return BOOT_EFLASH;
         }
 
-        rc = flash_area_write(fap_dst, off_dst + bytes_copied, buf, chunk_sz);
+        rc = flash_area_write(fap_dst, off_dst + bytes_copied, boot_copy_buf,
+                              chunk_sz);
         if (rc != 0) {
             return BOOT_EFLASH;
         }
@@ -1126,6 +1267,97 @@ boot_copy_region(struct boot_loader_state *state,
     return 0;
 }
 
+/**
+ * Erases a region of flash and copies the contents of another region into it,
+ * one sector at a time.  The erase of each destination sector is started
+ * first and the first chunk of its new contents is fetched from the source
+ * while the erase is in progress, if the flash device can be read while
+ * erasing (FLASH_DEV_READ_WHILE_ERASE).
+ *
+ * @param slot_dst              The slot whose sector layout describes the
+ *                                  destination region.
+ * @param first_sector          The index of the first destination sector.
+ * @param fap_src               The source flash area.
+ * @param fap_dst               The destination flash area.
+ * @param off_src               The offset within the source flash area to
+ *                                  copy from.
+ * @param off_dst               The offset within the destination flash area,
+ *                                  it must be the start of first_sector.
+ * @param erase_sz              The number of bytes to erase, a multiple of
+ *                                  the sector size.
+ * @param copy_sz               The number of bytes to copy, at most erase_sz.
+ *
+ * @return                      0 on success; nonzero on failure.
+ */
+static int
+boot_erase_copy_region(struct boot_loader_state *state, int slot_dst,
+                       size_t first_sector,
+                       const struct flash_area *fap_src,
+                       const struct flash_area *fap_dst,
+                       uint32_t off_src, uint32_t off_dst,
+                       uint32_t erase_sz, uint32_t copy_sz)
+{
+    size_t sect;
+    uint32_t sect_off;
+    uint32_t sect_sz;
+    uint32_t sect_copy_sz;
+    uint32_t chunk_sz;
+    int rc;
+    int rc_wait;
+
+    sect = first_sector;
+    for (sect_off = 0; sect_off < erase_sz; sect_off += sect_sz, sect++) {
+        sect_sz = boot_img_sector_size(state, slot_dst, sect);
+
+        sect_copy_sz = 0;
+        if (sect_off < copy_sz) {
+            sect_copy_sz = copy_sz - sect_off;
+            if (sect_copy_sz > sect_sz) {
+                sect_copy_sz = sect_sz;
+            }
+        }
+
+        chunk_sz = sect_copy_sz;
+        if (chunk_sz > sizeof(boot_copy_buf)) {
+            chunk_sz = sizeof(boot_copy_buf);
+        }
+
+        rc = flash_area_erase_start(fap_dst, off_dst + sect_off, sect_sz);
+        if (rc != 0) {
+            return BOOT_EFLASH;
+        }
+
+        rc = 0;
+        if (chunk_sz != 0) {
+            rc = flash_area_read(fap_src, off_src + sect_off, boot_copy_buf,
+                                 chunk_sz);
+        }
+
+        rc_wait = flash_area_erase_wait(fap_dst);
+        if (rc != 0 || rc_wait != 0) {
+            return BOOT_EFLASH;
+        }
+
+        if (chunk_sz != 0) {
+            rc = flash_area_write(fap_dst, off_dst + sect_off, boot_copy_buf,
+                                  chunk_sz);
+            if (rc != 0) {
+                return BOOT_EFLASH;
+            }
+        }
+
+        rc = boot_copy_region(state, fap_src, fap_dst,
+                              off_src + sect_off + chunk_sz,
+                              off_dst + sect_off + chunk_sz,
+                              sect_copy_sz - chunk_sz);
+        if (rc != 0) {
+            return rc;
+        }
+    }
+
+    return 0;
+}
+
 #ifndef MCUBOOT_OVERWRITE_ONLY
 static inline int
 boot_status_init(const struct boot_loader_state *state,
@@ -1319,11 +1551,9 @@ boot_swap_sectors(int idx, uint32_t sz, struct boot_loader_state *state,
     }
 
     if (bs->state == BOOT_STATUS_STATE_1) {
-        rc = boot_erase_region(fap_secondary_slot, img_off, sz);
-        assert(rc == 0);
-
-        rc = boot_copy_region(state, fap_primary_slot, fap_secondary_slot,
-                              img_off, img_off, copy_sz);
+        rc = boot_erase_copy_region(state, BOOT_SECONDARY_SLOT, idx,
+                                    fap_primary_slot, fap_secondary_slot,
+                                    img_off, img_off, sz, copy_sz);
         assert(rc == 0);
 
         if (bs->idx == BOOT_STATUS_IDX_0 && !bs->use_scratch) {
@@ -1340,14 +1570,12 @@ boot_swap_sectors(int idx, uint32_t sz, struct boot_loader_state *state,
     }
 
     if (bs->state == BOOT_STATUS_STATE_2) {
-        rc = boot_erase_region(fap_primary_slot, img_off, sz);
-        assert(rc == 0);
-
         /* NOTE: If this is the final sector, we exclude the image trailer from
          * this copy (copy_sz was truncated earlier).
          */
-        rc = boot_copy_region(state, fap_scratch, fap_primary_slot,
-                              0, img_off, copy_sz);
+        rc = boot_erase_copy_region(state, BOOT_PRIMARY_SLOT, idx,
+                                    fap_scratch, fap_primary_slot,
+                                    0, img_off, sz, copy_sz);
         assert(rc == 0);
 
         if (bs->use_scratch) {
@@ -1428,7 +1656,6 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
     size_t sect;
     int rc;
     size_t size;
-    size_t this_size;
     size_t last_sector;
     const struct flash_area *fap_primary_slot;
     const struct flash_area *fap_secondary_slot;
@@ -1437,7 +1664,6 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
     (void)bs;
 
     BOOT_LOG_INF("Image upgrade secondary slot -> primary slot");
-    BOOT_LOG_INF("Erasing the primary slot");
 
     image_index = BOOT_CURR_IMG(state);
 
@@ -1451,17 +1677,37 @@ boot_copy_image(struct boot_loader_state *state, struct boot_status *bs)
 
     sect_count = boot_img_num_sectors(state, BOOT_PRIMARY_SLOT);
     for (sect = 0, size = 0; sect < sect_count; sect++) {
-        this_size = boot_img_sector_size(state, BOOT_PRIMARY_SLOT, sect);
-        rc = boot_erase_region(fap_primary_slot, size, this_size);
-        assert(rc == 0);
-
-        size += this_size;
+        size += boot_img_sector_size(state, BOOT_PRIMARY_SLOT, sect);
     }
 
-    BOOT_LOG_INF("Copying the secondary slot to the primary slot: 0x%zx bytes",
-                 size);
-    rc = boot_copy_region(state, fap_secondary_slot, fap_primary_slot,
-                          0, 0, size);
+#ifdef MCUBOOT_DECOMPRESS_IMAGES
+    if (boot_img_hdr(state, BOOT_SECONDARY_SLOT)->ih_flags &
+        IMAGE_F_COMPRESSED) {
+        BOOT_LOG_INF("Decompressing the secondary slot to the primary slot");
+        rc = boot_erase_region(fap_primary_slot, 0, size);
+        if (rc == 0) {
+            rc = boot_decompress_to_flash(
+                                    boot_img_hdr(state, BOOT_SECONDARY_SLOT),
+                                    fap_secondary_slot, fap_primary_slot);
+        }
+        if (rc != 0) {
+            /* The secondary slot is kept, the upgrade is retried on the next
+             * boot.
+             */
+            BOOT_LOG_ERR("Failed to decompress the image.");
+            flash_area_close(fap_primary_slot);
+            flash_area_close(fap_secondary_slot);
+            return BOOT_EFLASH;
+        }
+    } else
+#endif
+    {
+        BOOT_LOG_INF("Erasing and copying the secondary slot to the primary"
+                     " slot: 0x%zx bytes", size);
+        rc = boot_erase_copy_region(state, BOOT_PRIMARY_SLOT, 0,
+                                    fap_secondary_slot, fap_primary_slot,
+                                    0, 0, size, size);
+    }
 
     /* Update the stored security counter with the new image's security counter
      * value. Both slots hold the new image at this point, but the secondary
@@ -2563,6 +2809,139 @@ boot_verify_ram_loading_address(uint32_t img_dst, uint32_t img_sz)
     return 0;
 }
 
+/**
+ * Removes an image from SRAM, by overwriting it with zeros.
+ *
+ * @param img_dst         The address of the image that needs to be removed from
+ *                        SRAM.
+ *
+ * @param img_sz          The size of the image that needs to be removed from
+ *                        SRAM.
+ *
+ * @return                0 on success; nonzero on failure.
+ */
+static int
+boot_remove_image_from_sram(uint32_t img_dst, uint32_t img_sz)
+{
+    BOOT_LOG_INF("Removing image from SRAM at address 0x%x", img_dst);
+    memset((void*)img_dst, 0, img_sz);
+
+    return 0;
+}
+
+#ifdef MCUBOOT_DECOMPRESS_IMAGES
+/**
+ * Checks that a decompressed image in SRAM is itself an image to be loaded at
+ * the address it was decompressed to, which fills exactly the decompressed
+ * size.
+ *
+ * @param img_dst         The address of the decompressed image in SRAM.
+ *
+ * @param img_sz          The size of the decompressed image.
+ *
+ * @param hdr             On success, the header of the decompressed image.
+ *
+ * @return                0 on success; nonzero on failure.
+ */
+static int
+boot_check_decompressed_header(uint32_t img_dst, uint32_t img_sz,
+                               struct image_header *hdr)
+{
+    struct image_tlv_info info;
+    uint32_t off;
+    uint32_t end;
+
+    if (img_sz < sizeof(*hdr)) {
+        return BOOT_EBADIMAGE;
+    }
+    memcpy(hdr, (void *)img_dst, sizeof(*hdr));
+
+    if (hdr->ih_magic != IMAGE_MAGIC ||
+        (hdr->ih_flags & IMAGE_F_COMPRESSED) ||
+        !(hdr->ih_flags & IMAGE_F_RAM_LOAD) ||
+        hdr->ih_load_addr != img_dst) {
+        return BOOT_EBADIMAGE;
+    }
+
+    if (!boot_u32_safe_add(&off, hdr->ih_hdr_size, hdr->ih_img_size)) {
+        return BOOT_EBADIMAGE;
+    }
+
+    if (hdr->ih_protect_tlv_size != 0) {
+        if (!boot_u32_safe_add(&end, off, sizeof(info)) || end > img_sz) {
+            return BOOT_EBADIMAGE;
+        }
+        memcpy(&info, (void *)(img_dst + off), sizeof(info));
+        if (info.it_magic != IMAGE_TLV_PROT_INFO_MAGIC ||
+            info.it_tlv_tot != hdr->ih_protect_tlv_size) {
+            return BOOT_EBADIMAGE;
+        }
+        off += info.it_tlv_tot;
+    }
+
+    if (!boot_u32_safe_add(&end, off, sizeof(info)) || end > img_sz) {
+        return BOOT_EBADIMAGE;
+    }
+    memcpy(&info, (void *)(img_dst + off), sizeof(info));
+    if (info.it_magic != IMAGE_TLV_INFO_MAGIC ||
+        !boot_u32_safe_add(&end, off, info.it_tlv_tot) || end != img_sz) {
+        return BOOT_EBADIMAGE;
+    }
+
+    return 0;
+}
+
+/**
+ * Loads the image carried by a compressed image to SRAM. The compressed image
+ * is validated in the flash before anything is written to SRAM, then it is
+ * decompressed to the load address, checking the result against its
+ * DECOMP_SIZE and DECOMP_SHA256 TLVs. On success the header of the slot is
+ * replaced by the header of the decompressed image, which still has to be
+ * validated in SRAM before it is booted.
+ *
+ * @param state           Boot loader status information.
+ *
+ * @param hdr             Pointer to the image header structure of the
+ *                        compressed image
+ *
+ * @param fap_src         The flash area of the slot of the compressed image.
+ *
+ * @param img_dst         The load address of the decompressed image.
+ *
+ * @param img_sz          The size of the decompressed image.
+ *
+ * @return                0 on success; nonzero on failure.
+ */
+static int
+boot_decompress_image_to_sram(struct boot_loader_state *state,
+                              struct image_header *hdr,
+                              const struct flash_area *fap_src,
+                              uint32_t img_dst, uint32_t img_sz)
+{
+    struct image_header inner_hdr;
+    int rc;
+
+    rc = boot_image_check(state, hdr, fap_src, NULL);
+    if (rc != 0) {
+        BOOT_LOG_INF("Compressed image failed validation in the flash");
+        return BOOT_EBADIMAGE;
+    }
+
+    rc = boot_decompress_to_sram(hdr, fap_src, (uint8_t *)img_dst, img_sz);
+    if (rc == 0) {
+        rc = boot_check_decompressed_header(img_dst, img_sz, &inner_hdr);
+    }
+    if (rc != 0) {
+        BOOT_LOG_INF("Error whilst decompressing image to SRAM");
+        boot_remove_image_from_sram(img_dst, img_sz);
+        return BOOT_EBADIMAGE;
+    }
+
+    *hdr = inner_hdr;
+    return 0;
+}
+#endif /* MCUBOOT_DECOMPRESS_IMAGES */
+
 /**
  * Copies an image from a slot in the flash to an SRAM address, where the load
  * address has already been inserted into the image header by this point and is
@@ -2603,6 +2982,15 @@ boot_copy_image_to_sram(struct boot_loader_state *state, int slot,
         return BOOT_EFLASH;
     }
 
+#ifdef MCUBOOT_DECOMPRESS_IMAGES
+    if (hdr->ih_flags & IMAGE_F_COMPRESSED) {
+        rc = boot_decompress_image_to_sram(state, hdr, fap_src,
+                                           img_dst, img_sz);
+        flash_area_close(fap_src);
+        return rc;
+    }
+#endif /* MCUBOOT_DECOMPRESS_IMAGES */
+
     while (bytes_copied < img_sz) {
         sect_sz = boot_img_sector_size(state, slot, sect);
         /*
@@ -2627,26 +3015,6 @@ boot_copy_image_to_sram(struct boot_loader_state *state, int slot,
     }
     return rc;
 }
-
-/**
- * Removes an image from SRAM, by overwriting it with zeros.
- *
- * @param img_dst         The address of the image that needs to be removed from
- *                        SRAM.
- *
- * @param img_sz          The size of the image that needs to be removed from
- *                        SRAM.
- *
- * @return                0 on success; nonzero on failure.
- */
-static int
-boot_remove_image_from_sram(uint32_t img_dst, uint32_t img_sz)
-{
-    BOOT_LOG_INF("Removing image from SRAM at address 0x%x", img_dst);
-    memset((void*)img_dst, 0, img_sz);
-
-    return 0;
-}
 #endif /* MCUBOOT_RAM_LOADING */
 
 /**
@@ -2717,6 +3085,15 @@ context_boot_go(struct boot_loader_state *state, struct boot_rsp *rsp)
                 img_dst = selected_image_header->ih_load_addr;
 
                 rc = boot_read_image_size(state, slot, &img_sz);
+#ifdef MCUBOOT_DECOMPRESS_IMAGES
+                if (rc == 0 &&
+                    (selected_image_header->ih_flags & IMAGE_F_COMPRESSED)) {
+                    /* The image carried by a compressed image is loaded */
+                    rc = boot_decompressed_size(selected_image_header,
+                                                BOOT_IMG_AREA(state, slot),
+                                                &img_sz);
+                }
+#endif /* MCUBOOT_DECOMPRESS_IMAGES */
                 if (rc != 0) {
                     rc = BOOT_EFLASH;
                     BOOT_LOG_INF("Could not load image headers from the image"
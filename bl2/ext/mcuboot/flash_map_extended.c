@@ -90,7 +90,7 @@ int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
     BOOT_LOG_DBG("read_is_empty area=%d, off=%#x, len=%#x",
                  fa->fa_id, off, len);
 
-    rc = FLASH_DEV_NAME.ReadData(fa->fa_off + off, dst, len);
+    rc = flash_area_read(fa, off, dst, len);
     if (rc) {
         return -1;
     }
@@ -105,3 +105,88 @@ int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
 
     return 1;
 }
+
+int flash_area_read_is_async(const struct flash_area *fa)
+{
+    (void)fa;
+
+    return FLASH_DEV_NAME.GetCapabilities().event_ready ? 1 : 0;
+}
+
+int flash_area_read_start(const struct flash_area *fa, uint32_t off,
+        void *dst, uint32_t len)
+{
+    int rc;
+
+    BOOT_LOG_DBG("read_start area=%d, off=%#x, len=%#x",
+                 fa->fa_id, off, len);
+
+    rc = FLASH_DEV_NAME.ReadData(fa->fa_off + off, dst, len);
+    if (rc < 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static int flash_area_wait_idle(const struct flash_area *fa)
+{
+    ARM_FLASH_STATUS status;
+
+    if (!flash_area_read_is_async(fa)) {
+        /* The operation has already completed when it was started. */
+        return 0;
+    }
+
+    do {
+        status = FLASH_DEV_NAME.GetStatus();
+    } while (status.busy);
+
+    return status.error ? -1 : 0;
+}
+
+int flash_area_read_wait(const struct flash_area *fa)
+{
+    return flash_area_wait_idle(fa);
+}
+
+int flash_area_erase_start(const struct flash_area *fa, uint32_t off,
+        uint32_t len)
+{
+#ifdef FLASH_DEV_READ_WHILE_ERASE
+    ARM_FLASH_INFO *flash_info;
+    int rc;
+
+    flash_info = FLASH_DEV_NAME.GetInfo();
+
+    if (!flash_area_read_is_async(fa) || flash_info->sector_info != NULL ||
+        len != flash_info->sector_size) {
+        return flash_area_erase(fa, off, len) ? -1 : 0;
+    }
+
+    BOOT_LOG_DBG("erase_start area=%d, off=%#x, len=%#x",
+                 fa->fa_id, off, len);
+
+    /* A previous operation might still be in progress. */
+    if (flash_area_wait_idle(fa)) {
+        return -1;
+    }
+
+    rc = FLASH_DEV_NAME.EraseSector(fa->fa_off + off);
+    if (rc != ARM_DRIVER_OK) {
+        return -1;
+    }
+
+    return 0;
+#else
+    /* A read issued while the sector is erasing would only be retried until
+     * the erase completes, so there is nothing to overlap it with.
+     */
+    return flash_area_erase(fa, off, len) ? -1 : 0;
+#endif
+}
+
+int flash_area_erase_wait(const struct flash_area *fa)
+{
+    return flash_area_wait_idle(fa);
+}
@@ -73,6 +73,52 @@ uint8_t flash_area_erased_val(const struct flash_area *fap);
 int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
         void *dst, uint32_t len);
 
+/*
+ * Returns 1 if the flash driver can read asynchronously, i.e. a read started
+ * with flash_area_read_start() can be overlapped with other work, 0 otherwise.
+ */
+int flash_area_read_is_async(const struct flash_area *fa);
+
+/*
+ * Starts reading len bytes from off into dst. If the flash driver is
+ * asynchronous the function may return before the data has arrived, so the
+ * read must be completed with flash_area_read_wait() before dst is used or
+ * another flash operation is started. Otherwise it behaves as
+ * flash_area_read().
+ *
+ * Returns 0 on success, or -1 on failure.
+ */
+int flash_area_read_start(const struct flash_area *fa, uint32_t off,
+        void *dst, uint32_t len);
+
+/*
+ * Waits for the completion of the read started by flash_area_read_start().
+ *
+ * Returns 0 on success, or -1 on failure.
+ */
+int flash_area_read_wait(const struct flash_area *fa);
+
+/*
+ * Starts erasing len bytes from off. If the flash device can be read while a
+ * sector is erasing (FLASH_DEV_READ_WHILE_ERASE in flash_layout.h), the flash
+ * driver is asynchronous and len is exactly one sector, the function returns
+ * as soon as the erase has been issued, so it can be overlapped with reads
+ * from other sectors. The erase must be completed with
+ * flash_area_erase_wait() before the erased sector is written. Otherwise it
+ * behaves as flash_area_erase().
+ *
+ * Returns 0 on success, or -1 on failure.
+ */
+int flash_area_erase_start(const struct flash_area *fa, uint32_t off,
+        uint32_t len);
+
+/*
+ * Waits for the completion of the erase started by flash_area_erase_start().
+ *
+ * Returns 0 on success, or -1 on failure.
+ */
+int flash_area_erase_wait(const struct flash_area *fa);
+
 #ifdef __cplusplus
 }
 #endif
@@ -22,9 +22,13 @@ import argparse
 from imgtool_lib import keys
 from imgtool_lib import image
 from imgtool_lib import version
+from imgtool_lib import delta
+from imgtool_lib import compress
+import hashlib
 import sys
 import macro_parser
 import fileinput
+import struct
 
 sign_bin_size_re = re.compile(r"^\s*RE_SIGN_BIN_SIZE\s*=\s*(.*)")
 image_load_address_re = re.compile(r"^\s*RE_IMAGE_LOAD_ADDRESS\s*=\s*(.*)")
@@ -127,6 +131,109 @@ def do_sign(args):
 
     img.save(args.outfile)
 
+def do_delta(args):
+    if args.rsa_pkcs1_15:
+        keys.sign_rsa_pss = False
+
+    with open(args.base, 'rb') as f:
+        base = f.read()
+    with open(args.infile, 'rb') as f:
+        target = f.read()
+
+    base_info = image.parse_plain_image(base)
+    target_info = image.parse_plain_image(target)
+    base = base[:base_info['length']]
+    target = target[:target_info['length']]
+
+    patch = delta.make_patch(base, target)
+    if delta.apply_patch(base, patch) != target:
+        raise Exception("Failed to create the patch")
+    print("**[INFO]** Delta image payload: {} bytes, full image: {} bytes"
+          .format(len(patch), len(target)))
+
+    if "_s.c" in args.layout:
+        sw_type = "SPE"
+    elif "_ns.c" in args.layout:
+        sw_type = "NSPE"
+    else:
+        sw_type = "NSPE_SPE"
+
+    # The delta image inherits the version and the security counter of the
+    # image it rebuilds.
+    major, minor, revision, build = target_info['version']
+    version_num = version.decode_version(
+        "{}.{}.{}+{}".format(major, minor, revision, build))
+
+    pad_size = macro_parser.evaluate_macro(args.layout, sign_bin_size_re, 0, 1)
+    img = image.Image(version=version_num,
+                      header_size=args.header_size,
+                      security_cnt=target_info['security_cnt'],
+                      pad=pad_size)
+    img.payload = bytes(img.header_size) + patch
+    key = keys.load(args.key, args.public_key_format) if args.key else None
+    delta_info = struct.pack(delta.DELTA_INFO_FMT, base_info['hash'],
+                             len(target))
+    img.sign(sw_type, key, None, None, [('DELTA_BASE', delta_info)],
+             image.IMAGE_F['DELTA'])
+
+    if pad_size:
+        img.pad_to(pad_size, args.align)
+
+    img.save(args.outfile)
+
+def do_compress(args):
+    if args.rsa_pkcs1_15:
+        keys.sign_rsa_pss = False
+
+    with open(args.infile, 'rb') as f:
+        target = f.read()
+
+    target_info = image.parse_plain_image(target)
+    target = target[:target_info['length']]
+
+    payload = compress.compress(target)
+    if compress.decompress(payload, len(target)) != target:
+        raise Exception("Failed to compress the image")
+    print("**[INFO]** Compressed image payload: {} bytes, full image: {} bytes"
+          .format(len(payload), len(target)))
+    if len(payload) >= len(target):
+        print("**[WARNING]** The image cannot be compressed")
+
+    if "_s.c" in args.layout:
+        sw_type = "SPE"
+    elif "_ns.c" in args.layout:
+        sw_type = "NSPE"
+    else:
+        sw_type = "NSPE_SPE"
+
+    # The compressed image inherits the version, the security counter, the
+    # header size and the load address of the image it carries, the latter
+    # two are used to boot the image after it has been decompressed to SRAM.
+    major, minor, revision, build = target_info['version']
+    version_num = version.decode_version(
+        "{}.{}.{}+{}".format(major, minor, revision, build))
+    ram_load_address = None
+    if target_info['flags'] & image.IMAGE_F['RAM_LOAD']:
+        ram_load_address = target_info['load_addr']
+
+    pad_size = macro_parser.evaluate_macro(args.layout, sign_bin_size_re, 0, 1)
+    img = image.Image(version=version_num,
+                      header_size=target_info['header_size'],
+                      security_cnt=target_info['security_cnt'],
+                      pad=pad_size)
+    img.payload = bytes(img.header_size) + payload
+    key = keys.load(args.key, args.public_key_format) if args.key else None
+    decomp_tlvs = [
+        ('DECOMP_SIZE', struct.pack(compress.DECOMP_SIZE_FMT, len(target))),
+        ('DECOMP_SHA256', hashlib.sha256(target).digest())]
+    img.sign(sw_type, key, ram_load_address, None, decomp_tlvs,
+             image.IMAGE_F['COMPRESSED'])
+
+    if pad_size:
+        img.pad_to(pad_size, args.align)
+
+    img.save(args.outfile)
+
 def do_flash(args):
     image_value_re = re.compile(r"^\s*"+args.macro+"\s*=\s*(.*)")
     value = macro_parser.evaluate_macro(args.layout, image_value_re, 0, 1,
@@ -150,6 +257,8 @@ subcmds = {
         'keygen': do_keygen,
         'getpub': do_getpub,
         'sign': do_sign,
+        'delta': do_delta,
+        'compress': do_compress,
         'flash': do_flash, }
 
 
@@ -226,6 +335,39 @@ def args():
     sign.add_argument("infile")
     sign.add_argument("outfile")
 
+    deltap = subs.add_parser('delta',
+                             help='Create a signed delta image from two signed images')
+    deltap.add_argument('-l', '--layout', required=True,
+                        help='Location of the file that contains preprocessed macros')
+    deltap.add_argument('-k', '--key', metavar='filename')
+    deltap.add_argument("-K", "--public-key-format",
+                        help='In what format to add the public key to the image manifest: full or hash',
+                        metavar='pub_key_format', choices=['full', 'hash'], default='hash')
+    deltap.add_argument("--align", type=alignment_value, required=True)
+    deltap.add_argument("-H", "--header-size", type=intparse, required=True)
+    deltap.add_argument("-b", "--base", metavar='filename', required=True,
+                        help='Signed image running on the device')
+    deltap.add_argument("--rsa-pkcs1-15",
+                        help='Use old PKCS#1 v1.5 signature algorithm',
+                        default=False, action='store_true')
+    deltap.add_argument("infile", help='Signed new image')
+    deltap.add_argument("outfile")
+
+    compressp = subs.add_parser('compress',
+                                help='Create a signed compressed image from a signed image')
+    compressp.add_argument('-l', '--layout', required=True,
+                           help='Location of the file that contains preprocessed macros')
+    compressp.add_argument('-k', '--key', metavar='filename')
+    compressp.add_argument("-K", "--public-key-format",
+                           help='In what format to add the public key to the image manifest: full or hash',
+                           metavar='pub_key_format', choices=['full', 'hash'], default='hash')
+    compressp.add_argument("--align", type=alignment_value, required=True)
+    compressp.add_argument("--rsa-pkcs1-15",
+                           help='Use old PKCS#1 v1.5 signature algorithm',
+                           default=False, action='store_true')
+    compressp.add_argument("infile", help='Signed image')
+    compressp.add_argument("outfile")
+
     flash = subs.add_parser('flash', help='modify flash script')
     flash.add_argument("infile")
     flash.add_argument('-l', '--layout', required=True,
@@ -0,0 +1,120 @@
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""
+Compressed image support.
+
+The payload of a compressed image is a complete signed image compressed with
+an LZSS variant which can be decompressed with a small, bounded window:
+
+    A flag byte describes the next 8 items, LSB first. A clear bit is a
+    literal byte. A set bit is a match, encoded in a little endian 16-bit
+    word: bits 0-11 hold the distance - 1 (1 to WINDOW_SIZE bytes back in
+    the output), bits 12-15 hold the length - MIN_MATCH. If the length
+    field is 15 then a byte follows which is added to the length.
+
+The stream ends when the number of bytes recorded in the DECOMP_SIZE TLV
+has been produced.
+"""
+
+import struct
+
+WINDOW_SIZE = 4096
+MIN_MATCH = 3
+# Longest match which fits in the 4-bit length field and the extra byte.
+MAX_MATCH = MIN_MATCH + 15 + 255
+
+# Number of candidates checked for each position, trades speed for ratio.
+MAX_CHAIN = 64
+
+# Payload of the DECOMP_SIZE TLV: size of the decompressed image.
+DECOMP_SIZE_FMT = '<I'
+
+
+def _longest_match(data, pos, chain, end):
+    best_len = 0
+    best_off = 0
+    limit = min(MAX_MATCH, end - pos)
+    for cand in chain:
+        if pos - cand > WINDOW_SIZE:
+            break
+        length = 0
+        while length < limit and data[cand + length] == data[pos + length]:
+            length += 1
+        if length > best_len:
+            best_len = length
+            best_off = pos - cand
+            if length == limit:
+                break
+    return best_len, best_off
+
+
+def compress(data):
+    """Compresses data, see the format description above."""
+    out = bytearray()
+    heads = {}
+    pos = 0
+    end = len(data)
+
+    def insert(p):
+        if p + MIN_MATCH <= end:
+            key = data[p:p + MIN_MATCH]
+            chain = heads.setdefault(key, [])
+            chain.insert(0, p)
+            del chain[MAX_CHAIN:]
+
+    while pos < end:
+        flag_pos = len(out)
+        out.append(0)
+        for bit in range(8):
+            if pos >= end:
+                break
+            length = 0
+            if pos + MIN_MATCH <= end:
+                chain = heads.get(data[pos:pos + MIN_MATCH], [])
+                length, dist = _longest_match(data, pos, chain, end)
+            if length >= MIN_MATCH:
+                out[flag_pos] |= 1 << bit
+                code = min(length - MIN_MATCH, 15)
+                out += struct.pack('<H', (dist - 1) | (code << 12))
+                if code == 15:
+                    out.append(length - MIN_MATCH - 15)
+                for p in range(pos, pos + length):
+                    insert(p)
+                pos += length
+            else:
+                out.append(data[pos])
+                insert(pos)
+                pos += 1
+    return bytes(out)
+
+
+def decompress(data, size):
+    """Decompresses data, used to check the compressed images."""
+    out = bytearray()
+    off = 0
+    while len(out) < size:
+        flags = data[off]
+        off += 1
+        for bit in range(8):
+            if len(out) >= size:
+                break
+            if flags & (1 << bit):
+                word = struct.unpack_from('<H', data, off)[0]
+                off += 2
+                dist = (word & 0xfff) + 1
+                length = (word >> 12) + MIN_MATCH
+                if length == MIN_MATCH + 15:
+                    length += data[off]
+                    off += 1
+                if dist > len(out):
+                    raise Exception("Invalid match distance")
+                for _ in range(length):
+                    out.append(out[-dist])
+            else:
+                out.append(data[off])
+                off += 1
+    if off != len(data) or len(out) != size:
+        raise Exception("Invalid compressed image")
+    return bytes(out)
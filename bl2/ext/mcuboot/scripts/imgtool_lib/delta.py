@@ -0,0 +1,106 @@
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+
+"""
+Delta (differential) image support.
+
+A delta image carries a patch instead of the full image in its payload. The
+patch rebuilds the complete, signed new image from the signed image which is
+running on the device (the base image). The patch is a stream of operations:
+
+    END                             end of the patch
+    COPY  <base offset> <length>    copy bytes of the base image
+    DATA  <length> <bytes>          insert literal bytes
+
+All fields are little endian 32-bit words following the 1-byte opcode.
+"""
+
+import struct
+
+DELTA_OP_END = 0x00
+DELTA_OP_COPY = 0x01
+DELTA_OP_DATA = 0x02
+
+# Size of the delta info TLV: base image hash + target image size.
+DELTA_INFO_FMT = '<32sI'
+
+# Matches shorter than this are cheaper to send as literal data.
+MIN_MATCH = 16
+
+
+def make_patch(base, target):
+    """Computes a patch which rebuilds target from base.
+
+    Every block of MIN_MATCH bytes of the base image is indexed, then the
+    target is scanned for blocks present in the base. Runs of the target
+    which cannot be matched are sent as literal data. The base position
+    right after the previous match is tried first, which keeps code that
+    only moved by a few bytes in one long match."""
+    index = {}
+    for off in range(len(base) - MIN_MATCH, -1, -1):
+        index[base[off:off + MIN_MATCH]] = off
+
+    patch = bytearray()
+    lit_start = 0
+    t = 0
+    next_s = 0
+
+    def emit_data(start, end):
+        if end > start:
+            patch.extend(struct.pack('<BI', DELTA_OP_DATA, end - start))
+            patch.extend(target[start:end])
+
+    while t + MIN_MATCH <= len(target):
+        block = target[t:t + MIN_MATCH]
+        if base[next_s:next_s + MIN_MATCH] == block:
+            s = next_s
+        else:
+            s = index.get(block)
+            if s is None:
+                t += 1
+                continue
+
+        # Extend the match forward
+        length = MIN_MATCH
+        while (t + length < len(target) and s + length < len(base) and
+               target[t + length] == base[s + length]):
+            length += 1
+
+        # and backward into the pending literal data.
+        while t > lit_start and s > 0 and target[t - 1] == base[s - 1]:
+            t -= 1
+            s -= 1
+            length += 1
+
+        emit_data(lit_start, t)
+        patch.extend(struct.pack('<BII', DELTA_OP_COPY, s, length))
+        t += length
+        lit_start = t
+        next_s = s + length
+
+    emit_data(lit_start, len(target))
+    patch.extend(struct.pack('<B', DELTA_OP_END))
+    return bytes(patch)
+
+
+def apply_patch(base, patch):
+    """Rebuilds the target image, used to check the generated patches."""
+    out = bytearray()
+    off = 0
+    while True:
+        op = patch[off]
+        off += 1
+        if op == DELTA_OP_END:
+            return bytes(out)
+        elif op == DELTA_OP_COPY:
+            src, length = struct.unpack_from('<II', patch, off)
+            off += 8
+            out += base[src:src + length]
+        elif op == DELTA_OP_DATA:
+            length = struct.unpack_from('<I', patch, off)[0]
+            off += 4
+            out += patch[off:off + length]
+            off += length
+        else:
+            raise Exception("Invalid delta opcode 0x{:x}".format(op))
@@ -34,7 +34,9 @@ DEP_VERSIONS_KEY = "versions"
 IMAGE_F = {
         'PIC':                   0x0000001,
         'NON_BOOTABLE':          0x0000010,
-        'RAM_LOAD':              0x0000020, }
+        'RAM_LOAD':              0x0000020,
+        'DELTA':                 0x0000040,
+        'COMPRESSED':            0x0000080, }
 TLV_VALUES = {
         'KEYHASH': 0x01,
         'KEY'    : 0x02,
@@ -43,7 +45,10 @@ TLV_VALUES = {
         'RSA3072': 0x23,
         'DEPENDENCY': 0x40,
         'SEC_CNT': 0x50,
-        'BOOT_RECORD': 0x60, }
+        'BOOT_RECORD': 0x60,
+        'DELTA_BASE': 0x70,
+        'DECOMP_SIZE': 0x71,
+        'DECOMP_SHA256': 0x72, }
 
 TLV_INFO_SIZE = 4
 TLV_INFO_MAGIC = 0x6907
@@ -127,7 +132,8 @@ class Image():
             if any(v != 0 and v != b'\000' for v in self.payload[0:self.header_size]):
                 raise Exception("Padding requested, but image does not start with zeros")
 
-    def sign(self, sw_type, key, ramLoadAddress, dependencies=None):
+    def sign(self, sw_type, key, ramLoadAddress, dependencies=None,
+             extra_tlvs=None, extra_flags=0):
         image_version = (str(self.version.major) + '.'
                       + str(self.version.minor) + '.'
                       + str(self.version.revision))
@@ -169,9 +175,16 @@ class Image():
             dependencies_num = len(dependencies[DEP_IMAGES_KEY])
             protected_tlv_size += (dependencies_num * 16)
 
+        if extra_tlvs is None:
+            extra_tlvs = []
+        # Additional protected TLVs describing how the payload is encoded,
+        # e.g. the base image of a delta image
+        for _, value in extra_tlvs:
+            protected_tlv_size += TLV_HEADER_SIZE + len(value)
+
         # At this point the image is already on the payload, this adds
         # the header to the payload as well
-        self.add_header(key, protected_tlv_size, ramLoadAddress)
+        self.add_header(key, protected_tlv_size, ramLoadAddress, extra_flags)
 
         prot_tlv = TLV(TLV_PROT_INFO_MAGIC)
 
@@ -193,6 +206,9 @@ class Image():
                                 )
                 prot_tlv.add('DEPENDENCY', payload)
 
+        for kind, value in extra_tlvs:
+            prot_tlv.add(kind, value)
+
         self.payload += prot_tlv.get()
 
         sha = hashlib.sha256()
@@ -214,13 +230,14 @@ class Image():
 
         self.payload += tlv.get()
 
-    def add_header(self, key, protected_tlv_size, ramLoadAddress):
+    def add_header(self, key, protected_tlv_size, ramLoadAddress,
+                   extra_flags=0):
         """Install the image header.
 
         The key is needed to know the type of signature, and
         approximate the size of the signature."""
 
-        flags = 0
+        flags = extra_flags
         if ramLoadAddress is not None:
             # add the load address flag to the header to indicate that an SRAM
             # load address macro has been defined
@@ -265,3 +282,59 @@ class Image():
         pbytes += b'\xff' * (tsize - len(boot_magic))
         pbytes += boot_magic
         self.payload += pbytes
+
+
+def _parse_tlv_area(data, off, magic):
+    """Returns a list of (type, value) pairs of a TLV area and its end."""
+    tlv_magic, tlv_tot = struct.unpack_from('<HH', data, off)
+    if tlv_magic != magic:
+        raise Exception("Invalid TLV area magic 0x{:x}".format(tlv_magic))
+    end = off + tlv_tot
+    off += TLV_INFO_SIZE
+    tlvs = []
+    while off < end:
+        kind, _, length = struct.unpack_from('<BBH', data, off)
+        off += TLV_HEADER_SIZE
+        tlvs.append((kind, bytes(data[off:off + length])))
+        off += length
+    return tlvs, end
+
+
+def parse_signed_image(data):
+    """Parses a signed image.
+
+    Returns a dictionary with the length of the image without the padding
+    and the trailer, its SHA256 hash, security counter, version and the
+    header fields needed to re-sign its content."""
+    (magic, load_addr, hdr_size, prot_tlv_size, img_size, flags,
+     major, minor, revision, build, _) = struct.unpack_from('<IIHHIIBBHII',
+                                                            data, 0)
+    if magic != IMAGE_MAGIC:
+        raise Exception("Not a signed image")
+
+    off = hdr_size + img_size
+    prot_tlvs = []
+    if prot_tlv_size:
+        prot_tlvs, off = _parse_tlv_area(data, off, TLV_PROT_INFO_MAGIC)
+    tlvs, end = _parse_tlv_area(data, off, TLV_INFO_MAGIC)
+
+    info = {'length': end, 'hash': None, 'security_cnt': 0,
+            'version': (major, minor, revision, build),
+            'header_size': hdr_size, 'flags': flags, 'load_addr': load_addr}
+    for kind, value in prot_tlvs + tlvs:
+        if kind == TLV_VALUES['SHA256']:
+            info['hash'] = value
+        elif kind == TLV_VALUES['SEC_CNT']:
+            info['security_cnt'] = struct.unpack('<I', value)[0]
+    if info['hash'] is None:
+        raise Exception("The image has no SHA256 TLV")
+    return info
+
+
+def parse_plain_image(data):
+    """Parses a signed image which carries its content as is, i.e. it is
+    neither a delta nor a compressed image."""
+    info = parse_signed_image(data)
+    if info['flags'] & (IMAGE_F['DELTA'] | IMAGE_F['COMPRESSED']):
+        raise Exception("The image is already a delta or compressed image")
+    return info
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BOOT_PROFILE_H__
+#define __BOOT_PROFILE_H__
+
+#include <stdint.h>
+#include "tfm_boot_profile_defs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def BOOT_PROFILE_MAX_ENTRIES
+ *
+ * \brief Number of boot phases BL2 can record.
+ */
+#ifndef BOOT_PROFILE_MAX_ENTRIES
+#define BOOT_PROFILE_MAX_ENTRIES (8u)
+#endif
+
+#ifdef TFM_BOOT_PROFILE
+
+/*!
+ * \brief Starts the cycle counter from 0, and records the
+ *        \ref TFM_BOOT_PHASE_BL2_START phase.
+ */
+void boot_profile_init(void);
+
+/*!
+ * \brief Records the end of a boot phase.
+ *
+ * \param[in] phase  \ref tfm_boot_phase_t
+ */
+void boot_profile_record(uint32_t phase);
+
+/*!
+ * \brief Records the \ref TFM_BOOT_PHASE_BL2_JUMP phase, and adds the phases
+ *        recorded to the shared data area, for the SPE to report them.
+ */
+void boot_profile_save(void);
+
+/*!
+ * \brief Timestamp of the phases on cores without a DWT cycle counter. The
+ *        default returns 0; platforms can override it, with a counter that
+ *        keeps running into the SPE.
+ */
+uint32_t boot_profile_platform_timestamp(void);
+
+#define BOOT_PROFILE_INIT()         boot_profile_init()
+#define BOOT_PROFILE_RECORD(phase)  boot_profile_record(phase)
+#define BOOT_PROFILE_SAVE()         boot_profile_save()
+
+#else /* TFM_BOOT_PROFILE */
+
+#define BOOT_PROFILE_INIT()
+#define BOOT_PROFILE_RECORD(phase)
+#define BOOT_PROFILE_SAVE()
+
+#endif /* TFM_BOOT_PROFILE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_PROFILE_H__ */
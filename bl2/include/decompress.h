@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __DECOMPRESS_H__
+#define __DECOMPRESS_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "bootutil/image.h"
+#include "flash_map/flash_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def DECOMP_WINDOW_SIZE
+ *
+ * \brief Size of the window of the compression format. It is the largest
+ *        distance of a match, the decompressor keeps this many bytes of the
+ *        output in RAM.
+ */
+#define DECOMP_WINDOW_SIZE (4096u)
+
+/*!
+ * \def DECOMP_HASH_SIZE
+ *
+ * \brief Size of the hash in the IMAGE_TLV_DECOMP_SHA256 TLV.
+ */
+#define DECOMP_HASH_SIZE   (32u)
+
+/*!
+ * \brief Reads the size of the image carried by a compressed image.
+ *
+ * \param[in]  hdr   Header of the compressed image
+ * \param[in]  fap   Flash area of the slot containing the compressed image
+ * \param[out] size  Size of the decompressed image
+ *
+ * \return 0 on success, nonzero otherwise.
+ */
+int
+boot_decompressed_size(const struct image_header *hdr,
+                       const struct flash_area *fap,
+                       uint32_t *size);
+
+/*!
+ * \brief Decompresses an image without storing it, and checks the size and
+ *        the hash of the result against the DECOMP_SIZE and DECOMP_SHA256
+ *        TLVs.
+ *
+ * \param[in]  hdr      Header of the compressed image
+ * \param[in]  fap_src  Flash area of the slot containing the compressed image
+ *
+ * \return 0 if the image can be decompressed, nonzero otherwise.
+ */
+int
+boot_decompress_check(const struct image_header *hdr,
+                      const struct flash_area *fap_src);
+
+/*!
+ * \brief Decompresses an image to the beginning of a flash area.
+ *
+ * The destination has to be erased by the caller.
+ *
+ * \param[in]  hdr      Header of the compressed image
+ * \param[in]  fap_src  Flash area of the slot containing the compressed image
+ * \param[in]  fap_dst  Flash area to write the decompressed image to
+ *
+ * \return 0 on success, nonzero otherwise.
+ */
+int
+boot_decompress_to_flash(const struct image_header *hdr,
+                         const struct flash_area *fap_src,
+                         const struct flash_area *fap_dst);
+
+/*!
+ * \brief Decompresses an image to RAM.
+ *
+ * The compressed image has to be validated in flash by the caller. The size
+ * and the hash of the result are checked against the DECOMP_SIZE and
+ * DECOMP_SHA256 TLVs, the image it carries has to be validated again in RAM
+ * before it is run.
+ *
+ * \param[in]  hdr      Header of the compressed image
+ * \param[in]  fap_src  Flash area of the slot containing the compressed image
+ * \param[out] dst      Address to write the decompressed image to
+ * \param[in]  dst_sz   Size of the destination buffer
+ *
+ * \return 0 on success, nonzero otherwise.
+ */
+int
+boot_decompress_to_sram(const struct image_header *hdr,
+                        const struct flash_area *fap_src,
+                        uint8_t *dst, uint32_t dst_sz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DECOMPRESS_H__ */
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __DELTA_UPDATE_H__
+#define __DELTA_UPDATE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "bootutil/image.h"
+#include "flash_map/flash_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def DELTA_HASH_SIZE
+ *
+ * \brief Size of the base image hash in the delta info TLV.
+ */
+#define DELTA_HASH_SIZE (32u)
+
+/*!
+ * \struct image_delta_info
+ *
+ * \brief Payload of the IMAGE_TLV_DELTA_BASE protected TLV.
+ */
+struct image_delta_info {
+    uint8_t  base_hash[DELTA_HASH_SIZE]; /* SHA256 TLV of the base image */
+    uint32_t target_size;                /* Size of the rebuilt image */
+};
+
+/*!
+ * \brief Rebuilds the full image from a delta image.
+ *
+ * The delta image in the secondary slot is validated, then its patch is moved
+ * to the scratch area and the new image is rebuilt into the secondary slot
+ * from the image in the primary slot and the patch. The swap request in the
+ * image trailer of the secondary slot is preserved. The rebuilt image has to
+ * be validated by the caller as any other image.
+ *
+ * \param[in]  image_index  Index of the image
+ * \param[in]  delta_hdr    Header of the delta image in the secondary slot
+ * \param[in]  base_hdr     Header of the image in the primary slot
+ * \param[in]  fap_base     Flash area of the primary slot
+ * \param[in]  fap_delta    Flash area of the secondary slot
+ * \param[in]  fap_scratch  Flash area of the scratch
+ *
+ * \return 0 on success, nonzero otherwise. On failure the content of the
+ *         secondary slot is undefined.
+ */
+int
+boot_delta_apply(int image_index,
+                 struct image_header *delta_hdr,
+                 const struct image_header *base_hdr,
+                 const struct flash_area *fap_base,
+                 const struct flash_area *fap_delta,
+                 const struct flash_area *fap_scratch);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DELTA_UPDATE_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -56,10 +56,15 @@ extern "C" {
  * |---------------------------------------|
  * | MAJOR_IAS   | sw_module(6) | claim(6) |
  * |---------------------------------------|
- * | MAJOR_CORE  |          TBD            |
+ * | MAJOR_CORE  |        core_type        |
  * |---------------------------------------|
  */
 
+/* Minor numbers (12 bit) to identify the data of the SPM. Boot profile:
+ * array of struct tfm_boot_profile_entry_t of tfm_boot_profile_defs.h
+ */
+#define TLV_MINOR_CORE_BOOT_PROFILE   0x001
+
 /* Initial attestation: SW components / SW modules
  * This list is intended to be adjusted per device. It contains more SW
  * components than currently available in TF-M project. It serves as an example,
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __VALIDATION_CACHE_H__
+#define __VALIDATION_CACHE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "bootutil/image.h"
+#include "flash_map/flash_map.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def VALIDATION_CACHE_HASH_SIZE
+ *
+ * \brief Size of the digests and the MAC stored in a validation record.
+ */
+#define VALIDATION_CACHE_HASH_SIZE (32u)
+
+/*!
+ * \struct validation_cache_record
+ *
+ * \brief Authenticated record of a successful full image validation.
+ *
+ * The record is stored in the primary slot, right before the image trailer.
+ * The size of the structure must be a multiple of the flash program unit.
+ */
+struct validation_cache_record {
+    uint32_t magic;                                 /* Record magic value */
+    uint32_t security_cnt;                          /* Image security counter */
+    uint8_t  image_hash[VALIDATION_CACHE_HASH_SIZE];/* Validated image hash */
+    uint8_t  hdr_digest[VALIDATION_CACHE_HASH_SIZE];/* Header and TLV digest */
+    uint8_t  mac[VALIDATION_CACHE_HASH_SIZE];       /* HMAC-SHA256, HUK bound */
+};
+
+/*!
+ * \enum validation_cache_err_t
+ *
+ * \brief Return values of the validation cache operations
+ */
+enum validation_cache_err_t {
+    VALIDATION_CACHE_HIT = 0,
+    VALIDATION_CACHE_MISS,
+    VALIDATION_CACHE_ERROR,
+};
+
+/*!
+ * \brief Checks whether the image in a slot has already been fully validated
+ *        on this device.
+ *
+ * The stored record is authenticated with a key derived from the hardware
+ * unique key, then the digest of the image header and TLV area is recomputed
+ * and compared against the record. The image payload itself is not hashed.
+ *
+ * \param[in]  image_index  Index of the image
+ * \param[in]  hdr          Pointer to the image header stored in RAM
+ * \param[in]  fap          Pointer to the flash area where image is stored
+ * \param[in]  tmp_buf      Scratch buffer used for the flash reads
+ * \param[in]  tmp_buf_sz   Size of the scratch buffer
+ *
+ * \return Returns VALIDATION_CACHE_HIT if the image can be trusted without
+ *         a full validation, otherwise VALIDATION_CACHE_MISS or
+ *         VALIDATION_CACHE_ERROR.
+ */
+enum validation_cache_err_t
+boot_validation_cache_check(int image_index,
+                            const struct image_header *hdr,
+                            const struct flash_area *fap,
+                            uint8_t *tmp_buf, uint32_t tmp_buf_sz);
+
+/*!
+ * \brief Stores a validation record for an image that has just passed the
+ *        full validation.
+ *
+ * The record is only written if its location is erased, it is never
+ * overwritten in place. The location is erased together with the image
+ * trailer whenever the slot is updated.
+ *
+ * \param[in]  image_index  Index of the image
+ * \param[in]  hdr          Pointer to the image header stored in RAM
+ * \param[in]  fap          Pointer to the flash area where image is stored
+ * \param[in]  image_hash   Hash of the image computed by the validation
+ * \param[in]  tmp_buf      Scratch buffer used for the flash reads
+ * \param[in]  tmp_buf_sz   Size of the scratch buffer
+ *
+ * \return 0 if the record was written or there was no room for it, nonzero
+ *         on failure.
+ */
+int
+boot_validation_cache_store(int image_index,
+                            const struct image_header *hdr,
+                            const struct flash_area *fap,
+                            const uint8_t *image_hash,
+                            uint8_t *tmp_buf, uint32_t tmp_buf_sz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __VALIDATION_CACHE_H__ */
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "tfm_hal_device_header.h"
+#include "boot_profile.h"
+#include "boot_record.h"
+#include "tfm_boot_status.h"
+
+/* Phases recorded so far, passed to the SPE by boot_profile_save() */
+static struct tfm_boot_profile_entry_t boot_profile[BOOT_PROFILE_MAX_ENTRIES];
+static uint32_t boot_profile_count;
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+/* Set if the DWT has a cycle counter, not all implementations do */
+static uint32_t boot_profile_has_cyccnt;
+#endif
+
+__WEAK uint32_t boot_profile_platform_timestamp(void)
+{
+    return 0;
+}
+
+static uint32_t boot_profile_timestamp(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (boot_profile_has_cyccnt) {
+        return DWT->CYCCNT;
+    }
+#endif
+    return boot_profile_platform_timestamp();
+}
+
+void boot_profile_init(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    /* The counter is left running for the SPE, so that the phases of both
+     * images share one time base.
+     */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    boot_profile_has_cyccnt = !(DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk);
+    if (boot_profile_has_cyccnt) {
+#if defined(DWT_CTRL_CYCDISS_Msk)
+        DWT->CTRL &= ~DWT_CTRL_CYCDISS_Msk;
+#endif
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+
+    boot_profile_count = 0;
+    boot_profile_record(TFM_BOOT_PHASE_BL2_START);
+}
+
+void boot_profile_record(uint32_t phase)
+{
+    struct tfm_boot_profile_entry_t *entry;
+
+    if (boot_profile_count >= BOOT_PROFILE_MAX_ENTRIES) {
+        return;
+    }
+
+    entry = &boot_profile[boot_profile_count++];
+    entry->timestamp = boot_profile_timestamp();
+    entry->phase = (uint16_t)phase;
+    entry->partition_id = 0;
+}
+
+void boot_profile_save(void)
+{
+    boot_profile_record(TFM_BOOT_PHASE_BL2_JUMP);
+
+    /* The profile is only for diagnostics, the boot goes on without it */
+    (void)boot_add_data_to_shared_area(TLV_MAJOR_CORE,
+                                       TLV_MINOR_CORE_BOOT_PROFILE,
+                                       boot_profile_count *
+                                       sizeof(boot_profile[0]),
+                                       (const uint8_t *)boot_profile);
+}
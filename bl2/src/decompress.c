@@ -0,0 +1,357 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "mcuboot_config/mcuboot_config.h"
+#include "decompress.h"
+#include "../ext/mcuboot/bootutil/src/bootutil_priv.h"
+#include "bootutil/image.h"
+#include "bootutil/sha256.h"
+#include "bootutil/bootutil_log.h"
+#include "flash_map/flash_map.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Format of the compressed stream, see imgtool_lib/compress.py */
+#define DECOMP_MIN_MATCH     (3u)
+#define DECOMP_DIST_MASK     (0x0FFFu)
+#define DECOMP_LEN_SHIFT     (12u)
+#define DECOMP_LEN_EXT       (15u)
+
+/* Size of the compressed data read buffer */
+#define DECOMP_READ_SIZE     (256u)
+
+/* The output is passed on in chunks of this size, taken from the window */
+#define DECOMP_FLUSH_SIZE    (256u)
+
+_Static_assert((DECOMP_WINDOW_SIZE & (DECOMP_WINDOW_SIZE - 1)) == 0,
+               "DECOMP_WINDOW_SIZE must be a power of two");
+_Static_assert((DECOMP_WINDOW_SIZE % DECOMP_FLUSH_SIZE) == 0,
+               "DECOMP_FLUSH_SIZE must divide DECOMP_WINDOW_SIZE");
+_Static_assert((DECOMP_FLUSH_SIZE % BOOT_MAX_ALIGN) == 0,
+               "DECOMP_FLUSH_SIZE must be a multiple of BOOT_MAX_ALIGN");
+
+/* Receives the decompressed image in order, chunk by chunk */
+typedef int (*decomp_sink_t)(void *sink_ctx, uint32_t off,
+                             const uint8_t *buf, uint32_t len);
+
+struct decomp_state {
+    const struct flash_area *fap;   /* Slot of the compressed image */
+    uint32_t rd_off;                /* Flash offset of the next refill */
+    uint32_t rd_end;                /* End of the compressed data */
+    uint32_t rd_pos;                /* Read position in rd_buf */
+    uint32_t rd_len;                /* Valid bytes in rd_buf */
+    uint32_t out;                   /* Bytes produced */
+    uint32_t flushed;               /* Bytes passed on to the sink */
+    decomp_sink_t sink;
+    void *sink_ctx;
+    bootutil_sha256_context sha256_ctx;
+    uint8_t rd_buf[DECOMP_READ_SIZE];
+    uint8_t window[DECOMP_WINDOW_SIZE];
+};
+
+static struct decomp_state decomp;
+
+static int
+decomp_read_byte(struct decomp_state *st, uint8_t *val)
+{
+    uint32_t chunk;
+
+    if (st->rd_pos == st->rd_len) {
+        chunk = st->rd_end - st->rd_off;
+        if (chunk == 0) {
+            /* Truncated stream */
+            return -1;
+        }
+        if (chunk > sizeof(st->rd_buf)) {
+            chunk = sizeof(st->rd_buf);
+        }
+        if (flash_area_read(st->fap, st->rd_off, st->rd_buf, chunk) != 0) {
+            return -1;
+        }
+        st->rd_off += chunk;
+        st->rd_pos = 0;
+        st->rd_len = chunk;
+    }
+
+    *val = st->rd_buf[st->rd_pos++];
+
+    return 0;
+}
+
+/* Hashes the new output and passes it on to the sink */
+static int
+decomp_flush(struct decomp_state *st)
+{
+    const uint8_t *buf = &st->window[st->flushed & (DECOMP_WINDOW_SIZE - 1)];
+    uint32_t len = st->out - st->flushed;
+
+    if (len == 0) {
+        return 0;
+    }
+
+    bootutil_sha256_update(&st->sha256_ctx, buf, len);
+    if (st->sink != NULL &&
+        st->sink(st->sink_ctx, st->flushed, buf, len) != 0) {
+        return -1;
+    }
+    st->flushed = st->out;
+
+    return 0;
+}
+
+static inline int
+decomp_put(struct decomp_state *st, uint8_t val)
+{
+    st->window[st->out & (DECOMP_WINDOW_SIZE - 1)] = val;
+    st->out++;
+
+    if ((st->out & (DECOMP_FLUSH_SIZE - 1)) == 0) {
+        return decomp_flush(st);
+    }
+
+    return 0;
+}
+
+/* Decodes a match and copies it from the window */
+static int
+decomp_match(struct decomp_state *st, uint32_t size)
+{
+    uint8_t lo;
+    uint8_t hi;
+    uint8_t ext;
+    uint32_t dist;
+    uint32_t len;
+
+    if (decomp_read_byte(st, &lo) != 0 || decomp_read_byte(st, &hi) != 0) {
+        return -1;
+    }
+    dist = (((uint32_t)hi << 8) | lo) & DECOMP_DIST_MASK;
+    dist += 1;
+    len = (hi >> (DECOMP_LEN_SHIFT - 8)) + DECOMP_MIN_MATCH;
+    if (len == DECOMP_LEN_EXT + DECOMP_MIN_MATCH) {
+        if (decomp_read_byte(st, &ext) != 0) {
+            return -1;
+        }
+        len += ext;
+    }
+
+    if (dist > st->out || len > size - st->out) {
+        return -1;
+    }
+
+    while (len-- > 0) {
+        if (decomp_put(st, st->window[(st->out - dist) &
+                                      (DECOMP_WINDOW_SIZE - 1)]) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* Reads the payload of a protected TLV with the given type and size */
+static int
+decomp_read_tlv(const struct image_header *hdr, const struct flash_area *fap,
+                uint8_t type, void *dst, uint16_t size)
+{
+    struct image_tlv_iter it;
+    uint32_t off;
+    uint16_t len;
+    int rc;
+
+    rc = bootutil_tlv_iter_begin(&it, hdr, fap, type, true);
+    if (rc != 0) {
+        return -1;
+    }
+
+    rc = bootutil_tlv_iter_next(&it, &off, &len, NULL);
+    if (rc != 0 || len != size) {
+        return -1;
+    }
+
+    return flash_area_read(fap, off, dst, size);
+}
+
+/* Decompresses an image, and checks the result against its hash TLV */
+static int
+decomp_run(const struct image_header *hdr, const struct flash_area *fap_src,
+           decomp_sink_t sink, void *sink_ctx)
+{
+    struct decomp_state *st = &decomp;
+    uint8_t expected[DECOMP_HASH_SIZE];
+    uint8_t hash[DECOMP_HASH_SIZE];
+    uint32_t size;
+    uint8_t flags = 0;
+    uint8_t val;
+    int bits = 0;
+    int rc;
+
+    if (!(hdr->ih_flags & IMAGE_F_COMPRESSED)) {
+        return -1;
+    }
+
+    rc = boot_decompressed_size(hdr, fap_src, &size);
+    if (rc != 0) {
+        return rc;
+    }
+
+    rc = decomp_read_tlv(hdr, fap_src, IMAGE_TLV_DECOMP_SHA256,
+                         expected, sizeof(expected));
+    if (rc != 0) {
+        return -1;
+    }
+
+    memset(st, 0, sizeof(*st));
+    st->fap = fap_src;
+    st->rd_off = hdr->ih_hdr_size;
+    st->rd_end = hdr->ih_hdr_size + hdr->ih_img_size;
+    st->sink = sink;
+    st->sink_ctx = sink_ctx;
+    bootutil_sha256_init(&st->sha256_ctx);
+
+    while (st->out < size) {
+        if (bits == 0) {
+            if (decomp_read_byte(st, &flags) != 0) {
+                return -1;
+            }
+            bits = 8;
+        }
+
+        if (flags & 1u) {
+            rc = decomp_match(st, size);
+        } else {
+            rc = decomp_read_byte(st, &val);
+            if (rc == 0) {
+                rc = decomp_put(st, val);
+            }
+        }
+        if (rc != 0) {
+            return -1;
+        }
+
+        flags >>= 1;
+        bits--;
+    }
+
+    if (decomp_flush(st) != 0) {
+        return -1;
+    }
+
+    /* All of the compressed data must have been consumed. */
+    if (st->rd_off != st->rd_end || st->rd_pos != st->rd_len) {
+        return -1;
+    }
+
+    bootutil_sha256_finish(&st->sha256_ctx, hash);
+    if (boot_secure_memequal(hash, expected, sizeof(hash)) != 0) {
+        BOOT_LOG_ERR("Decompressed image hash mismatch");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int
+decomp_flash_sink(void *sink_ctx, uint32_t off, const uint8_t *buf,
+                  uint32_t len)
+{
+    const struct flash_area *fap = sink_ctx;
+    uint8_t tail[BOOT_MAX_ALIGN];
+    uint32_t align = flash_area_align(fap);
+    uint32_t body = len & ~(align - 1);
+
+    if (body > 0 && flash_area_write(fap, off, buf, body) != 0) {
+        return -1;
+    }
+
+    /* Only the last chunk can be unaligned, pad it to the write size. */
+    if (body < len) {
+        memset(tail, flash_area_erased_val(fap), align);
+        memcpy(tail, &buf[body], len - body);
+        if (flash_area_write(fap, off + body, tail, align) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int
+decomp_sram_sink(void *sink_ctx, uint32_t off, const uint8_t *buf,
+                 uint32_t len)
+{
+    uint8_t *dst = sink_ctx;
+
+    memcpy(&dst[off], buf, len);
+
+    return 0;
+}
+
+/* See in decompress.h */
+int
+boot_decompressed_size(const struct image_header *hdr,
+                       const struct flash_area *fap,
+                       uint32_t *size)
+{
+    uint8_t le[4];
+
+    if (decomp_read_tlv(hdr, fap, IMAGE_TLV_DECOMP_SIZE,
+                        le, sizeof(le)) != 0) {
+        return -1;
+    }
+    *size = (uint32_t)le[0] | ((uint32_t)le[1] << 8) |
+            ((uint32_t)le[2] << 16) | ((uint32_t)le[3] << 24);
+
+    return 0;
+}
+
+/* See in decompress.h */
+int
+boot_decompress_check(const struct image_header *hdr,
+                      const struct flash_area *fap_src)
+{
+    return decomp_run(hdr, fap_src, NULL, NULL);
+}
+
+/* See in decompress.h */
+int
+boot_decompress_to_flash(const struct image_header *hdr,
+                         const struct flash_area *fap_src,
+                         const struct flash_area *fap_dst)
+{
+    uint32_t size;
+
+    if (flash_area_align(fap_dst) > BOOT_MAX_ALIGN) {
+        return -1;
+    }
+
+    /* The image must not overlap the trailer of the destination. */
+    if (boot_decompressed_size(hdr, fap_src, &size) != 0 ||
+        size > boot_status_off(fap_dst)) {
+        return -1;
+    }
+
+    return decomp_run(hdr, fap_src, decomp_flash_sink, (void *)fap_dst);
+}
+
+/* See in decompress.h */
+int
+boot_decompress_to_sram(const struct image_header *hdr,
+                        const struct flash_area *fap_src,
+                        uint8_t *dst, uint32_t dst_sz)
+{
+    uint32_t size;
+
+    if (boot_decompressed_size(hdr, fap_src, &size) != 0 || size > dst_sz) {
+        return -1;
+    }
+
+    return decomp_run(hdr, fap_src, decomp_sram_sink, dst);
+}
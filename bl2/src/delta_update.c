@@ -0,0 +1,421 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "mcuboot_config/mcuboot_config.h"
+#include "delta_update.h"
+#include "../ext/mcuboot/bootutil/src/bootutil_priv.h"
+#include "bootutil/image.h"
+#include "bootutil/bootutil_log.h"
+#include "target.h"
+#include "flash_map/flash_map.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Patch opcodes, see imgtool_lib/delta.py */
+#define DELTA_OP_END    (0x00u)
+#define DELTA_OP_COPY   (0x01u)
+#define DELTA_OP_DATA   (0x02u)
+
+/* Size of the patch read buffer and of the output buffer */
+#define DELTA_BUF_SIZE  (256u)
+
+_Static_assert((DELTA_BUF_SIZE % BOOT_MAX_ALIGN) == 0,
+               "DELTA_BUF_SIZE must be a multiple of BOOT_MAX_ALIGN");
+
+/* Buffered reader of the patch stored in the scratch area */
+struct delta_reader {
+    const struct flash_area *fap;
+    uint32_t off;                   /* Flash offset of the next refill */
+    uint32_t end;                   /* End of the patch in the flash area */
+    uint32_t pos;                   /* Read position in buf */
+    uint32_t len;                   /* Valid bytes in buf */
+    uint8_t buf[DELTA_BUF_SIZE];
+};
+
+/* Buffered writer of the rebuilt image */
+struct delta_writer {
+    const struct flash_area *fap;
+    uint32_t off;                   /* Flash offset of buf */
+    uint32_t limit;                 /* Size of the rebuilt image */
+    uint32_t fill;                  /* Valid bytes in buf */
+    uint8_t buf[DELTA_BUF_SIZE];
+};
+
+static struct delta_reader patch_rd;
+static struct delta_writer image_wr;
+
+static int
+delta_read(struct delta_reader *rd, void *dst, uint32_t len)
+{
+    uint8_t *u8dst = dst;
+    uint32_t chunk;
+
+    while (len > 0) {
+        if (rd->pos == rd->len) {
+            chunk = rd->end - rd->off;
+            if (chunk == 0) {
+                /* Truncated patch */
+                return -1;
+            }
+            if (chunk > sizeof(rd->buf)) {
+                chunk = sizeof(rd->buf);
+            }
+            if (flash_area_read(rd->fap, rd->off, rd->buf, chunk) != 0) {
+                return -1;
+            }
+            rd->off += chunk;
+            rd->pos = 0;
+            rd->len = chunk;
+        }
+
+        chunk = rd->len - rd->pos;
+        if (chunk > len) {
+            chunk = len;
+        }
+        memcpy(u8dst, &rd->buf[rd->pos], chunk);
+        rd->pos += chunk;
+        u8dst += chunk;
+        len -= chunk;
+    }
+
+    return 0;
+}
+
+static int
+delta_read_u32(struct delta_reader *rd, uint32_t *val)
+{
+    uint8_t le[4];
+
+    if (delta_read(rd, le, sizeof(le)) != 0) {
+        return -1;
+    }
+    *val = (uint32_t)le[0] | ((uint32_t)le[1] << 8) |
+           ((uint32_t)le[2] << 16) | ((uint32_t)le[3] << 24);
+
+    return 0;
+}
+
+/* Writes out the buffered data, the last chunk is padded to the write size */
+static int
+delta_flush(struct delta_writer *wr)
+{
+    uint32_t align;
+    uint32_t len;
+
+    if (wr->fill == 0) {
+        return 0;
+    }
+
+    align = flash_area_align(wr->fap);
+    len = (wr->fill + align - 1) & ~(align - 1);
+    memset(&wr->buf[wr->fill], flash_area_erased_val(wr->fap),
+           len - wr->fill);
+
+    if (flash_area_write(wr->fap, wr->off, wr->buf, len) != 0) {
+        return -1;
+    }
+    wr->off += wr->fill;
+    wr->fill = 0;
+
+    return 0;
+}
+
+/* Returns the room left in the output buffer, flushing it if it is full */
+static int
+delta_room(struct delta_writer *wr, uint32_t *room)
+{
+    if (wr->fill == sizeof(wr->buf)) {
+        if (delta_flush(wr) != 0) {
+            return -1;
+        }
+    }
+    *room = sizeof(wr->buf) - wr->fill;
+
+    return 0;
+}
+
+static int
+delta_op_copy(struct delta_reader *rd, struct delta_writer *wr,
+              const struct flash_area *fap_base)
+{
+    uint32_t src;
+    uint32_t len;
+    uint32_t chunk;
+
+    if (delta_read_u32(rd, &src) != 0 || delta_read_u32(rd, &len) != 0) {
+        return -1;
+    }
+    if (src > fap_base->fa_size || len > fap_base->fa_size - src ||
+        len > wr->limit - (wr->off + wr->fill)) {
+        return -1;
+    }
+
+    while (len > 0) {
+        if (delta_room(wr, &chunk) != 0) {
+            return -1;
+        }
+        if (chunk > len) {
+            chunk = len;
+        }
+        if (flash_area_read(fap_base, src, &wr->buf[wr->fill], chunk) != 0) {
+            return -1;
+        }
+        wr->fill += chunk;
+        src += chunk;
+        len -= chunk;
+    }
+
+    return 0;
+}
+
+static int
+delta_op_data(struct delta_reader *rd, struct delta_writer *wr)
+{
+    uint32_t len;
+    uint32_t chunk;
+
+    if (delta_read_u32(rd, &len) != 0) {
+        return -1;
+    }
+    if (len > wr->limit - (wr->off + wr->fill)) {
+        return -1;
+    }
+
+    while (len > 0) {
+        if (delta_room(wr, &chunk) != 0) {
+            return -1;
+        }
+        if (chunk > len) {
+            chunk = len;
+        }
+        if (delta_read(rd, &wr->buf[wr->fill], chunk) != 0) {
+            return -1;
+        }
+        wr->fill += chunk;
+        len -= chunk;
+    }
+
+    return 0;
+}
+
+/* Runs the patch and writes the rebuilt image */
+static int
+delta_patch(struct delta_reader *rd, struct delta_writer *wr,
+            const struct flash_area *fap_base)
+{
+    uint8_t op;
+    int rc;
+
+    while (1) {
+        if (delta_read(rd, &op, sizeof(op)) != 0) {
+            return -1;
+        }
+
+        switch (op) {
+        case DELTA_OP_END:
+            if (delta_flush(wr) != 0 || wr->off != wr->limit) {
+                return -1;
+            }
+            return 0;
+        case DELTA_OP_COPY:
+            rc = delta_op_copy(rd, wr, fap_base);
+            break;
+        case DELTA_OP_DATA:
+            rc = delta_op_data(rd, wr);
+            break;
+        default:
+            rc = -1;
+            break;
+        }
+
+        if (rc != 0) {
+            return rc;
+        }
+    }
+}
+
+/* Reads the payload of a TLV with the given type and size */
+static int
+delta_read_tlv(const struct image_header *hdr, const struct flash_area *fap,
+               uint8_t type, bool prot, void *dst, uint16_t size)
+{
+    struct image_tlv_iter it;
+    uint32_t off;
+    uint16_t len;
+    int rc;
+
+    rc = bootutil_tlv_iter_begin(&it, hdr, fap, type, prot);
+    if (rc != 0) {
+        return -1;
+    }
+
+    rc = bootutil_tlv_iter_next(&it, &off, &len, NULL);
+    if (rc != 0 || len != size) {
+        return -1;
+    }
+
+    return flash_area_read(fap, off, dst, size);
+}
+
+/* Rounds up a size to whole sectors */
+static uint32_t
+delta_sector_align(uint32_t size)
+{
+    return (size + FLASH_AREA_IMAGE_SECTOR_SIZE - 1) &
+           ~(FLASH_AREA_IMAGE_SECTOR_SIZE - 1);
+}
+
+/* Copies the patch from the delta image to the start of the scratch area */
+static int
+delta_move_patch(const struct image_header *delta_hdr,
+                 const struct flash_area *fap_delta,
+                 const struct flash_area *fap_scratch,
+                 uint8_t *buf, uint32_t buf_sz)
+{
+    uint32_t patch_sz = delta_hdr->ih_img_size;
+    uint32_t align = flash_area_align(fap_scratch);
+    uint32_t off;
+    uint32_t chunk;
+    uint32_t len;
+
+    /* The trailer of the scratch area must not be overwritten. */
+    if (patch_sz > boot_status_off(fap_scratch)) {
+        BOOT_LOG_ERR("Delta image does not fit in the scratch area");
+        return -1;
+    }
+
+    if (flash_area_erase(fap_scratch, 0, delta_sector_align(patch_sz)) != 0) {
+        return -1;
+    }
+
+    for (off = 0; off < patch_sz; off += chunk) {
+        chunk = patch_sz - off;
+        if (chunk > buf_sz) {
+            chunk = buf_sz;
+        }
+        if (flash_area_read(fap_delta, delta_hdr->ih_hdr_size + off,
+                            buf, chunk) != 0) {
+            return -1;
+        }
+
+        len = (chunk + align - 1) & ~(align - 1);
+        memset(&buf[chunk], flash_area_erased_val(fap_scratch), len - chunk);
+        if (flash_area_write(fap_scratch, off, buf, len) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/* See in delta_update.h */
+int
+boot_delta_apply(int image_index,
+                 struct image_header *delta_hdr,
+                 const struct image_header *base_hdr,
+                 const struct flash_area *fap_base,
+                 const struct flash_area *fap_delta,
+                 const struct flash_area *fap_scratch)
+{
+    struct image_delta_info info;
+    struct boot_swap_state swap_state;
+    uint8_t base_hash[DELTA_HASH_SIZE];
+    uint32_t erase_sz;
+    int rc;
+
+    /* The patch is only used if it has been signed with a trusted key. */
+    rc = bootutil_img_validate(image_index, delta_hdr, fap_delta,
+                               image_wr.buf, sizeof(image_wr.buf),
+                               NULL, 0, NULL);
+    if (rc != 0) {
+        BOOT_LOG_ERR("Delta image is not valid");
+        return rc;
+    }
+
+    rc = delta_read_tlv(delta_hdr, fap_delta, IMAGE_TLV_DELTA_BASE, true,
+                        &info, sizeof(info));
+    if (rc != 0) {
+        return BOOT_EBADIMAGE;
+    }
+
+    rc = delta_read_tlv(base_hdr, fap_base, IMAGE_TLV_SHA256, false,
+                        base_hash, sizeof(base_hash));
+    if (rc != 0 ||
+        boot_secure_memequal(base_hash, info.base_hash, sizeof(base_hash))) {
+        BOOT_LOG_ERR("Delta image does not apply to the primary slot");
+        return BOOT_EBADIMAGE;
+    }
+
+    if (info.target_size > boot_status_off(fap_delta)) {
+        return BOOT_EBADIMAGE;
+    }
+
+    rc = boot_read_swap_state(fap_delta, &swap_state);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    BOOT_LOG_INF("Rebuilding image %d from a delta image", image_index);
+
+    rc = delta_move_patch(delta_hdr, fap_delta, fap_scratch,
+                          image_wr.buf, sizeof(image_wr.buf));
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    /* From here the delta image is only available in the scratch area. */
+    erase_sz = delta_sector_align(info.target_size);
+    rc = flash_area_erase(fap_delta, 0, erase_sz);
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    memset(&patch_rd, 0, sizeof(patch_rd));
+    patch_rd.fap = fap_scratch;
+    patch_rd.end = delta_hdr->ih_img_size;
+
+    memset(&image_wr, 0, sizeof(image_wr));
+    image_wr.fap = fap_delta;
+    image_wr.limit = info.target_size;
+
+    rc = delta_patch(&patch_rd, &image_wr, fap_base);
+    if (rc != 0) {
+        BOOT_LOG_ERR("Failed to apply the delta image");
+        return BOOT_EBADIMAGE;
+    }
+
+    /* The last sector holds the image trailer, restore the swap request
+     * if it has been erased together with the image area.
+     */
+    if (erase_sz > fap_delta->fa_size - FLASH_AREA_IMAGE_SECTOR_SIZE) {
+        if (swap_state.image_ok == BOOT_FLAG_SET) {
+            rc = boot_write_image_ok(fap_delta);
+            if (rc != 0) {
+                return BOOT_EFLASH;
+            }
+        }
+        if (swap_state.magic == BOOT_MAGIC_GOOD) {
+            rc = boot_write_magic(fap_delta);
+            if (rc != 0) {
+                return BOOT_EFLASH;
+            }
+        }
+    }
+
+    /* Do not leave the patch behind, the scratch trailer is parsed on every
+     * boot.
+     */
+    rc = flash_area_erase(fap_scratch, 0,
+                          delta_sector_align(delta_hdr->ih_img_size));
+    if (rc != 0) {
+        return BOOT_EFLASH;
+    }
+
+    return 0;
+}
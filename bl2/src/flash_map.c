@@ -53,6 +53,26 @@ static const struct flash_area flash_map[] = {
 
 static const int flash_map_entry_num = ARRAY_SIZE(flash_map);
 
+/*
+ * Waits until the flash device is idle. Drivers which complete the operations
+ * asynchronously report it with the event_ready capability, with synchronous
+ * drivers this is a no-op.
+ */
+static int32_t flash_wait_idle(void)
+{
+    ARM_FLASH_STATUS status;
+
+    if (!FLASH_DEV_NAME.GetCapabilities().event_ready) {
+        return ARM_DRIVER_OK;
+    }
+
+    do {
+        status = FLASH_DEV_NAME.GetStatus();
+    } while (status.busy);
+
+    return status.error ? ARM_DRIVER_ERROR : ARM_DRIVER_OK;
+}
+
 /*
  * `open` a flash area.  The `area` in this case is not the individual
  * sectors, but describes the particular flash area in question.
@@ -84,15 +104,45 @@ void flash_area_close(const struct flash_area *area)
 int flash_area_read(const struct flash_area *area, uint32_t off, void *dst,
                     uint32_t len)
 {
+    int32_t rc;
+
     BOOT_LOG_DBG("read area=%d, off=%#x, len=%#x", area->fa_id, off, len);
-    return FLASH_DEV_NAME.ReadData(area->fa_off + off, dst, len);
+    rc = FLASH_DEV_NAME.ReadData(area->fa_off + off, dst, len);
+    if (rc == ARM_DRIVER_ERROR_BUSY) {
+        /* The device cannot be read while an erase is in progress. */
+        rc = flash_wait_idle();
+        if (rc == ARM_DRIVER_OK) {
+            rc = FLASH_DEV_NAME.ReadData(area->fa_off + off, dst, len);
+        }
+    }
+    if (rc == ARM_DRIVER_OK) {
+        /* The read has only been started by an asynchronous driver. */
+        rc = flash_wait_idle();
+    }
+
+    /* A positive value is the number of data items read. */
+    return (rc < 0) ? rc : 0;
 }
 
 int flash_area_write(const struct flash_area *area, uint32_t off,
                      const void *src, uint32_t len)
 {
+    int32_t rc;
+
     BOOT_LOG_DBG("write area=%d, off=%#x, len=%#x", area->fa_id, off, len);
-    return FLASH_DEV_NAME.ProgramData(area->fa_off + off, src, len);
+    rc = flash_wait_idle();
+    if (rc != ARM_DRIVER_OK) {
+        return rc;
+    }
+
+    rc = FLASH_DEV_NAME.ProgramData(area->fa_off + off, src, len);
+    if (rc == ARM_DRIVER_OK) {
+        /* The write has only been started by an asynchronous driver. */
+        rc = flash_wait_idle();
+    }
+
+    /* A positive value is the number of data items programmed. */
+    return (rc < 0) ? rc : 0;
 }
 
 int flash_area_erase(const struct flash_area *area, uint32_t off, uint32_t len)
@@ -107,6 +157,10 @@ int flash_area_erase(const struct flash_area *area, uint32_t off, uint32_t len)
     if (flash_info->sector_info == NULL) {
         /* Uniform sector layout */
         while (deleted_len < len) {
+            rc = flash_wait_idle();
+            if (rc != 0) {
+                break;
+            }
             rc = FLASH_DEV_NAME.EraseSector(area->fa_off + off);
             if (rc != 0) {
                 break;
@@ -114,6 +168,9 @@ int flash_area_erase(const struct flash_area *area, uint32_t off, uint32_t len)
             deleted_len += flash_info->sector_size;
             off         += flash_info->sector_size;
         }
+        if (rc == 0) {
+            rc = flash_wait_idle();
+        }
     } else {
         /* Inhomogeneous sector layout, explicitly defined
          * Currently not supported.
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "mcuboot_config/mcuboot_config.h"
+#include "validation_cache.h"
+#include "security_cnt.h"
+#include "../ext/mcuboot/bootutil/src/bootutil_priv.h"
+#include "bootutil/image.h"
+#include "bootutil/sha256.h"
+#include "bootutil/bootutil_log.h"
+#include "target.h"
+#include "flash_map/flash_map.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "platform/include/tfm_plat_crypto_keys.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define VALIDATION_CACHE_MAGIC      (0x56434331u) /* "VCC1" */
+#define VALIDATION_CACHE_BLOCK_SIZE (64u)         /* SHA256 block size */
+
+/* Offset of the MAC within the record, everything before it is MAC-ed. */
+#define VALIDATION_CACHE_MAC_OFF \
+    (offsetof(struct validation_cache_record, mac))
+
+/* The record is written with a single flash_area_write() call. */
+_Static_assert((sizeof(struct validation_cache_record) % BOOT_MAX_ALIGN) == 0,
+               "Validation record size must be a multiple of BOOT_MAX_ALIGN");
+
+static const uint8_t validation_cache_label[] = "BL2_VALIDATION_CACHE";
+
+/**
+ * \brief Offset of the validation record within the flash area. The record is
+ *        placed right before the image trailer.
+ */
+static uint32_t
+validation_cache_off(const struct flash_area *fap)
+{
+    return (boot_status_off(fap) - sizeof(struct validation_cache_record)) &
+           ~(BOOT_MAX_ALIGN - 1u);
+}
+
+/**
+ * \brief Computes HMAC-SHA256 over the authenticated part of a record.
+ *
+ * The MAC also covers the image index and the location of the slot, so a
+ * record is only accepted in the slot where it was created.
+ */
+static int
+validation_cache_mac(int image_index,
+                     const struct flash_area *fap,
+                     const struct validation_cache_record *record,
+                     uint8_t *mac)
+{
+    bootutil_sha256_context sha256_ctx;
+    uint8_t key[VALIDATION_CACHE_HASH_SIZE];
+    uint8_t pad[VALIDATION_CACHE_BLOCK_SIZE];
+    uint8_t inner[VALIDATION_CACHE_HASH_SIZE];
+    uint32_t binding[2];
+    uint32_t i;
+    enum tfm_plat_err_t plat_err;
+
+    plat_err = tfm_plat_get_huk_derived_key(validation_cache_label,
+                                            sizeof(validation_cache_label),
+                                            NULL, 0, key, sizeof(key));
+    if (plat_err != TFM_PLAT_ERR_SUCCESS) {
+        return -1;
+    }
+
+    binding[0] = (uint32_t)image_index;
+    binding[1] = fap->fa_off;
+
+    /* Inner hash: H((K ^ ipad) || binding || record) */
+    memset(pad, 0x36, sizeof(pad));
+    for (i = 0; i < sizeof(key); i++) {
+        pad[i] ^= key[i];
+    }
+    bootutil_sha256_init(&sha256_ctx);
+    bootutil_sha256_update(&sha256_ctx, pad, sizeof(pad));
+    bootutil_sha256_update(&sha256_ctx, binding, sizeof(binding));
+    bootutil_sha256_update(&sha256_ctx, record, VALIDATION_CACHE_MAC_OFF);
+    bootutil_sha256_finish(&sha256_ctx, inner);
+
+    /* Outer hash: H((K ^ opad) || inner) */
+    memset(pad, 0x5c, sizeof(pad));
+    for (i = 0; i < sizeof(key); i++) {
+        pad[i] ^= key[i];
+    }
+    bootutil_sha256_init(&sha256_ctx);
+    bootutil_sha256_update(&sha256_ctx, pad, sizeof(pad));
+    bootutil_sha256_update(&sha256_ctx, inner, sizeof(inner));
+    bootutil_sha256_finish(&sha256_ctx, mac);
+
+    memset(key, 0, sizeof(key));
+    memset(pad, 0, sizeof(pad));
+
+    return 0;
+}
+
+/**
+ * \brief Computes the digest of the image header and of the whole TLV area
+ *        (protected and unprotected). This binds the record to the image
+ *        manifest: hash, signature, key and security counter.
+ */
+static int
+validation_cache_hdr_digest(const struct image_header *hdr,
+                            const struct flash_area *fap,
+                            uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                            uint8_t *digest)
+{
+    bootutil_sha256_context sha256_ctx;
+    struct image_tlv_iter it;
+    uint32_t off;
+    uint32_t blk_sz;
+    int rc;
+
+    rc = bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_ANY, false);
+    if (rc) {
+        return rc;
+    }
+
+    bootutil_sha256_init(&sha256_ctx);
+    bootutil_sha256_update(&sha256_ctx, hdr, sizeof(*hdr));
+
+    for (off = BOOT_TLV_OFF(hdr); off < it.tlv_end; off += blk_sz) {
+        blk_sz = it.tlv_end - off;
+        if (blk_sz > tmp_buf_sz) {
+            blk_sz = tmp_buf_sz;
+        }
+        rc = flash_area_read(fap, off, tmp_buf, blk_sz);
+        if (rc) {
+            return rc;
+        }
+        bootutil_sha256_update(&sha256_ctx, tmp_buf, blk_sz);
+    }
+
+    bootutil_sha256_finish(&sha256_ctx, digest);
+
+    return 0;
+}
+
+/**
+ * \brief Checks that the record can be stored in the slot.
+ *
+ * The record must not overlap the image and it must be in the last sector of
+ * the slot, which is always erased together with the image trailer when the
+ * slot is updated.
+ */
+static int
+validation_cache_fits(const struct image_header *hdr,
+                      const struct flash_area *fap)
+{
+    struct image_tlv_iter it;
+    uint32_t off;
+
+    off = validation_cache_off(fap);
+    if (off < fap->fa_size - FLASH_AREA_IMAGE_SECTOR_SIZE) {
+        return 0;
+    }
+
+    if (bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_ANY, false)) {
+        return 0;
+    }
+
+    return it.tlv_end <= off;
+}
+
+/* See in validation_cache.h */
+enum validation_cache_err_t
+boot_validation_cache_check(int image_index,
+                            const struct image_header *hdr,
+                            const struct flash_area *fap,
+                            uint8_t *tmp_buf, uint32_t tmp_buf_sz)
+{
+    struct validation_cache_record record;
+    uint8_t digest[VALIDATION_CACHE_HASH_SIZE];
+    uint32_t security_cnt;
+    int rc;
+
+    if (!validation_cache_fits(hdr, fap)) {
+        return VALIDATION_CACHE_MISS;
+    }
+
+    rc = flash_area_read_is_empty(fap, validation_cache_off(fap),
+                                  &record, sizeof(record));
+    if (rc < 0) {
+        return VALIDATION_CACHE_ERROR;
+    }
+    if (rc == 1 || record.magic != VALIDATION_CACHE_MAGIC) {
+        return VALIDATION_CACHE_MISS;
+    }
+
+    rc = validation_cache_mac(image_index, fap, &record, digest);
+    if (rc) {
+        return VALIDATION_CACHE_ERROR;
+    }
+    if (boot_secure_memequal(digest, record.mac, sizeof(digest))) {
+        BOOT_LOG_WRN("Validation record of image %d is not authentic",
+                     image_index);
+        return VALIDATION_CACHE_MISS;
+    }
+
+    rc = validation_cache_hdr_digest(hdr, fap, tmp_buf, tmp_buf_sz, digest);
+    if (rc) {
+        return VALIDATION_CACHE_ERROR;
+    }
+    if (boot_secure_memequal(digest, record.hdr_digest, sizeof(digest))) {
+        return VALIDATION_CACHE_MISS;
+    }
+
+    /* The stored security counter might have been increased since the
+     * record was created.
+     */
+    rc = boot_nv_security_counter_get(image_index, &security_cnt);
+    if (rc) {
+        return VALIDATION_CACHE_ERROR;
+    }
+    if (record.security_cnt < security_cnt) {
+        return VALIDATION_CACHE_MISS;
+    }
+
+    return VALIDATION_CACHE_HIT;
+}
+
+/* See in validation_cache.h */
+int
+boot_validation_cache_store(int image_index,
+                            const struct image_header *hdr,
+                            const struct flash_area *fap,
+                            const uint8_t *image_hash,
+                            uint8_t *tmp_buf, uint32_t tmp_buf_sz)
+{
+    struct validation_cache_record record;
+    uint32_t off;
+    int rc;
+
+    if (!validation_cache_fits(hdr, fap)) {
+        BOOT_LOG_WRN("No room for the validation record of image %d",
+                     image_index);
+        return 0;
+    }
+
+    off = validation_cache_off(fap);
+    rc = flash_area_read_is_empty(fap, off, &record, sizeof(record));
+    if (rc < 0) {
+        return BOOT_EFLASH;
+    }
+    if (rc == 0) {
+        /* A stale record is present, it is erased with the next update. */
+        return 0;
+    }
+
+    memset(&record, 0, sizeof(record));
+    record.magic = VALIDATION_CACHE_MAGIC;
+    memcpy(record.image_hash, image_hash, sizeof(record.image_hash));
+
+    rc = bootutil_get_img_security_cnt((struct image_header *)hdr, fap,
+                                       &record.security_cnt);
+    if (rc) {
+        return rc;
+    }
+
+    rc = validation_cache_hdr_digest(hdr, fap, tmp_buf, tmp_buf_sz,
+                                     record.hdr_digest);
+    if (rc) {
+        return rc;
+    }
+
+    rc = validation_cache_mac(image_index, fap, &record, record.mac);
+    if (rc) {
+        return rc;
+    }
+
+    rc = flash_area_write(fap, off, &record, sizeof(record));
+    if (rc) {
+        return BOOT_EFLASH;
+    }
+
+    return 0;
+}
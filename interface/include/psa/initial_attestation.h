@@ -48,6 +48,12 @@ extern "C" {
  */
 #define PSA_INITIAL_ATTEST_MAX_TOKEN_SIZE (0x400)
 
+/**
+ * The maximum number of challenges which can be attested by a single batch
+ * token, see \ref tfm_initial_attest_get_batch_token.
+ */
+#define TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES (8u)
+
 /**
  * The list of fixed claims in the initial attestation token is still evolving,
  * you can expect slight changes in the future.
@@ -201,6 +207,38 @@ psa_status_t
 psa_initial_attest_get_token_size(size_t  challenge_size,
                                   size_t *token_size);
 
+/**
+ * \brief Get an initial attestation token for a batch of challenges
+ *
+ * A single token is signed for all of the challenges. The challenge claim of
+ * the token carries the root of the RFC 6962 Merkle Hash Tree of the
+ * challenges, in the order they are passed in. Each relying party can check
+ * that its challenge is covered by the token with an inclusion proof, which
+ * is derived from the list of challenges by the caller.
+ *
+ * \param[in]     challenges       Pointer to buffer where the challenges are
+ *                                 stored one after the other.
+ * \param[in]     challenge_size   Size of each challenge in bytes. This must
+ *                                 be a supported challenge size (as above).
+ * \param[in]     challenge_count  Number of challenges, from 1 to
+ *                                 \ref TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES.
+ * \param[out]    token_buf        Pointer to the buffer where attestation
+ *                                 token will be stored.
+ * \param[in]     token_buf_size   Size of allocated buffer for token, in
+ *                                 bytes.
+ * \param[out]    token_size       Size of the token that has been returned,
+ *                                 in bytes.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t
+tfm_initial_attest_get_batch_token(const uint8_t *challenges,
+                                   size_t         challenge_size,
+                                   size_t         challenge_count,
+                                   uint8_t       *token_buf,
+                                   size_t         token_buf_size,
+                                   size_t        *token_size);
+
 /**
  * \brief Get the initial attestation public key.
  *
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -31,7 +31,9 @@ extern "C" {
  * \note Currently the cryptography support is not yet enabled, so the
  *       token value is not used and must be passed as NULL, with 0 size
  *
- * \param[in]  record_index Index of the record to retrieve
+ * \param[in]  record_index Index of the record to retrieve, with
+ *                          \ref PSA_AUDIT_STORED_RECORD set to read the
+ *                          persistent copy of the log
  * \param[in]  buffer_size  Size in bytes of the provided buffer
  * \param[in]  token        Must be set to NULL. Token used as a challenge
  *                          for encryption, to protect against rollback
@@ -50,6 +52,55 @@ psa_status_t psa_audit_retrieve_record(const uint32_t record_index,
                                        const uint32_t token_size,
                                        uint8_t *buffer,
                                        uint32_t *record_size);
+/**
+ * \brief Retrieves consecutive records starting at the specified index
+ *
+ * \details The function copies in the buffer provided as many whole records
+ *          as the buffer can hold, up to num_records, starting from the record
+ *          at first_index. The records are concatenated in the buffer, each
+ *          one can be located from the size field of the previous one.
+ *
+ * \param[in]  first_index    Index of the first record to retrieve, with
+ *                            \ref PSA_AUDIT_STORED_RECORD set to read the
+ *                            persistent copy of the log
+ * \param[in]  num_records    Maximum number of records to retrieve
+ * \param[in]  buffer_size    Size in bytes of the provided buffer
+ * \param[out] buffer         Buffer used to store the retrieved records
+ * \param[out] num_retrieved  Number of records retrieved
+ * \param[out] retrieved_size Size in bytes of the retrieved records
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ *
+ */
+psa_status_t psa_audit_retrieve_records(const uint32_t first_index,
+                                        const uint32_t num_records,
+                                        const uint32_t buffer_size,
+                                        uint8_t *buffer,
+                                        uint32_t *num_retrieved,
+                                        uint32_t *retrieved_size);
+
+/**
+ * \brief Verifies the MACs of consecutive records
+ *
+ * \details The MAC of each record covers the MAC of the previous record, so
+ *          that records cannot be modified, removed or reordered without
+ *          breaking the chain. The function checks the chain of MACs of
+ *          num_records records starting at first_index.
+ *
+ * \note The MACs are only computed when the service is built with
+ *       AUDIT_RECORD_MAC, PSA_ERROR_NOT_SUPPORTED is returned otherwise
+ *
+ * \param[in] first_index Index of the first record to verify
+ * \param[in] num_records Number of records to verify
+ *
+ * \return Returns PSA_SUCCESS if the MACs of all the records are valid,
+ *         PSA_ERROR_INVALID_SIGNATURE if a record has been tampered with,
+ *         otherwise values as specified by the \ref psa_status_t
+ *
+ */
+psa_status_t psa_audit_verify_records(const uint32_t first_index,
+                                      const uint32_t num_records);
+
 /**
  * \brief Returns the total number and size of the records stored
  *
@@ -70,7 +121,9 @@ psa_status_t psa_audit_get_info(uint32_t *num_records, uint32_t *size);
  * \details The function returns the size of the record at the given index
  *          provided as input
  *
- * \param[in]  record_index Index of the record to return the size
+ * \param[in]  record_index Index of the record to return the size, with
+ *                          \ref PSA_AUDIT_STORED_RECORD set for a record of
+ *                          the persistent copy of the log
  * \param[out] size         Size of the specified record, in bytes
  *
  * \return Returns values as specified by the \ref psa_status_t
@@ -120,6 +173,22 @@ psa_status_t psa_audit_delete_record(const uint32_t record_index,
  */
 psa_status_t psa_audit_add_record(const struct psa_audit_record *record);
 
+/**
+ * \brief Writes the records added so far to the persistent log
+ *
+ * \details With AUDIT_RECORD_MAC, records are exported to the persistent log
+ *          and to the UART once their MAC is computed, in batches. The
+ *          function computes the pending MACs and writes the records still
+ *          buffered in RAM to flash, so that they are kept across a reset.
+ *
+ * \note This is a Secure only callable API, Non-Secure calls will
+ *       always return error
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ *
+ */
+psa_status_t psa_audit_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,17 @@ struct psa_audit_record {
     uint8_t  payload[]; /*!< Flexible array member for payload */
 };
 
+/*!
+ * \def PSA_AUDIT_STORED_RECORD
+ *
+ * \brief Flag of a record index which selects a record of the persistent copy
+ *        of the log instead of the log in RAM, when the Audit Logging service
+ *        is built with AUDIT_PERSISTENT_LOG. The persistent copy holds the
+ *        records which no longer fit in RAM too, index 0 being the oldest
+ *        record still stored.
+ */
+#define PSA_AUDIT_STORED_RECORD (0x80000000U)
+
 #ifdef __cplusplus
 }
 #endif
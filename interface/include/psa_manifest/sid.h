@@ -47,6 +47,12 @@ extern "C" {
 #define TFM_SP_PLATFORM_IOCTL_VERSION                              (1U)
 #define TFM_SP_PLATFORM_NV_COUNTER_SID                             (0x00000042U)
 #define TFM_SP_PLATFORM_NV_COUNTER_VERSION                         (1U)
+#define TFM_SP_PLATFORM_TRACE_SID                                  (0x00000043U)
+#define TFM_SP_PLATFORM_TRACE_VERSION                              (1U)
+#define TFM_SP_PLATFORM_MEM_PROFILE_SID                            (0x00000044U)
+#define TFM_SP_PLATFORM_MEM_PROFILE_VERSION                        (1U)
+#define TFM_SP_PLATFORM_BOOT_PROFILE_SID                           (0x00000045U)
+#define TFM_SP_PLATFORM_BOOT_PROFILE_VERSION                       (1U)
 
 /******** TFM_SP_INITIAL_ATTESTATION ********/
 #define TFM_ATTEST_GET_TOKEN_SID                                   (0x00000020U)
@@ -55,6 +61,8 @@ extern "C" {
 #define TFM_ATTEST_GET_TOKEN_SIZE_VERSION                          (1U)
 #define TFM_ATTEST_GET_PUBLIC_KEY_SID                              (0x00000022U)
 #define TFM_ATTEST_GET_PUBLIC_KEY_VERSION                          (1U)
+#define TFM_ATTEST_GET_BATCH_TOKEN_SID                             (0x00000023U)
+#define TFM_ATTEST_GET_BATCH_TOKEN_VERSION                         (1U)
 
 /******** TFM_SP_CORE_TEST ********/
 #define SPM_CORE_TEST_INIT_SUCCESS_SID                             (0x0000F020U)
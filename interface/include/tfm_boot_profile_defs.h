@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_BOOT_PROFILE_DEFS_H__
+#define __TFM_BOOT_PROFILE_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Phases of the boot (TFM_BOOT_PROFILE), from BL2 to the start of the
+ * non-secure image. Each entry of the profile marks the end of a phase, which
+ * started at the entry before it. BL2 passes its entries to the SPE in the
+ * shared data area, and the SPE adds its own after them.
+ */
+enum tfm_boot_phase_t {
+    TFM_BOOT_PHASE_BL2_START = 0,   /*!< BL2 main() entered */
+    TFM_BOOT_PHASE_BL2_INIT,        /*!< BL2 platform and crypto init done */
+    TFM_BOOT_PHASE_BL2_VALIDATE,    /*!< Images found and validated */
+    TFM_BOOT_PHASE_BL2_JUMP,        /*!< Jumping to the secure image */
+    TFM_BOOT_PHASE_SPE_START,       /*!< SPE main() entered */
+    TFM_BOOT_PHASE_CORE_INIT,       /*!< tfm_core_init() done */
+    TFM_BOOT_PHASE_SPM_INIT,        /*!< SPM and partition database set up */
+    TFM_BOOT_PHASE_PARTITION_INIT,  /*!< Init of partition_id done */
+    TFM_BOOT_PHASE_NS_START,        /*!< Non-secure image started */
+    TFM_BOOT_PHASE_MAX
+};
+
+struct tfm_boot_profile_entry_t {
+    uint32_t timestamp;     /*!< Cycle counter, or platform timestamp */
+    uint16_t phase;         /*!< \ref tfm_boot_phase_t */
+    uint16_t partition_id;  /*!< Partition of the phase, or 0 */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_BOOT_PROFILE_DEFS_H__ */
@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_MEM_PROFILE_DEFS_H__
+#define __TFM_MEM_PROFILE_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Memory usage of a partition (TFM_MEM_PROFILE), as read by
+ * tfm_platform_mem_profile_read(). All sizes are in bytes, and the peaks are
+ * the largest usage seen since boot.
+ */
+struct tfm_mem_profile_t {
+    int32_t partition_id;   /*!< ID of the partition */
+    uint32_t stack_size;    /*!< Size of the partition stack */
+    uint32_t stack_peak;    /*!< Stack high-water mark, 0 if not measured */
+    uint32_t scratch_size;  /*!< Size of the scratch buffer, 0 if none */
+    uint32_t scratch_peak;  /*!< Largest part of the scratch buffer used */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_MEM_PROFILE_DEFS_H__ */
@@ -91,6 +91,64 @@ enum tfm_platform_err_t
 tfm_platform_nv_counter_read(uint32_t counter_id,
                              uint32_t size, uint8_t *val);
 
+/*!
+ * \brief Moves events out of the SPM trace buffer, oldest first
+ *
+ * \note  The trace shows the timing of the secure side. It is only built in
+ *        with TFM_SPM_TRACE, and the NS OS should only let privileged clients
+ *        read it.
+ *
+ * \param[out] events     Buffer for the events, struct tfm_spm_trace_event_t
+ *                        of tfm_spm_trace_defs.h
+ * \param[in]  size       Size of the buffer in bytes
+ * \param[out] size_read  Number of bytes of events read, 0 once the trace is
+ *                        empty
+ *
+ * \return  TFM_PLATFORM_ERR_SUCCESS if the events are read correctly,
+ *          TFM_PLATFORM_ERR_NOT_SUPPORTED if the trace is not built in.
+ *          Otherwise, it returns TFM_PLATFORM_ERR_SYSTEM_ERROR.
+ */
+enum tfm_platform_err_t
+tfm_platform_trace_read(void *events, size_t size, size_t *size_read);
+
+/*!
+ * \brief Reads the stack and scratch buffer high-water marks of the secure
+ *        partitions
+ *
+ * \note  Only built in with TFM_MEM_PROFILE, to size the partition stacks
+ *        and buffers from measurements rather than by hand.
+ *
+ * \param[out] profile    Buffer for one struct tfm_mem_profile_t of
+ *                        tfm_mem_profile_defs.h per partition
+ * \param[in]  size       Size of the buffer in bytes
+ * \param[out] size_read  Number of bytes of the profile read
+ *
+ * \return  TFM_PLATFORM_ERR_SUCCESS if the profile is read correctly,
+ *          TFM_PLATFORM_ERR_NOT_SUPPORTED if the profile is not built in.
+ *          Otherwise, it returns TFM_PLATFORM_ERR_SYSTEM_ERROR.
+ */
+enum tfm_platform_err_t
+tfm_platform_mem_profile_read(void *profile, size_t size, size_t *size_read);
+
+/*!
+ * \brief Reads the boot phases, from BL2 to the start of the non-secure
+ *        image, and the time each ended at
+ *
+ * \note  Only built in with TFM_BOOT_PROFILE. The same profile is written to
+ *        the secure log when the non-secure image starts.
+ *
+ * \param[out] entries    Buffer for struct tfm_boot_profile_entry_t of
+ *                        tfm_boot_profile_defs.h, one per phase
+ * \param[in]  size       Size of the buffer in bytes
+ * \param[out] size_read  Number of bytes of phases read
+ *
+ * \return  TFM_PLATFORM_ERR_SUCCESS if the phases are read correctly,
+ *          TFM_PLATFORM_ERR_NOT_SUPPORTED if the profile is not built in.
+ *          Otherwise, it returns TFM_PLATFORM_ERR_SYSTEM_ERROR.
+ */
+enum tfm_platform_err_t
+tfm_platform_boot_profile_read(void *entries, size_t size, size_t *size_read);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_SPM_TRACE_DEFS_H__
+#define __TFM_SPM_TRACE_DEFS_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Events of the SPM trace (TFM_SPM_TRACE), as read by
+ * tfm_platform_trace_read(). The layout is fixed, little-endian, and
+ * shared with tools/spm_trace_decode.py.
+ */
+enum tfm_spm_trace_event_id_t {
+    TFM_SPM_TRACE_EV_SVC_ENTER = 0,   /*!< SVC handler entered, sid: SVC num */
+    TFM_SPM_TRACE_EV_SVC_EXIT,        /*!< SVC handler left, sid: SVC num */
+    TFM_SPM_TRACE_EV_CALL_ENTER,      /*!< psa_call() taken by the SPM */
+    TFM_SPM_TRACE_EV_CALL_CHECKED,    /*!< psa_call() vectors checked */
+    TFM_SPM_TRACE_EV_CALL_DISPATCH,   /*!< Message queued to the service */
+    TFM_SPM_TRACE_EV_SCHEDULE,        /*!< Switch to the thread of partition */
+    TFM_SPM_TRACE_EV_MSG_GET,         /*!< psa_get() of the message */
+    TFM_SPM_TRACE_EV_REPLY,           /*!< psa_reply() to the message */
+    TFM_SPM_TRACE_EV_DROPPED,         /*!< handle: events lost, buffer full */
+};
+
+struct tfm_spm_trace_event_t {
+    uint32_t timestamp;     /*!< Cycle counter, or platform timestamp */
+    uint16_t event_id;      /*!< \ref tfm_spm_trace_event_id_t */
+    uint16_t partition_id;  /*!< Partition running, or being scheduled */
+    uint32_t sid;           /*!< SID of the service, when there is one */
+    uint32_t handle;        /*!< Connection of the call, when there is one */
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_SPM_TRACE_DEFS_H__ */
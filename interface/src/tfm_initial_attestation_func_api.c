@@ -59,6 +59,36 @@ psa_initial_attest_get_token_size(size_t  challenge_size,
                             (uint32_t)out_vec, IOVEC_LEN(out_vec));
 }
 
+psa_status_t
+tfm_initial_attest_get_batch_token(const uint8_t *challenges,
+                                   size_t         challenge_size,
+                                   size_t         challenge_count,
+                                   uint8_t       *token_buf,
+                                   size_t         token_buf_size,
+                                   size_t        *token_size)
+{
+    int32_t res;
+
+    psa_invec in_vec[] = {
+        {challenges, challenge_size * challenge_count},
+        {&challenge_size, sizeof(challenge_size)}
+    };
+    psa_outvec out_vec[] = {
+        {token_buf, token_buf_size}
+    };
+
+    res = tfm_ns_interface_dispatch(
+                           (veneer_fn)tfm_initial_attest_get_batch_token_veneer,
+                           (uint32_t)in_vec,  IOVEC_LEN(in_vec),
+                           (uint32_t)out_vec, IOVEC_LEN(out_vec));
+
+    if (res == (int32_t)PSA_SUCCESS) {
+        *token_size = out_vec[0].len;
+    }
+
+    return res;
+}
+
 psa_status_t
 tfm_initial_attest_get_public_key(uint8_t         *public_key,
                                   size_t           public_key_buf_size,
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -50,3 +50,36 @@ tfm_platform_ioctl(tfm_platform_ioctl_req_t request,
                                 (uint32_t)output, (uint32_t)outlen);
 }
 
+
+enum tfm_platform_err_t
+tfm_platform_trace_read(void *events, size_t size, size_t *size_read)
+{
+    (void)events;
+    (void)size;
+
+    /* The SPM trace is only available in the IPC model */
+    *size_read = 0;
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+}
+
+enum tfm_platform_err_t
+tfm_platform_mem_profile_read(void *profile, size_t size, size_t *size_read)
+{
+    (void)profile;
+    (void)size;
+
+    /* The memory profile is only available in the IPC model */
+    *size_read = 0;
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+}
+
+enum tfm_platform_err_t
+tfm_platform_boot_profile_read(void *entries, size_t size, size_t *size_read)
+{
+    (void)entries;
+    (void)size;
+
+    /* In the library model the boot profile is only written to the log */
+    *size_read = 0;
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -76,3 +76,87 @@ tfm_platform_ioctl(tfm_platform_ioctl_req_t request,
     }
 }
 
+
+enum tfm_platform_err_t
+tfm_platform_trace_read(void *events, size_t size, size_t *size_read)
+{
+    psa_outvec out_vec = { .base = events, .len = size };
+    psa_status_t status = PSA_ERROR_CONNECTION_REFUSED;
+    psa_handle_t handle = PSA_NULL_HANDLE;
+
+    *size_read = 0;
+
+    handle = psa_connect(TFM_SP_PLATFORM_TRACE_SID,
+                         TFM_SP_PLATFORM_TRACE_VERSION);
+    if (handle <= 0) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    status = psa_call(handle, PSA_IPC_CALL,
+                      NULL, 0,
+                      &out_vec, 1);
+    psa_close(handle);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    *size_read = out_vec.len;
+    return (enum tfm_platform_err_t) status;
+}
+
+enum tfm_platform_err_t
+tfm_platform_mem_profile_read(void *profile, size_t size, size_t *size_read)
+{
+    psa_outvec out_vec = { .base = profile, .len = size };
+    psa_status_t status = PSA_ERROR_CONNECTION_REFUSED;
+    psa_handle_t handle = PSA_NULL_HANDLE;
+
+    *size_read = 0;
+
+    handle = psa_connect(TFM_SP_PLATFORM_MEM_PROFILE_SID,
+                         TFM_SP_PLATFORM_MEM_PROFILE_VERSION);
+    if (handle <= 0) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    status = psa_call(handle, PSA_IPC_CALL,
+                      NULL, 0,
+                      &out_vec, 1);
+    psa_close(handle);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    *size_read = out_vec.len;
+    return (enum tfm_platform_err_t) status;
+}
+
+enum tfm_platform_err_t
+tfm_platform_boot_profile_read(void *entries, size_t size, size_t *size_read)
+{
+    psa_outvec out_vec = { .base = entries, .len = size };
+    psa_status_t status = PSA_ERROR_CONNECTION_REFUSED;
+    psa_handle_t handle = PSA_NULL_HANDLE;
+
+    *size_read = 0;
+
+    handle = psa_connect(TFM_SP_PLATFORM_BOOT_PROFILE_SID,
+                         TFM_SP_PLATFORM_BOOT_PROFILE_VERSION);
+    if (handle <= 0) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    status = psa_call(handle, PSA_IPC_CALL,
+                      NULL, 0,
+                      &out_vec, 1);
+    psa_close(handle);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    *size_read = out_vec.len;
+    return (enum tfm_platform_err_t) status;
+}
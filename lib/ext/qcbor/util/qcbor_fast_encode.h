@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __QCBOR_FAST_ENCODE_H__
+#define __QCBOR_FAST_ENCODE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "qcbor.h"
+#include "q_useful_buf.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \file qcbor_fast_encode.h
+ *
+ * \brief Encoder for maps of a known shape.
+ *
+ * The general QCBOR encoder checks the space left in the output buffer
+ * for every data item and inserts the head of a map when the map is
+ * closed, after its items are encoded. For a map whose labels and
+ * value types are fixed, the size of the whole map can be calculated
+ * from the values up front. These functions do that, check the output
+ * buffer once and then write the heads and values straight to it.
+ *
+ * The shape of the map is described by a constant array of \ref
+ * qcbor_fast_field_t built with \ref QCBOR_FAST_FIELD, so the size of
+ * the labels is calculated at compile time. Only integer labels,
+ * integer values and byte string values are supported. The output is
+ * the same as the one of \c QCBOREncode_OpenMap(), \c
+ * QCBOREncode_AddInt64ToMapN() / \c QCBOREncode_AddBytesToMapN() and
+ * \c QCBOREncode_CloseMap() with the same items, that is preferred
+ * (shortest) serialization of all heads.
+ *
+ * Everything is inline so that the compiler can specialize the loops
+ * for a constant shape.
+ */
+
+/** Type of the value of a field */
+enum qcbor_fast_type_t {
+    QCBOR_FAST_TYPE_INT64 = 0,
+    QCBOR_FAST_TYPE_BYTES = 1,
+};
+
+/**
+ * Size of the head of a data item whose argument is \c arg. Can be
+ * evaluated at compile time.
+ */
+#define QCBOR_FAST_HEAD_SIZE(arg)                      \
+    ((uint64_t)(arg) < CBOR_TWENTY_FOUR ? 1u :         \
+     (uint64_t)(arg) <= UINT8_MAX       ? 2u :         \
+     (uint64_t)(arg) <= UINT16_MAX      ? 3u :         \
+     (uint64_t)(arg) <= UINT32_MAX      ? 5u : 9u)
+
+/** Argument of the head of the signed integer \c n */
+#define QCBOR_FAST_INT_ARG(n) \
+    ((n) < 0 ? (uint64_t)(-1 - (int64_t)(n)) : (uint64_t)(n))
+
+/**
+ * Initializer of a \ref qcbor_fast_field_t with the integer label
+ * \c label and a value of type \c type (\ref qcbor_fast_type_t).
+ */
+#define QCBOR_FAST_FIELD(label, type) \
+    { (label), (type), QCBOR_FAST_HEAD_SIZE(QCBOR_FAST_INT_ARG(label)) }
+
+/** Description of one field of the map */
+typedef struct {
+    int64_t label;           /* Integer label of the field */
+    uint8_t type;            /* One of \ref qcbor_fast_type_t */
+    uint8_t label_size;      /* Encoded size of the label */
+} qcbor_fast_field_t;
+
+/** Value of one field of the map, interpreted by the type of the field */
+typedef union {
+    int64_t int64;
+    struct q_useful_buf_c bytes;
+} qcbor_fast_value_t;
+
+/**
+ * \brief Writes the head of a data item.
+ *
+ * \param[in] dst         Where to write the head, must have
+ *                        \ref QCBOR_FAST_HEAD_SIZE(arg) bytes.
+ * \param[in] major_type  CBOR major type of the data item.
+ * \param[in] arg         Argument of the head.
+ *
+ * \return Pointer to the byte after the head.
+ */
+static inline uint8_t *qcbor_fast_put_head(uint8_t *dst,
+                                           uint8_t major_type,
+                                           uint64_t arg)
+{
+    size_t n;
+
+    major_type <<= 5;
+    if (arg < CBOR_TWENTY_FOUR) {
+        *dst++ = major_type | (uint8_t)arg;
+        return dst;
+    }
+
+    if (arg <= UINT8_MAX) {
+        *dst++ = major_type | LEN_IS_ONE_BYTE;
+        n = 1;
+    } else if (arg <= UINT16_MAX) {
+        *dst++ = major_type | LEN_IS_TWO_BYTES;
+        n = 2;
+    } else if (arg <= UINT32_MAX) {
+        *dst++ = major_type | LEN_IS_FOUR_BYTES;
+        n = 4;
+    } else {
+        *dst++ = major_type | LEN_IS_EIGHT_BYTES;
+        n = 8;
+    }
+
+    /* Network byte order */
+    while (n-- > 0) {
+        *dst++ = (uint8_t)(arg >> (n * 8));
+    }
+
+    return dst;
+}
+
+/**
+ * \brief Writes a signed integer.
+ */
+static inline uint8_t *qcbor_fast_put_int(uint8_t *dst, int64_t n)
+{
+    if (n < 0) {
+        return qcbor_fast_put_head(dst, CBOR_MAJOR_TYPE_NEGATIVE_INT,
+                                   QCBOR_FAST_INT_ARG(n));
+    }
+    return qcbor_fast_put_head(dst, CBOR_MAJOR_TYPE_POSITIVE_INT,
+                               (uint64_t)n);
+}
+
+/**
+ * \brief Calculates the size of an encoded map.
+ *
+ * \param[in] fields       Shape of the map.
+ * \param[in] values       Value of each field.
+ * \param[in] num_fields   Number of fields and values.
+ * \param[in] extra_items  Number of label and value pairs which are
+ *                         counted in the head of the map, but encoded
+ *                         separately after the fields. Their size is
+ *                         not included.
+ *
+ * \return Size of the head of the map and of the fields in bytes.
+ */
+static inline size_t
+qcbor_fast_map_size(const qcbor_fast_field_t *fields,
+                    const qcbor_fast_value_t *values,
+                    size_t num_fields,
+                    size_t extra_items)
+{
+    size_t size = QCBOR_FAST_HEAD_SIZE(num_fields + extra_items);
+    size_t i;
+
+    for (i = 0; i < num_fields; i++) {
+        size += fields[i].label_size;
+        if (fields[i].type == QCBOR_FAST_TYPE_BYTES) {
+            size += QCBOR_FAST_HEAD_SIZE(values[i].bytes.len) +
+                    values[i].bytes.len;
+        } else {
+            size += QCBOR_FAST_HEAD_SIZE(QCBOR_FAST_INT_ARG(values[i].int64));
+        }
+    }
+
+    return size;
+}
+
+/**
+ * \brief Encodes a map of a known shape.
+ *
+ * \param[in] buf          Output buffer. If \c buf.ptr is \c NULL only
+ *                         the size is calculated.
+ * \param[in] fields       Shape of the map.
+ * \param[in] values       Value of each field.
+ * \param[in] num_fields   Number of fields and values.
+ * \param[in] extra_items  Number of label and value pairs which are
+ *                         counted in the head of the map, but encoded
+ *                         separately by the caller after the fields.
+ *
+ * \return The encoded map, or \c NULL_Q_USEFUL_BUF_C if it does not
+ *         fit in \c buf.
+ */
+static inline struct q_useful_buf_c
+qcbor_fast_encode_map(struct q_useful_buf buf,
+                      const qcbor_fast_field_t *fields,
+                      const qcbor_fast_value_t *values,
+                      size_t num_fields,
+                      size_t extra_items)
+{
+    struct q_useful_buf_c encoded;
+    uint8_t *dst;
+    size_t i;
+
+    encoded.ptr = buf.ptr;
+    encoded.len = qcbor_fast_map_size(fields, values, num_fields,
+                                      extra_items);
+
+    /* The only bounds check, everything below fits */
+    if (encoded.len > buf.len) {
+        return NULL_Q_USEFUL_BUF_C;
+    }
+    if (buf.ptr == NULL) {
+        return encoded;
+    }
+
+    dst = qcbor_fast_put_head((uint8_t *)buf.ptr, CBOR_MAJOR_TYPE_MAP,
+                              num_fields + extra_items);
+    for (i = 0; i < num_fields; i++) {
+        dst = qcbor_fast_put_int(dst, fields[i].label);
+        if (fields[i].type == QCBOR_FAST_TYPE_BYTES) {
+            dst = qcbor_fast_put_head(dst, CBOR_MAJOR_TYPE_BYTE_STRING,
+                                      values[i].bytes.len);
+            if (values[i].bytes.len != 0) {
+                memcpy(dst, values[i].bytes.ptr, values[i].bytes.len);
+                dst += values[i].bytes.len;
+            }
+        } else {
+            dst = qcbor_fast_put_int(dst, values[i].int64);
+        }
+    }
+
+    return encoded;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __QCBOR_FAST_ENCODE_H__ */
@@ -312,6 +312,82 @@ t_cose_sign1_encode_signature(struct t_cose_sign1_sign_ctx *context,
                               QCBOREncodeContext           *cbor_encode_ctx);
 
 
+struct t_cose_crypto_hash;
+
+/**
+ * \brief Start a \c COSE_Sign1 message whose payload is output in chunks.
+ *
+ * \param[in] context       The t_cose signing context.
+ * \param[in] hash_ctx      Hash context which is kept by the caller
+ *                          until t_cose_sign1_stream_finish().
+ * \param[in] payload_len   Length of the encoded payload in bytes.
+ * \param[in] out_buf       Buffer into which the start of the message
+ *                          is put.
+ * \param[out] header       Pointer and length of the start of the
+ *                          message, up to and including the head of
+ *                          the payload bstr.
+ * \param[out] message_len  Length of the complete message.
+ *
+ * \return This returns one of the error codes defined by \ref t_cose_err_t.
+ *
+ * This is an alternative to t_cose_sign1_encode_parameters() and
+ * t_cose_sign1_encode_signature() when the message is not wanted in
+ * a single buffer. The length of the payload has to be known in
+ * advance. The message is made of the bytes of \c header, then the
+ * payload chunks in the order they are passed to
+ * t_cose_sign1_stream_payload(), then the bytes returned by
+ * t_cose_sign1_stream_finish(). The message is the same as the one
+ * t_cose_sign1_sign() makes from the same payload.
+ *
+ * \c out_buf needs to hold the protected and unprotected parameters,
+ * around 100 bytes with a kid. It can be reused once the header is
+ * output.
+ */
+enum t_cose_err_t
+t_cose_sign1_stream_start(struct t_cose_sign1_sign_ctx *context,
+                          struct t_cose_crypto_hash    *hash_ctx,
+                          size_t                        payload_len,
+                          struct q_useful_buf           out_buf,
+                          struct q_useful_buf_c        *header,
+                          size_t                       *message_len);
+
+
+/**
+ * \brief Hash the next chunk of the payload of a streamed \c COSE_Sign1.
+ *
+ * \param[in] hash_ctx       The hash context passed to
+ *                           t_cose_sign1_stream_start().
+ * \param[in] payload_chunk  The next bytes of the encoded payload.
+ *
+ * Hash errors are returned by t_cose_sign1_stream_finish().
+ */
+void
+t_cose_sign1_stream_payload(struct t_cose_crypto_hash *hash_ctx,
+                            struct q_useful_buf_c      payload_chunk);
+
+
+/**
+ * \brief Sign a streamed \c COSE_Sign1 message.
+ *
+ * \param[in] context   The t_cose signing context.
+ * \param[in] hash_ctx  The hash context passed to
+ *                      t_cose_sign1_stream_start().
+ * \param[in] out_buf   Buffer into which the end of the message is put.
+ * \param[out] trailer  Pointer and length of the end of the message,
+ *                      which is the signature bstr.
+ *
+ * \return This returns one of the error codes defined by \ref t_cose_err_t.
+ *
+ * All of the \c payload_len bytes of the payload must have been passed
+ * to t_cose_sign1_stream_payload() before this is called.
+ */
+enum t_cose_err_t
+t_cose_sign1_stream_finish(struct t_cose_sign1_sign_ctx *context,
+                           struct t_cose_crypto_hash    *hash_ctx,
+                           struct q_useful_buf           out_buf,
+                           struct q_useful_buf_c        *trailer);
+
+
 
 
 
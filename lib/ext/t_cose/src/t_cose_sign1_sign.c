@@ -226,6 +226,60 @@ add_unprotected_parameters(const struct t_cose_sign1_sign_ctx *me,
 }
 
 
+/**
+ * \brief Sign the hash of the to-be-signed bytes.
+ *
+ * \param[in] me                    The t_cose signing context.
+ * \param[in] tbs_hash              The hash of the TBS bytes.
+ * \param[in] buffer_for_signature  Pointer and length of buffer into which
+ *                                  the resulting signature is put.
+ * \param[out] signature            Pointer and length of the signature
+ *                                  returned.
+ *
+ * \return This returns one of the error codes defined by \ref t_cose_err_t.
+ */
+static inline enum t_cose_err_t
+sign_tbs_hash(const struct t_cose_sign1_sign_ctx *me,
+              struct q_useful_buf_c               tbs_hash,
+              struct q_useful_buf                 buffer_for_signature,
+              struct q_useful_buf_c              *signature)
+{
+    enum t_cose_err_t return_value;
+
+    /* Compute the signature using public key crypto. The key and
+     * algorithm ID are passed in to know how and what to sign
+     * with. The hash of the TBS bytes is what is signed. A buffer
+     * in which to place the signature is passed in and the
+     * signature is returned.
+     *
+     * Short-circuit signing is invoked if requested. It does no
+     * public key operation and requires no key. It is just a test
+     * mode that works even if no public key algorithm is
+     * integrated.
+     */
+    if(!(me->option_flags & T_COSE_OPT_SHORT_CIRCUIT_SIG)) {
+        /* Normal, non-short-circuit signing */
+        return_value = t_cose_crypto_pub_key_sign(me->cose_algorithm_id,
+                                                  me->signing_key,
+                                                  tbs_hash,
+                                                  buffer_for_signature,
+                                                  signature);
+    } else {
+#ifndef T_COSE_DISABLE_SHORT_CIRCUIT_SIGN
+        /* Short-circuit signing */
+        return_value = short_circuit_sign(me->cose_algorithm_id,
+                                          tbs_hash,
+                                          buffer_for_signature,
+                                          signature);
+#else
+        return_value = T_COSE_ERR_SHORT_CIRCUIT_SIG_DISABLED;
+#endif
+    }
+
+    return return_value;
+}
+
+
 /*
  * Public function. See t_cose_sign1_sign.h
  */
@@ -375,34 +429,10 @@ t_cose_sign1_encode_signature(struct t_cose_sign1_sign_ctx *me,
             goto Done;
         }
 
-        /* Compute the signature using public key crypto. The key and
-         * algorithm ID are passed in to know how and what to sign
-         * with. The hash of the TBS bytes is what is signed. A buffer
-         * in which to place the signature is passed in and the
-         * signature is returned.
-         *
-         * Short-circuit signing is invoked if requested. It does no
-         * public key operation and requires no key. It is just a test
-         * mode that works even if no public key algorithm is
-         * integrated.
-         */
-        if(!(me->option_flags & T_COSE_OPT_SHORT_CIRCUIT_SIG)) {
-            /* Normal, non-short-circuit signing */
-            return_value = t_cose_crypto_pub_key_sign(me->cose_algorithm_id,
-                                                      me->signing_key,
-                                                      tbs_hash,
-                                                      buffer_for_signature,
-                                                      &signature);
-        } else {
-    #ifndef T_COSE_DISABLE_SHORT_CIRCUIT_SIGN
-            /* Short-circuit signing */
-            return_value = short_circuit_sign(me->cose_algorithm_id,
-                                              tbs_hash,
-                                              buffer_for_signature,
-                                              &signature);
-    #endif
-        }
-
+        return_value = sign_tbs_hash(me,
+                                     tbs_hash,
+                                     buffer_for_signature,
+                                     &signature);
         if(return_value) {
             goto Done;
         }
@@ -465,3 +495,153 @@ Done:
     return return_value;
 }
 
+
+/*
+ * Public function. See t_cose_sign1_sign.h
+ */
+enum t_cose_err_t
+t_cose_sign1_stream_start(struct t_cose_sign1_sign_ctx *me,
+                          struct t_cose_crypto_hash    *hash_ctx,
+                          size_t                        payload_len,
+                          struct q_useful_buf           out_buf,
+                          struct q_useful_buf_c        *header,
+                          size_t                       *message_len)
+{
+    /* The head of the array of the four parts of a COSE_Sign1. The
+     * array is not closed by QCBOR as its parts are output
+     * separately.
+     */
+    static const uint8_t   array_head[] = {0x84};
+    const struct q_useful_buf_c array_head_c =
+                            Q_USEFUL_BUF_FROM_BYTE_ARRAY_LITERAL(array_head);
+    enum t_cose_err_t      return_value;
+    QCBOREncodeContext     cbor_encode_ctx;
+    struct q_useful_buf    buffer_for_protected_parameters;
+    struct q_useful_buf_c  kid;
+    struct q_useful_buf_c  payload_len_only;
+    struct q_useful_buf    size_only = {NULL, INT32_MAX};
+    size_t                 sig_size;
+    size_t                 trailer_len;
+
+    if(hash_alg_id_from_sig_alg_id(me->cose_algorithm_id) == T_COSE_INVALID_ALGORITHM_ID) {
+        return T_COSE_ERR_UNSUPPORTED_SIGNING_ALG;
+    }
+
+    buffer_for_protected_parameters = Q_USEFUL_BUF_FROM_BYTE_ARRAY(me->protected_parameters_buffer);
+    me->protected_parameters = encode_protected_parameters(me->cose_algorithm_id, buffer_for_protected_parameters);
+    if(q_useful_buf_c_is_null(me->protected_parameters)) {
+        return T_COSE_ERR_MAKING_PROTECTED;
+    }
+
+    kid = me->kid;
+    if(me->option_flags & T_COSE_OPT_SHORT_CIRCUIT_SIG) {
+#ifndef T_COSE_DISABLE_SHORT_CIRCUIT_SIGN
+        if(q_useful_buf_c_is_null_or_empty(kid)) {
+            kid = get_short_circuit_kid();
+        }
+#else
+        return T_COSE_ERR_SHORT_CIRCUIT_SIG_DISABLED;
+#endif
+    }
+
+    /* -- Everything up to and including the head of the payload bstr -- */
+    QCBOREncode_Init(&cbor_encode_ctx, out_buf);
+    if(!(me->option_flags & T_COSE_OPT_OMIT_CBOR_TAG)) {
+        QCBOREncode_AddTag(&cbor_encode_ctx, CBOR_TAG_COSE_SIGN1);
+    }
+    QCBOREncode_AddEncoded(&cbor_encode_ctx, array_head_c);
+    QCBOREncode_AddBytes(&cbor_encode_ctx, me->protected_parameters);
+
+    return_value = add_unprotected_parameters(me, kid, &cbor_encode_ctx);
+    if(return_value != T_COSE_SUCCESS) {
+        return return_value;
+    }
+
+    payload_len_only.ptr = NULL;
+    payload_len_only.len = payload_len;
+    QCBOREncode_AddBytesLenOnly(&cbor_encode_ctx, payload_len_only);
+
+    if(QCBOREncode_Finish(&cbor_encode_ctx, header)) {
+        return T_COSE_ERR_TOO_SMALL;
+    }
+
+    /* -- Size of the signature bstr that will close the message -- */
+    return_value = t_cose_crypto_sig_size(me->cose_algorithm_id,
+                                          me->signing_key,
+                                          &sig_size);
+    if(return_value) {
+        return return_value;
+    }
+
+    QCBOREncode_Init(&cbor_encode_ctx, size_only);
+    payload_len_only.len = sig_size;
+    QCBOREncode_AddBytes(&cbor_encode_ctx, payload_len_only);
+    if(QCBOREncode_FinishGetSize(&cbor_encode_ctx, &trailer_len)) {
+        return T_COSE_ERR_CBOR_FORMATTING;
+    }
+
+    *message_len = header->len + payload_len + trailer_len;
+
+    /* -- Hash everything in the TBS bytes before the payload -- */
+    payload_len_only.len = payload_len;
+    return start_tbs_hash(me->cose_algorithm_id,
+                          me->protected_parameters,
+                          T_COSE_TBS_BARE_PAYLOAD,
+                          payload_len_only,
+                          hash_ctx);
+}
+
+
+/*
+ * Public function. See t_cose_sign1_sign.h
+ */
+void
+t_cose_sign1_stream_payload(struct t_cose_crypto_hash *hash_ctx,
+                            struct q_useful_buf_c      payload_chunk)
+{
+    t_cose_crypto_hash_update(hash_ctx, payload_chunk);
+}
+
+
+/*
+ * Public function. See t_cose_sign1_sign.h
+ */
+enum t_cose_err_t
+t_cose_sign1_stream_finish(struct t_cose_sign1_sign_ctx *me,
+                           struct t_cose_crypto_hash    *hash_ctx,
+                           struct q_useful_buf           out_buf,
+                           struct q_useful_buf_c        *trailer)
+{
+    enum t_cose_err_t            return_value;
+    QCBOREncodeContext           cbor_encode_ctx;
+    struct q_useful_buf_c        tbs_hash;
+    struct q_useful_buf_c        signature;
+    Q_USEFUL_BUF_MAKE_STACK_UB(  buffer_for_signature, T_COSE_MAX_SIG_SIZE);
+    Q_USEFUL_BUF_MAKE_STACK_UB(  buffer_for_tbs_hash, T_COSE_CRYPTO_MAX_HASH_SIZE);
+
+    return_value = t_cose_crypto_hash_finish(hash_ctx,
+                                             buffer_for_tbs_hash,
+                                             &tbs_hash);
+    if(return_value) {
+        return return_value;
+    }
+
+    return_value = sign_tbs_hash(me,
+                                 tbs_hash,
+                                 buffer_for_signature,
+                                 &signature);
+    if(return_value) {
+        return return_value;
+    }
+
+    /* The signature is the last item of the array opened by
+     * t_cose_sign1_stream_start(), nothing else follows it.
+     */
+    QCBOREncode_Init(&cbor_encode_ctx, out_buf);
+    QCBOREncode_AddBytes(&cbor_encode_ctx, signature);
+    if(QCBOREncode_Finish(&cbor_encode_ctx, trailer)) {
+        return T_COSE_ERR_TOO_SMALL;
+    }
+
+    return T_COSE_SUCCESS;
+}
@@ -150,24 +150,20 @@ enum t_cose_err_t create_tbm(UsefulBuf                       tbm_first_part_buf,
 /*
  * Public function. See t_cose_util.h
  */
-enum t_cose_err_t create_tbs_hash(int32_t                     cose_algorithm_id,
-                                  struct q_useful_buf_c       protected_parameters,
-                                  enum t_cose_tbs_hash_mode_t payload_mode,
-                                  struct q_useful_buf_c       payload,
-                                  struct q_useful_buf         buffer_for_hash,
-                                  struct q_useful_buf_c      *hash)
+enum t_cose_err_t start_tbs_hash(int32_t                     cose_algorithm_id,
+                                 struct q_useful_buf_c       protected_parameters,
+                                 enum t_cose_tbs_hash_mode_t payload_mode,
+                                 struct q_useful_buf_c       payload,
+                                 struct t_cose_crypto_hash  *hash_ctx)
 {
     /* approximate stack use on 32-bit machine:
-     *    210 bytes for all but hash context
-     *    8 to 224 of hash context depending on hash implementation
-     *    220 to 434 bytes total
+     *    210 bytes
      */
     enum t_cose_err_t           return_value;
     QCBOREncodeContext          cbor_encode_ctx;
     UsefulBuf_MAKE_STACK_UB(    buffer_for_TBS_first_part, T_COSE_SIZE_OF_TBS);
     struct q_useful_buf_c       tbs_first_part;
     QCBORError                  qcbor_result;
-    struct t_cose_crypto_hash   hash_ctx;
     int32_t                     hash_alg_id;
     size_t                      bytes_to_omit;
 
@@ -220,11 +216,41 @@ enum t_cose_err_t create_tbs_hash(int32_t                     cose_algorithm_id,
     /* Don't check hash_alg_id for failure. t_cose_crypto_hash_start()
      * will handle error properly. It was also checked earlier.
      */
-    return_value = t_cose_crypto_hash_start(&hash_ctx, hash_alg_id);
+    return_value = t_cose_crypto_hash_start(hash_ctx, hash_alg_id);
     if(return_value) {
         goto Done;
     }
 
+    /* This is the hashing of the first part, all the CBOR except the
+     * payload.
+     */
+    t_cose_crypto_hash_update(hash_ctx,
+                              q_useful_buf_head(tbs_first_part,
+                                                tbs_first_part.len - bytes_to_omit));
+
+Done:
+    return return_value;
+}
+
+
+/*
+ * Public function. See t_cose_util.h
+ */
+enum t_cose_err_t create_tbs_hash(int32_t                     cose_algorithm_id,
+                                  struct q_useful_buf_c       protected_parameters,
+                                  enum t_cose_tbs_hash_mode_t payload_mode,
+                                  struct q_useful_buf_c       payload,
+                                  struct q_useful_buf         buffer_for_hash,
+                                  struct q_useful_buf_c      *hash)
+{
+    /* approximate stack use on 32-bit machine:
+     *    210 bytes for all but hash context
+     *    8 to 224 of hash context depending on hash implementation
+     *    220 to 434 bytes total
+     */
+    enum t_cose_err_t           return_value;
+    struct t_cose_crypto_hash   hash_ctx;
+
     /* This structure is hashed in two parts. The first part is
      * the CBOR-formatted array with protected parameters and such.
      * The last part is the actual bytes of the payload. Doing it
@@ -238,13 +264,14 @@ enum t_cose_err_t create_tbs_hash(int32_t                     cose_algorithm_id,
      * to be wrapped in a bstr. It is done one way when signing and
      * another when verifying.
      */
-
-    /* This is the hashing of the first part, all the CBOR except the
-     * payload.
-     */
-    t_cose_crypto_hash_update(&hash_ctx,
-                              q_useful_buf_head(tbs_first_part,
-                                                tbs_first_part.len - bytes_to_omit));
+    return_value = start_tbs_hash(cose_algorithm_id,
+                                  protected_parameters,
+                                  payload_mode,
+                                  payload,
+                                  &hash_ctx);
+    if(return_value) {
+        goto Done;
+    }
 
     /* Hash the payload, the second part. This may or may not have the
      * bstr wrapping. If not, it was hashed above.
@@ -194,6 +194,36 @@ enum t_cose_err_t create_tbs_hash(int32_t                     cose_algorithm_id,
                                   struct q_useful_buf_c      *hash);
 
 
+struct t_cose_crypto_hash;
+
+/**
+ * \brief Start the hash of the to-be-signed (TBS) bytes for COSE.
+ *
+ * \param[in] cose_algorithm_id     The COSE signing algorithm ID. Used to
+ *                                  determine which hash function to use.
+ * \param[in] protected_parameters  Full, CBOR encoded, protected parameters.
+ * \param[in] payload_mode          See \ref t_cose_tbs_hash_mode_t.
+ * \param[in] payload               The CBOR encoded payload. With
+ *                                  \ref T_COSE_TBS_BARE_PAYLOAD only the
+ *                                  length is used, the pointer can be \c NULL.
+ * \param[out] hash_ctx             The hash context to start.
+ *
+ * \return This returns one of the error codes defined by \ref t_cose_err_t.
+ *
+ * This hashes everything in the TBS bytes up to the payload, as
+ * create_tbs_hash() does. The payload is then passed to
+ * t_cose_crypto_hash_update() by the caller, in as many chunks as
+ * needed, and the hash is completed with t_cose_crypto_hash_finish().
+ * This lets the payload be hashed as it is produced, without
+ * holding all of it in a buffer.
+ */
+enum t_cose_err_t start_tbs_hash(int32_t                     cose_algorithm_id,
+                                 struct q_useful_buf_c       protected_parameters,
+                                 enum t_cose_tbs_hash_mode_t payload_mode,
+                                 struct q_useful_buf_c       payload,
+                                 struct t_cose_crypto_hash  *hash_ctx);
+
+
 
 
 #ifndef T_COSE_DISABLE_SHORT_CIRCUIT_SIGN
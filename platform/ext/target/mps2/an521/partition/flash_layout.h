@@ -28,7 +28,8 @@
  * 0x0030_0000 Protected Storage Area (20 KB)
  * 0x0030_5000 Internal Trusted Storage Area (16 KB)
  * 0x0030_9000 NV counters area (4 KB)
- * 0x0030_A000 Unused (984 KB)
+ * 0x0030_A000 Audit Logging Area (16 KB)
+ * 0x0030_E000 Unused (968 KB)
  *
  * Flash layout on MPS2 AN521 with BL2 (single image boot):
  *
@@ -43,7 +44,8 @@
  * 0x0038_0000 Protected Storage Area (20 KB)
  * 0x0038_5000 Internal Trusted Storage Area (16 KB)
  * 0x0038_9000 NV counters area (4 KB)
- * 0x0038_A000 Unused (472 KB)
+ * 0x0038_A000 Audit Logging Area (16 KB)
+ * 0x0038_E000 Unused (456 KB)
  *
  * Flash layout on MPS2 AN521, if BL2 not defined:
  *
@@ -153,6 +155,11 @@
                                          FLASH_ITS_AREA_SIZE)
 #define FLASH_NV_COUNTERS_AREA_SIZE     (FLASH_AREA_IMAGE_SECTOR_SIZE)
 
+/* Audit Logging Service definitions */
+#define FLASH_AUDIT_AREA_OFFSET         (FLASH_NV_COUNTERS_AREA_OFFSET + \
+                                         FLASH_NV_COUNTERS_AREA_SIZE)
+#define FLASH_AUDIT_AREA_SIZE           (0x4000)   /* 16 KB */
+
 /* Offset and size definition in flash area used by assemble.py */
 #define SECURE_IMAGE_OFFSET             (0x0)
 #define SECURE_IMAGE_MAX_SIZE           FLASH_S_PARTITION_SIZE
@@ -218,6 +225,25 @@
 #define TFM_NV_COUNTERS_SECTOR_ADDR  FLASH_NV_COUNTERS_AREA_OFFSET
 #define TFM_NV_COUNTERS_SECTOR_SIZE  FLASH_AREA_IMAGE_SECTOR_SIZE
 
+/* Audit Logging Service definitions, used when the persistent audit log is
+ * enabled.
+ * Note: Further documentation of these definitions can be found in the
+ * TF-M Audit Logging Integration Guide.
+ */
+#define AUDIT_FLASH_DEV_NAME Driver_FLASH0
+
+/* In this target the CMSIS driver requires only the offset from the base
+ * address instead of the full memory address.
+ */
+#define AUDIT_FLASH_AREA_ADDR     FLASH_AUDIT_AREA_OFFSET
+/* Dedicated flash area for the audit log */
+#define AUDIT_FLASH_AREA_SIZE     FLASH_AUDIT_AREA_SIZE
+#define AUDIT_SECTOR_SIZE         FLASH_AREA_IMAGE_SECTOR_SIZE
+/* Number of AUDIT_SECTOR_SIZE per segment of the log */
+#define AUDIT_SECTORS_PER_SEGMENT (0x1)
+/* Specifies the smallest flash programmable unit in bytes */
+#define AUDIT_FLASH_PROGRAM_UNIT  (0x1)
+
 /* Use SRAM1 memory to store Code data */
 #define S_ROM_ALIAS_BASE  (0x10000000)
 #define NS_ROM_ALIAS_BASE (0x00000000)
@@ -10,6 +10,10 @@
 
 enum tfm_spm_request_type_t {
     TFM_SPM_REQUEST_RESET_VOTE,
+    TFM_SPM_REQUEST_TRACE_READ,
+    TFM_SPM_REQUEST_SCRATCH_PEAK,
+    TFM_SPM_REQUEST_MEM_PROFILE_READ,
+    TFM_SPM_REQUEST_BOOT_PROFILE_READ,
 };
 
 /**
@@ -19,4 +23,55 @@ enum tfm_spm_request_type_t {
  */
 int32_t tfm_spm_request_reset_vote(void);
 
+/**
+ * \brief Request SPM to move events out of its trace buffer (TFM_SPM_TRACE)
+ *
+ * \param[out] events      Buffer of struct tfm_spm_trace_event_t
+ * \param[in]  max_events  Number of events that fit in the buffer
+ *
+ * \return Returns the number of events read, or -1 if the trace is not built
+ *         in, the caller is not a PSA RoT partition or the buffer is invalid
+ */
+int32_t tfm_spm_request_trace_read(void *events, uint32_t max_events);
+
+/**
+ * \brief Report to SPM the high-water mark of the calling partition's scratch
+ *        buffer (TFM_MEM_PROFILE)
+ *
+ * \param[in] size  Size of the scratch buffer in bytes
+ * \param[in] peak  Largest number of bytes of it used so far
+ *
+ * \return Returns 0 on success, or -1 if the profile is not built in
+ */
+int32_t tfm_spm_request_scratch_peak(uint32_t size, uint32_t peak);
+
+/**
+ * \brief Request SPM to read the memory profile of the partitions
+ *        (TFM_MEM_PROFILE)
+ *
+ * \param[out] profile      Buffer of struct tfm_mem_profile_t
+ * \param[in]  first        Index of the first partition to read
+ * \param[in]  max_entries  Number of partitions that fit in the buffer
+ *
+ * \return Returns the number of partitions read, or -1 if the profile is not
+ *         built in, the caller is not a PSA RoT partition or the buffer is
+ *         invalid
+ */
+int32_t tfm_spm_request_mem_profile_read(void *profile, uint32_t first,
+                                         uint32_t max_entries);
+
+/**
+ * \brief Request SPM to read the boot phases it recorded (TFM_BOOT_PROFILE)
+ *
+ * \param[out] entries      Buffer of struct tfm_boot_profile_entry_t
+ * \param[in]  first        Index of the first phase to read
+ * \param[in]  max_entries  Number of phases that fit in the buffer
+ *
+ * \return Returns the number of phases read, or -1 if the profile is not
+ *         built in, the caller is not a PSA RoT partition or the buffer is
+ *         invalid
+ */
+int32_t tfm_spm_request_boot_profile_read(void *entries, uint32_t first,
+                                          uint32_t max_entries);
+
 #endif /* __TFM_SPM_SERVICES_API_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -11,6 +11,12 @@
 #include "audit_core.h"
 #include "psa_audit_defs.h"
 #include "tfm_secure_api.h"
+#ifdef AUDIT_PERSISTENT_LOG
+#include "audit_flash_log.h"
+#endif
+#ifdef AUDIT_RECORD_MAC
+#include "audit_mac.h"
+#endif
 
 /*!
  * \def AUDIT_UART_REDIRECTION
@@ -57,6 +63,81 @@ static uint8_t log_uart_init_success = 0U;
  *        representation for UART redirection
  */
 static const char hex_values[] = "0123456789ABCDEF";
+
+/*!
+ * \def AUDIT_UART_ASYNC
+ *
+ * \brief If set to 1 by the build system, the log entries are staged in a
+ *        transmit ring and sent by the non-blocking Send of the UART driver,
+ *        so that adding a record does not wait for the UART. The driver must
+ *        signal ARM_USART_EVENT_SEND_COMPLETE when a transfer is done. Keep it
+ *        disabled by default.
+ */
+#ifndef AUDIT_UART_ASYNC
+#define AUDIT_UART_ASYNC (0U)
+#endif
+
+#if (AUDIT_UART_ASYNC == 1U)
+/*!
+ * \def AUDIT_UART_TX_RING_SIZE
+ *
+ * \brief Size in bytes of the transmit ring. Each byte of a log entry takes 3
+ *        characters on the UART, entries which do not fit in the free space
+ *        of the ring are dropped.
+ *
+ * \note Must be a power of 2, large enough for an entry of LOG_SIZE bytes
+ *       and the report of dropped entries.
+ */
+#ifndef AUDIT_UART_TX_RING_SIZE
+#define AUDIT_UART_TX_RING_SIZE (4096)
+#endif
+
+#if (AUDIT_UART_TX_RING_SIZE & (AUDIT_UART_TX_RING_SIZE - 1)) != 0
+#error "AUDIT_UART_TX_RING_SIZE must be a power of 2"
+#endif
+
+/*!
+ * \def AUDIT_UART_DROP_MSG_SIZE
+ *
+ * \brief Size of the line reporting the number of dropped entries, i.e.
+ *        "DROPPED " followed by 8 hex digits and the end of line
+ */
+#define AUDIT_UART_DROP_MSG_SIZE (18)
+
+/*!
+ * \var uart_tx_ring
+ *
+ * \brief Ring holding the characters waiting to be sent to the UART
+ */
+static uint8_t uart_tx_ring[AUDIT_UART_TX_RING_SIZE];
+
+/*!
+ * \struct uart_tx_vars
+ *
+ * \brief Contains the state variables of the transmit ring
+ *
+ * \details head is only written when adding a record, tail and in_flight
+ *          only by the owner of the transfer, which is the completion
+ *          callback while a transfer is in progress. The indexes are free
+ *          running and wrap on the ring size when accessing the ring.
+ */
+struct uart_tx_vars {
+    volatile uint32_t head;      /*!< Index of the next character to stage */
+    volatile uint32_t tail;      /*!< Index of the next character to send */
+    volatile uint32_t in_flight; /*!< Number of characters being sent, 0 when
+                                      the UART is idle */
+    volatile uint32_t dropped;   /*!< Number of entries dropped because the
+                                      ring was full */
+    uint32_t reported;           /*!< Value of dropped when last reported */
+};
+
+/*!
+ * \var uart_tx_state
+ *
+ * \brief Current state variables for the transmit ring
+ */
+static struct uart_tx_vars uart_tx_state = {0};
+#endif /* AUDIT_UART_ASYNC == 1U */
 #endif
 
 /*!
@@ -86,6 +167,22 @@ static const char hex_values[] = "0123456789ABCDEF";
  */
 #define LOG_SIZE (1024)
 
+#if (AUDIT_UART_REDIRECTION == 1U) && (AUDIT_UART_ASYNC == 1U)
+/* An empty ring must take the largest entry, or it would never be sent */
+#if AUDIT_UART_TX_RING_SIZE < ((3 * LOG_SIZE) + 2 + AUDIT_UART_DROP_MSG_SIZE)
+#error "AUDIT_UART_TX_RING_SIZE is too small for an entry of LOG_SIZE bytes"
+#endif
+#endif
+
+/*!
+ * \def LOG_MAX_RECORDS
+ *
+ * \brief Maximum number of records which can be stored in the log at the same
+ *        time, i.e. the number of records of minimum size which fill the log
+ */
+#define LOG_MAX_RECORDS (LOG_SIZE / \
+                         (LOG_FIXED_FIELD_SIZE + LOG_MIN_SIZE + LOG_MAC_SIZE))
+
 /*!
  * \var log_buffer
  *
@@ -104,6 +201,16 @@ static uint8_t log_buffer[LOG_SIZE] = {0};
  */
 static uint64_t scratch_buffer[(LOG_SIZE)/8] = {0};
 
+/*!
+ * \var log_index
+ *
+ * \brief Circular index of the records in the log. It holds the byte index in
+ *        the log of each record, in chronological order starting from the
+ *        position first_rec_slot of the log state, so that any record can be
+ *        accessed without walking the log from the first element
+ */
+static uint32_t log_index[LOG_MAX_RECORDS] = {0};
+
 /*!
  * \struct log_vars
  *
@@ -120,6 +227,8 @@ struct log_vars {
                                 zero after a reset, i.e. log is empty */
     uint32_t stored_size;  /*!< Indicates the total size of the items
                                 currently stored in the log */
+    uint32_t first_rec_slot; /*!< Position in log_index of the byte index
+                                  of the first element */
 };
 
 /*!
@@ -129,6 +238,42 @@ struct log_vars {
  */
 static struct log_vars log_state = {0};
 
+#ifdef AUDIT_RECORD_MAC
+/*!
+ * \def AUDIT_MAC_BATCH_SIZE
+ *
+ * \brief Number of records added before their MACs are computed
+ */
+#ifndef AUDIT_MAC_BATCH_SIZE
+#define AUDIT_MAC_BATCH_SIZE (8)
+#endif
+
+/*!
+ * \struct log_mac_vars
+ *
+ * \brief Contains the state variables of the chain of MACs of the log
+ *
+ * \details The MACs are computed in chronological order, so the records whose
+ *          MAC is pending are always the most recent records of the log.
+ */
+struct log_mac_vars {
+    uint32_t num_pending;          /*!< Number of records at the end of the
+                                        log whose MAC is not computed yet */
+    uint32_t pending_size;         /*!< Total size of the pending records */
+    uint8_t chain[LOG_MAC_SIZE];   /*!< MAC of the last record whose MAC is
+                                        computed */
+    uint8_t anchor[LOG_MAC_SIZE];  /*!< MAC of the record before the first
+                                        element of the log */
+};
+
+/*!
+ * \var mac_state
+ *
+ * \brief Current state variables for the chain of MACs
+ */
+static struct log_mac_vars mac_state = {0};
+#endif /* AUDIT_RECORD_MAC */
+
 /*!
  * \var global_timestamp
  *
@@ -198,6 +343,21 @@ uint32_t GET_NEXT_LOG_INDEX(const uint32_t idx)
                                    *GET_SIZE_FIELD_POINTER(idx)) ) % LOG_SIZE );
 }
 
+/*!
+ * \brief Static inline function to get the byte index in the log of a record
+ *
+ * \param[in] record_index Index of the record, 0 being the first element in
+ *                         chronological order
+ *
+ * \return Byte index of the record in the log
+ */
+__attribute__ ((always_inline)) __STATIC_INLINE
+uint32_t GET_RECORD_LOG_INDEX(const uint32_t record_index)
+{
+    return log_index[(log_state.first_rec_slot + record_index) %
+                     LOG_MAX_RECORDS];
+}
+
 /*!
  * \brief Static function to update the state variables of the log after the
  *        addition of a new log record of a given size
@@ -224,6 +384,10 @@ static void audit_update_state(const uint32_t first_el_idx,
     log_state.stored_size = stored_size;
 }
 
+#ifdef AUDIT_RECORD_MAC
+static void audit_read_mac(const uint32_t start_idx, uint8_t *mac);
+#endif
+
 /*!
  * \brief Static function to identify the begin and end position for a new write
  *        into the log. It will replace items based on "older entries first"
@@ -260,11 +424,18 @@ static void audit_replace_record(const uint32_t size,
             break;
         }
 
+#ifdef AUDIT_RECORD_MAC
+        /* The MAC of the oldest is needed to verify the next record */
+        audit_read_mac(first_el_idx, mac_state.anchor);
+#endif
+
         /* Remove the oldest */
         stored_size -= COMPUTE_LOG_ENTRY_SIZE(
                            *GET_SIZE_FIELD_POINTER(first_el_idx) );
         num_items--;
         first_el_idx = GET_NEXT_LOG_INDEX(first_el_idx);
+        log_state.first_rec_slot = (log_state.first_rec_slot + 1) %
+                                   LOG_MAX_RECORDS;
     }
 
     /* Get the start and stop positions */
@@ -297,7 +468,7 @@ static psa_status_t audit_buffer_copy(const uint8_t *src,
                                       uint8_t *dest)
 {
     uint32_t idx = 0;
-    uint32_t dest_idx = (uint32_t)dest - (uint32_t)&log_buffer[0];
+    uint32_t dest_idx = (uint32_t)((uintptr_t)dest - (uintptr_t)&log_buffer[0]);
 
     if ((dest_idx >= LOG_SIZE) || (size > LOG_SIZE)) {
         return PSA_ERROR_BUFFER_TOO_SMALL;
@@ -336,6 +507,83 @@ static psa_status_t audit_memcpy(const uint8_t *src,
     return PSA_SUCCESS;
 }
 
+/*!
+ * \brief Static function to copy an item out of the log buffer. It takes into
+ *        account circular wrapping on the log buffer size.
+ *
+ * \param[in]  start_idx Byte index in the log of the item to copy
+ * \param[in]  size      Size in bytes to be copied
+ * \param[out] dest      Pointer to the destination buffer
+ *
+ */
+static psa_status_t audit_buffer_read(const uint32_t start_idx,
+                                      const uint32_t size,
+                                      uint8_t *dest)
+{
+    uint32_t chunk_size;
+    psa_status_t status;
+
+    if ((start_idx >= LOG_SIZE) || (size > LOG_SIZE)) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    /* Copy up to the end of the log buffer, then the wrapped part if any */
+    chunk_size = LOG_SIZE - start_idx;
+    if (chunk_size > size) {
+        chunk_size = size;
+    }
+
+    status = audit_memcpy(&log_buffer[start_idx], chunk_size, dest);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    return audit_memcpy(&log_buffer[0], size - chunk_size, &dest[chunk_size]);
+}
+
+#ifdef AUDIT_RECORD_MAC
+/*!
+ * \brief Static function to read the MAC field of an item of the log
+ *
+ * \param[in]  start_idx Byte index in the log of the item
+ * \param[out] mac       Buffer of LOG_MAC_SIZE bytes to store the MAC
+ *
+ */
+static void audit_read_mac(const uint32_t start_idx, uint8_t *mac)
+{
+    uint32_t size = *GET_SIZE_FIELD_POINTER(start_idx);
+    uint32_t mac_idx = (start_idx + LOG_FIXED_FIELD_SIZE + size) % LOG_SIZE;
+
+    (void)audit_buffer_read(mac_idx, LOG_MAC_SIZE, mac);
+}
+
+/*!
+ * \brief Static function to compute the MAC of an item of the log
+ *
+ * \param[in]  start_idx Byte index in the log of the item
+ * \param[in]  prev_mac  MAC of the previous item
+ * \param[out] mac       Buffer of LOG_MAC_SIZE bytes to store the MAC
+ *
+ */
+static psa_status_t audit_compute_mac(const uint32_t start_idx,
+                                      const uint8_t *prev_mac,
+                                      uint8_t *mac)
+{
+    uint32_t len = LOG_FIXED_FIELD_SIZE + *GET_SIZE_FIELD_POINTER(start_idx);
+    uint32_t chunk_size = LOG_SIZE - start_idx;
+
+    /* The item can wrap around the end of the log buffer */
+    if (chunk_size > len) {
+        chunk_size = len;
+    }
+
+    return audit_mac_compute(prev_mac,
+                             &log_buffer[start_idx], chunk_size,
+                             &log_buffer[0], len - chunk_size,
+                             mac);
+}
+#endif /* AUDIT_RECORD_MAC */
+
 /*!
  * \brief Static function to format a log entry before the addition to the log
  *
@@ -381,8 +629,8 @@ static psa_status_t audit_format_buffer(const struct psa_audit_record *record,
         return status;
     }
 
-    /* FIXME: The MAC here is just a dummy value for prototyping. It will be
-     *        filled by a call to the crypto interface directly when available.
+    /* The MAC here is just a dummy value. When AUDIT_RECORD_MAC is set, it is
+     * replaced with the MAC of the record when the pending MACs are computed.
      */
     tlr = (struct log_tlr *) ((uint8_t *)hdr + LOG_FIXED_FIELD_SIZE + size);
     for (idx=0; idx<LOG_MAC_SIZE; idx++) {
@@ -392,11 +640,83 @@ static psa_status_t audit_format_buffer(const struct psa_audit_record *record,
     return PSA_SUCCESS;
 }
 
+#if (AUDIT_UART_REDIRECTION == 1U) && (AUDIT_UART_ASYNC == 1U)
+/*!
+ * \brief Static function to start sending the characters staged in the
+ *        transmit ring, up to the end of the ring
+ *
+ * \note Must only be called when no transfer is in progress
+ *
+ */
+static void audit_uart_tx_start(void)
+{
+    uint32_t tail = uart_tx_state.tail;
+    uint32_t pos = tail & (AUDIT_UART_TX_RING_SIZE - 1);
+    uint32_t num = uart_tx_state.head - tail;
+
+    if (num == 0) {
+        uart_tx_state.in_flight = 0;
+        return;
+    }
+
+    /* Send a contiguous chunk, the rest is sent on completion */
+    if (num > (AUDIT_UART_TX_RING_SIZE - pos)) {
+        num = AUDIT_UART_TX_RING_SIZE - pos;
+    }
+
+    uart_tx_state.in_flight = num;
+    if (LOG_UART_NAME.Send(&uart_tx_ring[pos], num) != ARM_DRIVER_OK) {
+        /* Keep the characters in the ring, the transfer is started again
+         * when the next entry is staged
+         */
+        uart_tx_state.in_flight = 0;
+    }
+}
+
+/*!
+ * \brief Static function called by the UART driver to signal events
+ *
+ * \param[in] event Events signalled, as ARM_USART_EVENT_* flags
+ *
+ */
+static void audit_uart_event(uint32_t event)
+{
+    if ((event & ARM_USART_EVENT_SEND_COMPLETE) == 0) {
+        return;
+    }
+
+    if (uart_tx_state.in_flight == 0) {
+        return;
+    }
+
+    /* Release the characters sent and chain the next transfer */
+    uart_tx_state.tail += uart_tx_state.in_flight;
+    audit_uart_tx_start();
+}
+
+/*!
+ * \brief Static function to stage a character in the transmit ring
+ *
+ * \param[in] pos Free running index where to stage the character
+ * \param[in] c   Character to stage
+ *
+ * \return Index of the next character
+ */
+static uint32_t audit_uart_tx_put(const uint32_t pos, const uint8_t c)
+{
+    uart_tx_ring[pos & (AUDIT_UART_TX_RING_SIZE - 1)] = c;
+
+    return pos + 1;
+}
+#endif
+
 /*!
  * \brief Static function to stream an entry of the log to a (secure) UART
  *
  * \details The entry of the log is streamed as a stream of hex values,
- *          not parsed nor interpreted.
+ *          not parsed nor interpreted. When AUDIT_UART_ASYNC is set, the
+ *          entry is only staged in the transmit ring and the function returns
+ *          without waiting for the UART.
  *
  * \param[in] start_idx Byte index in the log from where to start streaming
  *            to UART
@@ -404,7 +724,63 @@ static psa_status_t audit_format_buffer(const struct psa_audit_record *record,
  */
 static void audit_uart_redirection(const uint32_t start_idx)
 {
-#if (AUDIT_UART_REDIRECTION == 1U)
+#if (AUDIT_UART_REDIRECTION == 1U) && (AUDIT_UART_ASYNC == 1U)
+    uint32_t entry_size;
+    uint32_t head, needed, idx;
+    uint32_t dropped;
+    uint8_t read_byte;
+
+    if (log_uart_init_success != 1U) {
+        return;
+    }
+
+    entry_size = COMPUTE_LOG_ENTRY_SIZE(*GET_SIZE_FIELD_POINTER(start_idx));
+    dropped = uart_tx_state.dropped;
+
+    /* Each byte is sent as two hex digits and a space, then end of line */
+    needed = (3 * entry_size) + 2;
+    if (dropped != uart_tx_state.reported) {
+        needed += AUDIT_UART_DROP_MSG_SIZE;
+    }
+
+    head = uart_tx_state.head;
+    if (needed > (AUDIT_UART_TX_RING_SIZE - (head - uart_tx_state.tail))) {
+        /* Not enough space, drop the whole entry */
+        uart_tx_state.dropped = dropped + 1;
+        return;
+    }
+
+    /* Report the entries dropped since the last report first */
+    if (dropped != uart_tx_state.reported) {
+        for (idx = 0; idx < 8; idx++) {
+            head = audit_uart_tx_put(head, "DROPPED "[idx]);
+        }
+        for (idx = 0; idx < 8; idx++) {
+            head = audit_uart_tx_put(head,
+                                 hex_values[(dropped >> (28 - 4*idx)) & 0xF]);
+        }
+        head = audit_uart_tx_put(head, '\r');
+        head = audit_uart_tx_put(head, '\n');
+        uart_tx_state.reported = dropped;
+    }
+
+    for (idx = 0; idx < entry_size; idx++) {
+        read_byte = log_buffer[(start_idx+idx) % LOG_SIZE];
+        head = audit_uart_tx_put(head, hex_values[(read_byte >> 4) & 0xF]);
+        head = audit_uart_tx_put(head, hex_values[read_byte & 0xF]);
+        head = audit_uart_tx_put(head, ' ');
+    }
+    head = audit_uart_tx_put(head, '\r');
+    head = audit_uart_tx_put(head, '\n');
+
+    /* Publish the entry, then start the UART if it is idle. If a transfer is
+     * in progress, its completion sends the entry.
+     */
+    uart_tx_state.head = head;
+    if (uart_tx_state.in_flight == 0) {
+        audit_uart_tx_start();
+    }
+#elif (AUDIT_UART_REDIRECTION == 1U)
     uint32_t size = *GET_SIZE_FIELD_POINTER(start_idx);
     uint8_t end_of_line[] = {'\r', '\n'};
     uint32_t idx = 0;
@@ -436,19 +812,14 @@ static psa_status_t _audit_core_get_info(uint32_t *num_records, uint32_t *size)
 static psa_status_t _audit_core_get_record_info(const uint32_t record_index,
                                                 uint32_t *size)
 {
-    uint32_t start_idx, idx;
+    uint32_t start_idx;
 
     if (record_index >= log_state.num_records) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    /* First element to read from the log */
-    start_idx = log_state.first_el_idx;
-
-    /* Move the start_idx index to the desired element */
-    for (idx = 0; idx < record_index; idx++) {
-        start_idx = GET_NEXT_LOG_INDEX(start_idx);
-    }
+    /* Element to read from the log */
+    start_idx = GET_RECORD_LOG_INDEX(record_index);
 
     /* Get the size of the requested record */
     *size = COMPUTE_LOG_ENTRY_SIZE(*GET_SIZE_FIELD_POINTER(start_idx));
@@ -456,6 +827,284 @@ static psa_status_t _audit_core_get_record_info(const uint32_t record_index,
     return PSA_SUCCESS;
 }
 
+/*!
+ * \brief Static function to read consecutive records of the persistent copy
+ *        of the log, selected by an index with \ref PSA_AUDIT_STORED_RECORD
+ *
+ * \param[in]  first_index    Index of the first record, with the flag set
+ * \param[in]  num_records    Maximum number of records to read
+ * \param[out] buffer         Buffer to copy the records to
+ * \param[in]  buffer_size    Size of the buffer in bytes
+ * \param[out] num_retrieved  Number of records read
+ * \param[out] retrieved_size Size of the records read in bytes
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ */
+static psa_status_t audit_retrieve_stored(const uint32_t first_index,
+                                          const uint32_t num_records,
+                                          uint8_t *buffer,
+                                          const uint32_t buffer_size,
+                                          uint32_t *num_retrieved,
+                                          uint32_t *retrieved_size)
+{
+#ifdef AUDIT_PERSISTENT_LOG
+    psa_status_t status;
+
+    status = audit_flash_log_read_records(first_index &
+                                          ~PSA_AUDIT_STORED_RECORD,
+                                          num_records, buffer, buffer_size,
+                                          num_retrieved, retrieved_size);
+
+    /* Same error as for an index past the records in RAM */
+    if (status == PSA_ERROR_INVALID_ARGUMENT) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    return status;
+#else
+    (void)first_index;
+    (void)num_records;
+    (void)buffer;
+    (void)buffer_size;
+    (void)num_retrieved;
+    (void)retrieved_size;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+/*!
+ * \brief Static function to add the log item formatted in the scratch buffer
+ *        to the log, replacing older items if needed
+ *
+ * \param[in]  size        Value of the size field of the log item
+ * \param[out] last_el_idx Index in the log of the added item
+ *
+ */
+static psa_status_t audit_store_record(const uint32_t size,
+                                       uint32_t *last_el_idx)
+{
+    uint32_t start_pos = 0, stop_pos = 0;
+    uint32_t first_el_idx = 0;
+    uint32_t num_items = 0, stored_size = 0;
+    psa_status_t status;
+
+    /* Get the size in bytes and num of elements present in the log */
+    status = _audit_core_get_info(&num_items, &stored_size);
+    if (status !=  PSA_SUCCESS) {
+        return status;
+    }
+
+    if (num_items == 0) {
+
+        start_pos = 0;
+
+    } else {
+
+        /* The log is not empty, need to decide the candidate position
+         * and invalidate older entries in case there is not enough space
+         */
+        audit_replace_record(COMPUTE_LOG_ENTRY_SIZE(size),
+                             &start_pos,
+                             &stop_pos);
+    }
+
+    /* Do the copy of the log item to be added in the log */
+    status = audit_buffer_copy((const uint8_t *) &scratch_buffer[0],
+                               COMPUTE_LOG_ENTRY_SIZE(size),
+                               (uint8_t *) &log_buffer[start_pos]);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Retrieve current log state */
+    first_el_idx = log_state.first_el_idx;
+    num_items = log_state.num_records;
+    stored_size = log_state.stored_size;
+
+    /* The last element is the one we just added */
+    *last_el_idx = start_pos;
+
+    /* Update the number of items and stored size */
+    num_items++;
+    stored_size += COMPUTE_LOG_ENTRY_SIZE(size);
+
+    /* Update the log state */
+    audit_update_state(first_el_idx, *last_el_idx, stored_size, num_items);
+
+    /* Add the new element at the end of the index */
+    log_index[(log_state.first_rec_slot + num_items - 1) % LOG_MAX_RECORDS] =
+                                                                   start_pos;
+
+    return PSA_SUCCESS;
+}
+
+#ifdef AUDIT_RECORD_MAC
+/*!
+ * \brief Static function to export an item of the log once its MAC is
+ *        computed, to the persistent log and to the UART
+ *
+ * \param[in] start_idx Byte index in the log of the item
+ *
+ */
+static psa_status_t audit_export_record(const uint32_t start_idx)
+{
+#ifdef AUDIT_PERSISTENT_LOG
+    uint32_t size = COMPUTE_LOG_ENTRY_SIZE(*GET_SIZE_FIELD_POINTER(start_idx));
+    psa_status_t status;
+
+    status = audit_buffer_read(start_idx, size, (uint8_t *)&scratch_buffer[0]);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = audit_flash_log_append((const uint8_t *) &scratch_buffer[0], size);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif
+
+    /* Stream to a secure UART if available for the platform and built */
+    audit_uart_redirection(start_idx);
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Static function to compute the MACs of the pending items of the log,
+ *        in chronological order
+ *
+ * \note Uses the scratch buffer when the persistent log is enabled
+ *
+ */
+static psa_status_t audit_mac_pending(void)
+{
+    uint32_t start_idx;
+    psa_status_t status;
+
+    while (mac_state.num_pending > 0) {
+        start_idx = GET_RECORD_LOG_INDEX(log_state.num_records -
+                                         mac_state.num_pending);
+
+        status = audit_compute_mac(start_idx, mac_state.chain,
+                                   mac_state.chain);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        /* Write the MAC in the trailer of the item */
+        status = audit_buffer_copy(mac_state.chain, LOG_MAC_SIZE,
+                       &log_buffer[(start_idx + LOG_FIXED_FIELD_SIZE +
+                                    *GET_SIZE_FIELD_POINTER(start_idx)) %
+                                   LOG_SIZE]);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        mac_state.pending_size -= COMPUTE_LOG_ENTRY_SIZE(
+                                           *GET_SIZE_FIELD_POINTER(start_idx));
+        mac_state.num_pending--;
+
+        status = audit_export_record(start_idx);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Static function to remove the newest item of the log while its MAC
+ *        is still pending
+ *
+ * \note The items removed from the log to make space for it are not restored
+ *
+ */
+static void audit_remove_pending_record(void)
+{
+    uint32_t size = COMPUTE_LOG_ENTRY_SIZE(
+                        *GET_SIZE_FIELD_POINTER(log_state.last_el_idx));
+
+    mac_state.num_pending--;
+    mac_state.pending_size -= size;
+
+    if (log_state.num_records == 1) {
+        audit_update_state(0,0,0,0);
+        return;
+    }
+
+    log_state.num_records--;
+    log_state.stored_size -= size;
+    log_state.last_el_idx = GET_RECORD_LOG_INDEX(log_state.num_records - 1);
+}
+#endif /* AUDIT_RECORD_MAC */
+
+#ifdef AUDIT_PERSISTENT_LOG
+/*!
+ * \brief Static function to load the most recent records of the persistent
+ *        log in the RAM log after a reset
+ *
+ */
+static psa_status_t audit_restore_records(void)
+{
+    /* At most this many records can be in the RAM log at the same time */
+    const uint32_t max_records = LOG_MAX_RECORDS;
+    const struct log_hdr *hdr = (const struct log_hdr *)&scratch_buffer[0];
+    uint32_t num_records, idx, size, last_el_idx;
+    psa_status_t status;
+
+    num_records = audit_flash_log_num_records();
+    idx = (num_records > max_records) ? (num_records - max_records) : 0;
+
+#ifdef AUDIT_RECORD_MAC
+    /* The MAC of the record before the first restored record is needed to
+     * verify the first restored record
+     */
+    if (idx > 0) {
+        status = audit_flash_log_read(idx - 1, (uint8_t *)&scratch_buffer[0],
+                                      sizeof(scratch_buffer), &size);
+        if ((status != PSA_SUCCESS) || (size < LOG_MAC_SIZE)) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+
+        (void)audit_memcpy((const uint8_t *)&scratch_buffer[0] +
+                           size - LOG_MAC_SIZE,
+                           LOG_MAC_SIZE, mac_state.anchor);
+    }
+#endif
+
+    for (; idx < num_records; idx++) {
+        status = audit_flash_log_read(idx, (uint8_t *)&scratch_buffer[0],
+                                      sizeof(scratch_buffer), &size);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        if (size != COMPUTE_LOG_ENTRY_SIZE(hdr->size)) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+
+        status = audit_store_record(hdr->size, &last_el_idx);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        /* Carry on with the timestamps of the restored records */
+        global_timestamp = hdr->timestamp + 1;
+    }
+
+#ifdef AUDIT_RECORD_MAC
+    /* New records are chained to the last restored record */
+    if (log_state.num_records > 0) {
+        audit_read_mac(log_state.last_el_idx, mac_state.chain);
+    }
+#endif
+
+    return PSA_SUCCESS;
+}
+#endif /* AUDIT_PERSISTENT_LOG */
+
 /*!
  * \defgroup public Public functions
  *
@@ -467,7 +1116,11 @@ psa_status_t audit_core_init(void)
 #if (AUDIT_UART_REDIRECTION == 1U)
     int32_t ret = ARM_DRIVER_OK;
 
+#if (AUDIT_UART_ASYNC == 1U)
+    ret = LOG_UART_NAME.Initialize(audit_uart_event);
+#else
     ret = LOG_UART_NAME.Initialize(NULL);
+#endif
     if (ret != ARM_DRIVER_OK) {
         return PSA_ERROR_GENERIC_ERROR;
     }
@@ -485,6 +1138,17 @@ psa_status_t audit_core_init(void)
     /* Clear the log state variables */
     audit_update_state(0,0,0,0);
 
+#ifdef AUDIT_PERSISTENT_LOG
+    if (audit_flash_log_init() != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    /* Fill the log with the records which were stored before the reset */
+    if (audit_restore_records() != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+#endif
+
     return PSA_SUCCESS;
 }
 
@@ -494,6 +1158,9 @@ psa_status_t audit_core_delete_record(psa_invec in_vec[],
                                       size_t out_len)
 {
     uint32_t first_el_idx, size_removed;
+#ifdef AUDIT_RECORD_MAC
+    psa_status_t status;
+#endif
 
     if ((in_len != 2) || (out_len != 0)) {
         return PSA_ERROR_CONNECTION_REFUSED;
@@ -528,6 +1195,18 @@ psa_status_t audit_core_delete_record(psa_invec in_vec[],
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+#ifdef AUDIT_RECORD_MAC
+    /* The MAC of the removed record is needed to verify the next record */
+    if (mac_state.num_pending == log_state.num_records) {
+        status = audit_mac_pending();
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    audit_read_mac(log_state.first_el_idx, mac_state.anchor);
+#endif
+
     /* If the log contains just one element, reset the state and return */
     if (log_state.num_records == 1) {
 
@@ -553,6 +1232,8 @@ psa_status_t audit_core_delete_record(psa_invec in_vec[],
     log_state.first_el_idx = first_el_idx;
     log_state.num_records--;
     log_state.stored_size -= size_removed;
+    log_state.first_rec_slot = (log_state.first_rec_slot + 1) %
+                               LOG_MAX_RECORDS;
 
     return PSA_SUCCESS;
 }
@@ -588,7 +1269,7 @@ psa_status_t audit_core_get_record_info(psa_invec in_vec[],
                                         psa_outvec out_vec[],
                                         size_t out_len)
 {
-    uint32_t start_idx, idx;
+    uint32_t start_idx;
 
     if ((in_len != 1) || (out_len != 1)) {
         return PSA_ERROR_CONNECTION_REFUSED;
@@ -602,17 +1283,25 @@ psa_status_t audit_core_get_record_info(psa_invec in_vec[],
     const uint32_t record_index = *((uint32_t *)in_vec[0].base);
     uint32_t *size = out_vec[0].base;
 
+    if (record_index & PSA_AUDIT_STORED_RECORD) {
+#ifdef AUDIT_PERSISTENT_LOG
+        if (audit_flash_log_get_record_size(record_index &
+                                            ~PSA_AUDIT_STORED_RECORD,
+                                            size) != PSA_SUCCESS) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+        return PSA_SUCCESS;
+#else
+        return PSA_ERROR_NOT_SUPPORTED;
+#endif
+    }
+
     if (record_index >= log_state.num_records) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    /* First element to read from the log */
-    start_idx = log_state.first_el_idx;
-
-    /* Move the start_idx index to the desired element */
-    for (idx = 0; idx < record_index; idx++) {
-        start_idx = GET_NEXT_LOG_INDEX(start_idx);
-    }
+    /* Element to read from the log */
+    start_idx = GET_RECORD_LOG_INDEX(record_index);
 
     /* Get the size of the requested record */
     *size = COMPUTE_LOG_ENTRY_SIZE(*GET_SIZE_FIELD_POINTER(start_idx));
@@ -625,9 +1314,7 @@ psa_status_t audit_core_add_record(psa_invec in_vec[],
                                    psa_outvec out_vec[],
                                    size_t out_len)
 {
-    uint32_t start_pos = 0, stop_pos = 0;
-    uint32_t first_el_idx = 0, last_el_idx = 0, size = 0;
-    uint32_t num_items = 0, stored_size = 0;
+    uint32_t last_el_idx = 0, size = 0;
     int32_t partition_id;
     psa_status_t status;
 
@@ -659,6 +1346,13 @@ psa_status_t audit_core_add_record(psa_invec in_vec[],
         return PSA_ERROR_NOT_SUPPORTED;
     }
 
+    /* Check that the record holds at least the record ID, which bounds the
+     * number of records in the log to LOG_MAX_RECORDS
+     */
+    if (size < LOG_MIN_SIZE) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
     /* Check that the entry to be added is not greater than the
      * maximum space available
      */
@@ -666,25 +1360,17 @@ psa_status_t audit_core_add_record(psa_invec in_vec[],
         return PSA_ERROR_INSUFFICIENT_MEMORY;
     }
 
-    /* Get the size in bytes and num of elements present in the log */
-    status = _audit_core_get_info(&num_items, &stored_size);
-    if (status !=  PSA_SUCCESS) {
-        return status;
-    }
-
-    if (num_items == 0) {
-
-        start_pos = 0;
-
-    } else {
-
-        /* The log is not empty, need to decide the candidate position
-         * and invalidate older entries in case there is not enough space
-         */
-        audit_replace_record(COMPUTE_LOG_ENTRY_SIZE(size),
-                             &start_pos,
-                             &stop_pos);
+#ifdef AUDIT_RECORD_MAC
+    /* The pending records must not be removed from the log before their MAC
+     * is computed, as the MAC of the next records depend on them
+     */
+    if (COMPUTE_LOG_ENTRY_SIZE(size) > (LOG_SIZE - mac_state.pending_size)) {
+        status = audit_mac_pending();
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
     }
+#endif
 
     /* Format the scratch buffer with the complete log item */
     status = audit_format_buffer(record, partition_id, &scratch_buffer[0]);
@@ -692,37 +1378,49 @@ psa_status_t audit_core_add_record(psa_invec in_vec[],
         return status;
     }
 
-    /* TODO: At this point, encryption should be called if supported */
-
-    /* Do the copy of the log item to be added in the log */
-    status = audit_buffer_copy((const uint8_t *) &scratch_buffer[0],
-                               COMPUTE_LOG_ENTRY_SIZE(size),
-                               (uint8_t *) &log_buffer[start_pos]);
+#if defined(AUDIT_PERSISTENT_LOG) && !defined(AUDIT_RECORD_MAC)
+    /* Append the log item to the persistent copy of the log first, so that a
+     * record is never visible in the log without being stored
+     */
+    status = audit_flash_log_append((const uint8_t *) &scratch_buffer[0],
+                                    COMPUTE_LOG_ENTRY_SIZE(size));
     if (status != PSA_SUCCESS) {
         return status;
     }
+#endif
 
-    /* Retrieve current log state */
-    first_el_idx = log_state.first_el_idx;
-    num_items = log_state.num_records;
-    stored_size = log_state.stored_size;
-
-    /* The last element is the one we just added */
-    last_el_idx = start_pos;
+    status = audit_store_record(size, &last_el_idx);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
 
-    /* Update the number of items and stored size */
-    num_items++;
-    stored_size += COMPUTE_LOG_ENTRY_SIZE(size);
+#ifdef AUDIT_RECORD_MAC
+    /* Defer the MAC computation, the MACs are computed in batches. The record
+     * is exported once its MAC is computed
+     */
+    mac_state.num_pending++;
+    mac_state.pending_size += COMPUTE_LOG_ENTRY_SIZE(size);
 
-    /* Update the log state */
-    audit_update_state(first_el_idx, last_el_idx, stored_size, num_items);
+#ifndef AUDIT_FLASH_FLUSH_EACH_RECORD
+    if (mac_state.num_pending < AUDIT_MAC_BATCH_SIZE) {
+        return PSA_SUCCESS;
+    }
+#endif
 
-    /* TODO: At this point, we would need to update the stored copy in
-     *       persistent storage. Need to define a strategy for this
+    /* The MACs are computed in chronological order, so the new record is
+     * still pending if the batch stopped on an error. It is then removed from
+     * the log, as the caller is told that it is not added
      */
+    status = audit_mac_pending();
+    if ((status != PSA_SUCCESS) && (mac_state.num_pending > 0)) {
+        audit_remove_pending_record();
+    }
 
+    return status;
+#else
     /* Stream to a secure UART if available for the platform and built */
     audit_uart_redirection(last_el_idx);
+#endif
 
     return PSA_SUCCESS;
 }
@@ -732,7 +1430,7 @@ psa_status_t audit_core_retrieve_record(psa_invec in_vec[],
                                         psa_outvec out_vec[],
                                         size_t out_len)
 {
-    uint32_t idx, start_idx, record_size_tmp;
+    uint32_t start_idx, record_size_tmp, num_read;
     psa_status_t status;
 
     if ((in_len != 2) || (out_len != 1)) {
@@ -757,6 +1455,22 @@ psa_status_t audit_core_retrieve_record(psa_invec in_vec[],
         return PSA_ERROR_NOT_SUPPORTED;
     }
 
+#ifdef AUDIT_RECORD_MAC
+    /* Records are only returned with their MAC */
+    status = audit_mac_pending();
+    if (status != PSA_SUCCESS) {
+        out_vec[0].len = 0;
+        return status;
+    }
+#endif
+
+    if (record_index & PSA_AUDIT_STORED_RECORD) {
+        status = audit_retrieve_stored(record_index, 1, buffer, buffer_size,
+                                       &num_read, &record_size_tmp);
+        out_vec[0].len = (status == PSA_SUCCESS) ? record_size_tmp : 0;
+        return status;
+    }
+
     /* Get the size of the record we want to retrieve */
     status = _audit_core_get_record_info(record_index, &record_size_tmp);
 
@@ -772,17 +1486,14 @@ psa_status_t audit_core_retrieve_record(psa_invec in_vec[],
         return PSA_ERROR_BUFFER_TOO_SMALL;
     }
 
-    /* First element to read from the log */
-    start_idx = log_state.first_el_idx;
-
-    /* Move the start_idx index to the desired element */
-    for (idx=0; idx<record_index; idx++) {
-        start_idx = GET_NEXT_LOG_INDEX(start_idx);
-    }
+    /* Element to read from the log */
+    start_idx = GET_RECORD_LOG_INDEX(record_index);
 
     /* Do the copy */
-    for (idx=0; idx<record_size_tmp; idx++) {
-        buffer[idx] = log_buffer[(start_idx + idx) % LOG_SIZE];
+    status = audit_buffer_read(start_idx, record_size_tmp, buffer);
+    if (status != PSA_SUCCESS) {
+        out_vec[0].len = 0;
+        return status;
     }
 
     /* Update the retrieved size */
@@ -790,4 +1501,205 @@ psa_status_t audit_core_retrieve_record(psa_invec in_vec[],
 
     return PSA_SUCCESS;
 }
+
+psa_status_t audit_core_retrieve_records(psa_invec in_vec[],
+                                         size_t in_len,
+                                         psa_outvec out_vec[],
+                                         size_t out_len)
+{
+    uint32_t start_idx, record_size_tmp;
+    uint32_t retrieved = 0, retrieved_size = 0;
+    psa_status_t status;
+
+    if ((in_len != 2) || (out_len != 2)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(uint32_t)) ||
+        (in_vec[1].len != sizeof(uint32_t)) ||
+        (out_vec[1].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    const uint32_t first_index = *((uint32_t *)in_vec[0].base);
+    const uint32_t num_records = *((uint32_t *)in_vec[1].base);
+    uint8_t *buffer = out_vec[0].base;
+    const uint32_t buffer_size = out_vec[0].len;
+    uint32_t *num_retrieved = out_vec[1].base;
+
+    *num_retrieved = 0;
+    out_vec[0].len = 0;
+
+    if ((num_records == 0) ||
+        (!(first_index & PSA_AUDIT_STORED_RECORD) &&
+         (first_index >= log_state.num_records))) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+#ifdef AUDIT_RECORD_MAC
+    /* Records are only returned with their MAC */
+    status = audit_mac_pending();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif
+
+    if (first_index & PSA_AUDIT_STORED_RECORD) {
+        status = audit_retrieve_stored(first_index, num_records, buffer,
+                                       buffer_size, &retrieved,
+                                       &retrieved_size);
+        if (status == PSA_SUCCESS) {
+            *num_retrieved = retrieved;
+            out_vec[0].len = retrieved_size;
+        }
+        return status;
+    }
+
+    /* Copy as many whole records as the buffer can hold */
+    while ((retrieved < num_records) &&
+           ((first_index + retrieved) < log_state.num_records)) {
+
+        start_idx = GET_RECORD_LOG_INDEX(first_index + retrieved);
+        record_size_tmp = COMPUTE_LOG_ENTRY_SIZE(
+                                           *GET_SIZE_FIELD_POINTER(start_idx));
+
+        if ((buffer_size - retrieved_size) < record_size_tmp) {
+            break;
+        }
+
+        status = audit_buffer_read(start_idx, record_size_tmp,
+                                   &buffer[retrieved_size]);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        retrieved_size += record_size_tmp;
+        retrieved++;
+    }
+
+    /* buffer_size must be enough to hold at least the first record */
+    if (retrieved == 0) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    /* Update the number of records and the size retrieved */
+    *num_retrieved = retrieved;
+    out_vec[0].len = retrieved_size;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t audit_core_verify_records(psa_invec in_vec[],
+                                       size_t in_len,
+                                       psa_outvec out_vec[],
+                                       size_t out_len)
+{
+#ifdef AUDIT_RECORD_MAC
+    uint8_t prev_mac[LOG_MAC_SIZE], mac[LOG_MAC_SIZE], stored_mac[LOG_MAC_SIZE];
+    uint32_t idx, start_idx;
+    uint8_t diff, i;
+    psa_status_t status;
+
+    if ((in_len != 2) || (out_len != 0)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    if ((in_vec[0].len != sizeof(uint32_t)) ||
+        (in_vec[1].len != sizeof(uint32_t))) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    const uint32_t first_index = *((uint32_t *)in_vec[0].base);
+    const uint32_t num_records = *((uint32_t *)in_vec[1].base);
+
+    if ((num_records == 0) || (first_index >= log_state.num_records) ||
+        (num_records > (log_state.num_records - first_index))) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    status = audit_mac_pending();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Get the MAC the first record is chained to */
+    if (first_index == 0) {
+        (void)audit_memcpy(mac_state.anchor, LOG_MAC_SIZE, prev_mac);
+    } else {
+        audit_read_mac(GET_RECORD_LOG_INDEX(first_index - 1), prev_mac);
+    }
+
+    for (idx = first_index; idx < (first_index + num_records); idx++) {
+        start_idx = GET_RECORD_LOG_INDEX(idx);
+
+        status = audit_compute_mac(start_idx, prev_mac, mac);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        audit_read_mac(start_idx, stored_mac);
+
+        /* Compare without an early exit */
+        diff = 0;
+        for (i = 0; i < LOG_MAC_SIZE; i++) {
+            diff |= mac[i] ^ stored_mac[i];
+        }
+        if (diff != 0) {
+            return PSA_ERROR_INVALID_SIGNATURE;
+        }
+
+        (void)audit_memcpy(stored_mac, LOG_MAC_SIZE, prev_mac);
+    }
+
+    return PSA_SUCCESS;
+#else
+    (void)in_vec;
+    (void)in_len;
+    (void)out_vec;
+    (void)out_len;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+psa_status_t audit_core_flush(psa_invec in_vec[],
+                              size_t in_len,
+                              psa_outvec out_vec[],
+                              size_t out_len)
+{
+    int32_t partition_id;
+#ifdef AUDIT_RECORD_MAC
+    psa_status_t status;
+#endif
+
+    (void)in_vec;
+    (void)out_vec;
+
+    if ((in_len != 0) || (out_len != 0)) {
+        return PSA_ERROR_CONNECTION_REFUSED;
+    }
+
+    /* Only the secure callers, which add the records, can flush the log */
+    if (tfm_core_get_caller_client_id(&partition_id) != (int32_t)TFM_SUCCESS) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    if (TFM_CLIENT_ID_IS_NS(partition_id)) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+#ifdef AUDIT_RECORD_MAC
+    /* The records are only exported once their MAC is computed */
+    status = audit_mac_pending();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif
+
+#ifdef AUDIT_PERSISTENT_LOG
+    return audit_flash_log_flush();
+#else
+    return PSA_SUCCESS;
+#endif
+}
 /*!@}*/
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  * Copyright (c) 2020, Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -44,7 +44,8 @@ extern "C" {
  * SIZE: at least LOG_MIN_SIZE bytes, known only at runtime. It's the size of
  *       the (RECORD_ID, PAYLOAD) fields
  *
- * MAC_SIZE: known at build time (currently, 4 bytes)
+ * MAC_SIZE: known at build time, AUDIT_MAC_SIZE bytes (16 by default) when
+ *           AUDIT_RECORD_MAC is enabled, 4 bytes otherwise
  *
  * At runtime, when adding a record, the value of SIZE has to be checked and
  * must be less than LOG_SIZE - MAC_SIZE - 12 and equal or greater than
@@ -84,12 +85,35 @@ struct audit_tlv_entry {
     uint8_t value[];
 };
 
+#ifdef AUDIT_RECORD_MAC
+/*!
+ * \def AUDIT_MAC_SIZE
+ *
+ * \brief Size in bytes of the HMAC-SHA256 of each entry, after truncation. It
+ *        must be at least 16 bytes for the MAC to be hard to forge, at most
+ *        the 32 bytes of the full HMAC, and a multiple of 4 bytes to keep the
+ *        entries aligned in the log.
+ */
+#ifndef AUDIT_MAC_SIZE
+#define AUDIT_MAC_SIZE (16)
+#endif
+
+#if (AUDIT_MAC_SIZE < 16) || (AUDIT_MAC_SIZE > 32) || (AUDIT_MAC_SIZE % 4)
+#error "AUDIT_MAC_SIZE must be a multiple of 4 between 16 and 32"
+#endif
+#endif /* AUDIT_RECORD_MAC */
+
 /*!
  * \def LOG_MAC_SIZE
  *
- * \brief Size in bytes of the MAC for each entry
+ * \brief Size in bytes of the MAC for each entry. Without AUDIT_RECORD_MAC the
+ *        field is kept, and holds a dummy value.
  */
+#ifdef AUDIT_RECORD_MAC
+#define LOG_MAC_SIZE (AUDIT_MAC_SIZE)
+#else
 #define LOG_MAC_SIZE (4)
+#endif
 
 /*!
  * \struct log_hdr
@@ -142,6 +166,9 @@ psa_status_t audit_core_init(void);
     X(audit_core_get_record_info)            \
     X(audit_core_add_record)                 \
     X(audit_core_retrieve_record)            \
+    X(audit_core_retrieve_records)           \
+    X(audit_core_verify_records)             \
+    X(audit_core_flush)                      \
 
 #define X(api_name) UNIFORM_SIGNATURE_API(api_name);
 LIST_TFM_AUDIT_UNIFORM_SIGNATURE_API
@@ -0,0 +1,850 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "audit_flash_log.h"
+#include "flash_layout.h"
+#include "tfm_memory_utils.h"
+
+#ifndef AUDIT_FLASH_LOG_RAM_FS
+#include "Driver_Flash.h"
+
+#ifndef AUDIT_FLASH_DEV_NAME
+#error "AUDIT_FLASH_DEV_NAME must be defined by the target in flash_layout.h"
+#endif
+
+#ifndef AUDIT_FLASH_AREA_ADDR
+#error "AUDIT_FLASH_AREA_ADDR must be defined by the target in flash_layout.h"
+#endif
+#endif /* !AUDIT_FLASH_LOG_RAM_FS */
+
+/* The flash area used when it is emulated in RAM */
+#ifndef AUDIT_FLASH_AREA_SIZE
+#define AUDIT_FLASH_AREA_SIZE (0x4000)
+#endif
+
+#ifndef AUDIT_SECTOR_SIZE
+#define AUDIT_SECTOR_SIZE (0x1000)
+#endif
+
+#ifndef AUDIT_SECTORS_PER_SEGMENT
+#define AUDIT_SECTORS_PER_SEGMENT (0x1)
+#endif
+
+#ifndef AUDIT_FLASH_PROGRAM_UNIT
+#define AUDIT_FLASH_PROGRAM_UNIT (0x1)
+#elif (AUDIT_FLASH_PROGRAM_UNIT & (AUDIT_FLASH_PROGRAM_UNIT - 1)) != 0
+#error "AUDIT_FLASH_PROGRAM_UNIT must be a power of two"
+#endif
+
+/*!
+ * \def AUDIT_FLASH_BUF_SIZE
+ *
+ * \brief Size of the RAM buffer which collects the records before they are
+ *        written to flash. Records larger than the buffer are written
+ *        through it in several chunks.
+ */
+#ifndef AUDIT_FLASH_BUF_SIZE
+#define AUDIT_FLASH_BUF_SIZE (256)
+#endif
+
+#if (AUDIT_FLASH_BUF_SIZE % AUDIT_FLASH_PROGRAM_UNIT) != 0
+#error "AUDIT_FLASH_BUF_SIZE must be a multiple of AUDIT_FLASH_PROGRAM_UNIT"
+#endif
+
+#define AUDIT_FLASH_SEGMENT_SIZE (AUDIT_SECTOR_SIZE * AUDIT_SECTORS_PER_SEGMENT)
+#define AUDIT_FLASH_NUM_SEGMENTS (AUDIT_FLASH_AREA_SIZE / \
+                                  AUDIT_FLASH_SEGMENT_SIZE)
+
+#if (AUDIT_FLASH_NUM_SEGMENTS < 2)
+#error "The audit flash area must hold at least two segments"
+#endif
+
+/* Value of each byte in the flash when erased */
+#define AUDIT_FLASH_ERASE_VAL (0xFFU)
+#define AUDIT_FLASH_ERASED_WORD (0xFFFFFFFFU)
+
+/* Identifies a segment which has been opened by the flash log */
+#define AUDIT_SEGMENT_MAGIC (0x41554454U)
+
+#define AUDIT_ALIGN(x) (((x) + AUDIT_FLASH_PROGRAM_UNIT - 1) & \
+                        ~(AUDIT_FLASH_PROGRAM_UNIT - 1))
+
+/*!
+ * \struct audit_segment_hdr
+ *
+ * \brief Header at the start of each segment in flash
+ */
+struct audit_segment_hdr {
+    uint32_t magic;        /*!< \ref AUDIT_SEGMENT_MAGIC */
+    uint32_t seq;          /*!< Incremented each time a segment is opened */
+    uint32_t first_record; /*!< Sequence number of the first record */
+    uint32_t check;        /*!< Integrity check of the fields above */
+};
+
+/*!
+ * \struct audit_frame_hdr
+ *
+ * \brief Header of each record in a segment. A frame is the header followed
+ *        by the record, padded to the program unit.
+ */
+struct audit_frame_hdr {
+    uint32_t size;  /*!< Size of the record in bytes */
+    uint32_t check; /*!< Integrity check of the size and the record */
+};
+
+#define AUDIT_SEGMENT_HDR_SIZE AUDIT_ALIGN(sizeof(struct audit_segment_hdr))
+#define AUDIT_FRAME_SIZE(size) AUDIT_ALIGN(sizeof(struct audit_frame_hdr) + \
+                                           (size))
+
+/*!
+ * \struct audit_segment
+ *
+ * \brief RAM copy of the state of a segment, to find the records without
+ *        reading the flash
+ */
+struct audit_segment {
+    uint32_t seq;          /*!< Sequence number, 0 if the segment is unused */
+    uint32_t first_record; /*!< Sequence number of the first record */
+    uint32_t num_records;  /*!< Number of records, flushed or not */
+};
+
+/*!
+ * \struct audit_flash_state
+ *
+ * \brief State of the flash log
+ */
+struct audit_flash_state {
+    uint32_t oldest;    /*!< Index of the segment with the oldest records */
+    uint32_t current;   /*!< Index of the segment being written */
+    uint32_t write_off; /*!< Offset in the current segment where the RAM
+                         *   buffer is written to on the next flush
+                         */
+    uint32_t buf_used;  /*!< Number of bytes used in the RAM buffer */
+};
+
+static struct audit_segment segments[AUDIT_FLASH_NUM_SEGMENTS];
+static struct audit_flash_state flash_state;
+
+/*!
+ * \var flash_buf
+ *
+ * \brief RAM buffer which collects the frames not written to flash yet
+ */
+__attribute__ ((aligned(4)))
+static uint8_t flash_buf[AUDIT_FLASH_BUF_SIZE];
+
+#ifdef AUDIT_FLASH_LOG_RAM_FS
+/* Allocate a static buffer to emulate storage in RAM */
+static uint8_t audit_flash_data[AUDIT_FLASH_AREA_SIZE];
+#else
+/* Import the CMSIS flash device driver */
+extern ARM_DRIVER_FLASH AUDIT_FLASH_DEV_NAME;
+#endif
+
+/*!
+ * \brief Static function to read from a segment in flash
+ *
+ * \param[in]  seg    Index of the segment
+ * \param[in]  offset Offset in the segment
+ * \param[out] buf    Buffer to store the data read
+ * \param[in]  size   Number of bytes to read
+ *
+ * \return Returns PSA_SUCCESS or PSA_ERROR_STORAGE_FAILURE
+ */
+static psa_status_t audit_flash_read(uint32_t seg, uint32_t offset,
+                                     void *buf, uint32_t size)
+{
+    uint32_t addr = (seg * AUDIT_FLASH_SEGMENT_SIZE) + offset;
+
+#ifdef AUDIT_FLASH_LOG_RAM_FS
+    (void)tfm_memcpy(buf, &audit_flash_data[addr], size);
+#else
+    if (AUDIT_FLASH_DEV_NAME.ReadData(AUDIT_FLASH_AREA_ADDR + addr,
+                                      buf, size) != ARM_DRIVER_OK) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+#endif
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Static function to program a segment in flash
+ *
+ * \param[in] seg    Index of the segment
+ * \param[in] offset Offset in the segment, aligned to the program unit
+ * \param[in] buf    Data to write
+ * \param[in] size   Number of bytes to write, aligned to the program unit
+ *
+ * \return Returns PSA_SUCCESS or PSA_ERROR_STORAGE_FAILURE
+ */
+static psa_status_t audit_flash_write(uint32_t seg, uint32_t offset,
+                                      const void *buf, uint32_t size)
+{
+    uint32_t addr = (seg * AUDIT_FLASH_SEGMENT_SIZE) + offset;
+
+#ifdef AUDIT_FLASH_LOG_RAM_FS
+    (void)tfm_memcpy(&audit_flash_data[addr], buf, size);
+#else
+    if (AUDIT_FLASH_DEV_NAME.ProgramData(AUDIT_FLASH_AREA_ADDR + addr,
+                                         buf, size) != ARM_DRIVER_OK) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+#endif
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Static function to erase a segment in flash
+ *
+ * \param[in] seg Index of the segment
+ *
+ * \return Returns PSA_SUCCESS or PSA_ERROR_STORAGE_FAILURE
+ */
+static psa_status_t audit_flash_erase(uint32_t seg)
+{
+#ifdef AUDIT_FLASH_LOG_RAM_FS
+    (void)tfm_memset(&audit_flash_data[seg * AUDIT_FLASH_SEGMENT_SIZE],
+                     AUDIT_FLASH_ERASE_VAL, AUDIT_FLASH_SEGMENT_SIZE);
+#else
+    uint32_t offset;
+
+    for (offset = 0; offset < AUDIT_FLASH_SEGMENT_SIZE;
+         offset += AUDIT_SECTOR_SIZE) {
+        if (AUDIT_FLASH_DEV_NAME.EraseSector(AUDIT_FLASH_AREA_ADDR +
+                                             (seg * AUDIT_FLASH_SEGMENT_SIZE) +
+                                             offset) != ARM_DRIVER_OK) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+    }
+#endif
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Static function to update an integrity check (FNV-1a) with some
+ *        data
+ *
+ * \param[in] check Current value of the check
+ * \param[in] data  Data to add
+ * \param[in] size  Size of the data in bytes
+ *
+ * \return Updated value of the check
+ */
+static uint32_t audit_check_update(uint32_t check, const void *data,
+                                   uint32_t size)
+{
+    const uint8_t *p_data = data;
+    uint32_t idx;
+
+    for (idx = 0; idx < size; idx++) {
+        check = (check ^ p_data[idx]) * 16777619U;
+    }
+
+    return check;
+}
+
+/* Initial value of the integrity check */
+#define AUDIT_CHECK_INIT (2166136261U)
+
+/*!
+ * \brief Static function to read from a segment, including the part of the
+ *        current segment which is still in the RAM buffer
+ *
+ * \param[in]  seg    Index of the segment
+ * \param[in]  offset Offset in the segment
+ * \param[out] buf    Buffer to store the data read
+ * \param[in]  size   Number of bytes to read
+ *
+ * \return Returns PSA_SUCCESS or PSA_ERROR_STORAGE_FAILURE
+ */
+static psa_status_t audit_segment_read(uint32_t seg, uint32_t offset,
+                                       void *buf, uint32_t size)
+{
+    uint8_t *p_buf = buf;
+    uint32_t len = size;
+    psa_status_t status;
+
+    if ((seg == flash_state.current) &&
+        (offset + size > flash_state.write_off)) {
+        /* The data can start in flash and end in the RAM buffer */
+        len = (offset < flash_state.write_off) ?
+              (flash_state.write_off - offset) : 0;
+
+        (void)tfm_memcpy(&p_buf[len],
+                         &flash_buf[offset + len - flash_state.write_off],
+                         size - len);
+    }
+
+    if (len == 0) {
+        return PSA_SUCCESS;
+    }
+
+    status = audit_flash_read(seg, offset, p_buf, len);
+
+    return status;
+}
+
+/*!
+ * \brief Static function to check the record of a frame in flash
+ *
+ * \param[in] seg    Index of the segment
+ * \param[in] offset Offset of the frame in the segment
+ * \param[in] hdr    Header of the frame
+ *
+ * \return Returns PSA_SUCCESS if the record matches the check of the header
+ */
+static psa_status_t audit_frame_verify(uint32_t seg, uint32_t offset,
+                                       const struct audit_frame_hdr *hdr)
+{
+    uint8_t chunk[32];
+    uint32_t check = AUDIT_CHECK_INIT;
+    uint32_t done, len;
+    psa_status_t status;
+
+    check = audit_check_update(check, &hdr->size, sizeof(hdr->size));
+
+    offset += sizeof(struct audit_frame_hdr);
+    for (done = 0; done < hdr->size; done += len) {
+        len = hdr->size - done;
+        if (len > sizeof(chunk)) {
+            len = sizeof(chunk);
+        }
+
+        status = audit_flash_read(seg, offset + done, chunk, len);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        check = audit_check_update(check, chunk, len);
+    }
+
+    return (check == hdr->check) ? PSA_SUCCESS : PSA_ERROR_STORAGE_FAILURE;
+}
+
+/*!
+ * \brief Static function to find the end of the records of a segment
+ *
+ * \param[in]  seg         Index of the segment
+ * \param[out] end         Offset of the first free byte in the segment
+ * \param[out] num_records Number of valid records in the segment
+ *
+ * \return Returns PSA_SUCCESS if the segment ends with erased flash,
+ *         PSA_ERROR_STORAGE_FAILURE if a record is corrupted, for example by a
+ *         reset while it was written.
+ */
+static psa_status_t audit_segment_scan(uint32_t seg, uint32_t *end,
+                                       uint32_t *num_records)
+{
+    struct audit_frame_hdr hdr;
+    uint32_t offset = AUDIT_SEGMENT_HDR_SIZE;
+    psa_status_t status = PSA_SUCCESS;
+
+    *num_records = 0;
+
+    while (offset + sizeof(hdr) <= AUDIT_FLASH_SEGMENT_SIZE) {
+        status = audit_flash_read(seg, offset, &hdr, sizeof(hdr));
+        if (status != PSA_SUCCESS) {
+            break;
+        }
+
+        if ((hdr.size == AUDIT_FLASH_ERASED_WORD) &&
+            (hdr.check == AUDIT_FLASH_ERASED_WORD)) {
+            break;
+        }
+
+        if ((hdr.size == 0) ||
+            (hdr.size > AUDIT_FLASH_SEGMENT_SIZE - offset) ||
+            (AUDIT_FRAME_SIZE(hdr.size) > AUDIT_FLASH_SEGMENT_SIZE - offset)) {
+            status = PSA_ERROR_STORAGE_FAILURE;
+            break;
+        }
+
+        status = audit_frame_verify(seg, offset, &hdr);
+        if (status != PSA_SUCCESS) {
+            break;
+        }
+
+        offset += AUDIT_FRAME_SIZE(hdr.size);
+        (*num_records)++;
+    }
+
+    *end = offset;
+
+    return status;
+}
+
+/*!
+ * \brief Static function to erase a segment and make it the current one
+ *
+ * \param[in] seg          Index of the segment
+ * \param[in] seq          Sequence number of the segment
+ * \param[in] first_record Sequence number of the first record of the segment
+ *
+ * \return Returns PSA_SUCCESS or PSA_ERROR_STORAGE_FAILURE
+ */
+static psa_status_t audit_segment_open(uint32_t seg, uint32_t seq,
+                                       uint32_t first_record)
+{
+    __attribute__ ((aligned(4)))
+    uint8_t hdr_buf[AUDIT_SEGMENT_HDR_SIZE];
+    struct audit_segment_hdr hdr;
+    psa_status_t status;
+
+    status = audit_flash_erase(seg);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    hdr.magic = AUDIT_SEGMENT_MAGIC;
+    hdr.seq = seq;
+    hdr.first_record = first_record;
+    hdr.check = audit_check_update(AUDIT_CHECK_INIT, &hdr,
+                                   offsetof(struct audit_segment_hdr, check));
+
+    (void)tfm_memset(hdr_buf, AUDIT_FLASH_ERASE_VAL, sizeof(hdr_buf));
+    (void)tfm_memcpy(hdr_buf, &hdr, sizeof(hdr));
+
+    status = audit_flash_write(seg, 0, hdr_buf, sizeof(hdr_buf));
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    segments[seg].seq = seq;
+    segments[seg].first_record = first_record;
+    segments[seg].num_records = 0;
+
+    flash_state.current = seg;
+    flash_state.write_off = AUDIT_SEGMENT_HDR_SIZE;
+    flash_state.buf_used = 0;
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Static function to continue the log in the next segment, which
+ *        drops the records of the oldest segment if all of them are in use
+ *
+ * \return Returns PSA_SUCCESS or PSA_ERROR_STORAGE_FAILURE
+ */
+static psa_status_t audit_segment_rotate(void)
+{
+    struct audit_segment *cur = &segments[flash_state.current];
+    uint32_t next = (flash_state.current + 1) % AUDIT_FLASH_NUM_SEGMENTS;
+
+    if (next == flash_state.oldest) {
+        segments[next].seq = 0;
+        flash_state.oldest = (next + 1) % AUDIT_FLASH_NUM_SEGMENTS;
+    }
+
+    return audit_segment_open(next, cur->seq + 1,
+                              cur->first_record + cur->num_records);
+}
+
+/*!
+ * \brief Static function to read the header of a segment
+ *
+ * \param[in]  seg Index of the segment
+ * \param[out] hdr Header of the segment
+ *
+ * \return Returns PSA_SUCCESS if the segment has a valid header
+ */
+static psa_status_t audit_segment_read_hdr(uint32_t seg,
+                                           struct audit_segment_hdr *hdr)
+{
+    psa_status_t status;
+
+    status = audit_flash_read(seg, 0, hdr, sizeof(*hdr));
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if ((hdr->magic != AUDIT_SEGMENT_MAGIC) || (hdr->seq == 0) ||
+        (hdr->check != audit_check_update(AUDIT_CHECK_INIT, hdr,
+                            offsetof(struct audit_segment_hdr, check)))) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Static function to find the frame of a record
+ *
+ * \details The segment is found from the table in RAM, then the frames of
+ *          that segment only are walked, so the time taken is bounded by the
+ *          size of a segment.
+ *
+ * \param[in]  record_index Index of the record, 0 is the oldest record
+ * \param[out] seg          Index of the segment holding the record
+ * \param[out] offset       Offset of the frame in the segment
+ * \param[out] hdr          Header of the frame
+ *
+ * \return Returns PSA_SUCCESS, PSA_ERROR_INVALID_ARGUMENT if there is no
+ *         such record, or PSA_ERROR_STORAGE_FAILURE
+ */
+static psa_status_t audit_frame_locate(uint32_t record_index, uint32_t *seg,
+                                       uint32_t *offset,
+                                       struct audit_frame_hdr *hdr)
+{
+    uint32_t record, idx;
+    psa_status_t status;
+
+    if (record_index >= audit_flash_log_num_records()) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Find the segment which holds the record */
+    record = segments[flash_state.oldest].first_record + record_index;
+    *seg = flash_state.oldest;
+    while (record - segments[*seg].first_record >=
+           segments[*seg].num_records) {
+        *seg = (*seg + 1) % AUDIT_FLASH_NUM_SEGMENTS;
+    }
+
+    /* Walk the frames of the segment */
+    *offset = AUDIT_SEGMENT_HDR_SIZE;
+    for (idx = segments[*seg].first_record; ; idx++) {
+        status = audit_segment_read(*seg, *offset, hdr, sizeof(*hdr));
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        if (idx == record) {
+            break;
+        }
+        *offset += AUDIT_FRAME_SIZE(hdr->size);
+    }
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \defgroup public Public functions
+ *
+ */
+
+/*!@{*/
+psa_status_t audit_flash_log_init(void)
+{
+    struct audit_segment_hdr hdr;
+    uint32_t seg, prev, end, newest = 0;
+    psa_status_t status;
+
+#ifndef AUDIT_FLASH_LOG_RAM_FS
+    if (AUDIT_FLASH_DEV_NAME.Initialize(NULL) != ARM_DRIVER_OK) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+#endif
+
+    /* Find the segment written last */
+    for (seg = 0; seg < AUDIT_FLASH_NUM_SEGMENTS; seg++) {
+        segments[seg].seq = 0;
+        segments[seg].num_records = 0;
+
+        if (audit_segment_read_hdr(seg, &hdr) == PSA_SUCCESS) {
+            segments[seg].seq = hdr.seq;
+            segments[seg].first_record = hdr.first_record;
+            if (hdr.seq > segments[newest].seq) {
+                newest = seg;
+            }
+        }
+    }
+
+    if (segments[newest].seq == 0) {
+        /* Empty log */
+        flash_state.oldest = 0;
+        return audit_segment_open(0, 1, 0);
+    }
+
+    /* The log starts at the first segment of the sequence which ends with the
+     * newest segment. Older segments are reused when the log wraps.
+     */
+    flash_state.oldest = newest;
+    prev = (newest + AUDIT_FLASH_NUM_SEGMENTS - 1) % AUDIT_FLASH_NUM_SEGMENTS;
+    while ((prev != newest) && (segments[prev].seq != 0) &&
+           (segments[prev].seq + 1 == segments[flash_state.oldest].seq)) {
+        flash_state.oldest = prev;
+        prev = (prev + AUDIT_FLASH_NUM_SEGMENTS - 1) %
+               AUDIT_FLASH_NUM_SEGMENTS;
+    }
+
+    for (seg = 0; seg < AUDIT_FLASH_NUM_SEGMENTS; seg++) {
+        if (segments[seg].seq < segments[flash_state.oldest].seq) {
+            segments[seg].seq = 0;
+        }
+    }
+
+    /* Count the records, and find where to continue in the newest segment */
+    seg = flash_state.oldest;
+    while (1) {
+        status = audit_segment_scan(seg, &end, &segments[seg].num_records);
+        if (seg == newest) {
+            break;
+        }
+        seg = (seg + 1) % AUDIT_FLASH_NUM_SEGMENTS;
+    }
+
+    flash_state.current = newest;
+    flash_state.write_off = end;
+    flash_state.buf_used = 0;
+
+    /* A record was interrupted by a reset, the rest of the segment can't be
+     * programmed safely.
+     */
+    if (status != PSA_SUCCESS) {
+        return audit_segment_rotate();
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t audit_flash_log_flush(void)
+{
+    psa_status_t status;
+
+    if (flash_state.buf_used == 0) {
+        return PSA_SUCCESS;
+    }
+
+    status = audit_flash_write(flash_state.current, flash_state.write_off,
+                               flash_buf, flash_state.buf_used);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    flash_state.write_off += flash_state.buf_used;
+    flash_state.buf_used = 0;
+
+    return PSA_SUCCESS;
+}
+
+/*!
+ * \brief Static function to add data to the RAM buffer, flushing the buffer
+ *        each time it is full
+ *
+ * \param[in] data Data to add
+ * \param[in] size Size of the data in bytes
+ *
+ * \return Returns PSA_SUCCESS or PSA_ERROR_STORAGE_FAILURE
+ */
+static psa_status_t audit_flash_buf_put(const void *data, uint32_t size)
+{
+    const uint8_t *p_data = data;
+    uint32_t len;
+    psa_status_t status;
+
+    while (size > 0) {
+        len = sizeof(flash_buf) - flash_state.buf_used;
+        if (len > size) {
+            len = size;
+        }
+
+        (void)tfm_memcpy(&flash_buf[flash_state.buf_used], p_data, len);
+        flash_state.buf_used += len;
+        p_data += len;
+        size -= len;
+
+        if (flash_state.buf_used == sizeof(flash_buf)) {
+            status = audit_flash_log_flush();
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t audit_flash_log_append(const uint8_t *record, uint32_t size)
+{
+    uint8_t padding[AUDIT_FLASH_PROGRAM_UNIT];
+    struct audit_frame_hdr hdr;
+    uint32_t frame_size = AUDIT_FRAME_SIZE(size);
+    psa_status_t status;
+
+    if ((size == 0) ||
+        (frame_size > AUDIT_FLASH_SEGMENT_SIZE - AUDIT_SEGMENT_HDR_SIZE)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* Move to the next segment if the frame doesn't fit in this one */
+    if (flash_state.write_off + flash_state.buf_used + frame_size >
+        AUDIT_FLASH_SEGMENT_SIZE) {
+        status = audit_flash_log_flush();
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        status = audit_segment_rotate();
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    /* Keep the frames which fit in the buffer in one piece */
+    if ((frame_size <= sizeof(flash_buf)) &&
+        (flash_state.buf_used + frame_size > sizeof(flash_buf))) {
+        status = audit_flash_log_flush();
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    hdr.size = size;
+    hdr.check = audit_check_update(AUDIT_CHECK_INIT, &hdr.size,
+                                   sizeof(hdr.size));
+    hdr.check = audit_check_update(hdr.check, record, size);
+
+    (void)tfm_memset(padding, AUDIT_FLASH_ERASE_VAL, sizeof(padding));
+
+    status = audit_flash_buf_put(&hdr, sizeof(hdr));
+    if (status == PSA_SUCCESS) {
+        status = audit_flash_buf_put(record, size);
+    }
+    if (status == PSA_SUCCESS) {
+        status = audit_flash_buf_put(padding,
+                                     frame_size - sizeof(hdr) - size);
+    }
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    segments[flash_state.current].num_records++;
+
+#ifdef AUDIT_FLASH_FLUSH_EACH_RECORD
+    return audit_flash_log_flush();
+#else
+    return PSA_SUCCESS;
+#endif
+}
+
+uint32_t audit_flash_log_num_records(void)
+{
+    const struct audit_segment *cur = &segments[flash_state.current];
+
+    return cur->first_record + cur->num_records -
+           segments[flash_state.oldest].first_record;
+}
+
+psa_status_t audit_flash_log_read(uint32_t record_index,
+                                  uint8_t *buffer,
+                                  uint32_t buffer_size,
+                                  uint32_t *size)
+{
+    struct audit_frame_hdr hdr;
+    uint32_t seg, offset;
+    psa_status_t status;
+
+    status = audit_frame_locate(record_index, &seg, &offset, &hdr);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (buffer_size < hdr.size) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    status = audit_segment_read(seg, offset + sizeof(hdr), buffer, hdr.size);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    *size = hdr.size;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t audit_flash_log_get_record_size(uint32_t record_index,
+                                             uint32_t *size)
+{
+    struct audit_frame_hdr hdr;
+    uint32_t seg, offset;
+    psa_status_t status;
+
+    status = audit_frame_locate(record_index, &seg, &offset, &hdr);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    *size = hdr.size;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t audit_flash_log_read_records(uint32_t first_index,
+                                          uint32_t num_records,
+                                          uint8_t *buffer,
+                                          uint32_t buffer_size,
+                                          uint32_t *num_read,
+                                          uint32_t *size)
+{
+    struct audit_frame_hdr hdr;
+    uint32_t seg, offset, record, last;
+    uint32_t read = 0, read_size = 0;
+    psa_status_t status;
+
+    *num_read = 0;
+    *size = 0;
+
+    status = audit_frame_locate(first_index, &seg, &offset, &hdr);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    record = segments[flash_state.oldest].first_record + first_index;
+    last = segments[flash_state.oldest].first_record +
+           audit_flash_log_num_records();
+
+    /* The frames are walked in order from the first one, possibly into the
+     * following segments
+     */
+    while (1) {
+        if ((buffer_size - read_size) < hdr.size) {
+            break;
+        }
+
+        status = audit_segment_read(seg, offset + sizeof(hdr),
+                                    &buffer[read_size], hdr.size);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+
+        read_size += hdr.size;
+        read++;
+        record++;
+
+        if ((read == num_records) || (record == last)) {
+            break;
+        }
+
+        if (record - segments[seg].first_record < segments[seg].num_records) {
+            offset += AUDIT_FRAME_SIZE(hdr.size);
+        } else {
+            seg = (seg + 1) % AUDIT_FLASH_NUM_SEGMENTS;
+            offset = AUDIT_SEGMENT_HDR_SIZE;
+        }
+
+        status = audit_segment_read(seg, offset, &hdr, sizeof(hdr));
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    if (read == 0) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    *num_read = read;
+    *size = read_size;
+
+    return PSA_SUCCESS;
+}
+/*!@}*/
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __AUDIT_FLASH_LOG_H__
+#define __AUDIT_FLASH_LOG_H__
+
+#include <stdint.h>
+#include "psa/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \file audit_flash_log.h
+ *
+ * \brief Persistent copy of the audit log
+ *
+ * \details The log records are appended to a dedicated flash area which is
+ *          split in segments. A segment is only written sequentially, and
+ *          when the last segment is full the oldest one is erased and reused.
+ *          Records are first collected in a RAM buffer and written to flash in
+ *          program unit aligned chunks when the buffer is flushed.
+ *
+ *          Records are identified by their index, 0 being the oldest record
+ *          still stored in flash.
+ */
+
+/*!
+ * \brief Mounts the flash log, creating an empty log if there is no valid
+ *        segment in the flash area.
+ *
+ * \return Returns PSA_SUCCESS if the log is ready to be used, otherwise
+ *         PSA_ERROR_STORAGE_FAILURE
+ */
+psa_status_t audit_flash_log_init(void);
+
+/*!
+ * \brief Appends a record to the log
+ *
+ * \details The record is copied to the RAM buffer. It is written to flash
+ *          straight away if \ref AUDIT_FLASH_FLUSH_EACH_RECORD is set, or when
+ *          the buffer cannot take the next record otherwise.
+ *
+ * \param[in] record Pointer to the formatted log record
+ * \param[in] size   Size of the record in bytes
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ */
+psa_status_t audit_flash_log_append(const uint8_t *record, uint32_t size);
+
+/*!
+ * \brief Writes the records held in the RAM buffer to flash
+ *
+ * \return Returns PSA_SUCCESS if the function is executed correctly,
+ *         otherwise PSA_ERROR_STORAGE_FAILURE
+ */
+psa_status_t audit_flash_log_flush(void);
+
+/*!
+ * \brief Returns the number of records in the log, including the ones which
+ *        are not flushed yet
+ *
+ * \return Number of records
+ */
+uint32_t audit_flash_log_num_records(void);
+
+/*!
+ * \brief Reads a record from the log
+ *
+ * \details The record is found from the table of segments kept in RAM, then
+ *          by walking the record headers of a single segment, so the time to
+ *          read any record is bounded by the size of a segment.
+ *
+ * \param[in]  record_index Index of the record, 0 is the oldest record
+ * \param[out] buffer       Buffer to copy the record to
+ * \param[in]  buffer_size  Size of the buffer in bytes
+ * \param[out] size         Size of the record in bytes
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ */
+psa_status_t audit_flash_log_read(uint32_t record_index,
+                                  uint8_t *buffer,
+                                  uint32_t buffer_size,
+                                  uint32_t *size);
+
+/*!
+ * \brief Returns the size of a record of the log
+ *
+ * \param[in]  record_index Index of the record, 0 is the oldest record
+ * \param[out] size         Size of the record in bytes
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ */
+psa_status_t audit_flash_log_get_record_size(uint32_t record_index,
+                                             uint32_t *size);
+
+/*!
+ * \brief Reads consecutive records from the log
+ *
+ * \details As many whole records as the buffer can hold are copied, up to
+ *          \p num_records. The first record is found as for
+ *          \ref audit_flash_log_read, the next ones follow it in flash, so
+ *          the time taken is bounded by the size of a segment plus the size
+ *          of the records read.
+ *
+ * \param[in]  first_index  Index of the first record, 0 is the oldest record
+ * \param[in]  num_records  Maximum number of records to read
+ * \param[out] buffer       Buffer to copy the records to
+ * \param[in]  buffer_size  Size of the buffer in bytes
+ * \param[out] num_read     Number of records read
+ * \param[out] size         Size of the records read in bytes
+ *
+ * \return Returns values as specified by the \ref psa_status_t,
+ *         PSA_ERROR_BUFFER_TOO_SMALL if not even the first record fits
+ */
+psa_status_t audit_flash_log_read_records(uint32_t first_index,
+                                          uint32_t num_records,
+                                          uint8_t *buffer,
+                                          uint32_t buffer_size,
+                                          uint32_t *num_read,
+                                          uint32_t *size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AUDIT_FLASH_LOG_H__ */
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "audit_mac.h"
+
+#include "audit_core.h"
+#include "psa/crypto.h"
+#include "tfm_crypto_defs.h"
+#include "tfm_memory_utils.h"
+
+/* The PSA algorithm used by this implementation */
+#define AUDIT_MAC_ALG PSA_ALG_HMAC(PSA_ALG_SHA_256)
+/* Size of the full HMAC-SHA256 before truncation */
+#define AUDIT_MAC_FULL_SIZE (32)
+/* Size of the derived key */
+#define AUDIT_MAC_KEY_SIZE (32)
+
+static const uint8_t audit_key_label[] = "audit_log_mac_key";
+static psa_key_handle_t audit_key_handle;
+static uint8_t audit_key_ready;
+
+/*!
+ * \brief Static function to derive the MAC key from the hardware unique key
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ */
+static psa_status_t audit_mac_setkey(void)
+{
+    psa_status_t status;
+    psa_key_attributes_t attributes = PSA_KEY_ATTRIBUTES_INIT;
+    psa_key_derivation_operation_t op = PSA_KEY_DERIVATION_OPERATION_INIT;
+
+    /* Set the key attributes for the MAC key */
+    psa_set_key_usage_flags(&attributes, PSA_KEY_USAGE_SIGN);
+    psa_set_key_algorithm(&attributes, AUDIT_MAC_ALG);
+    psa_set_key_type(&attributes, PSA_KEY_TYPE_HMAC);
+    psa_set_key_bits(&attributes, PSA_BYTES_TO_BITS(AUDIT_MAC_KEY_SIZE));
+
+    /* Set up a key derivation operation with HUK derivation as the alg */
+    status = psa_key_derivation_setup(&op, TFM_CRYPTO_ALG_HUK_DERIVATION);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Supply the audit key label as an input to the key derivation */
+    status = psa_key_derivation_input_bytes(&op, PSA_KEY_DERIVATION_INPUT_LABEL,
+                                            audit_key_label,
+                                            sizeof(audit_key_label));
+    if (status != PSA_SUCCESS) {
+        goto err_release_op;
+    }
+
+    /* Create the MAC key from the key derivation operation */
+    status = psa_key_derivation_output_key(&attributes, &op,
+                                           &audit_key_handle);
+    if (status != PSA_SUCCESS) {
+        goto err_release_op;
+    }
+
+    /* Free resources associated with the key derivation operation */
+    status = psa_key_derivation_abort(&op);
+    if (status != PSA_SUCCESS) {
+        (void)psa_destroy_key(audit_key_handle);
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    audit_key_ready = 1U;
+
+    return PSA_SUCCESS;
+
+err_release_op:
+    (void)psa_key_derivation_abort(&op);
+
+    return PSA_ERROR_GENERIC_ERROR;
+}
+
+psa_status_t audit_mac_compute(const uint8_t *prev_mac,
+                               const uint8_t *chunk1, size_t len1,
+                               const uint8_t *chunk2, size_t len2,
+                               uint8_t *mac)
+{
+    psa_status_t status;
+    psa_mac_operation_t op = psa_mac_operation_init();
+    uint8_t full_mac[AUDIT_MAC_FULL_SIZE];
+    size_t full_mac_len;
+
+    if (audit_key_ready == 0U) {
+        status = audit_mac_setkey();
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    status = psa_mac_sign_setup(&op, audit_key_handle, AUDIT_MAC_ALG);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Chain the record to the previous one */
+    status = psa_mac_update(&op, prev_mac, LOG_MAC_SIZE);
+    if (status != PSA_SUCCESS) {
+        goto err_abort;
+    }
+
+    status = psa_mac_update(&op, chunk1, len1);
+    if (status != PSA_SUCCESS) {
+        goto err_abort;
+    }
+
+    if (len2 != 0) {
+        status = psa_mac_update(&op, chunk2, len2);
+        if (status != PSA_SUCCESS) {
+            goto err_abort;
+        }
+    }
+
+    status = psa_mac_sign_finish(&op, full_mac, sizeof(full_mac),
+                                 &full_mac_len);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (full_mac_len < LOG_MAC_SIZE) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    (void)tfm_memcpy(mac, full_mac, LOG_MAC_SIZE);
+
+    return PSA_SUCCESS;
+
+err_abort:
+    (void)psa_mac_abort(&op);
+
+    return status;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __AUDIT_MAC_H__
+#define __AUDIT_MAC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psa/error.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \file audit_mac.h
+ *
+ * \brief Computation of the MAC of the log records
+ *
+ * \details The MAC of a record is an HMAC-SHA256, truncated to LOG_MAC_SIZE
+ *          bytes, of the MAC of the previous record followed by the record
+ *          without its MAC field. The key is derived from the hardware unique
+ *          key by the crypto service the first time a MAC is computed, as the
+ *          crypto service is not available yet when the audit logging service
+ *          is initialised.
+ */
+
+/*!
+ * \brief Computes the MAC of a record
+ *
+ * \details The record can be split in two chunks, to support records which
+ *          wrap around the end of the log buffer.
+ *
+ * \param[in]  prev_mac Pointer to the MAC of the previous record
+ * \param[in]  chunk1   Pointer to the first chunk of the record
+ * \param[in]  len1     Size in bytes of the first chunk
+ * \param[in]  chunk2   Pointer to the second chunk of the record
+ * \param[in]  len2     Size in bytes of the second chunk, can be 0
+ * \param[out] mac      Buffer of LOG_MAC_SIZE bytes to store the MAC
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ */
+psa_status_t audit_mac_compute(const uint8_t *prev_mac,
+                               const uint8_t *chunk1, size_t len1,
+                               const uint8_t *chunk2, size_t len2,
+                               uint8_t *mac);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __AUDIT_MAC_H__ */
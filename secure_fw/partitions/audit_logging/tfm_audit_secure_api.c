@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -49,6 +49,46 @@ psa_status_t psa_audit_retrieve_record(const uint32_t record_index,
     return status;
 }
 
+__attribute__((section("SFN")))
+psa_status_t psa_audit_retrieve_records(const uint32_t first_index,
+                                        const uint32_t num_records,
+                                        const uint32_t buffer_size,
+                                        uint8_t *buffer,
+                                        uint32_t *num_retrieved,
+                                        uint32_t *retrieved_size)
+{
+    psa_status_t status;
+    psa_invec in_vec[] = {
+        {.base = &first_index, .len = sizeof(uint32_t)},
+        {.base = &num_records, .len = sizeof(uint32_t)},
+    };
+    psa_outvec out_vec[] = {
+        {.base = buffer, .len = buffer_size},
+        {.base = num_retrieved, .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH(audit_core_retrieve_records);
+
+    *retrieved_size = out_vec[0].len;
+
+    return status;
+}
+
+__attribute__((section("SFN")))
+psa_status_t psa_audit_verify_records(const uint32_t first_index,
+                                      const uint32_t num_records)
+{
+    psa_status_t status;
+    psa_invec in_vec[] = {
+        {.base = &first_index, .len = sizeof(uint32_t)},
+        {.base = &num_records, .len = sizeof(uint32_t)},
+    };
+
+    status = API_DISPATCH_NO_OUTVEC(audit_core_verify_records);
+
+    return status;
+}
+
 __attribute__((section("SFN")))
 psa_status_t psa_audit_get_info(uint32_t *num_records, uint32_t *size)
 {
@@ -108,3 +148,9 @@ psa_status_t psa_audit_add_record(const struct psa_audit_record *record)
 
     return status;
 }
+
+__attribute__((section("SFN")))
+psa_status_t psa_audit_flush(void)
+{
+    return tfm_audit_core_flush_veneer(NULL, 0, NULL, 0);
+}
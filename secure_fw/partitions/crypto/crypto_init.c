@@ -28,6 +28,9 @@
 #include "psa/service.h"
 #include "psa_manifest/tfm_crypto.h"
 #include "tfm_memory_utils.h"
+#ifdef TFM_MEM_PROFILE
+#include "tfm/tfm_spm_services_api.h"
+#endif
 
 /**
  * \brief Table containing all the Uniform Signature API exposed
@@ -67,6 +70,9 @@ static struct tfm_crypto_scratch {
     uint8_t buf[TFM_CRYPTO_IOVEC_BUFFER_SIZE];
     uint32_t alloc_index;
     int32_t owner;
+#ifdef TFM_MEM_PROFILE
+    uint32_t peak;
+#endif
 } scratch = {.buf = {0}, .alloc_index = 0};
 
 static psa_status_t tfm_crypto_set_scratch_owner(int32_t id)
@@ -96,6 +102,14 @@ static psa_status_t tfm_crypto_alloc_scratch(size_t requested_size, void **buf)
     /* Increase the allocated size */
     scratch.alloc_index += requested_size;
 
+#ifdef TFM_MEM_PROFILE
+    /* Report the high-water mark to SPM, only when it moves */
+    if (scratch.alloc_index > scratch.peak) {
+        scratch.peak = scratch.alloc_index;
+        (void)tfm_spm_request_scratch_peak(sizeof(scratch.buf), scratch.peak);
+    }
+#endif
+
     return PSA_SUCCESS;
 }
 
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "attest_batch.h"
+#include "psa/crypto.h"
+#include "psa/initial_attestation.h"
+#include "tfm_memory_utils.h"
+
+/* Domain separation prefixes of RFC 6962 */
+#define ATTEST_BATCH_LEAF_PREFIX (0x00u)
+#define ATTEST_BATCH_NODE_PREFIX (0x01u)
+
+/* Number of subtrees which can be pending while the leaves are added. A full
+ * tree of 2^(n-1) leaves needs n entries at most.
+ */
+#define ATTEST_BATCH_STACK_DEPTH (4u)
+
+#if (TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES > \
+     (1u << (ATTEST_BATCH_STACK_DEPTH - 1)))
+#error "ATTEST_BATCH_STACK_DEPTH is too small for the maximum batch size"
+#endif
+
+/*!
+ * \struct attest_batch_subtree
+ *
+ * \brief Root of a complete subtree which is not merged yet.
+ */
+struct attest_batch_subtree {
+    size_t leaves;                        /* Number of leaves in the subtree */
+    uint8_t hash[ATTEST_BATCH_ROOT_SIZE];
+};
+
+/*!
+ * \brief Static function to hash a prefix byte followed by up to two buffers.
+ *
+ * \param[in]  prefix  Domain separation prefix
+ * \param[in]  a       First buffer to hash
+ * \param[in]  a_len   Size of the first buffer
+ * \param[in]  b       Second buffer to hash, can be NULL
+ * \param[in]  b_len   Size of the second buffer
+ * \param[out] hash    Buffer of \ref ATTEST_BATCH_ROOT_SIZE bytes to store the
+ *                     hash
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t attest_batch_hash(uint8_t prefix,
+                                               const uint8_t *a, size_t a_len,
+                                               const uint8_t *b, size_t b_len,
+                                               uint8_t *hash)
+{
+    psa_status_t crypto_res;
+    psa_hash_operation_t op = psa_hash_operation_init();
+    size_t hash_len;
+
+    crypto_res = psa_hash_setup(&op, PSA_ALG_SHA_256);
+    if (crypto_res != PSA_SUCCESS) {
+        return PSA_ATTEST_ERR_GENERAL;
+    }
+
+    crypto_res = psa_hash_update(&op, &prefix, sizeof(prefix));
+    if (crypto_res != PSA_SUCCESS) {
+        goto error;
+    }
+
+    crypto_res = psa_hash_update(&op, a, a_len);
+    if (crypto_res != PSA_SUCCESS) {
+        goto error;
+    }
+
+    if (b != NULL) {
+        crypto_res = psa_hash_update(&op, b, b_len);
+        if (crypto_res != PSA_SUCCESS) {
+            goto error;
+        }
+    }
+
+    crypto_res = psa_hash_finish(&op, hash, ATTEST_BATCH_ROOT_SIZE, &hash_len);
+    if (crypto_res != PSA_SUCCESS || hash_len != ATTEST_BATCH_ROOT_SIZE) {
+        return PSA_ATTEST_ERR_GENERAL;
+    }
+
+    return PSA_ATTEST_ERR_SUCCESS;
+
+error:
+    (void)psa_hash_abort(&op);
+    return PSA_ATTEST_ERR_GENERAL;
+}
+
+/* See in attest_batch.h */
+enum psa_attest_err_t
+attest_batch_merkle_root(const uint8_t *challenges,
+                         size_t challenge_size,
+                         size_t challenge_count,
+                         uint8_t *root)
+{
+    struct attest_batch_subtree stack[ATTEST_BATCH_STACK_DEPTH];
+    struct attest_batch_subtree *left;
+    struct attest_batch_subtree *right;
+    enum psa_attest_err_t attest_err;
+    size_t depth = 0;
+    size_t i;
+
+    if (challenges == NULL || challenge_count == 0 ||
+        challenge_count > TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES) {
+        return PSA_ATTEST_ERR_INVALID_INPUT;
+    }
+
+    for (i = 0; i < challenge_count; i++) {
+        attest_err = attest_batch_hash(ATTEST_BATCH_LEAF_PREFIX,
+                                       &challenges[i * challenge_size],
+                                       challenge_size,
+                                       NULL, 0,
+                                       stack[depth].hash);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+        stack[depth].leaves = 1;
+        depth++;
+
+        /* Merge the subtrees of the same size, which leaves the complete
+         * subtrees of decreasing size on the stack.
+         */
+        while ((depth > 1) &&
+               (stack[depth - 2].leaves == stack[depth - 1].leaves)) {
+            left = &stack[depth - 2];
+            right = &stack[depth - 1];
+            attest_err = attest_batch_hash(ATTEST_BATCH_NODE_PREFIX,
+                                           left->hash, sizeof(left->hash),
+                                           right->hash, sizeof(right->hash),
+                                           left->hash);
+            if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+                return attest_err;
+            }
+            left->leaves += right->leaves;
+            depth--;
+        }
+    }
+
+    /* Fold the remaining subtrees from the right, as RFC 6962 splits the
+     * leaves at the largest power of two.
+     */
+    while (depth > 1) {
+        left = &stack[depth - 2];
+        right = &stack[depth - 1];
+        attest_err = attest_batch_hash(ATTEST_BATCH_NODE_PREFIX,
+                                       left->hash, sizeof(left->hash),
+                                       right->hash, sizeof(right->hash),
+                                       left->hash);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+        left->leaves += right->leaves;
+        depth--;
+    }
+
+    (void)tfm_memcpy(root, stack[0].hash, ATTEST_BATCH_ROOT_SIZE);
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
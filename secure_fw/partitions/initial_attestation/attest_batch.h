@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __ATTEST_BATCH_H__
+#define __ATTEST_BATCH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "attestation.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def ATTEST_BATCH_ROOT_SIZE
+ *
+ * \brief Size of the Merkle root of a batch of challenges (SHA-256).
+ */
+#define ATTEST_BATCH_ROOT_SIZE (32u)
+
+/*!
+ * \brief Calculates the Merkle root of a batch of challenges.
+ *
+ * The tree is built as the Merkle Hash Tree of RFC 6962 (section 2.1) over the
+ * challenges in the order they are passed in:
+ *
+ *   - leaf hash: SHA-256(0x00 || challenge)
+ *   - node hash: SHA-256(0x01 || left || right)
+ *
+ * The root is signed by the batch token instead of a single challenge. The
+ * inclusion proof of each challenge can be derived from the list of
+ * challenges, no proof is returned by the device.
+ *
+ * \param[in]  challenges       Challenges of the batch, one after the other
+ * \param[in]  challenge_size   Size of each challenge in bytes
+ * \param[in]  challenge_count  Number of challenges in the batch, between 1
+ *                              and \ref TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES
+ * \param[out] root             Buffer to write the root to, it must be at
+ *                              least \ref ATTEST_BATCH_ROOT_SIZE bytes long
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+enum psa_attest_err_t
+attest_batch_merkle_root(const uint8_t *challenges,
+                         size_t challenge_size,
+                         size_t challenge_count,
+                         uint8_t *root);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ATTEST_BATCH_H__ */
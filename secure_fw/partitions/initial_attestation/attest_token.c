@@ -17,6 +17,9 @@
 #include "t_cose_sign1_sign.h"
 #endif
 #include "t_cose_common.h"
+#include "t_cose_crypto.h"
+#include "t_cose_standard_constants.h"
+#include "t_cose_util.h"
 #include "q_useful_buf.h"
 #include "psa/crypto.h"
 #include "attestation_key.h"
@@ -224,27 +227,25 @@ Done:
  */
 
 /*
- Public function. See attest_token.h
+ * \brief Set up the signing context with the attestation key.
+ *
+ * \param[in] signer_ctx   The t_cose signing context to initialize.
+ * \param[in] opt_flags    Flags to select different custom options.
+ * \param[in] cose_alg_id  The algorithm to sign with.
+ *
+ * \return one of the \ref attest_token_err_t errors.
  */
-enum attest_token_err_t attest_token_start(struct attest_token_ctx *me,
-                                           uint32_t opt_flags,
-                                           int32_t key_select,
-                                           int32_t cose_alg_id,
-                                           const struct q_useful_buf *out_buf)
+static enum attest_token_err_t
+attest_token_signer_init(struct t_cose_sign1_sign_ctx *signer_ctx,
+                         uint32_t opt_flags,
+                         int32_t cose_alg_id)
 {
-    enum t_cose_err_t cose_ret;
-    enum attest_token_err_t return_value = ATTEST_TOKEN_ERR_SUCCESS;
     enum psa_attest_err_t   attest_ret;
     int32_t                 t_cose_options = 0;
     struct t_cose_key attest_key;
     psa_key_handle_t private_key;
     struct q_useful_buf_c attest_key_id = NULL_Q_USEFUL_BUF_C;
 
-    /* Remember some of the configuration values */
-    me->opt_flags  = opt_flags;
-    me->key_select = key_select;
-
-
     if (opt_flags & TOKEN_OPT_SHORT_CIRCUIT_SIGN) {
         t_cose_options |= T_COSE_OPT_SHORT_CIRCUIT_SIG;
     } else {
@@ -256,7 +257,7 @@ enum attest_token_err_t attest_token_start(struct attest_token_ctx *me,
 #endif /* INCLUDE_COSE_KEY_ID */
     }
 
-    t_cose_sign1_sign_init(&(me->signer_ctx), t_cose_options, cose_alg_id);
+    t_cose_sign1_sign_init(signer_ctx, t_cose_options, cose_alg_id);
 
     attest_ret = attest_get_signing_key_handle(&private_key);
     if (attest_ret != PSA_ATTEST_ERR_SUCCESS) {
@@ -265,10 +266,36 @@ enum attest_token_err_t attest_token_start(struct attest_token_ctx *me,
     attest_key.crypto_lib = T_COSE_CRYPTO_LIB_PSA;
     attest_key.k.key_handle = private_key;
 
-    t_cose_sign1_set_signing_key(&(me->signer_ctx),
+    t_cose_sign1_set_signing_key(signer_ctx,
                                  attest_key,
                                  attest_key_id);
 
+    return ATTEST_TOKEN_ERR_SUCCESS;
+}
+
+/*
+ Public function. See attest_token.h
+ */
+enum attest_token_err_t attest_token_start(struct attest_token_ctx *me,
+                                           uint32_t opt_flags,
+                                           int32_t key_select,
+                                           int32_t cose_alg_id,
+                                           const struct q_useful_buf *out_buf)
+{
+    enum t_cose_err_t cose_ret;
+    enum attest_token_err_t return_value = ATTEST_TOKEN_ERR_SUCCESS;
+
+    /* Remember some of the configuration values */
+    me->opt_flags  = opt_flags;
+    me->key_select = key_select;
+
+    return_value = attest_token_signer_init(&(me->signer_ctx),
+                                            opt_flags,
+                                            cose_alg_id);
+    if (return_value != ATTEST_TOKEN_ERR_SUCCESS) {
+        return return_value;
+    }
+
     /* Spin up the CBOR encoder */
     QCBOREncode_Init(&(me->cbor_enc_ctx), *out_buf);
 
@@ -326,6 +353,114 @@ attest_token_finish(struct attest_token_ctx *me,
 Done:
         return return_value;
 }
+#ifdef ATTEST_STREAM_TOKEN
+/*
+ * Outline of streamed token creation. The token is the same as the
+ * one above, but it is output in three parts and never held in a
+ * single buffer.
+ *
+ * - Encode the COSE header up to the head of the payload bstr, which
+ *   needs the length of the payload. Start the hash of the
+ *   \c Sig_structure and output the header.
+ * - Hash and output each chunk of the payload.
+ * - Finish the hash, run ECDSA and output the signature bstr.
+ */
+
+/*
+ Public function. See attest_token.h
+ */
+enum attest_token_err_t
+attest_token_stream_start(struct attest_token_stream_ctx *me,
+                          uint32_t opt_flags,
+                          int32_t key_select,
+                          int32_t cose_alg_id,
+                          size_t payload_len,
+                          size_t max_token_len,
+                          attest_token_sink_t sink,
+                          void *sink_ctx,
+                          size_t *token_len)
+{
+    enum attest_token_err_t return_value;
+    enum t_cose_err_t       cose_ret;
+    struct q_useful_buf     work_buf = {me->work_buf, sizeof(me->work_buf)};
+    struct q_useful_buf_c   header;
+
+    /* There is a single key, the key selection is not used */
+    (void)key_select;
+
+    return_value = attest_token_signer_init(&(me->signer_ctx),
+                                            opt_flags,
+                                            cose_alg_id);
+    if (return_value != ATTEST_TOKEN_ERR_SUCCESS) {
+        return return_value;
+    }
+
+    cose_ret = t_cose_sign1_stream_start(&(me->signer_ctx),
+                                         &(me->hash_ctx),
+                                         payload_len,
+                                         work_buf,
+                                         &header,
+                                         token_len);
+    if (cose_ret != T_COSE_SUCCESS) {
+        return t_cose_err_to_attest_err(cose_ret);
+    }
+
+    /* Nothing is output unless the whole token fits */
+    if (*token_len > max_token_len) {
+        return ATTEST_TOKEN_ERR_TOO_SMALL;
+    }
+
+    me->sink         = sink;
+    me->sink_ctx     = sink_ctx;
+    me->payload_left = payload_len;
+
+    return me->sink(me->sink_ctx, &header);
+}
+
+/*
+ Public function. See attest_token.h
+ */
+enum attest_token_err_t
+attest_token_stream_payload(struct attest_token_stream_ctx *me,
+                            const struct q_useful_buf_c *chunk)
+{
+    /* The length of the payload is already encoded in the header */
+    if (chunk->len > me->payload_left) {
+        return ATTEST_TOKEN_ERR_CBOR_FORMATTING;
+    }
+    me->payload_left -= chunk->len;
+
+    t_cose_sign1_stream_payload(&(me->hash_ctx), *chunk);
+
+    return me->sink(me->sink_ctx, chunk);
+}
+
+/*
+ Public function. See attest_token.h
+ */
+enum attest_token_err_t
+attest_token_stream_finish(struct attest_token_stream_ctx *me)
+{
+    enum t_cose_err_t     cose_ret;
+    struct q_useful_buf   work_buf = {me->work_buf, sizeof(me->work_buf)};
+    struct q_useful_buf_c trailer;
+
+    if (me->payload_left != 0) {
+        return ATTEST_TOKEN_ERR_CBOR_FORMATTING;
+    }
+
+    /* -- This is where the signing happens -- */
+    cose_ret = t_cose_sign1_stream_finish(&(me->signer_ctx),
+                                          &(me->hash_ctx),
+                                          work_buf,
+                                          &trailer);
+    if (cose_ret != T_COSE_SUCCESS) {
+        return t_cose_err_to_attest_err(cose_ret);
+    }
+
+    return me->sink(me->sink_ctx, &trailer);
+}
+#endif /* ATTEST_STREAM_TOKEN */
 #endif /* SYMMETRIC_INITIAL_ATTESTATION */
 
 /*
@@ -381,3 +516,249 @@ void attest_token_add_encoded(struct attest_token_ctx *me,
 {
     QCBOREncode_AddEncodedToMapN(&(me->cbor_enc_ctx), label, *encoded);
 }
+
+
+/**
+ * \brief Decode the label at the start of an encoded claim
+ *
+ * \param[in] claim   A single label and value pair.
+ * \param[out] label  The integer label.
+ *
+ * \return Size of the encoded label, or 0 if the claim does not start with
+ *         an integer label which is followed by a value.
+ *
+ * Only the head of the label is decoded, as defined by RFC 7049. Labels are
+ * 32-bit, so the argument is at most four bytes.
+ */
+static size_t attest_token_decode_label(const struct q_useful_buf_c *claim,
+                                        int32_t *label)
+{
+    const uint8_t *head = claim->ptr;
+    uint8_t major_type;
+    uint8_t additional_info;
+    uint32_t argument;
+    size_t head_len;
+    size_t i;
+
+    if (claim->len == 0) {
+        return 0;
+    }
+
+    major_type = head[0] >> 5;
+    additional_info = head[0] & 0x1f;
+
+    if (additional_info < LEN_IS_ONE_BYTE) {
+        argument = additional_info;
+        head_len = 1;
+    } else if (additional_info <= LEN_IS_FOUR_BYTES) {
+        head_len = 1 + (1u << (additional_info - LEN_IS_ONE_BYTE));
+        if (claim->len < head_len) {
+            return 0;
+        }
+        argument = 0;
+        for (i = 1; i < head_len; i++) {
+            argument = (argument << 8) | head[i];
+        }
+    } else {
+        return 0;
+    }
+
+    if (argument > INT32_MAX || claim->len == head_len) {
+        return 0;
+    }
+
+    if (major_type == CBOR_MAJOR_TYPE_POSITIVE_INT) {
+        *label = (int32_t)argument;
+    } else if (major_type == CBOR_MAJOR_TYPE_NEGATIVE_INT) {
+        *label = -1 - (int32_t)argument;
+    } else {
+        return 0;
+    }
+
+    return head_len;
+}
+
+
+/*
+ See attest_token.h
+ */
+enum attest_token_err_t
+attest_token_add_encoded_claims(struct attest_token_ctx *me,
+                                const struct q_useful_buf_c *claims,
+                                uint32_t claim_count)
+{
+    struct q_useful_buf_c value;
+    int32_t label;
+    size_t label_len;
+    uint32_t i;
+
+    /* Each claim is added as a labelled item of the open map, so that QCBOR
+     * counts it as one entry.
+     */
+    for (i = 0; i < claim_count; i++) {
+        label_len = attest_token_decode_label(&claims[i], &label);
+        if (label_len == 0) {
+            return ATTEST_TOKEN_ERR_CBOR_FORMATTING;
+        }
+
+        value.ptr = (const uint8_t *)claims[i].ptr + label_len;
+        value.len = claims[i].len - label_len;
+        QCBOREncode_AddEncodedToMapN(&(me->cbor_enc_ctx), label, value);
+    }
+
+    return ATTEST_TOKEN_ERR_SUCCESS;
+}
+
+
+/*
+ Public function. See attest_token.h
+ */
+void attest_token_claims_start(struct attest_token_ctx *me,
+                               const struct q_useful_buf *out_buf)
+{
+    me->opt_flags  = 0;
+    me->key_select = 0;
+
+    QCBOREncode_Init(&(me->cbor_enc_ctx), *out_buf);
+}
+
+
+/*
+ Public function. See attest_token.h
+ */
+enum attest_token_err_t
+attest_token_claims_finish(struct attest_token_ctx *me,
+                           struct q_useful_buf_c *encoded_claims)
+{
+    QCBORError qcbor_result;
+
+    qcbor_result = QCBOREncode_Finish(&(me->cbor_enc_ctx), encoded_claims);
+    if (qcbor_result == QCBOR_ERR_BUFFER_TOO_SMALL) {
+        return ATTEST_TOKEN_ERR_TOO_SMALL;
+    } else if (qcbor_result != QCBOR_SUCCESS) {
+        return ATTEST_TOKEN_ERR_CBOR_FORMATTING;
+    }
+
+    return ATTEST_TOKEN_ERR_SUCCESS;
+}
+
+
+/*
+ Public function. See attest_token.h
+ */
+enum attest_token_err_t
+attest_token_size(uint32_t opt_flags,
+                  int32_t cose_alg_id,
+                  size_t payload_len,
+                  size_t *token_len)
+{
+    QCBOREncodeContext    cbor_enc_ctx;
+    struct q_useful_buf   size_only = {NULL, INT32_MAX};
+    struct q_useful_buf_c attest_key_id = NULL_Q_USEFUL_BUF_C;
+    struct q_useful_buf_c placeholder = NULL_Q_USEFUL_BUF_C;
+    size_t                kid_len = 0;
+    size_t                protected_len;
+    size_t                sig_len;
+    enum psa_attest_err_t attest_ret;
+    QCBORError            qcbor_result;
+
+#ifdef SYMMETRIC_INITIAL_ATTESTATION
+    sig_len = t_cose_tag_size(cose_alg_id);
+    if (sig_len == INT32_MAX) {
+        return ATTEST_TOKEN_ERR_GENERAL;
+    }
+#else
+    switch (cose_alg_id) {
+    case T_COSE_ALGORITHM_ES256:
+        sig_len = T_COSE_EC_P256_SIG_SIZE;
+        break;
+    case T_COSE_ALGORITHM_ES384:
+        sig_len = T_COSE_EC_P384_SIG_SIZE;
+        break;
+    default:
+        return ATTEST_TOKEN_ERR_GENERAL;
+    }
+#endif
+
+    /* The same kid as t_cose puts in the token for the signer set up by
+     * attest_token_start()
+     */
+#ifdef SYMMETRIC_INITIAL_ATTESTATION
+    /* A short-circuit tag goes without a kid */
+    if (!(opt_flags & TOKEN_OPT_SHORT_CIRCUIT_SIGN)) {
+        attest_ret = attest_get_initial_attestation_key_id(&attest_key_id);
+        if (attest_ret != PSA_ATTEST_ERR_SUCCESS) {
+            return ATTEST_TOKEN_ERR_GENERAL;
+        }
+    }
+#else
+    if (opt_flags & TOKEN_OPT_SHORT_CIRCUIT_SIGN) {
+#ifndef T_COSE_DISABLE_SHORT_CIRCUIT_SIGN
+        /* No kid is set, so t_cose uses the short-circuit kid */
+        kid_len = T_COSE_SHORT_CIRCUIT_KID_SIZE;
+#else
+        return ATTEST_TOKEN_ERR_GENERAL;
+#endif
+    } else {
+#ifdef INCLUDE_COSE_KEY_ID
+        attest_ret = attest_get_initial_attestation_key_id(&attest_key_id);
+        if (attest_ret != PSA_ATTEST_ERR_SUCCESS) {
+            return ATTEST_TOKEN_ERR_GENERAL;
+        }
+#endif /* INCLUDE_COSE_KEY_ID */
+    }
+#endif /* SYMMETRIC_INITIAL_ATTESTATION */
+    if (!q_useful_buf_c_is_null_or_empty(attest_key_id)) {
+        kid_len = attest_key_id.len;
+    }
+
+    /* Size of the protected parameters, which only hold the algorithm */
+    QCBOREncode_Init(&cbor_enc_ctx, size_only);
+    QCBOREncode_OpenMap(&cbor_enc_ctx);
+    QCBOREncode_AddInt64ToMapN(&cbor_enc_ctx,
+                               COSE_HEADER_PARAM_ALG,
+                               cose_alg_id);
+    QCBOREncode_CloseMap(&cbor_enc_ctx);
+    qcbor_result = QCBOREncode_FinishGetSize(&cbor_enc_ctx, &protected_len);
+    if (qcbor_result != QCBOR_SUCCESS) {
+        return ATTEST_TOKEN_ERR_CBOR_FORMATTING;
+    }
+
+    /* Encode the structure of the token, only the sizes of the byte strings
+     * matter, their content is not copied.
+     */
+    QCBOREncode_Init(&cbor_enc_ctx, size_only);
+#ifdef SYMMETRIC_INITIAL_ATTESTATION
+    QCBOREncode_AddTag(&cbor_enc_ctx, CBOR_TAG_COSE_MAC0);
+#else
+    QCBOREncode_AddTag(&cbor_enc_ctx, CBOR_TAG_COSE_SIGN1);
+#endif
+    QCBOREncode_OpenArray(&cbor_enc_ctx);
+
+    placeholder.len = protected_len;
+    QCBOREncode_AddBytes(&cbor_enc_ctx, placeholder);
+
+    QCBOREncode_OpenMap(&cbor_enc_ctx);
+    if (kid_len != 0) {
+        placeholder.len = kid_len;
+        QCBOREncode_AddBytesToMapN(&cbor_enc_ctx,
+                                   COSE_HEADER_PARAM_KID,
+                                   placeholder);
+    }
+    QCBOREncode_CloseMap(&cbor_enc_ctx);
+
+    placeholder.len = payload_len;
+    QCBOREncode_AddBytes(&cbor_enc_ctx, placeholder);
+
+    placeholder.len = sig_len;
+    QCBOREncode_AddBytes(&cbor_enc_ctx, placeholder);
+
+    QCBOREncode_CloseArray(&cbor_enc_ctx);
+
+    qcbor_result = QCBOREncode_FinishGetSize(&cbor_enc_ctx, token_len);
+    if (qcbor_result != QCBOR_SUCCESS) {
+        return ATTEST_TOKEN_ERR_CBOR_FORMATTING;
+    }
+
+    return ATTEST_TOKEN_ERR_SUCCESS;
+}
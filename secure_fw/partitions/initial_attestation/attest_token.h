@@ -18,6 +18,9 @@
 #include "t_cose_mac0_sign.h"
 #else
 #include "t_cose_sign1_sign.h"
+#ifdef ATTEST_STREAM_TOKEN
+#include "t_cose_crypto.h"
+#endif
 #endif
 
 #ifdef __cplusplus
@@ -243,6 +246,56 @@ void attest_token_add_encoded(struct attest_token_ctx *me,
                               int32_t label,
                               const struct q_useful_buf_c *encoded);
 
+/**
+ * \brief Add claims that were encoded in advance
+ *
+ * \param[in] me           Token creation context.
+ * \param[in] claims       Array of encoded claims, each of them a single
+ *                         label and value pair.
+ * \param[in] claim_count  Number of claims in \c claims.
+ *
+ * \return one of the \ref attest_token_err_t errors.
+ *
+ * The claims are typically encoded with attest_token_claims_start() and
+ * attest_token_claims_finish(). Every value must be complete, as for
+ * attest_token_add_encoded().
+ */
+enum attest_token_err_t
+attest_token_add_encoded_claims(struct attest_token_ctx *me,
+                                const struct q_useful_buf_c *claims,
+                                uint32_t claim_count);
+
+
+/**
+ * \brief Initialize a context to encode claims without a token
+ *
+ * \param[in] me          The context to be initialized.
+ * \param[out] out_buffer The output buffer to write the encoded claims into.
+ *
+ * The claims added to the context with the \c attest_token_add_XXX()
+ * functions are encoded as a sequence of label and value pairs which
+ * is not part of a map, and it is not signed. A pointer of NULL in
+ * \p out_buffer only calculates the size. Claims encoded one per
+ * context can be added to a token later by
+ * attest_token_add_encoded_claims().
+ */
+void attest_token_claims_start(struct attest_token_ctx *me,
+                               const struct q_useful_buf *out_buffer);
+
+
+/**
+ * \brief Finish encoding claims and get the result
+ *
+ * \param[in] me               Context initialized by
+ *                              attest_token_claims_start().
+ * \param[out] encoded_claims  Pointer and length of the encoded claims.
+ *
+ * \return one of the \ref attest_token_err_t errors.
+ */
+enum attest_token_err_t
+attest_token_claims_finish(struct attest_token_ctx *me,
+                           struct q_useful_buf_c *encoded_claims);
+
 
 /**
  * \brief Finish the token, complete the signing and get the result
@@ -260,6 +313,136 @@ enum attest_token_err_t
 attest_token_finish(struct attest_token_ctx *me,
                     struct q_useful_buf_c *completed_token);
 
+/**
+ * \brief Calculate the size of a token without creating it
+ *
+ * \param[in] opt_flags    Flags to select different custom options,
+ *                         as for attest_token_start().
+ * \param[in] cose_alg_id  The algorithm to sign with, as for
+ *                         attest_token_start().
+ * \param[in] payload_len  Size of the encoded payload, which is the map
+ *                         of the claims.
+ * \param[out] token_len   Size of the token.
+ *
+ * \return one of the \ref attest_token_err_t errors.
+ *
+ * The result is the size that attest_token_finish() returns for a
+ * token with the same payload and option flags, including the kid
+ * that goes into the token with or without short-circuit signing.
+ * The size is calculated from the COSE structure: no key is needed
+ * and nothing is signed.
+ */
+enum attest_token_err_t
+attest_token_size(uint32_t opt_flags,
+                  int32_t cose_alg_id,
+                  size_t payload_len,
+                  size_t *token_len);
+
+#if defined(ATTEST_STREAM_TOKEN) && !defined(SYMMETRIC_INITIAL_ATTESTATION)
+/**
+ * Size of the buffer of a streamed token to encode the COSE header and
+ * the signature into. It must hold the protected and unprotected
+ * parameters with the key ID, and the signature of the largest
+ * supported algorithm.
+ */
+#define ATTEST_TOKEN_STREAM_WORK_SIZE 128
+
+
+/**
+ * \brief Output function of a streamed token.
+ *
+ * \param[in] sink_ctx  The context passed to attest_token_stream_start().
+ * \param[in] data      The next bytes of the token.
+ *
+ * \return one of the \ref attest_token_err_t errors.
+ */
+typedef enum attest_token_err_t
+(*attest_token_sink_t)(void *sink_ctx, const struct q_useful_buf_c *data);
+
+
+/**
+ * The context for creating a streamed attestation token. The token is
+ * never held in a single buffer: the bytes are passed to the sink
+ * function as they are produced.
+ *
+ * The structure is opaque for the caller.
+ */
+struct attest_token_stream_ctx {
+    /* Private data structure */
+    struct t_cose_sign1_sign_ctx signer_ctx;
+    struct t_cose_crypto_hash    hash_ctx;
+    attest_token_sink_t          sink;
+    void                        *sink_ctx;
+    size_t                       payload_left;
+    uint8_t                      work_buf[ATTEST_TOKEN_STREAM_WORK_SIZE];
+};
+
+
+/**
+ * \brief Start a streamed token and output its COSE header.
+ *
+ * \param[in] me             The token creation context to be initialized.
+ * \param[in] opt_flags      Flags to select different custom options,
+ *                           as for attest_token_start().
+ * \param[in] key_select     Selects which attestation key to sign with.
+ * \param[in] cose_alg_id    The algorithm to sign with.
+ * \param[in] payload_len    Size of the encoded payload, which is the
+ *                           map of the claims.
+ * \param[in] max_token_len  Maximum size of the token.
+ * \param[in] sink           Function to output the token with.
+ * \param[in] sink_ctx       Context passed to \c sink.
+ * \param[out] token_len     Size of the token.
+ *
+ * \return one of the \ref attest_token_err_t errors.
+ *
+ * The size of the payload has to be known in advance, as it is encoded
+ * before the payload. If the token is larger than \c max_token_len
+ * then \ref ATTEST_TOKEN_ERR_TOO_SMALL is returned before anything is
+ * output. The payload is then output with attest_token_stream_payload()
+ * and the token is completed by attest_token_stream_finish().
+ */
+enum attest_token_err_t
+attest_token_stream_start(struct attest_token_stream_ctx *me,
+                          uint32_t opt_flags,
+                          int32_t key_select,
+                          int32_t cose_alg_id,
+                          size_t payload_len,
+                          size_t max_token_len,
+                          attest_token_sink_t sink,
+                          void *sink_ctx,
+                          size_t *token_len);
+
+
+/**
+ * \brief Output the next chunk of the payload of a streamed token
+ *
+ * \param[in] me     Token creation context.
+ * \param[in] chunk  The next bytes of the encoded payload.
+ *
+ * \return one of the \ref attest_token_err_t errors.
+ *
+ * The chunk is hashed and passed to the sink. It can be released as
+ * soon as this returns.
+ */
+enum attest_token_err_t
+attest_token_stream_payload(struct attest_token_stream_ctx *me,
+                            const struct q_useful_buf_c *chunk);
+
+
+/**
+ * \brief Sign a streamed token and output the signature
+ *
+ * \param[in] me  Token creation context.
+ *
+ * \return one of the \ref attest_token_err_t errors.
+ *
+ * All of the \c payload_len bytes must have been output by
+ * attest_token_stream_payload() before this is called.
+ */
+enum attest_token_err_t
+attest_token_stream_finish(struct attest_token_stream_ctx *me);
+#endif /* ATTEST_STREAM_TOKEN && !SYMMETRIC_INITIAL_ATTESTATION */
+
 #ifdef __cplusplus
 }
 #endif
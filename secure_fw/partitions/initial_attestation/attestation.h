@@ -11,6 +11,9 @@
 #include "psa/initial_attestation.h"
 #include "tfm_client.h"
 #include "tfm_boot_status.h"
+#ifdef ATTEST_STREAM_TOKEN
+#include "attest_token.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -109,6 +112,50 @@ psa_status_t
 initial_attest_get_token_size(const psa_invec  *in_vec,  uint32_t num_invec,
                                     psa_outvec *out_vec, uint32_t num_outvec);
 
+/**
+ * \brief Get initial attestation token for a batch of challenges
+ *
+ * \param[in]     in_vec     Pointer to in_vec array, which contains input data
+ *                           to attestation service
+ * \param[in]     num_invec  Number of elements in in_vec array
+ * \param[in,out] out_vec    Pointer out_vec array, which contains output data
+ *                           to attestation service
+ * \param[in]     num_outvec Number of elements in out_vec array
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t
+initial_attest_get_batch_token(const psa_invec  *in_vec,  uint32_t num_invec,
+                                     psa_outvec *out_vec, uint32_t num_outvec);
+
+#ifdef ATTEST_STREAM_TOKEN
+/**
+ * \brief Get initial attestation token, output in chunks
+ *
+ * \param[in]  in_vec          Pointer to in_vec array, which contains input
+ *                             data to attestation service
+ * \param[in]  num_invec       Number of elements in in_vec array
+ * \param[in]  token_buf_size  Size of the buffer of the caller to receive the
+ *                             token
+ * \param[in]  sink            Function to output the token with, it is
+ *                             called with consecutive parts of the token
+ * \param[in]  sink_ctx        Context passed to \p sink
+ * \param[out] token_size      Size of the token
+ *
+ * The token is the same as the one returned by initial_attest_get_token(),
+ * but it is never held in a single buffer of the service. Nothing is output
+ * if the token is larger than \p token_buf_size.
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+psa_status_t
+initial_attest_stream_token(const psa_invec     *in_vec, uint32_t num_invec,
+                            size_t               token_buf_size,
+                            attest_token_sink_t  sink,
+                            void                *sink_ctx,
+                            size_t              *token_size);
+#endif /* ATTEST_STREAM_TOKEN */
+
 /**
  * \brief Get the initial attestation public key.
  *
@@ -17,13 +17,19 @@
 #include "tfm_plat_boot_seed.h"
 #include "tfm_attest_hal.h"
 #include "attest_token.h"
+#include "attest_batch.h"
 #include "attest_eat_defines.h"
 #include "t_cose_common.h"
 #include "tfm_memory_utils.h"
 #include "tfm_plat_crypto_keys.h"
+#include "qcbor_fast_encode.h"
 
 #define MAX_BOOT_STATUS 512
 
+#if defined(ATTEST_STREAM_TOKEN) && !defined(ATTEST_STATIC_CLAIMS_CACHE)
+#error "ATTEST_STREAM_TOKEN requires ATTEST_STATIC_CLAIMS_CACHE"
+#endif
+
 /* Indicates how to encode SW components' measurements in the CBOR map */
 #define EAT_SW_COMPONENT_NESTED     1  /* Nested map */
 #define EAT_SW_COMPONENT_NOT_NESTED 0  /* Flat structure */
@@ -96,6 +102,27 @@ error_mapping_to_psa_status_t(enum psa_attest_err_t attest_err)
     }
 }
 
+#ifdef ATTEST_RESIDENT_KEY
+/*!
+ * \brief Static function to make sure that the initial attestation key is
+ *        registered to the Crypto service. The key is registered only once
+ *        and it is kept until the next reset, together with the Instance ID
+ *        and the key ID derived from it.
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t attest_load_resident_key(void)
+{
+    psa_key_handle_t key_handle;
+
+    if (attest_get_signing_key_handle(&key_handle) == PSA_ATTEST_ERR_SUCCESS) {
+        return PSA_ATTEST_ERR_SUCCESS;
+    }
+
+    return attest_register_initial_attestation_key();
+}
+#endif /* ATTEST_RESIDENT_KEY */
+
 psa_status_t attest_init(void)
 {
     enum psa_attest_err_t res;
@@ -104,6 +131,15 @@ psa_status_t attest_init(void)
                                (struct tfm_boot_data *)&boot_data,
                                MAX_BOOT_STATUS);
 
+#ifdef ATTEST_RESIDENT_KEY
+    if (res == PSA_ATTEST_ERR_SUCCESS) {
+        /* A failure is not fatal here, the registration is retried when the
+         * first token is requested.
+         */
+        (void)attest_load_resident_key();
+    }
+#endif
+
     return error_mapping_to_psa_status_t(res);
 }
 
@@ -658,6 +694,252 @@ attest_add_hw_version_claim(struct attest_token_ctx *token_ctx)
 }
 #endif /* INCLUDE_OPTIONAL_CLAIMS */
 
+#ifdef ATTEST_STATIC_CLAIMS_CACHE
+/* Size of the buffer to store the encoded static claims. It has to hold the
+ * SW components copied from the boot status and the rest of the claims.
+ */
+#define ATTEST_STATIC_CLAIMS_SIZE   (MAX_BOOT_STATUS + 256)
+
+typedef enum psa_attest_err_t
+(*attest_claim_func_t)(struct attest_token_ctx *token_ctx);
+
+/* Each of these functions adds at most one claim */
+static const attest_claim_func_t static_claim_funcs[] = {
+    attest_add_boot_seed_claim,
+    attest_add_instance_id_claim,
+    attest_add_implementation_id_claim,
+    attest_add_security_lifecycle_claim,
+    attest_add_all_sw_components,
+#ifdef INCLUDE_OPTIONAL_CLAIMS
+    attest_add_verification_service,
+    attest_add_profile_definition,
+    attest_add_hw_version_claim,
+#endif
+};
+
+#define ATTEST_STATIC_CLAIM_FUNCS_NUM \
+    (sizeof(static_claim_funcs) / sizeof(static_claim_funcs[0]))
+
+/*!
+ * \struct attest_static_claims
+ *
+ * \brief Claims which are the same in every token until the next reset.
+ *
+ * \details They are encoded once, when the first token is created, and the
+ *          encoded claims are copied to every subsequent token. If they do
+ *          not fit in the buffer then every token encodes them instead.
+ */
+struct attest_static_claims {
+    uint32_t valid;                 /* The claims are encoded */
+    uint32_t too_large;             /* The claims do not fit in buf */
+    uint32_t count;                 /* Number of claims in encoded */
+    struct q_useful_buf_c encoded;  /* Label and value pairs */
+    struct q_useful_buf_c claims[ATTEST_STATIC_CLAIM_FUNCS_NUM];
+    uint8_t buf[ATTEST_STATIC_CLAIMS_SIZE];
+};
+
+static struct attest_static_claims static_claims;
+
+/*!
+ * \brief Static function to encode one static claim, or calculate its size.
+ *
+ * \param[in]  claim_func  Function adding the claim
+ * \param[in]  buf         Buffer to encode to, its pointer can be NULL to
+ *                         calculate the size only
+ * \param[out] encoded     Encoded claim, empty if the claim is not present
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_encode_static_claim(attest_claim_func_t claim_func,
+                           const struct q_useful_buf *buf,
+                           struct q_useful_buf_c *encoded)
+{
+    enum psa_attest_err_t attest_err;
+    struct attest_token_ctx claims_ctx;
+
+    attest_token_claims_start(&claims_ctx, buf);
+
+    attest_err = claim_func(&claims_ctx);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        return attest_err;
+    }
+
+    if (attest_token_claims_finish(&claims_ctx, encoded) !=
+        ATTEST_TOKEN_ERR_SUCCESS) {
+        return PSA_ATTEST_ERR_GENERAL;
+    }
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
+/*!
+ * \brief Static function to encode the static claims to \ref static_claims.
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t. If the
+ *         claims do not fit in the cache then
+ *         \ref PSA_ATTEST_ERR_BUFFER_OVERFLOW is returned, and the cache is
+ *         not tried again.
+ */
+static enum psa_attest_err_t attest_encode_static_claims(void)
+{
+    enum psa_attest_err_t attest_err;
+    struct q_useful_buf size_only = {NULL, INT32_MAX};
+    struct q_useful_buf buf;
+    struct q_useful_buf_c encoded;
+    size_t used = 0;
+    uint32_t count = 0;
+    uint32_t i;
+
+    if (static_claims.too_large) {
+        return PSA_ATTEST_ERR_BUFFER_OVERFLOW;
+    }
+
+    /* The size is checked first, so that the claims are only encoded to the
+     * cache if all of them fit.
+     */
+    for (i = 0; i < ATTEST_STATIC_CLAIM_FUNCS_NUM; i++) {
+        attest_err = attest_encode_static_claim(static_claim_funcs[i],
+                                                &size_only, &encoded);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+        used += encoded.len;
+    }
+
+    if (used > sizeof(static_claims.buf)) {
+        static_claims.too_large = 1;
+        return PSA_ATTEST_ERR_BUFFER_OVERFLOW;
+    }
+
+    /* Claims are encoded one by one to know how many of them are present */
+    used = 0;
+    for (i = 0; i < ATTEST_STATIC_CLAIM_FUNCS_NUM; i++) {
+        buf.ptr = &static_claims.buf[used];
+        buf.len = sizeof(static_claims.buf) - used;
+        attest_err = attest_encode_static_claim(static_claim_funcs[i],
+                                                &buf, &encoded);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+
+        if (encoded.len != 0) {
+            static_claims.claims[count] = encoded;
+            used += encoded.len;
+            count++;
+        }
+    }
+
+    static_claims.encoded.ptr = static_claims.buf;
+    static_claims.encoded.len = used;
+    static_claims.count = count;
+    static_claims.valid = 1;
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
+/*!
+ * \brief Static function to add the static claims to the attestation token.
+ *        They are encoded at the first call.
+ *
+ * \param[in]  token_ctx  Token encoding context
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_add_static_claims(struct attest_token_ctx *token_ctx)
+{
+    enum psa_attest_err_t attest_err;
+    uint32_t i;
+
+    if (!static_claims.valid) {
+        attest_err = attest_encode_static_claims();
+        if (attest_err == PSA_ATTEST_ERR_BUFFER_OVERFLOW) {
+            /* Not cached, the claims are encoded to the token instead */
+            for (i = 0; i < ATTEST_STATIC_CLAIM_FUNCS_NUM; i++) {
+                attest_err = static_claim_funcs[i](token_ctx);
+                if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+                    return attest_err;
+                }
+            }
+            return PSA_ATTEST_ERR_SUCCESS;
+        } else if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+    }
+
+    if (attest_token_add_encoded_claims(token_ctx,
+                                        static_claims.claims,
+                                        static_claims.count) !=
+        ATTEST_TOKEN_ERR_SUCCESS) {
+        return PSA_ATTEST_ERR_GENERAL;
+    }
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
+/* Shape of the claims which are different in each token. The challenge is
+ * always the first claim of the map.
+ */
+static const qcbor_fast_field_t dynamic_claims_shape[] = {
+    QCBOR_FAST_FIELD(EAT_CBOR_ARM_LABEL_CHALLENGE, QCBOR_FAST_TYPE_BYTES),
+    QCBOR_FAST_FIELD(EAT_CBOR_ARM_LABEL_CLIENT_ID, QCBOR_FAST_TYPE_INT64),
+};
+
+/*!
+ * \brief Static function to encode the head of the claims map and the claims
+ *        which are different in each token: the challenge and, unless the
+ *        claims are omitted, the caller ID. The head of the map counts the
+ *        static claims too, which have to follow the encoded part.
+ *
+ * \details These claims have a fixed shape, so they are encoded with the
+ *          fast path of \ref qcbor_fast_encode_map() instead of a QCBOR
+ *          encoding context.
+ *
+ * \param[in]  challenge    Challenge object, its pointer can be NULL to
+ *                          calculate the size only
+ * \param[in]  omit_claims  Only the challenge claim is encoded
+ * \param[in]  buf          Buffer to encode to, its pointer can be NULL to
+ *                          calculate the size only
+ * \param[out] encoded      Encoded head and claims
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_encode_dynamic_claims(const struct q_useful_buf_c *challenge,
+                             uint32_t omit_claims,
+                             struct q_useful_buf buf,
+                             struct q_useful_buf_c *encoded)
+{
+    qcbor_fast_value_t values[2];
+    enum psa_attest_err_t attest_err;
+    int32_t caller_id;
+    size_t num_claims = 1;
+    size_t static_count = 0;
+
+    values[0].bytes = *challenge;
+
+    if (!omit_claims) {
+        attest_err = attest_get_caller_client_id(&caller_id);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            return attest_err;
+        }
+        values[1].int64 = (int64_t)caller_id;
+        num_claims = 2;
+        static_count = static_claims.count;
+    }
+
+    *encoded = qcbor_fast_encode_map(buf, dynamic_claims_shape, values,
+                                     num_claims, static_count);
+    if (encoded->len == 0) {
+        return PSA_ATTEST_ERR_GENERAL;
+    }
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+
+#endif /* ATTEST_STATIC_CLAIMS_CACHE */
+
 /*!
  * \brief Static function to verify the input challenge size
  *
@@ -735,6 +1017,71 @@ static void attest_get_option_flags(struct q_useful_buf_c *challenge,
 }
 #endif /* INCLUDE_TEST_CODE */
 
+#ifdef ATTEST_STATIC_CLAIMS_CACHE
+/*!
+ * \brief Static function to calculate the size of the token without creating
+ *        it, from the size of the claims that are different in each token
+ *        and the size of the encoded static claims.
+ *
+ * \param[in]  challenge   Structure to carry the challenge value:
+ *                         pointer + challeng's length. Only the length is
+ *                         needed, unless the challenge selects test options.
+ * \param[out] token_size  Size of the token
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t. If the
+ *         static claims have not been encoded yet then
+ *         \ref PSA_ATTEST_ERR_CLAIM_UNAVAILABLE is returned.
+ */
+static enum psa_attest_err_t
+attest_calc_token_size(struct q_useful_buf_c *challenge, uint32_t *token_size)
+{
+    struct q_useful_buf size_only = {NULL, INT32_MAX};
+    struct q_useful_buf_c size_only_challenge = {NULL, challenge->len};
+    struct q_useful_buf_c dynamic_part;
+    enum psa_attest_err_t attest_err;
+    enum attest_token_err_t token_err;
+    size_t static_len = 0;
+    size_t size;
+    int32_t key_select = 0;
+    uint32_t option_flags = 0;
+
+#ifdef INCLUDE_TEST_CODE /* Remove them from release build */
+    attest_get_option_flags(challenge, &option_flags, &key_select);
+#endif
+    (void)key_select;
+
+    /* The same claims as attest_create_token() adds */
+    if (!(option_flags & TOKEN_OPT_OMIT_CLAIMS)) {
+        if (!static_claims.valid) {
+            return PSA_ATTEST_ERR_CLAIM_UNAVAILABLE;
+        }
+        static_len = static_claims.encoded.len;
+    }
+
+    /* Only the size of the payload is calculated, nothing is copied */
+    attest_err = attest_encode_dynamic_claims(&size_only_challenge,
+                                              option_flags &
+                                              TOKEN_OPT_OMIT_CLAIMS,
+                                              size_only,
+                                              &dynamic_part);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        return attest_err;
+    }
+
+    token_err = attest_token_size(option_flags,
+                                  T_COSE_ALGORITHM,
+                                  dynamic_part.len + static_len,
+                                  &size);
+    if (token_err != ATTEST_TOKEN_ERR_SUCCESS) {
+        return PSA_ATTEST_ERR_GENERAL;
+    }
+
+    *token_size = (uint32_t)size;
+
+    return PSA_ATTEST_ERR_SUCCESS;
+}
+#endif /* ATTEST_STATIC_CLAIMS_CACHE */
+
 /*!
  * \brief Static function to create the initial attestation token
  *
@@ -758,7 +1105,11 @@ attest_create_token(struct q_useful_buf_c *challenge,
     int32_t key_select = 0;
     uint32_t option_flags = 0;
 
+#ifdef ATTEST_RESIDENT_KEY
+    attest_err = attest_load_resident_key();
+#else
     attest_err = attest_register_initial_attestation_key();
+#endif
     if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
         goto error;
     }
@@ -788,6 +1139,18 @@ attest_create_token(struct q_useful_buf_c *challenge,
     }
 
     if (!(option_flags & TOKEN_OPT_OMIT_CLAIMS)) {
+#ifdef ATTEST_STATIC_CLAIMS_CACHE
+        /* Claims which do not change between tokens, encoded only once */
+        attest_err = attest_add_static_claims(&attest_token_ctx);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            goto error;
+        }
+
+        attest_err = attest_add_caller_id_claim(&attest_token_ctx);
+        if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+            goto error;
+        }
+#else /* ATTEST_STATIC_CLAIMS_CACHE */
         /* Mandatory claims in IAT token */
         attest_err = attest_add_boot_seed_claim(&attest_token_ctx);
         if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
@@ -836,6 +1199,7 @@ attest_create_token(struct q_useful_buf_c *challenge,
             goto error;
         }
 #endif /* INCLUDE_OPTIONAL_CLAIMS */
+#endif /* ATTEST_STATIC_CLAIMS_CACHE */
     }
 
     /* Finish up creating the token. This is where the actual signature
@@ -848,6 +1212,127 @@ attest_create_token(struct q_useful_buf_c *challenge,
     }
 
 error:
+#ifndef ATTEST_RESIDENT_KEY
+    if (attest_err == PSA_ATTEST_ERR_SUCCESS) {
+        /* We got here normally and therefore care about error codes. */
+        attest_err = attest_unregister_initial_attestation_key();
+    }
+    else {
+        /* Error handler: just remove they key and preserve error. */
+        (void)attest_unregister_initial_attestation_key();
+    }
+#endif /* !ATTEST_RESIDENT_KEY */
+    return attest_err;
+}
+
+#ifdef ATTEST_STREAM_TOKEN
+/* Size of the buffer to encode the claims which are different in each token
+ * into: the head of the map, the challenge and the caller ID.
+ */
+#define ATTEST_STREAM_PREFIX_SIZE (PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64 + 32)
+
+/*!
+ * \brief Static function to create the initial attestation token and output
+ *        it in chunks, without a buffer for the whole token
+ *
+ * The payload is output in two parts: the claims which are different in each
+ * token, encoded to a small buffer on the stack, then the encoded static
+ * claims straight from \ref static_claims.
+ *
+ * \param[in]  challenge       Structure to carry the challenge value:
+ *                             pointer + challeng's length
+ * \param[in]  token_buf_size  Maximum size of the token
+ * \param[in]  sink            Function to output the token with
+ * \param[in]  sink_ctx        Context passed to \p sink
+ * \param[out] token_size      Size of the token
+ *
+ * \return Returns error code as specified in \ref psa_attest_err_t
+ */
+static enum psa_attest_err_t
+attest_stream_token(struct q_useful_buf_c *challenge,
+                    size_t                 token_buf_size,
+                    attest_token_sink_t    sink,
+                    void                  *sink_ctx,
+                    size_t                *token_size)
+{
+    enum psa_attest_err_t attest_err = PSA_ATTEST_ERR_SUCCESS;
+    enum attest_token_err_t token_err;
+    struct attest_token_stream_ctx stream_ctx;
+    uint8_t prefix_buf[ATTEST_STREAM_PREFIX_SIZE];
+    struct q_useful_buf buf = {prefix_buf, sizeof(prefix_buf)};
+    struct q_useful_buf_c prefix;
+    struct q_useful_buf_c static_part = NULL_Q_USEFUL_BUF_C;
+    int32_t key_select = 0;
+    uint32_t option_flags = 0;
+
+#ifdef ATTEST_RESIDENT_KEY
+    attest_err = attest_load_resident_key();
+#else
+    attest_err = attest_register_initial_attestation_key();
+#endif
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
+#ifdef INCLUDE_TEST_CODE /* Remove them from release build */
+    attest_get_option_flags(challenge, &option_flags, &key_select);
+#endif
+
+    if (!(option_flags & TOKEN_OPT_OMIT_CLAIMS)) {
+        if (!static_claims.valid) {
+            attest_err = attest_encode_static_claims();
+            if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+                goto error;
+            }
+        }
+        static_part = static_claims.encoded;
+    }
+
+    /* The static claims are only counted in the head of the map here, they
+     * are output from the cache after this part.
+     */
+    attest_err = attest_encode_dynamic_claims(challenge,
+                                              option_flags &
+                                              TOKEN_OPT_OMIT_CLAIMS,
+                                              buf,
+                                              &prefix);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
+    /* This outputs the COSE headers, if the whole token fits */
+    token_err = attest_token_stream_start(&stream_ctx,
+                                          option_flags,
+                                          key_select,
+                                          T_COSE_ALGORITHM,
+                                          prefix.len + static_part.len,
+                                          token_buf_size,
+                                          sink,
+                                          sink_ctx,
+                                          token_size);
+    if (token_err != ATTEST_TOKEN_ERR_SUCCESS) {
+        attest_err = error_mapping_to_psa_attest_err_t(token_err);
+        goto error;
+    }
+
+    token_err = attest_token_stream_payload(&stream_ctx, &prefix);
+    if (token_err == ATTEST_TOKEN_ERR_SUCCESS && static_part.len != 0) {
+        token_err = attest_token_stream_payload(&stream_ctx, &static_part);
+    }
+    if (token_err != ATTEST_TOKEN_ERR_SUCCESS) {
+        attest_err = error_mapping_to_psa_attest_err_t(token_err);
+        goto error;
+    }
+
+    /* This is where the signature is generated and output */
+    token_err = attest_token_stream_finish(&stream_ctx);
+    if (token_err != ATTEST_TOKEN_ERR_SUCCESS) {
+        attest_err = error_mapping_to_psa_attest_err_t(token_err);
+        goto error;
+    }
+
+error:
+#ifndef ATTEST_RESIDENT_KEY
     if (attest_err == PSA_ATTEST_ERR_SUCCESS) {
         /* We got here normally and therefore care about error codes. */
         attest_err = attest_unregister_initial_attestation_key();
@@ -856,8 +1341,10 @@ error:
         /* Error handler: just remove they key and preserve error. */
         (void)attest_unregister_initial_attestation_key();
     }
+#endif /* !ATTEST_RESIDENT_KEY */
     return attest_err;
 }
+#endif /* ATTEST_STREAM_TOKEN */
 
 psa_status_t
 initial_attest_get_token(const psa_invec  *in_vec,  uint32_t num_invec,
@@ -924,6 +1411,16 @@ initial_attest_get_token_size(const psa_invec  *in_vec,  uint32_t num_invec,
         goto error;
     }
 
+#ifdef ATTEST_STATIC_CLAIMS_CACHE
+    /* Once the static claims are encoded the size can be calculated without
+     * registering the key and creating the token.
+     */
+    if (attest_calc_token_size(&challenge,
+                               token_buf_size) == PSA_ATTEST_ERR_SUCCESS) {
+        return PSA_SUCCESS;
+    }
+#endif
+
     attest_err = attest_create_token(&challenge, &token, &completed_token);
     if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
         goto error;
@@ -935,6 +1432,100 @@ error:
     return error_mapping_to_psa_status_t(attest_err);
 }
 
+psa_status_t
+initial_attest_get_batch_token(const psa_invec  *in_vec,  uint32_t num_invec,
+                                     psa_outvec *out_vec, uint32_t num_outvec)
+{
+    enum psa_attest_err_t attest_err = PSA_ATTEST_ERR_SUCCESS;
+    uint8_t root[ATTEST_BATCH_ROOT_SIZE];
+    size_t challenge_size;
+    size_t challenge_count;
+    struct q_useful_buf_c challenge;
+    struct q_useful_buf token;
+    struct q_useful_buf_c completed_token;
+
+    if (num_invec != 2 || num_outvec != 1 ||
+        in_vec[1].len != sizeof(challenge_size)) {
+        attest_err = PSA_ATTEST_ERR_INVALID_INPUT;
+        goto error;
+    }
+
+    challenge_size = *(const size_t *)in_vec[1].base;
+    token.ptr = out_vec[0].base;
+    token.len = out_vec[0].len;
+
+    attest_err = attest_verify_challenge_size(challenge_size);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
+    /* All of the challenges have the same size */
+    challenge_count = in_vec[0].len / challenge_size;
+    if ((in_vec[0].len % challenge_size) != 0 || challenge_count == 0 ||
+        challenge_count > TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES) {
+        attest_err = PSA_ATTEST_ERR_INVALID_INPUT;
+        goto error;
+    }
+
+    if (token.len == 0) {
+        attest_err = PSA_ATTEST_ERR_INVALID_INPUT;
+        goto error;
+    }
+
+    attest_err = attest_batch_merkle_root(in_vec[0].base, challenge_size,
+                                          challenge_count, root);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
+    /* The root is signed in place of a single challenge */
+    challenge.ptr = root;
+    challenge.len = sizeof(root);
+
+    attest_err = attest_create_token(&challenge, &token, &completed_token);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
+    out_vec[0].base = (void *)completed_token.ptr;
+    out_vec[0].len  = completed_token.len;
+
+error:
+    return error_mapping_to_psa_status_t(attest_err);
+}
+
+#ifdef ATTEST_STREAM_TOKEN
+psa_status_t
+initial_attest_stream_token(const psa_invec     *in_vec, uint32_t num_invec,
+                            size_t               token_buf_size,
+                            attest_token_sink_t  sink,
+                            void                *sink_ctx,
+                            size_t              *token_size)
+{
+    enum psa_attest_err_t attest_err = PSA_ATTEST_ERR_SUCCESS;
+    struct q_useful_buf_c challenge;
+
+    challenge.ptr = in_vec[0].base;
+    challenge.len = in_vec[0].len;
+
+    attest_err = attest_verify_challenge_size(challenge.len);
+    if (attest_err != PSA_ATTEST_ERR_SUCCESS) {
+        goto error;
+    }
+
+    if (token_buf_size == 0) {
+        attest_err = PSA_ATTEST_ERR_INVALID_INPUT;
+        goto error;
+    }
+
+    attest_err = attest_stream_token(&challenge, token_buf_size,
+                                     sink, sink_ctx, token_size);
+
+error:
+    return error_mapping_to_psa_status_t(attest_err);
+}
+#endif /* ATTEST_STREAM_TOKEN */
+
 #ifdef SYMMETRIC_INITIAL_ATTESTATION
 psa_status_t
 initial_attest_get_public_key(const psa_invec  *in_vec,  uint32_t num_invec,
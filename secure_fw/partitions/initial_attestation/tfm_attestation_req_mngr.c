@@ -23,6 +23,52 @@ typedef psa_status_t (*attest_func_t)(const psa_msg_t *msg);
 
 int32_t g_attest_caller_id;
 
+#ifdef ATTEST_STREAM_TOKEN
+/* Output function of the streamed token, the data is appended to the outvec
+ * of the client.
+ */
+static enum attest_token_err_t
+attest_token_write(void *sink_ctx, const struct q_useful_buf_c *data)
+{
+    const psa_msg_t *msg = (const psa_msg_t *)sink_ctx;
+
+    psa_write(msg->handle, 0, data->ptr, data->len);
+
+    return ATTEST_TOKEN_ERR_SUCCESS;
+}
+
+static psa_status_t psa_attest_get_token(const psa_msg_t *msg)
+{
+    uint8_t challenge_buff[PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
+    uint32_t bytes_read = 0;
+    size_t challenge_size = msg->in_size[0];
+    size_t token_size;
+    psa_invec in_vec[] = {
+        {challenge_buff, challenge_size}
+    };
+
+    if (challenge_size > PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* store the client ID here for later use in service */
+    g_attest_caller_id = msg->client_id;
+
+    bytes_read = psa_read(msg->handle, 0,
+                          challenge_buff, challenge_size);
+    if (bytes_read != challenge_size) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    /* The token is written to the outvec in chunks as it is created, there
+     * is no buffer for the whole token in the service.
+     */
+    return initial_attest_stream_token(in_vec, IOVEC_LEN(in_vec),
+                                       msg->out_size[0],
+                                       attest_token_write, (void *)msg,
+                                       &token_size);
+}
+#else /* ATTEST_STREAM_TOKEN */
 static psa_status_t psa_attest_get_token(const psa_msg_t *msg)
 {
     psa_status_t status = PSA_SUCCESS;
@@ -62,6 +108,7 @@ static psa_status_t psa_attest_get_token(const psa_msg_t *msg)
 
     return status;
 }
+#endif /* ATTEST_STREAM_TOKEN */
 
 static psa_status_t psa_attest_get_token_size(const psa_msg_t *msg)
 {
@@ -99,6 +146,57 @@ static psa_status_t psa_attest_get_token_size(const psa_msg_t *msg)
     return status;
 }
 
+static psa_status_t psa_attest_get_batch_token(const psa_msg_t *msg)
+{
+    static uint8_t challenges_buff[TFM_INITIAL_ATTEST_BATCH_MAX_CHALLENGES *
+                                   PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
+    psa_status_t status = PSA_SUCCESS;
+    uint8_t token_buff[PSA_INITIAL_ATTEST_TOKEN_MAX_SIZE];
+    uint32_t bytes_read = 0;
+    size_t challenges_size = msg->in_size[0];
+    size_t challenge_size;
+    size_t token_size = msg->out_size[0];
+    psa_invec in_vec[] = {
+        {challenges_buff, challenges_size},
+        {&challenge_size, sizeof(challenge_size)}
+    };
+    psa_outvec out_vec[] = {
+        {token_buff, token_size}
+    };
+
+    if (challenges_size > sizeof(challenges_buff) ||
+        msg->in_size[1] != sizeof(challenge_size)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* store the client ID here for later use in service */
+    g_attest_caller_id = msg->client_id;
+
+    bytes_read = psa_read(msg->handle, 0,
+                          challenges_buff, challenges_size);
+    if (bytes_read != challenges_size) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    bytes_read = psa_read(msg->handle, 1,
+                          &challenge_size, sizeof(challenge_size));
+    if (bytes_read != sizeof(challenge_size)) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    token_size = (token_size < PSA_INITIAL_ATTEST_TOKEN_MAX_SIZE) ?
+                  token_size : PSA_INITIAL_ATTEST_TOKEN_MAX_SIZE;
+    out_vec[0].len = token_size;
+
+    status = initial_attest_get_batch_token(in_vec, IOVEC_LEN(in_vec),
+                                            out_vec, IOVEC_LEN(out_vec));
+    if (status == PSA_SUCCESS) {
+        psa_write(msg->handle, 0, out_vec[0].base, out_vec[0].len);
+    }
+
+    return status;
+}
+
 static psa_status_t tfm_attest_get_public_key(const psa_msg_t *msg)
 {
     psa_status_t status = PSA_SUCCESS;
@@ -187,6 +285,9 @@ psa_status_t attest_partition_init(void)
         } else if (signals & TFM_ATTEST_GET_TOKEN_SIZE_SIGNAL) {
             attest_signal_handle(TFM_ATTEST_GET_TOKEN_SIZE_SIGNAL,
                                  psa_attest_get_token_size);
+        } else if (signals & TFM_ATTEST_GET_BATCH_TOKEN_SIGNAL) {
+            attest_signal_handle(TFM_ATTEST_GET_BATCH_TOKEN_SIGNAL,
+                                 psa_attest_get_batch_token);
         } else if (signals & TFM_ATTEST_GET_PUBLIC_KEY_SIGNAL) {
             attest_signal_handle(TFM_ATTEST_GET_PUBLIC_KEY_SIGNAL,
                                  tfm_attest_get_public_key);
@@ -90,6 +90,49 @@ psa_initial_attest_get_token_size(size_t challenge_size,
     return status;
 }
 
+__attribute__((section("SFN")))
+psa_status_t
+tfm_initial_attest_get_batch_token(const uint8_t *challenges,
+                                   size_t         challenge_size,
+                                   size_t         challenge_count,
+                                   uint8_t       *token_buf,
+                                   size_t         token_buf_size,
+                                   size_t        *token_size)
+{
+    psa_status_t status;
+    psa_invec in_vec[] = {
+        {challenges, challenge_size * challenge_count},
+        {&challenge_size, sizeof(challenge_size)}
+    };
+    psa_outvec out_vec[] = {
+        {token_buf, token_buf_size}
+    };
+
+#ifdef TFM_PSA_API
+    psa_handle_t handle = PSA_NULL_HANDLE;
+    handle = psa_connect(TFM_ATTEST_GET_BATCH_TOKEN_SID,
+                         TFM_ATTEST_GET_BATCH_TOKEN_VERSION);
+    if (!PSA_HANDLE_IS_VALID(handle)) {
+        return PSA_HANDLE_TO_ERROR(handle);
+    }
+
+    status = psa_call(handle, PSA_IPC_CALL,
+                      in_vec, IOVEC_LEN(in_vec),
+                      out_vec, IOVEC_LEN(out_vec));
+    psa_close(handle);
+#else
+    status = tfm_initial_attest_get_batch_token_veneer(in_vec,
+                                                       IOVEC_LEN(in_vec),
+                                                       out_vec,
+                                                       IOVEC_LEN(out_vec));
+#endif
+    if (status == PSA_SUCCESS) {
+        *token_size = out_vec[0].len;
+    }
+
+    return status;
+}
+
 __attribute__((section("SFN")))
 psa_status_t
 tfm_initial_attest_get_public_key(uint8_t         *public_key,
@@ -367,9 +367,12 @@ psa_status_t its_flash_fs_file_delete(struct its_flash_fs_ctx_t *fs_ctx,
         if ((file_meta.lblock == del_file_lblock) &&
             (its_utils_validate_fid(file_meta.id) == PSA_SUCCESS)) {
             /* If a file is located after the data to delete, this
-             * needs to be moved.
+             * needs to be moved. When the deleted file is empty, the file
+             * created after it starts at the same index.
              */
-            if (file_meta.data_idx > del_file_data_idx) {
+            if ((file_meta.data_idx > del_file_data_idx) ||
+                ((file_meta.data_idx == del_file_data_idx) &&
+                 (del_file_max_size == 0))) {
                 /* Check if this is the position after the deleted
                  * data. This will be the first file data to move.
                  */
@@ -14,6 +14,9 @@
 #include "tfm_its_defs.h"
 #include "tfm_its_req_mngr.h"
 #include "its_utils.h"
+#ifdef TFM_MEM_PROFILE
+#include "tfm/tfm_spm_services_api.h"
+#endif
 
 #ifndef ITS_BUF_SIZE
 /* By default, set the ITS buffer size to the max asset size so that all
@@ -29,6 +32,24 @@
 static uint8_t asset_data[ITS_UTILS_ALIGN(ITS_BUF_SIZE,
                                           ITS_FLASH_MAX_ALIGNMENT)];
 
+#ifdef TFM_MEM_PROFILE
+/* Largest part of asset_data used by a request */
+static size_t asset_data_peak;
+
+/**
+ * \brief Records the use of size bytes of the asset_data buffer, and reports
+ *        the high-water mark to SPM when it moves.
+ */
+static void tfm_its_asset_data_use(size_t size)
+{
+    if (size > asset_data_peak) {
+        asset_data_peak = size;
+        (void)tfm_spm_request_scratch_peak(sizeof(asset_data),
+                                           asset_data_peak);
+    }
+}
+#endif
+
 static uint8_t g_fid[ITS_FILE_ID_SIZE];
 static struct its_file_info_t g_file_info;
 
@@ -170,6 +191,10 @@ psa_status_t tfm_its_set(int32_t client_id,
 
     /* Write as much of the data as will fit in the asset_data buffer */
     write_size = ITS_UTILS_MIN(data_length, sizeof(asset_data));
+#ifdef TFM_MEM_PROFILE
+    /* The chunks that follow are no larger */
+    tfm_its_asset_data_use(write_size);
+#endif
 
     /* Read asset data from the caller */
     (void)its_req_mngr_read(asset_data, write_size);
@@ -261,6 +286,9 @@ psa_status_t tfm_its_get(int32_t client_id,
     do {
         /* Read as much of the data as will fit in the asset_data buffer */
         read_size = ITS_UTILS_MIN(data_size, sizeof(asset_data));
+#ifdef TFM_MEM_PROFILE
+        tfm_its_asset_data_use(read_size);
+#endif
 
         /* Read file data from the filesystem */
         status = its_flash_fs_file_read(get_fs_ctx(client_id), g_fid, read_size,
@@ -29,9 +29,22 @@ static const int32_t nv_counter_access_map[NV_COUNTER_MAP_SIZE] = {
 #include "psa/service.h"
 #include "region_defs.h"
 
+#include "tfm_spm_trace_defs.h"
+#include "tfm_mem_profile_defs.h"
+#include "tfm_boot_profile_defs.h"
+
 #define INPUT_BUFFER_SIZE  64
 #define OUTPUT_BUFFER_SIZE 64
 
+/* Events moved out of the SPM trace at a time */
+#define TRACE_CHUNK_EVENTS 8
+
+/* Partitions of the memory profile read from SPM at a time */
+#define MEM_PROFILE_CHUNK_ENTRIES 4
+
+/* Phases of the boot profile read from SPM at a time */
+#define BOOT_PROFILE_CHUNK_ENTRIES 8
+
 typedef enum tfm_platform_err_t (*plat_func_t)(const psa_msg_t *msg);
 #endif
 
@@ -311,6 +324,100 @@ platform_sp_ioctl_ipc(const psa_msg_t *msg)
     return ret;
 }
 
+static enum tfm_platform_err_t
+platform_sp_trace_ipc(const psa_msg_t *msg)
+{
+    struct tfm_spm_trace_event_t events[TRACE_CHUNK_EVENTS];
+    size_t max_events;
+    int32_t num;
+
+    max_events = msg->out_size[0] / sizeof(events[0]);
+    if (max_events == 0) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    /* Fill the client buffer, or empty the trace, whichever comes first */
+    while (max_events > 0) {
+        num = tfm_spm_request_trace_read(events,
+                                         (max_events < TRACE_CHUNK_EVENTS) ?
+                                         max_events : TRACE_CHUNK_EVENTS);
+        if (num < 0) {
+            return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+        }
+        if (num == 0) {
+            break;
+        }
+        psa_write(msg->handle, 0, events, num * sizeof(events[0]));
+        max_events -= num;
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+}
+
+static enum tfm_platform_err_t
+platform_sp_mem_profile_ipc(const psa_msg_t *msg)
+{
+    struct tfm_mem_profile_t profile[MEM_PROFILE_CHUNK_ENTRIES];
+    size_t max_entries;
+    uint32_t first = 0;
+    int32_t num;
+
+    max_entries = msg->out_size[0] / sizeof(profile[0]);
+    if (max_entries == 0) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    /* Fill the client buffer, or read all the partitions */
+    while (max_entries > 0) {
+        num = tfm_spm_request_mem_profile_read(profile, first,
+                                    (max_entries < MEM_PROFILE_CHUNK_ENTRIES) ?
+                                    max_entries : MEM_PROFILE_CHUNK_ENTRIES);
+        if (num < 0) {
+            return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+        }
+        if (num == 0) {
+            break;
+        }
+        psa_write(msg->handle, 0, profile, num * sizeof(profile[0]));
+        first += num;
+        max_entries -= num;
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+}
+
+static enum tfm_platform_err_t
+platform_sp_boot_profile_ipc(const psa_msg_t *msg)
+{
+    struct tfm_boot_profile_entry_t entries[BOOT_PROFILE_CHUNK_ENTRIES];
+    size_t max_entries;
+    uint32_t first = 0;
+    int32_t num;
+
+    max_entries = msg->out_size[0] / sizeof(entries[0]);
+    if (max_entries == 0) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    /* Fill the client buffer, or read all the phases */
+    while (max_entries > 0) {
+        num = tfm_spm_request_boot_profile_read(entries, first,
+                                    (max_entries < BOOT_PROFILE_CHUNK_ENTRIES) ?
+                                    max_entries : BOOT_PROFILE_CHUNK_ENTRIES);
+        if (num < 0) {
+            return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+        }
+        if (num == 0) {
+            break;
+        }
+        psa_write(msg->handle, 0, entries, num * sizeof(entries[0]));
+        first += num;
+        max_entries -= num;
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+}
+
 static void platform_signal_handle(psa_signal_t signal, plat_func_t pfn)
 {
     psa_msg_t msg;
@@ -363,6 +470,15 @@ enum tfm_platform_err_t platform_sp_init(void)
        } else if (signals & TFM_SP_PLATFORM_NV_COUNTER_SIGNAL) {
             platform_signal_handle(TFM_SP_PLATFORM_NV_COUNTER_SIGNAL,
                                    platform_sp_nv_counter_ipc);
+        } else if (signals & TFM_SP_PLATFORM_TRACE_SIGNAL) {
+            platform_signal_handle(TFM_SP_PLATFORM_TRACE_SIGNAL,
+                                   platform_sp_trace_ipc);
+        } else if (signals & TFM_SP_PLATFORM_MEM_PROFILE_SIGNAL) {
+            platform_signal_handle(TFM_SP_PLATFORM_MEM_PROFILE_SIGNAL,
+                                   platform_sp_mem_profile_ipc);
+        } else if (signals & TFM_SP_PLATFORM_BOOT_PROFILE_SIGNAL) {
+            platform_signal_handle(TFM_SP_PLATFORM_BOOT_PROFILE_SIGNAL,
+                                   platform_sp_boot_profile_ipc);
         } else {
             psa_panic();
         }
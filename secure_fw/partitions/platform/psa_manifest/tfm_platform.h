@@ -17,6 +17,9 @@ extern "C" {
 #define TFM_SP_PLATFORM_SYSTEM_RESET_SIGNAL                     (1U << (0 + 4))
 #define TFM_SP_PLATFORM_IOCTL_SIGNAL                            (1U << (1 + 4))
 #define TFM_SP_PLATFORM_NV_COUNTER_SIGNAL                       (1U << (2 + 4))
+#define TFM_SP_PLATFORM_TRACE_SIGNAL                            (1U << (3 + 4))
+#define TFM_SP_PLATFORM_MEM_PROFILE_SIGNAL                      (1U << (4 + 4))
+#define TFM_SP_PLATFORM_BOOT_PROFILE_SIGNAL                     (1U << (5 + 4))
 
 #ifdef __cplusplus
 }
@@ -93,6 +93,10 @@ struct spm_partition_runtime_data_t {
     struct tfm_list_node_t service_list;/* Service list                      */
     struct tfm_core_thread_t sp_thrd;   /* Thread object                     */
     uint32_t assigned_signals;          /* All assigned signals              */
+#ifdef TFM_MEM_PROFILE
+    uint32_t scratch_size;              /* Size of the scratch buffer        */
+    uint32_t scratch_peak;              /* Scratch buffer high-water mark    */
+#endif
 #else /* TFM_PSA_API */
     uint32_t partition_state;
     uint32_t caller_partition_idx;
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_BOOT_PROFILE_H__
+#define __TFM_BOOT_PROFILE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "tfm_boot_profile_defs.h"
+
+/* Number of boot phases the profile holds, those of BL2 included */
+#ifndef TFM_BOOT_PROFILE_MAX_ENTRIES
+#define TFM_BOOT_PROFILE_MAX_ENTRIES    (32U)
+#endif
+
+#ifdef TFM_BOOT_PROFILE
+
+/**
+ * \brief Starts the cycle counter if BL2 has not, takes the phases of BL2
+ *        from the shared data area and records
+ *        \ref TFM_BOOT_PHASE_SPE_START.
+ */
+void tfm_boot_profile_init(void);
+
+/**
+ * \brief Records the end of a boot phase.
+ *
+ * \param[in] phase         \ref tfm_boot_phase_t
+ * \param[in] partition_id  Partition of the phase, or 0
+ */
+void tfm_boot_profile_record(uint32_t phase, int32_t partition_id);
+
+/**
+ * \brief Records the end of a boot phase, unless it is recorded already.
+ *
+ * \param[in] phase         \ref tfm_boot_phase_t
+ * \param[in] partition_id  Partition of the phase, or 0
+ *
+ * \return true if the phase is recorded by this call
+ */
+bool tfm_boot_profile_record_once(uint32_t phase, int32_t partition_id);
+
+/**
+ * \brief Reads the phases recorded, BL2's first.
+ *
+ * \param[out] entries      Where to write the phases
+ * \param[in]  first        Index of the first phase to read
+ * \param[in]  max_entries  Number of phases that fit in entries
+ *
+ * \return Number of phases written
+ */
+uint32_t tfm_boot_profile_read(struct tfm_boot_profile_entry_t *entries,
+                               uint32_t first, uint32_t max_entries);
+
+/**
+ * \brief Writes the phases recorded, and how long each took, to the log.
+ */
+void tfm_boot_profile_report(void);
+
+/**
+ * \brief Timestamp of the phases on cores without a DWT cycle counter. The
+ *        default returns 0; platforms can override it.
+ */
+uint32_t tfm_boot_profile_platform_timestamp(void);
+
+#endif /* TFM_BOOT_PROFILE */
+
+#endif /* __TFM_BOOT_PROFILE_H__ */
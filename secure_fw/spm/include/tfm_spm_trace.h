@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_SPM_TRACE_H__
+#define __TFM_SPM_TRACE_H__
+
+#include <stdint.h>
+#include "tfm_spm_trace_defs.h"
+
+/* Number of events the trace buffer holds, a power of 2 */
+#ifndef TFM_SPM_TRACE_BUF_EVENTS
+#define TFM_SPM_TRACE_BUF_EVENTS    (256U)
+#endif
+
+#ifdef TFM_SPM_TRACE
+
+/**
+ * \brief Empties the trace buffer and starts the cycle counter.
+ */
+void tfm_spm_trace_init(void);
+
+/**
+ * \brief Writes one event into the trace buffer. If the buffer is full, the
+ *        event is counted as lost instead.
+ *
+ * \param[in] event_id      \ref tfm_spm_trace_event_id_t
+ * \param[in] partition_id  Partition the event is about
+ * \param[in] sid           SID of the service, or 0
+ * \param[in] handle        Connection of the call, or 0
+ */
+void tfm_spm_trace_record(uint32_t event_id, int32_t partition_id,
+                          uint32_t sid, uint32_t handle);
+
+/**
+ * \brief Moves events out of the trace buffer, oldest first. Once the buffer
+ *        is empty, a \ref TFM_SPM_TRACE_EV_DROPPED event reports the events
+ *        lost since the last read, if any.
+ *
+ * \param[out] events      Where to write the events
+ * \param[in]  max_events  Number of events that fit in events
+ *
+ * \return Number of events written
+ */
+uint32_t tfm_spm_trace_read(struct tfm_spm_trace_event_t *events,
+                            uint32_t max_events);
+
+/**
+ * \brief Timestamp of the events on cores without a DWT cycle counter. The
+ *        default returns 0; platforms can override it.
+ */
+uint32_t tfm_spm_trace_platform_timestamp(void);
+
+#define TFM_SPM_TRACE_EVENT(event_id, partition_id, sid, handle) \
+    tfm_spm_trace_record((event_id), (partition_id), (sid), (handle))
+
+#else /* TFM_SPM_TRACE */
+
+#define TFM_SPM_TRACE_EVENT(event_id, partition_id, sid, handle)
+
+#endif /* TFM_SPM_TRACE */
+
+#endif /* __TFM_SPM_TRACE_H__ */
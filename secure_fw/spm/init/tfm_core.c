@@ -14,6 +14,7 @@
 #include "tfm_version.h"
 #include "log/tfm_log.h"
 #include "spm_api.h"
+#include "tfm_boot_profile.h"
 
 /*
  * Avoids the semihosting issue
@@ -144,6 +145,10 @@ int main(void)
                                                     ARM_LIB_STACK_MSP,
                                                     $$ZI$$Base));
 
+#ifdef TFM_BOOT_PROFILE
+    tfm_boot_profile_init();
+#endif
+
 #ifndef TFM_PSA_API
     /* Seal the PSP stacks viz ARM_LIB_STACK and TFM_SECURE_STACK */
     tfm_spm_seal_psp_stacks();
@@ -152,6 +157,9 @@ int main(void)
     if (tfm_core_init() != TFM_SUCCESS) {
         tfm_core_panic();
     }
+#ifdef TFM_BOOT_PROFILE
+    tfm_boot_profile_record(TFM_BOOT_PHASE_CORE_INIT, 0);
+#endif
     /* Print the TF-M version */
     LOG_MSG("\033[1;34mBooting TFM v%d.%d %s\033[0m\r\n",
             VERSION_MAJOR, VERSION_MINOR, VERSION_STRING);
@@ -175,6 +183,10 @@ int main(void)
 
     tfm_arch_set_psplim(psp_stack_bottom);
 
+#ifdef TFM_BOOT_PROFILE
+    tfm_boot_profile_record(TFM_BOOT_PHASE_SPM_INIT, 0);
+#endif
+
     if (tfm_spm_partition_init() != SPM_ERR_OK) {
         /* Certain systems might refuse to boot altogether if partitions fail
          * to initialize. This is a placeholder for such an error handler
@@ -196,6 +208,11 @@ int main(void)
     tfm_spm_partition_set_state(TFM_SP_NON_SECURE_ID,
                                 SPM_PARTITION_STATE_RUNNING);
 
+#ifdef TFM_BOOT_PROFILE
+    tfm_boot_profile_record(TFM_BOOT_PHASE_NS_START, 0);
+    tfm_boot_profile_report();
+#endif
+
 #ifdef TFM_CORE_DEBUG
     /* Jumps to non-secure code */
     LOG_MSG("\033[1;34mJumping to non-secure code...\033[0m\r\n");
@@ -24,6 +24,7 @@
 #include "region_defs.h"
 #include "region.h"
 #include "tfm/tfm_spm_services_api.h"
+#include "tfm_boot_profile.h"
 #include "tfm_spm_db_func.inc"
 
 #define EXC_RETURN_SECURE_FUNCTION 0xFFFFFFFD
@@ -1156,6 +1157,10 @@ enum spm_err_t tfm_spm_partition_init(void)
             desc.sfn = (sfn_t)part->static_data->partition_init;
             desc.sp_id = part->static_data->partition_id;
             res = tfm_core_sfn_request(&desc);
+#ifdef TFM_BOOT_PROFILE
+            tfm_boot_profile_record(TFM_BOOT_PHASE_PARTITION_INIT,
+                                    desc.sp_id);
+#endif
             if (res == TFM_SUCCESS) {
                 tfm_spm_partition_set_state(idx, SPM_PARTITION_STATE_IDLE);
             } else {
@@ -34,6 +34,9 @@ psa_status_t audit_core_add_record(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t audit_core_get_info(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t audit_core_get_record_info(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t audit_core_delete_record(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t audit_core_retrieve_records(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t audit_core_verify_records(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t audit_core_flush(psa_invec *, size_t, psa_outvec *, size_t);
 #endif /* TFM_PARTITION_AUDIT_LOG */
 
 #ifdef TFM_PARTITION_CRYPTO
@@ -115,6 +118,7 @@ psa_status_t platform_sp_nv_counter_increment(psa_invec *, size_t, psa_outvec *,
 psa_status_t initial_attest_get_token(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t initial_attest_get_token_size(psa_invec *, size_t, psa_outvec *, size_t);
 psa_status_t initial_attest_get_public_key(psa_invec *, size_t, psa_outvec *, size_t);
+psa_status_t initial_attest_get_batch_token(psa_invec *, size_t, psa_outvec *, size_t);
 #endif /* TFM_PARTITION_INITIAL_ATTESTATION */
 
 #ifdef TFM_PARTITION_TEST_CORE
@@ -207,6 +211,9 @@ TFM_VENEER_FUNCTION(TFM_SP_AUDIT_LOG, audit_core_add_record)
 TFM_VENEER_FUNCTION(TFM_SP_AUDIT_LOG, audit_core_get_info)
 TFM_VENEER_FUNCTION(TFM_SP_AUDIT_LOG, audit_core_get_record_info)
 TFM_VENEER_FUNCTION(TFM_SP_AUDIT_LOG, audit_core_delete_record)
+TFM_VENEER_FUNCTION(TFM_SP_AUDIT_LOG, audit_core_retrieve_records)
+TFM_VENEER_FUNCTION(TFM_SP_AUDIT_LOG, audit_core_verify_records)
+TFM_VENEER_FUNCTION(TFM_SP_AUDIT_LOG, audit_core_flush)
 #endif /* TFM_PARTITION_AUDIT_LOG */
 
 #ifdef TFM_PARTITION_CRYPTO
@@ -288,6 +295,7 @@ TFM_VENEER_FUNCTION(TFM_SP_PLATFORM, platform_sp_nv_counter_increment)
 TFM_VENEER_FUNCTION(TFM_SP_INITIAL_ATTESTATION, initial_attest_get_token)
 TFM_VENEER_FUNCTION(TFM_SP_INITIAL_ATTESTATION, initial_attest_get_token_size)
 TFM_VENEER_FUNCTION(TFM_SP_INITIAL_ATTESTATION, initial_attest_get_public_key)
+TFM_VENEER_FUNCTION(TFM_SP_INITIAL_ATTESTATION, initial_attest_get_batch_token)
 #endif /* TFM_PARTITION_INITIAL_ATTESTATION */
 
 #ifdef TFM_PARTITION_TEST_CORE
@@ -34,6 +34,11 @@
 #include "region.h"
 #include "region_defs.h"
 #include "tfm/tfm_spm_services_api.h"
+#include "tfm_spm_trace.h"
+#include "tfm_boot_profile.h"
+#ifdef TFM_MEM_PROFILE
+#include "tfm_mem_profile_defs.h"
+#endif
 
 #include "secure_fw/partitions/tfm_service_list.inc"
 #include "tfm_spm_db_ipc.inc"
@@ -574,6 +579,112 @@ static uint32_t tfm_spm_partition_get_stack_top(uint32_t partition_idx)
     return g_spm_partition_db.partitions[partition_idx].memory_data->stack_top;
 }
 
+#ifdef TFM_MEM_PROFILE
+/* Fills the unused stack, to find how deep it has been used */
+#define TFM_STACK_PAINT_PATTERN     0x5AFE57ACU
+
+/**
+ * \brief Paint the stack of a partition with \ref TFM_STACK_PAINT_PATTERN
+ *
+ * \param[in] partition_idx     Partition index
+ *
+ * \note This function doesn't check if partition_idx is valid. The stack
+ *       must not be in use.
+ */
+static void tfm_spm_partition_paint_stack(uint32_t partition_idx)
+{
+    uint32_t *p = (uint32_t *)tfm_spm_partition_get_stack_bottom(partition_idx);
+    uint32_t *top = (uint32_t *)tfm_spm_partition_get_stack_top(partition_idx);
+
+    while (p < top) {
+        *p++ = TFM_STACK_PAINT_PATTERN;
+    }
+}
+
+/**
+ * \brief Get the stack high-water mark of a partition
+ *
+ * \param[in] partition_idx     Partition index
+ *
+ * \return The number of bytes of the painted stack that have been written
+ *
+ * \note This function doesn't check if partition_idx is valid. The stack grows
+ *       down, so the lowest word that lost its paint marks the deepest use.
+ */
+static uint32_t tfm_spm_partition_get_stack_peak(uint32_t partition_idx)
+{
+    uint32_t *p = (uint32_t *)tfm_spm_partition_get_stack_bottom(partition_idx);
+    uint32_t *top = (uint32_t *)tfm_spm_partition_get_stack_top(partition_idx);
+
+    while (p < top && *p == TFM_STACK_PAINT_PATTERN) {
+        p++;
+    }
+
+    return (uint32_t)top - (uint32_t)p;
+}
+
+/**
+ * \brief Record the scratch buffer high-water mark of the running partition
+ *
+ * \param[in] size  Size of the scratch buffer
+ * \param[in] peak  Largest number of bytes of it used so far
+ */
+static void tfm_spm_partition_set_scratch_peak(uint32_t size, uint32_t peak)
+{
+    struct spm_partition_desc_t *partition = tfm_spm_get_running_partition();
+
+    if (!partition) {
+        tfm_core_panic();
+    }
+
+    partition->runtime_data.scratch_size = size;
+    if (peak > partition->runtime_data.scratch_peak) {
+        partition->runtime_data.scratch_peak = peak;
+    }
+}
+
+/**
+ * \brief Read the memory profile of the IPC partitions
+ *
+ * \param[out] profile      Profile of each partition
+ * \param[in]  first        Number of IPC partitions to skip
+ * \param[in]  max_entries  Number of entries in profile
+ *
+ * \return The number of entries written
+ */
+static uint32_t tfm_spm_mem_profile_read(struct tfm_mem_profile_t *profile,
+                                         uint32_t first, uint32_t max_entries)
+{
+    struct spm_partition_desc_t *partition;
+    uint32_t i, num = 0;
+
+    for (i = 0; i < g_spm_partition_db.partition_count && num < max_entries;
+         i++) {
+        if ((tfm_spm_partition_get_flags(i) & SPM_PART_FLAG_IPC) == 0) {
+            continue;
+        }
+        if (first > 0) {
+            first--;
+            continue;
+        }
+        partition = &g_spm_partition_db.partitions[i];
+
+        profile[num].partition_id = partition->static_data->partition_id;
+        profile[num].stack_size = tfm_spm_partition_get_stack_top(i) -
+                                  tfm_spm_partition_get_stack_bottom(i);
+        /* The non-secure entry stack is in use when the others are painted */
+        profile[num].stack_peak =
+            (partition->static_data->partition_id == TFM_SP_NON_SECURE_ID) ?
+            0 : tfm_spm_partition_get_stack_peak(i);
+        profile[num].scratch_size = partition->runtime_data.scratch_size;
+        profile[num].scratch_peak = partition->runtime_data.scratch_peak;
+        num++;
+    }
+
+    return num;
+}
+#endif /* TFM_MEM_PROFILE */
+
 uint32_t tfm_spm_partition_get_running_partition_id(void)
 {
     struct tfm_core_thread_t *pth = tfm_core_thrd_get_curr_thread();
@@ -651,6 +762,10 @@ uint32_t tfm_spm_init(void)
                   sizeof(struct tfm_conn_handle_t),
                   TFM_CONN_HANDLE_MAX_NUM);
 
+#ifdef TFM_SPM_TRACE
+    tfm_spm_trace_init();
+#endif
+
     /* Init partition first for it will be used when init service */
     for (i = 0; i < g_spm_partition_db.partition_count; i++) {
         partition = &g_spm_partition_db.partitions[i];
@@ -699,6 +814,16 @@ uint32_t tfm_spm_init(void)
             tfm_core_panic();
         }
 
+#ifdef TFM_MEM_PROFILE
+        /*
+         * The non-secure entry stack is the one SPM init is running on, so it
+         * is left as it is.
+         */
+        if (partition->static_data->partition_id != TFM_SP_NON_SECURE_ID) {
+            tfm_spm_partition_paint_stack(i);
+        }
+#endif
+
         tfm_core_thrd_init(pth,
                            tfm_spm_partition_get_init_func(i),
                            NULL,
@@ -746,11 +871,30 @@ uint32_t tfm_spm_init(void)
      * cleaned up and the background context is never going to return. Tell
      * the scheduler that the current thread is non-secure entry thread.
      */
+#ifdef TFM_BOOT_PROFILE
+    tfm_boot_profile_record(TFM_BOOT_PHASE_SPM_INIT, 0);
+#endif
     tfm_core_thrd_start_scheduler(p_ns_entry_thread);
 
     return p_ns_entry_thread->arch_ctx.lr;
 }
 
+#if defined(TFM_SPM_TRACE) || defined(TFM_BOOT_PROFILE)
+/* ID of the partition the thread belongs to */
+static int32_t tfm_spm_thrd_partition_id(struct tfm_core_thread_t *pth)
+{
+    struct spm_partition_runtime_data_t *r_data;
+    struct spm_partition_desc_t *partition;
+
+    r_data = TFM_GET_CONTAINER_PTR(pth, struct spm_partition_runtime_data_t,
+                                   sp_thrd);
+    partition = TFM_GET_CONTAINER_PTR(r_data, struct spm_partition_desc_t,
+                                      runtime_data);
+
+    return partition->static_data->partition_id;
+}
+#endif
+
 void tfm_pendsv_do_schedule(struct tfm_arch_ctx_t *p_actx)
 {
 #if TFM_LVL == 2
@@ -780,6 +924,21 @@ void tfm_pendsv_do_schedule(struct tfm_arch_ctx_t *p_actx)
         tfm_spm_partition_change_privilege(is_privileged);
 #endif
 
+        TFM_SPM_TRACE_EVENT(TFM_SPM_TRACE_EV_SCHEDULE,
+                            tfm_spm_thrd_partition_id(pth_next), 0, 0);
+
+#ifdef TFM_BOOT_PROFILE
+        /*
+         * The non-secure entry thread has the lowest priority, so the first
+         * switch to it comes once the other partitions have initialized and
+         * are waiting for signals.
+         */
+        if (tfm_spm_thrd_partition_id(pth_next) == TFM_SP_NON_SECURE_ID &&
+            tfm_boot_profile_record_once(TFM_BOOT_PHASE_NS_START, 0)) {
+            tfm_boot_profile_report();
+        }
+#endif
+
         tfm_core_thrd_switch_context(p_actx, pth_curr, pth_next);
     }
 
@@ -919,6 +1078,12 @@ psa_signal_t tfm_spm_psa_wait(uint32_t *args)
         tfm_core_panic();
     }
 
+#ifdef TFM_BOOT_PROFILE
+    /* The first wait of a partition ends its initialization */
+    (void)tfm_boot_profile_record_once(TFM_BOOT_PHASE_PARTITION_INIT,
+                                       partition->static_data->partition_id);
+#endif
+
     /*
      * Expected signals are included in signal wait mask, ignored signals
      * should not be set and affect caller thread state. Save this mask for
@@ -1007,6 +1172,10 @@ psa_status_t tfm_spm_psa_get(uint32_t *args)
         return PSA_ERROR_DOES_NOT_EXIST;
     }
 
+    TFM_SPM_TRACE_EVENT(TFM_SPM_TRACE_EV_MSG_GET,
+                        partition->static_data->partition_id,
+                        service->service_db->sid, (uint32_t)tmp_msg->handle);
+
     ((struct tfm_conn_handle_t *)(tmp_msg->handle))->status =
                                                        TFM_HANDLE_STATUS_ACTIVE;
 
@@ -1288,6 +1457,10 @@ void tfm_spm_psa_reply(uint32_t *args)
         tfm_core_panic();
     }
 
+    TFM_SPM_TRACE_EVENT(TFM_SPM_TRACE_EV_REPLY,
+                        service->service_db->partition_id,
+                        service->service_db->sid, (uint32_t)msg->handle);
+
     /*
      * Three type of message are passed in this function: CONNECTION, REQUEST,
      * DISCONNECTION. It needs to process differently for each type.
@@ -1652,6 +1825,99 @@ void tfm_spm_request_handler(const struct tfm_state_context_t *svc_ctx)
          */
         *res_ptr = (uint32_t)TFM_SUCCESS;
 
+        break;
+    case TFM_SPM_REQUEST_TRACE_READ:
+        *res_ptr = (uint32_t)-1;
+#ifdef TFM_SPM_TRACE
+        partition = tfm_spm_get_running_partition();
+        if (!partition) {
+            tfm_core_panic();
+        }
+        running_partition_flags = partition->static_data->partition_flags;
+
+        /* Only PSA Root of Trust services can read the trace */
+        if ((running_partition_flags & SPM_PART_FLAG_PSA_ROT) == 0) {
+            break;
+        }
+
+        if (svc_ctx->r2 > UINT32_MAX / sizeof(struct tfm_spm_trace_event_t) ||
+            tfm_memory_check((void *)svc_ctx->r1,
+                svc_ctx->r2 * sizeof(struct tfm_spm_trace_event_t), false,
+                TFM_MEMORY_ACCESS_RW,
+                tfm_spm_partition_get_privileged_mode(running_partition_flags))
+            != IPC_SUCCESS) {
+            break;
+        }
+
+        *res_ptr = tfm_spm_trace_read(
+                            (struct tfm_spm_trace_event_t *)svc_ctx->r1,
+                            svc_ctx->r2);
+#endif
+        break;
+    case TFM_SPM_REQUEST_SCRATCH_PEAK:
+        *res_ptr = (uint32_t)-1;
+#ifdef TFM_MEM_PROFILE
+        /* Partitions only update their own entry, so any of them can */
+        tfm_spm_partition_set_scratch_peak(svc_ctx->r1, svc_ctx->r2);
+        *res_ptr = 0;
+#endif
+        break;
+    case TFM_SPM_REQUEST_MEM_PROFILE_READ:
+        *res_ptr = (uint32_t)-1;
+#ifdef TFM_MEM_PROFILE
+        partition = tfm_spm_get_running_partition();
+        if (!partition) {
+            tfm_core_panic();
+        }
+        running_partition_flags = partition->static_data->partition_flags;
+
+        /* Only PSA Root of Trust services can read the profile */
+        if ((running_partition_flags & SPM_PART_FLAG_PSA_ROT) == 0) {
+            break;
+        }
+
+        if (svc_ctx->r3 > UINT32_MAX / sizeof(struct tfm_mem_profile_t) ||
+            tfm_memory_check((void *)svc_ctx->r1,
+                svc_ctx->r3 * sizeof(struct tfm_mem_profile_t), false,
+                TFM_MEMORY_ACCESS_RW,
+                tfm_spm_partition_get_privileged_mode(running_partition_flags))
+            != IPC_SUCCESS) {
+            break;
+        }
+
+        *res_ptr = tfm_spm_mem_profile_read(
+                            (struct tfm_mem_profile_t *)svc_ctx->r1,
+                            svc_ctx->r2, svc_ctx->r3);
+#endif
+        break;
+    case TFM_SPM_REQUEST_BOOT_PROFILE_READ:
+        *res_ptr = (uint32_t)-1;
+#ifdef TFM_BOOT_PROFILE
+        partition = tfm_spm_get_running_partition();
+        if (!partition) {
+            tfm_core_panic();
+        }
+        running_partition_flags = partition->static_data->partition_flags;
+
+        /* Only PSA Root of Trust services can read the profile */
+        if ((running_partition_flags & SPM_PART_FLAG_PSA_ROT) == 0) {
+            break;
+        }
+
+        if (svc_ctx->r3 >
+                UINT32_MAX / sizeof(struct tfm_boot_profile_entry_t) ||
+            tfm_memory_check((void *)svc_ctx->r1,
+                svc_ctx->r3 * sizeof(struct tfm_boot_profile_entry_t), false,
+                TFM_MEMORY_ACCESS_RW,
+                tfm_spm_partition_get_privileged_mode(running_partition_flags))
+            != IPC_SUCCESS) {
+            break;
+        }
+
+        *res_ptr = tfm_boot_profile_read(
+                            (struct tfm_boot_profile_entry_t *)svc_ctx->r1,
+                            svc_ctx->r2, svc_ctx->r3);
+#endif
         break;
     default:
         *res_ptr = (uint32_t)TFM_ERROR_INVALID_PARAMETER;
@@ -15,6 +15,7 @@
 #include "tfm_utils.h"
 #include "tfm_wait.h"
 #include "tfm_nspm.h"
+#include "tfm_spm_trace.h"
 
 uint32_t tfm_spm_client_psa_framework_version(void)
 {
@@ -159,6 +160,10 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle, int32_t type,
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
+    TFM_SPM_TRACE_EVENT(TFM_SPM_TRACE_EV_CALL_ENTER,
+                        tfm_spm_partition_get_running_partition_id(),
+                        service->service_db->sid, (uint32_t)conn_handle);
+
     /*
      * Read client invecs from the wrap input vector. It is a fatal error
      * if the memory reference for the wrap input vector is invalid or not
@@ -224,6 +229,10 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle, int32_t type,
         }
     }
 
+    TFM_SPM_TRACE_EVENT(TFM_SPM_TRACE_EV_CALL_CHECKED,
+                        tfm_spm_partition_get_running_partition_id(),
+                        service->service_db->sid, (uint32_t)conn_handle);
+
     /*
      * FixMe: Need to check if the message is unrecognized by the RoT
      * Service or incorrectly formatted.
@@ -237,6 +246,10 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle, int32_t type,
     tfm_spm_fill_msg(msg, service, conn_handle, type, client_id,
                      invecs, in_num, outvecs, out_num, outptr);
 
+    TFM_SPM_TRACE_EVENT(TFM_SPM_TRACE_EV_CALL_DISPATCH,
+                        service->service_db->partition_id,
+                        service->service_db->sid, (uint32_t)conn_handle);
+
     /*
      * Send message and wake up the SP who is waiting on message queue,
      * and scheduler triggered
@@ -14,6 +14,7 @@
 #include "tfm_core_trustzone.h"
 #include "tfm_internal.h"
 #include "tfm_svcalls.h"
+#include "tfm_spm_trace.h"
 #include "tfm_utils.h"
 #include "tfm/tfm_core_svc.h"
 
@@ -104,7 +105,8 @@ static int32_t SVC_Handler_IPC(tfm_svc_number_t svc_num, uint32_t *ctx,
         break;
     case TFM_SVC_SPM_REQUEST:
         tfm_spm_request_handler((const struct tfm_state_context_t *)ctx);
-        break;
+        /* The handler leaves its result in r0 of the caller's stack frame */
+        return (int32_t)ctx[0];
     case TFM_SVC_PSA_LIFECYCLE:
         return tfm_spm_get_lifecycle_state();
     default:
@@ -147,7 +149,13 @@ uint32_t tfm_core_svc_handler(uint32_t *svc_args, uint32_t exc_return)
         tfm_core_get_boot_data_handler(svc_args);
         break;
     default:
+        TFM_SPM_TRACE_EVENT(TFM_SPM_TRACE_EV_SVC_ENTER,
+                            tfm_spm_partition_get_running_partition_id(),
+                            svc_number, 0);
         svc_args[0] = SVC_Handler_IPC(svc_number, svc_args, exc_return);
+        TFM_SPM_TRACE_EVENT(TFM_SPM_TRACE_EV_SVC_EXIT,
+                            tfm_spm_partition_get_running_partition_id(),
+                            svc_number, 0);
         break;
     }
 
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "tfm_hal_device_header.h"
+#include "tfm_boot_status.h"
+#include "region_defs.h"
+#include "tfm_core_utils.h"
+#include "log/tfm_log_raw.h"
+#include "tfm_boot_profile.h"
+
+/*
+ * The boot phases: those of BL2 first, as passed in the shared data area,
+ * then those of the SPE. The phases are recorded in thread mode before the
+ * scheduler starts, then by the SVC and PendSV handlers, which do not preempt
+ * each other, so the profile needs no lock. Phases past the end of the
+ * profile are not recorded.
+ */
+static struct tfm_boot_profile_entry_t profile[TFM_BOOT_PROFILE_MAX_ENTRIES];
+static uint32_t profile_count;
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+/* Set if the DWT has a cycle counter, not all implementations do */
+static uint32_t profile_has_cyccnt;
+#endif
+
+static const char *const phase_names[TFM_BOOT_PHASE_MAX] = {
+    [TFM_BOOT_PHASE_BL2_START]       = "BL2 start",
+    [TFM_BOOT_PHASE_BL2_INIT]        = "BL2 init",
+    [TFM_BOOT_PHASE_BL2_VALIDATE]    = "BL2 image validation",
+    [TFM_BOOT_PHASE_BL2_JUMP]        = "BL2 jump to SPE",
+    [TFM_BOOT_PHASE_SPE_START]       = "SPE start",
+    [TFM_BOOT_PHASE_CORE_INIT]       = "Core init",
+    [TFM_BOOT_PHASE_SPM_INIT]        = "SPM init",
+    [TFM_BOOT_PHASE_PARTITION_INIT]  = "Partition init",
+    [TFM_BOOT_PHASE_NS_START]        = "NS start",
+};
+
+__WEAK uint32_t tfm_boot_profile_platform_timestamp(void)
+{
+    return 0;
+}
+
+static uint32_t tfm_boot_profile_timestamp(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (profile_has_cyccnt) {
+        return DWT->CYCCNT;
+    }
+#endif
+    return tfm_boot_profile_platform_timestamp();
+}
+
+/* Takes the phases of BL2 from the shared data area, if it passed any */
+static void tfm_boot_profile_import_bl2(void)
+{
+#ifdef BOOT_DATA_AVAILABLE
+    struct tfm_boot_data *boot_data;
+    struct shared_data_tlv_entry tlv_entry;
+    uintptr_t tlv_end, offset;
+    size_t next_tlv_offset, data_len, num;
+
+    boot_data = (struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
+    if (boot_data->header.tlv_magic != SHARED_DATA_TLV_INFO_MAGIC) {
+        return;
+    }
+
+    tlv_end = BOOT_TFM_SHARED_DATA_BASE + boot_data->header.tlv_tot_len;
+    offset  = BOOT_TFM_SHARED_DATA_BASE + SHARED_DATA_HEADER_SIZE;
+
+    for (; offset < tlv_end; offset += next_tlv_offset) {
+        /* Create local copy to avoid unaligned access */
+        (void)tfm_core_util_memcpy(&tlv_entry, (const void *)offset,
+                                   SHARED_DATA_ENTRY_HEADER_SIZE);
+#ifdef LEGACY_TFM_TLV_HEADER
+        next_tlv_offset = tlv_entry.tlv_len;
+        data_len = tlv_entry.tlv_len - SHARED_DATA_ENTRY_HEADER_SIZE;
+#else
+        next_tlv_offset = SHARED_DATA_ENTRY_HEADER_SIZE + tlv_entry.tlv_len;
+        data_len = tlv_entry.tlv_len;
+#endif
+        if (next_tlv_offset < SHARED_DATA_ENTRY_HEADER_SIZE) {
+            return;
+        }
+        if (GET_MAJOR(tlv_entry.tlv_type) == TLV_MAJOR_CORE &&
+            GET_MINOR(tlv_entry.tlv_type) == TLV_MINOR_CORE_BOOT_PROFILE) {
+            num = data_len / sizeof(profile[0]);
+            if (num > TFM_BOOT_PROFILE_MAX_ENTRIES) {
+                num = TFM_BOOT_PROFILE_MAX_ENTRIES;
+            }
+            (void)tfm_core_util_memcpy(profile,
+                               (const void *)(offset +
+                                              SHARED_DATA_ENTRY_HEADER_SIZE),
+                               num * sizeof(profile[0]));
+            profile_count = num;
+            return;
+        }
+    }
+#endif /* BOOT_DATA_AVAILABLE */
+}
+
+void tfm_boot_profile_init(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    /* BL2 may have started the counter already, it is not reset so that the
+     * phases of both images share one time base.
+     */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    profile_has_cyccnt = !(DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk);
+    if (profile_has_cyccnt) {
+#if defined(DWT_CTRL_CYCDISS_Msk)
+        DWT->CTRL &= ~DWT_CTRL_CYCDISS_Msk;
+#endif
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+
+    profile_count = 0;
+    tfm_boot_profile_import_bl2();
+    tfm_boot_profile_record(TFM_BOOT_PHASE_SPE_START, 0);
+}
+
+void tfm_boot_profile_record(uint32_t phase, int32_t partition_id)
+{
+    struct tfm_boot_profile_entry_t *entry;
+
+    if (profile_count >= TFM_BOOT_PROFILE_MAX_ENTRIES) {
+        return;
+    }
+
+    entry = &profile[profile_count++];
+    entry->timestamp = tfm_boot_profile_timestamp();
+    entry->phase = (uint16_t)phase;
+    entry->partition_id = (uint16_t)partition_id;
+}
+
+bool tfm_boot_profile_record_once(uint32_t phase, int32_t partition_id)
+{
+    uint32_t i;
+
+    for (i = 0; i < profile_count; i++) {
+        if (profile[i].phase == phase &&
+            profile[i].partition_id == (uint16_t)partition_id) {
+            return false;
+        }
+    }
+
+    tfm_boot_profile_record(phase, partition_id);
+    return true;
+}
+
+uint32_t tfm_boot_profile_read(struct tfm_boot_profile_entry_t *entries,
+                               uint32_t first, uint32_t max_entries)
+{
+    uint32_t num = 0;
+
+    while (num < max_entries && first + num < profile_count) {
+        entries[num] = profile[first + num];
+        num++;
+    }
+
+    return num;
+}
+
+void tfm_boot_profile_report(void)
+{
+    const struct tfm_boot_profile_entry_t *entry;
+    const char *name;
+    uint32_t i, last = 0;
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    tfm_log_printf("[Sec Thread] Boot profile, in %s:\r\n",
+                   profile_has_cyccnt ? "cycles" : "platform ticks");
+#else
+    tfm_log_printf("[Sec Thread] Boot profile, in platform ticks:\r\n");
+#endif
+
+    for (i = 0; i < profile_count; i++) {
+        entry = &profile[i];
+        name = (entry->phase < TFM_BOOT_PHASE_MAX) ?
+               phase_names[entry->phase] : "Unknown";
+
+        /* Each phase started at the end of the one before it */
+        if (entry->phase == TFM_BOOT_PHASE_PARTITION_INIT) {
+            tfm_log_printf("  %s 0x%x: at %u, took %u\r\n", name,
+                           entry->partition_id, entry->timestamp,
+                           entry->timestamp - last);
+        } else {
+            tfm_log_printf("  %s: at %u, took %u\r\n", name,
+                           entry->timestamp, entry->timestamp - last);
+        }
+        last = entry->timestamp;
+    }
+}
@@ -63,6 +63,54 @@ int32_t tfm_spm_request_reset_vote(void)
         : : "I" (TFM_SPM_REQUEST_RESET_VOTE));
 }
 
+__attribute__((naked))
+int32_t tfm_spm_request_trace_read(void *events, uint32_t max_events)
+{
+    __ASM volatile(
+        "MOVS   R2, R1\n"
+        "MOVS   R1, R0\n"
+        "MOVS   R0, %0\n"
+        "B      tfm_spm_request\n"
+        : : "I" (TFM_SPM_REQUEST_TRACE_READ));
+}
+
+__attribute__((naked))
+int32_t tfm_spm_request_scratch_peak(uint32_t size, uint32_t peak)
+{
+    __ASM volatile(
+        "MOVS   R2, R1\n"
+        "MOVS   R1, R0\n"
+        "MOVS   R0, %0\n"
+        "B      tfm_spm_request\n"
+        : : "I" (TFM_SPM_REQUEST_SCRATCH_PEAK));
+}
+
+__attribute__((naked))
+int32_t tfm_spm_request_mem_profile_read(void *profile, uint32_t first,
+                                         uint32_t max_entries)
+{
+    __ASM volatile(
+        "MOVS   R3, R2\n"
+        "MOVS   R2, R1\n"
+        "MOVS   R1, R0\n"
+        "MOVS   R0, %0\n"
+        "B      tfm_spm_request\n"
+        : : "I" (TFM_SPM_REQUEST_MEM_PROFILE_READ));
+}
+
+__attribute__((naked))
+int32_t tfm_spm_request_boot_profile_read(void *entries, uint32_t first,
+                                          uint32_t max_entries)
+{
+    __ASM volatile(
+        "MOVS   R3, R2\n"
+        "MOVS   R2, R1\n"
+        "MOVS   R1, R0\n"
+        "MOVS   R0, %0\n"
+        "B      tfm_spm_request\n"
+        : : "I" (TFM_SPM_REQUEST_BOOT_PROFILE_READ));
+}
+
 __attribute__((naked))
 int32_t tfm_core_get_boot_data(uint8_t major_type,
                                struct tfm_boot_data *boot_status,
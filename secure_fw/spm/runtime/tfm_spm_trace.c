@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "tfm_hal_device_header.h"
+#include "tfm_spm_trace.h"
+
+#if (TFM_SPM_TRACE_BUF_EVENTS & (TFM_SPM_TRACE_BUF_EVENTS - 1U)) != 0
+#error "TFM_SPM_TRACE_BUF_EVENTS must be a power of 2"
+#endif
+
+#define TRACE_BUF_MASK  (TFM_SPM_TRACE_BUF_EVENTS - 1U)
+
+/*
+ * The trace buffer of the SPE core. Events are written by the tracepoints,
+ * and read by tfm_spm_trace_read() on an SPM request, all of them in the SVC
+ * and PendSV handlers. Those do not preempt each other (the SVCs are raised
+ * from thread mode only), so the buffer needs no lock: the writer only moves
+ * trace_head, the reader only trace_tail, and a full buffer drops the new
+ * event rather than overwriting one that has not been read.
+ */
+static struct tfm_spm_trace_event_t trace_buf[TFM_SPM_TRACE_BUF_EVENTS];
+static uint32_t trace_head;     /* Count of events written */
+static uint32_t trace_tail;     /* Count of events read */
+static uint32_t trace_dropped;  /* Events lost since the last read */
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+/* Set if the DWT has a cycle counter, not all implementations do */
+static uint32_t trace_has_cyccnt;
+#endif
+
+__WEAK uint32_t tfm_spm_trace_platform_timestamp(void)
+{
+    return 0;
+}
+
+static uint32_t tfm_spm_trace_timestamp(void)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (trace_has_cyccnt) {
+        return DWT->CYCCNT;
+    }
+#endif
+    return tfm_spm_trace_platform_timestamp();
+}
+
+void tfm_spm_trace_init(void)
+{
+    trace_head = 0;
+    trace_tail = 0;
+    trace_dropped = 0;
+
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    /* The counter only counts in Secure state if secure non-invasive debug
+     * is allowed.
+     */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    trace_has_cyccnt = !(DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk);
+    if (trace_has_cyccnt) {
+#if defined(DWT_CTRL_CYCDISS_Msk)
+        DWT->CTRL &= ~DWT_CTRL_CYCDISS_Msk;
+#endif
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+#endif
+}
+
+void tfm_spm_trace_record(uint32_t event_id, int32_t partition_id,
+                          uint32_t sid, uint32_t handle)
+{
+    struct tfm_spm_trace_event_t *event;
+
+    if (trace_head - trace_tail >= TFM_SPM_TRACE_BUF_EVENTS) {
+        trace_dropped++;
+        return;
+    }
+
+    event = &trace_buf[trace_head & TRACE_BUF_MASK];
+    event->timestamp = tfm_spm_trace_timestamp();
+    event->event_id = (uint16_t)event_id;
+    event->partition_id = (uint16_t)partition_id;
+    event->sid = sid;
+    event->handle = handle;
+    trace_head++;
+}
+
+uint32_t tfm_spm_trace_read(struct tfm_spm_trace_event_t *events,
+                            uint32_t max_events)
+{
+    uint32_t num = 0;
+
+    while (num < max_events && trace_tail != trace_head) {
+        events[num++] = trace_buf[trace_tail & TRACE_BUF_MASK];
+        trace_tail++;
+    }
+
+    /* The lost events came after all of those in the buffer */
+    if (num < max_events && trace_tail == trace_head && trace_dropped != 0) {
+        events[num].timestamp = tfm_spm_trace_timestamp();
+        events[num].event_id = TFM_SPM_TRACE_EV_DROPPED;
+        events[num].partition_id = 0;
+        events[num].sid = 0;
+        events[num].handle = trace_dropped;
+        trace_dropped = 0;
+        num++;
+    }
+
+    return num;
+}
@@ -0,0 +1,303 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "bench_framework.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#ifdef TFM_BENCH_HOST
+#include <time.h>
+#else
+#include "cmsis.h"
+#endif
+
+#define BENCH_SUB_MASK ((1u << BENCH_HIST_SUB_BITS) - 1u)
+
+/* The benchmark, case and histogram being run */
+static const char *bench_suite_name;
+static const char *bench_test_name;
+static const char *bench_case_param;
+static uint32_t bench_case_value;
+static struct bench_hist_t bench_hist;
+
+#ifdef TFM_BENCH_HOST
+#define BENCH_TICKS_UNIT "ns"
+
+static void bench_counter_init(void)
+{
+}
+
+bench_ticks_t bench_ticks(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (bench_ticks_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+#elif defined(DWT_CTRL_CYCCNTENA_Msk)
+#define BENCH_TICKS_UNIT "cycles"
+
+/* Set if the DWT has a cycle counter, not all implementations do */
+static uint32_t bench_has_cyccnt;
+
+static void bench_counter_init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    bench_has_cyccnt = !(DWT->CTRL & DWT_CTRL_NOCYCCNT_Msk);
+    if (bench_has_cyccnt) {
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+}
+
+bench_ticks_t bench_ticks(void)
+{
+    return bench_has_cyccnt ? DWT->CYCCNT : bench_platform_ticks();
+}
+#else
+/* Armv6-M and Armv8-M Baseline have no cycle counter */
+#define BENCH_TICKS_UNIT "ticks"
+
+static void bench_counter_init(void)
+{
+}
+
+bench_ticks_t bench_ticks(void)
+{
+    return bench_platform_ticks();
+}
+#endif
+
+__attribute__((weak))
+bench_ticks_t bench_platform_ticks(void)
+{
+    return 0;
+}
+
+uint32_t bench_iterations(void)
+{
+    return BENCH_ITERATIONS;
+}
+
+/* Buckets are linear up to 2^BENCH_HIST_SUB_BITS, then each power of 2 is
+ * split into 2^BENCH_HIST_SUB_BITS buckets.
+ */
+static uint32_t bench_bucket(bench_ticks_t ticks)
+{
+    uint32_t msb = 0;
+
+    if (ticks <= BENCH_SUB_MASK) {
+        return ticks;
+    }
+    while ((ticks >> msb) > 1u) {
+        msb++;
+    }
+
+    return ((msb - BENCH_HIST_SUB_BITS + 1u) << BENCH_HIST_SUB_BITS) +
+           ((ticks >> (msb - BENCH_HIST_SUB_BITS)) & BENCH_SUB_MASK);
+}
+
+/* The smallest value that falls into the bucket */
+static bench_ticks_t bench_bucket_low(uint32_t bucket)
+{
+    uint32_t msb;
+
+    if (bucket <= BENCH_SUB_MASK) {
+        return bucket;
+    }
+    msb = (bucket >> BENCH_HIST_SUB_BITS) + BENCH_HIST_SUB_BITS - 1u;
+
+    return (1u << msb) | ((bucket & BENCH_SUB_MASK) <<
+                          (msb - BENCH_HIST_SUB_BITS));
+}
+
+/* The value below which percent % of the samples fall, to within the width
+ * of a bucket.
+ */
+static bench_ticks_t bench_percentile(const struct bench_hist_t *hist,
+                                      uint32_t percent)
+{
+    uint32_t target = (uint32_t)(((uint64_t)hist->count * percent + 99u) /
+                                 100u);
+    uint32_t seen = 0;
+    bench_ticks_t value = hist->max;
+    uint32_t i;
+
+    for (i = 0; i < BENCH_HIST_BUCKETS; i++) {
+        seen += hist->buckets[i];
+        if (seen >= target && hist->buckets[i] != 0) {
+            if (i + 1u < BENCH_HIST_BUCKETS) {
+                value = bench_bucket_low(i + 1u) - 1u;
+            }
+            break;
+        }
+    }
+    if (value > hist->max) {
+        value = hist->max;
+    }
+    if (value < hist->min) {
+        value = hist->min;
+    }
+
+    return value;
+}
+
+void bench_case_begin(const char *param, uint32_t value)
+{
+    bench_case_param = param;
+    bench_case_value = value;
+    memset(&bench_hist, 0, sizeof(bench_hist));
+    bench_hist.min = UINT32_MAX;
+}
+
+void bench_record(bench_ticks_t ticks)
+{
+    bench_hist.count++;
+    bench_hist.sum += ticks;
+    if (ticks < bench_hist.min) {
+        bench_hist.min = ticks;
+    }
+    if (ticks > bench_hist.max) {
+        bench_hist.max = ticks;
+    }
+    bench_hist.buckets[bench_bucket(ticks)]++;
+}
+
+void bench_case_end(void)
+{
+    const char *sep = "";
+    uint32_t i;
+
+    if (bench_case_param == NULL) {
+        return;
+    }
+    if (bench_hist.count == 0) {
+        bench_hist.min = 0;
+    }
+
+    /* One line per case, for the results to be picked out of the log */
+    TEST_LOG("BENCH {\"suite\":\"%s\",\"bench\":\"%s\",\"param\":\"%s\","
+             "\"value\":%u,\"unit\":\"%s\",", bench_suite_name,
+             bench_test_name, bench_case_param, bench_case_value,
+             BENCH_TICKS_UNIT);
+    TEST_LOG("\"n\":%u,\"min\":%u,\"mean\":%u,", bench_hist.count,
+             bench_hist.min, bench_hist.count ?
+             (uint32_t)(bench_hist.sum / bench_hist.count) : 0u);
+    TEST_LOG("\"p50\":%u,\"p90\":%u,\"p99\":%u,\"max\":%u,\"hist\":[",
+             bench_percentile(&bench_hist, 50),
+             bench_percentile(&bench_hist, 90),
+             bench_percentile(&bench_hist, 99), bench_hist.max);
+    for (i = 0; i < BENCH_HIST_BUCKETS; i++) {
+        if (bench_hist.buckets[i] != 0) {
+            TEST_LOG("%s[%u,%u]", sep, bench_bucket_low(i),
+                     bench_hist.buckets[i]);
+            sep = ",";
+        }
+    }
+    TEST_LOG("]}\r\n");
+
+    bench_case_param = NULL;
+}
+
+enum test_suite_err_t run_benchsuite(struct test_suite_t *bench_suite)
+{
+    uint32_t failed_benchs = 0;
+    uint32_t i;
+    struct test_t *p_bench;
+
+    if (bench_suite == 0 || bench_suite->freg == 0) {
+        TEST_LOG("Error ( TEST_SUITE_ERR_INVALID_DATA! )\r\n");
+        return TEST_SUITE_ERR_INVALID_DATA;
+    }
+
+    /* Sets benchmark suite parameters */
+    bench_suite->freg(bench_suite);
+    if (bench_suite->name == 0 || bench_suite->list_size == 0) {
+        TEST_LOG("Error ( TEST_SUITE_ERR_INVALID_DATA! )\r\n");
+        return TEST_SUITE_ERR_INVALID_DATA;
+    }
+
+    printf_set_color(YELLOW);
+    TEST_LOG("Running Benchmark Suite %s...\r\n", bench_suite->name);
+
+    bench_counter_init();
+    bench_suite_name = bench_suite->name;
+    p_bench = bench_suite->test_list;
+
+    for (i = 0; i < bench_suite->list_size; i++) {
+        if (p_bench->test == 0 || p_bench->name == 0) {
+            TEST_LOG("Error ( TEST_SUITE_ERR_INVALID_TEST_DATA! )\r\n");
+            return TEST_SUITE_ERR_INVALID_TEST_DATA;
+        }
+
+        printf_set_color(WHITE);
+        TEST_LOG("> Executing '%s' \r\n  Description: '%s'\r\n",
+                 p_bench->name, p_bench->desc);
+
+        bench_test_name = p_bench->name;
+        bench_case_param = NULL;
+        p_bench->ret.val = TEST_PASSED;
+
+        p_bench->test(&p_bench->ret);
+        if (p_bench->ret.val == TEST_FAILED) {
+            /* The results of a case cut short are not written out */
+            bench_case_param = NULL;
+            printf_set_color(RED);
+            if (p_bench->ret.info_msg != 0) {
+                TEST_LOG("  %s", p_bench->ret.info_msg);
+            }
+            if (p_bench->ret.filename != 0) {
+                TEST_LOG(" (Failed at %s:%d)", p_bench->ret.filename,
+                         p_bench->ret.line);
+            }
+            TEST_LOG("\r\n  BENCHMARK FAILED!\r\n");
+            failed_benchs++;
+        }
+
+        p_bench++;
+    }
+
+    if (failed_benchs == 0) {
+        printf_set_color(GREEN);
+        TEST_LOG("BENCHMARK SUITE COMPLETED!\r\n");
+        bench_suite->val = TEST_PASSED;
+    } else {
+        printf_set_color(RED);
+        TEST_LOG("Number of failed benchmarks: %d of %d\r\n",
+                 failed_benchs, bench_suite->list_size);
+        bench_suite->val = TEST_FAILED;
+    }
+
+    return TEST_SUITE_ERR_NO_ERROR;
+}
+
+enum test_suite_err_t bench_run_suites(const char *suite_type,
+                                       struct test_suite_t bench_suites[])
+{
+    enum test_suite_err_t retval = TEST_SUITE_ERR_NO_ERROR;
+    enum test_suite_err_t err;
+    uint32_t i;
+
+    printf_set_color(YELLOW);
+    TEST_LOG("\r\n#### Execute benchmark suites for the %s area ####\r\n",
+             suite_type);
+
+    for (i = 0; bench_suites[i].freg != NULL; i++) {
+        err = run_benchsuite(&bench_suites[i]);
+        if (err != TEST_SUITE_ERR_NO_ERROR) {
+            return err;
+        }
+        if (bench_suites[i].val != TEST_PASSED) {
+            retval = TEST_SUITE_ERR_TEST_FAILED;
+        }
+    }
+
+    printf_set_color(YELLOW);
+    TEST_LOG("\r\n*** End of %s benchmark suites ***\r\n", suite_type);
+    return retval;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BENCH_FRAMEWORK_H__
+#define __BENCH_FRAMEWORK_H__
+
+#include <stdint.h>
+
+#include "test_framework.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Benchmarks are registered and run like tests: a benchmark suite is a
+ * \ref test_suite_t, and each of its \ref test_t runs one operation of the
+ * service for a number of cases (sizes, object counts...). Each case times
+ * the operation \ref bench_iterations times with \ref BENCH_TIME, and its
+ * latency histogram is written out, one line per case, as:
+ *
+ * BENCH {"suite":"<suite>","bench":"<test name>","param":"<parameter>",
+ *        "value":<value>,"unit":"cycles","n":<n>,"min":<min>,"mean":<mean>,
+ *        "p50":<p50>,"p90":<p90>,"p99":<p99>,"max":<max>,
+ *        "hist":[[<low>,<count>],...]}
+ *
+ * (on one line). On target the latency is read from the DWT cycle counter;
+ * in the host build (TFM_BENCH_HOST) it is in nanoseconds, from
+ * clock_gettime().
+ */
+
+/* The operation mix: every list can be overridden from the build options */
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS        (100u)
+#endif
+
+/* Data sizes of the ITS set and get benchmarks */
+#ifndef BENCH_ITS_SIZES
+#define BENCH_ITS_SIZES         16, 128, 512
+#endif
+
+/* Number of objects already stored in PS, for the PS benchmarks */
+#ifndef BENCH_PS_OBJECT_COUNTS
+#define BENCH_PS_OBJECT_COUNTS  1, 4, 8
+#endif
+
+/* Data size of each PS object */
+#ifndef BENCH_PS_OBJECT_SIZE
+#define BENCH_PS_OBJECT_SIZE    (256u)
+#endif
+
+/* Input sizes of the hash benchmarks */
+#ifndef BENCH_HASH_SIZES
+#define BENCH_HASH_SIZES        64, 1024, 4096
+#endif
+
+/* Plaintext sizes of the AEAD benchmarks */
+#ifndef BENCH_AEAD_SIZES
+#define BENCH_AEAD_SIZES        64, 1024
+#endif
+
+/* Message sizes of the sign benchmarks (hashed, then signed) */
+#ifndef BENCH_SIGN_SIZES
+#define BENCH_SIGN_SIZES        32, 1024
+#endif
+
+/* Challenge sizes of the attestation token benchmarks */
+#ifndef BENCH_TOKEN_CHALLENGE_SIZES
+#define BENCH_TOKEN_CHALLENGE_SIZES 32, 48, 64
+#endif
+
+/* Number of entries of a list of cases */
+#define BENCH_ARRAY_SIZE(arr)   (sizeof(arr) / sizeof((arr)[0]))
+
+/* The histogram has 2^BENCH_HIST_SUB_BITS buckets per power of 2 */
+#define BENCH_HIST_SUB_BITS     (2u)
+#define BENCH_HIST_BUCKETS      (32u << BENCH_HIST_SUB_BITS)
+
+typedef uint32_t bench_ticks_t;
+
+struct bench_hist_t {
+    uint32_t count;                         /*!< Number of samples */
+    bench_ticks_t min;                      /*!< Smallest sample */
+    bench_ticks_t max;                      /*!< Largest sample */
+    uint64_t sum;                           /*!< Sum of the samples */
+    uint32_t buckets[BENCH_HIST_BUCKETS];   /*!< Log-linear histogram */
+};
+
+/**
+ * \brief Reads the cycle counter (nanoseconds on the host).
+ *
+ * \return Returns the counter value. It wraps, so only the differences of two
+ *         values are meaningful.
+ */
+bench_ticks_t bench_ticks(void);
+
+/**
+ * \brief Reads the platform's own counter, on cores without a DWT cycle
+ *        counter. The default returns 0; platforms can override it.
+ *
+ * \return Returns the counter value.
+ */
+bench_ticks_t bench_platform_ticks(void);
+
+/**
+ * \brief Returns the number of times each case should run its operation.
+ */
+uint32_t bench_iterations(void);
+
+/**
+ * \brief Starts a case of the running benchmark, with an empty histogram.
+ *
+ * \param[in] param  Name of the parameter of the case, for example "size"
+ * \param[in] value  Value of the parameter
+ */
+void bench_case_begin(const char *param, uint32_t value);
+
+/**
+ * \brief Adds one latency sample to the histogram of the running case.
+ *
+ * \param[in] ticks  Latency, in counter ticks
+ */
+void bench_record(bench_ticks_t ticks);
+
+/**
+ * \brief Ends the running case and writes out its results.
+ */
+void bench_case_end(void);
+
+/**
+ * \brief Times one call, and adds its latency to the running case.
+ */
+#define BENCH_TIME(call)                                        \
+    do {                                                        \
+        bench_ticks_t bench_start_ = bench_ticks();             \
+        call;                                                   \
+        bench_record(bench_ticks() - bench_start_);             \
+    } while (0)
+
+/**
+ * \brief Runs the given benchmark suite.
+ *
+ * \param[in,out] bench_suite  Benchmark suite to run and store results in.
+ *
+ * \returns Returns error code as specified in \ref test_suite_err_t
+ */
+enum test_suite_err_t run_benchsuite(struct test_suite_t *bench_suite);
+
+/**
+ * \brief Runs a list of benchmark suites, ended by a suite with a NULL
+ *        registration function.
+ *
+ * \param[in]     suite_type    Name of the area, for the log
+ * \param[in,out] bench_suites  Benchmark suites to run
+ *
+ * \returns Returns error code as specified in \ref test_suite_err_t
+ */
+enum test_suite_err_t bench_run_suites(const char *suite_type,
+                                       struct test_suite_t bench_suites[]);
+
+/**
+ * \brief Runs the non-secure benchmark suites (TFM_BENCHMARKS).
+ *
+ * \returns Returns error code as specified in \ref test_suite_err_t
+ */
+enum test_suite_err_t tfm_non_secure_client_run_benchmarks(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BENCH_FRAMEWORK_H__ */
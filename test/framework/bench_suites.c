@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "bench_framework.h"
+
+/* Service specific includes */
+#include "test/suites/its/benchmark/its_bench_tests.h"
+#include "test/suites/ps/benchmark/ps_bench_tests.h"
+#include "test/suites/crypto/benchmark/crypto_bench_tests.h"
+#include "test/suites/attestation/benchmark/attestation_bench_tests.h"
+
+static struct test_suite_t bench_suites[] = {
+#ifdef ENABLE_INTERNAL_TRUSTED_STORAGE_SERVICE_TESTS
+    {&register_testsuite_ns_psa_its_bench, 0, 0, 0},
+#endif
+
+#ifdef ENABLE_PROTECTED_STORAGE_SERVICE_TESTS
+    {&register_testsuite_ns_psa_ps_bench, 0, 0, 0},
+#endif
+
+#ifdef ENABLE_CRYPTO_SERVICE_TESTS
+    {&register_testsuite_ns_crypto_bench, 0, 0, 0},
+#endif
+
+#ifdef ENABLE_ATTESTATION_SERVICE_TESTS
+    {&register_testsuite_ns_attestation_bench, 0, 0, 0},
+#endif
+
+    /* End of benchmark suites */
+    {0, 0, 0, 0}
+};
+
+/* To be called from a non-secure context, after the tests */
+enum test_suite_err_t tfm_non_secure_client_run_benchmarks(void)
+{
+    return bench_run_suites("Non-secure", bench_suites);
+}
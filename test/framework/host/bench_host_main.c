@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Runs the ITS and PS benchmark suites on the host, against the host build of
+ * the partitions of tools/tf_fuzz/harness, so that the PSA calls are direct
+ * calls to the services. The crypto and attestation suites need Mbed Crypto,
+ * and are only run on target.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+
+#include "tfz_host_spe.h"
+#include "test/framework/bench_framework.h"
+#include "test/suites/its/benchmark/its_bench_tests.h"
+#include "test/suites/ps/benchmark/ps_bench_tests.h"
+
+static struct test_suite_t bench_suites[] = {
+    {&register_testsuite_ns_psa_its_bench, 0, 0, 0},
+    {&register_testsuite_ns_psa_ps_bench, 0, 0, 0},
+
+    /* End of benchmark suites */
+    {0, 0, 0, 0}
+};
+
+int tfm_log_printf(const char *fmt, ...)
+{
+    va_list args;
+    int len;
+
+    va_start(args, fmt);
+    len = vprintf(fmt, args);
+    va_end(args);
+
+    return len;
+}
+
+int main(void)
+{
+    if (tfz_host_spe_reset() != PSA_SUCCESS) {
+        printf("Host SPE initialization failed\n");
+        return 2;
+    }
+
+    return bench_run_suites("Host", bench_suites) == TEST_SUITE_ERR_NO_ERROR ?
+           0 : 1;
+}
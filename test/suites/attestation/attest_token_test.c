@@ -296,6 +296,46 @@ int_fast16_t buffer_too_small_test()
 #endif /* INCLUDE_TEST_CODE */
 
 
+/*
+ * Public function. See token_test.h
+ */
+int_fast16_t get_size_test()
+{
+    int_fast16_t          return_value;
+    size_t                length;
+    Q_USEFUL_BUF_MAKE_STACK_UB(token_storage, ATTEST_TOKEN_MAX_SIZE);
+    struct q_useful_buf_c completed_token;
+    struct q_useful_buf_c nonce;
+
+    /* The nonce packs no option flags, so the token has all the claims */
+    nonce = TOKEN_TEST_VALUE_NONCE;
+
+    return_value = token_main_alt(0,
+                                  nonce,
+                                  token_storage,
+                                  &completed_token);
+    if(return_value) {
+        goto Done;
+    }
+
+    /* The static claims are known once a token has been created, so the
+     * size is calculated here rather than taken from creating a token.
+     */
+    return_value = psa_initial_attest_get_token_size(nonce.len,
+                                                     &length);
+    if(return_value) {
+        goto Done;
+    }
+
+    if(length != completed_token.len) {
+        return_value = -1;
+    }
+
+Done:
+    return return_value;
+}
+
+
 /**
  * \brief Check the simple IAT claims against compiled-in known values
  *
@@ -59,6 +59,15 @@ int_fast16_t minimal_get_size_test(void);
  */
 int_fast16_t buffer_too_small_test(void);
 
+
+/**
+ * \brief Check that the token size calculation matches the size of a
+ *        token with all the claims.
+ *
+ * \return non-zero on failure.
+ */
+int_fast16_t get_size_test(void);
+
 #ifdef SYMMETRIC_INITIAL_ATTESTATION
 /**
  * \brief Test by checking token generated by symmetric key algorithms based
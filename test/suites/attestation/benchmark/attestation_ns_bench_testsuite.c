@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string.h>
+
+#include "attestation_bench_tests.h"
+#include "test/framework/bench_framework.h"
+#include "test/framework/test_framework_helpers.h"
+#include "psa/initial_attestation.h"
+#include "../attestation_tests_common.h"
+
+static const uint32_t bench_challenge_sizes[] = {BENCH_TOKEN_CHALLENGE_SIZES};
+static uint8_t bench_challenge[PSA_INITIAL_ATTEST_CHALLENGE_SIZE_64];
+static uint8_t bench_token[TEST_TOKEN_SIZE];
+
+static void tfm_attest_bench_4001(struct test_result_t *ret);
+
+static struct test_t attestation_ns_benchs[] = {
+    {&tfm_attest_bench_4001, "TFM_ATTEST_BENCH_4001",
+     "Get token, per challenge size"},
+};
+
+void
+register_testsuite_ns_attestation_bench(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(attestation_ns_benchs) /
+                 sizeof(attestation_ns_benchs[0]));
+
+    set_testsuite("Initial Attestation Service NS benchmarks "
+                  "(TFM_ATTEST_BENCH_4XXX)",
+                  attestation_ns_benchs, list_size, p_test_suite);
+}
+
+/**
+ * \brief Times psa_initial_attest_get_token
+ */
+static void tfm_attest_bench_4001(struct test_result_t *ret)
+{
+    psa_status_t status = PSA_SUCCESS;
+    size_t token_size;
+    uint32_t i, j;
+
+    memset(bench_challenge, 0xA5, sizeof(bench_challenge));
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_challenge_sizes); i++) {
+        if (bench_challenge_sizes[i] > sizeof(bench_challenge)) {
+            TEST_FAIL("Attestation benchmark challenge is too big");
+            return;
+        }
+
+        bench_case_begin("challenge", bench_challenge_sizes[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            BENCH_TIME(status = psa_initial_attest_get_token(
+                                                    bench_challenge,
+                                                    bench_challenge_sizes[i],
+                                                    bench_token,
+                                                    sizeof(bench_token),
+                                                    &token_size));
+        }
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Get token should not fail with valid challenge");
+            return;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+}
@@ -25,6 +25,7 @@ static void tfm_attest_test_1003(struct test_result_t *ret);
 #endif
 static void tfm_attest_test_1004(struct test_result_t *ret);
 static void tfm_attest_test_1005(struct test_result_t *ret);
+static void tfm_attest_test_1006(struct test_result_t *ret);
 
 static struct test_t attestation_interface_tests[] = {
 #ifdef INCLUDE_TEST_CODE /* Remove them from release build */
@@ -39,6 +40,8 @@ static struct test_t attestation_interface_tests[] = {
      "ECDSA signature test of attest token", {TEST_PASSED} },
     {&tfm_attest_test_1005, "TFM_ATTEST_TEST_1005",
      "Negative test cases for initial attestation service", {TEST_PASSED} },
+    {&tfm_attest_test_1006, "TFM_ATTEST_TEST_1006",
+     "Token size test of attest token", {TEST_PASSED} },
 };
 
 void
@@ -181,3 +184,21 @@ static void tfm_attest_test_1005(struct test_result_t *ret)
 
     ret->val = TEST_PASSED;
 }
+
+/*!
+ * \brief Get the size of a token with all the claims, and compare it with
+ *        the size of the token itself
+ */
+static void tfm_attest_test_1006(struct test_result_t *ret)
+{
+    int32_t err;
+
+    err = get_size_test();
+    if (err != 0) {
+        TEST_LOG("get_size_test() returned: %d\r\n", err);
+        TEST_FAIL("Attest token get_size_test() has failed");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -28,7 +28,7 @@ extern "C" {
  * \brief Size in bytes of the local buffer. Size accomodates two standard size
  *        (no payload) log items, at maximum
  */
-#define LOCAL_BUFFER_SIZE (80)
+#define LOCAL_BUFFER_SIZE (LOCAL_BUFFER_ITEMS * STANDARD_LOG_ENTRY_SIZE)
 
 /*!
  * \def LOCAL_BUFFER_ITEMS
@@ -43,23 +43,27 @@ extern "C" {
  *
  * \brief A log item with no payload (standard size) has the following size.
  *        More details can be found observing \ref psa_audit_record
- *        \ref log_tlr and \ref log_hdr
+ *        \ref log_tlr and \ref log_hdr, i.e. 24 bytes of header with the
+ *        record ID, then the MAC
+ *
+ * \note The tests must include audit_core.h first, for LOG_MAC_SIZE
  */
-#define STANDARD_LOG_ENTRY_SIZE (28)
+#define STANDARD_LOG_ENTRY_SIZE (24 + LOG_MAC_SIZE)
 
 /*!
  * \def INITIAL_LOGGING_REQUESTS
  *
  * \brief Number of initial consecutive logging requests to perform
  */
-#define INITIAL_LOGGING_REQUESTS (36)
+#define INITIAL_LOGGING_REQUESTS (MAX_LOG_SIZE / STANDARD_LOG_ENTRY_SIZE)
 
 /*!
  * \def INITIAL_LOGGING_SIZE
  *
  * \brief Size of the initial consecutive logging requests
  */
-#define INITIAL_LOGGING_SIZE (1008)
+#define INITIAL_LOGGING_SIZE (INITIAL_LOGGING_REQUESTS * \
+                              STANDARD_LOG_ENTRY_SIZE)
 
 /*!
  * \def FINAL_LOGGING_REQUESTS
@@ -79,7 +83,7 @@ extern "C" {
  * \note This defines the state of the log when secure interface tests are
  *       terminated
  */
-#define FINAL_LOGGING_SIZE (56)
+#define FINAL_LOGGING_SIZE (FINAL_LOGGING_REQUESTS * STANDARD_LOG_ENTRY_SIZE)
 
 /*!
  * \def DUMMY_TEST_RECORD_ID_BASE
@@ -115,7 +119,7 @@ extern "C" {
  * \note This takes into account additional fields that are concatenated to the
  *       record in the header and trailer
  */
-#define MAX_LOG_RECORD_SIZE (1000)
+#define MAX_LOG_RECORD_SIZE (MAX_LOG_SIZE - 20 - LOG_MAC_SIZE)
 
 /*!
  * \def INITIAL_LOG_SIZE
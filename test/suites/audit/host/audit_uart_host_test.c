@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Tests the transmit ring of the UART redirection (AUDIT_UART_ASYNC) on the
+ * host. The audit core is built as is, against a stub USART driver whose
+ * transfers only complete when a test says so, which stands for the UART
+ * interrupt. The characters of a transfer are only read on completion, so an
+ * entry staged over characters still in flight shows in the output.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Driver_USART.h"
+#include "tfm_secure_api.h"
+#include "test/framework/test_framework.h"
+#include "secure_fw/partitions/audit_logging/audit_core.h"
+
+/*!
+ * \def UART_OUT_SIZE
+ *
+ * \brief Size of the buffers of the characters sent, and expected, by a test
+ */
+#define UART_OUT_SIZE (16384)
+
+/*!
+ * \def TEST_LOG_SIZE
+ *
+ * \brief Size of the log of the audit core, LOG_SIZE in audit_core.c
+ */
+#define TEST_LOG_SIZE (1024)
+
+/*!
+ * \def MAX_PAYLOAD_SIZE
+ *
+ * \brief Payload of the largest record the log takes, i.e. a record which
+ *        fills the whole log
+ */
+#define MAX_PAYLOAD_SIZE (TEST_LOG_SIZE - LOG_HDR_SIZE - LOG_TLR_SIZE)
+
+/* Any secure partition, as records from the NS world are refused */
+#define TEST_CALLER_ID (0x100)
+
+static const char hex_digits[] = "0123456789ABCDEF";
+
+/* State of the stub USART driver */
+static ARM_USART_SignalEvent_t uart_cb_event;
+static const uint8_t *uart_tx_data;     /* Transfer in progress, or NULL */
+static uint32_t uart_tx_num;
+static uint32_t uart_num_sends;         /* Transfers started */
+static uint32_t uart_fail_sends;        /* Transfers to refuse */
+
+static uint8_t uart_out[UART_OUT_SIZE];
+static uint32_t uart_out_len;
+static uint8_t expected[UART_OUT_SIZE];
+static uint32_t expected_len;
+
+static int32_t uart_initialize(ARM_USART_SignalEvent_t cb_event)
+{
+    uart_cb_event = cb_event;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t uart_control(uint32_t control, uint32_t arg)
+{
+    (void)control;
+    (void)arg;
+    return ARM_DRIVER_OK;
+}
+
+static int32_t uart_send(const void *data, uint32_t num)
+{
+    if (uart_tx_data != NULL) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    if ((data == NULL) || (num == 0)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    if (uart_fail_sends > 0) {
+        uart_fail_sends--;
+        return ARM_DRIVER_ERROR;
+    }
+
+    uart_tx_data = data;
+    uart_tx_num = num;
+    uart_num_sends++;
+
+    return ARM_DRIVER_OK;
+}
+
+ARM_DRIVER_USART Driver_USART1 = {
+    .Initialize = uart_initialize,
+    .Send = uart_send,
+    .Control = uart_control,
+};
+
+int32_t tfm_core_get_caller_client_id(int32_t *caller_client_id)
+{
+    *caller_client_id = TEST_CALLER_ID;
+    return (int32_t)TFM_SUCCESS;
+}
+
+int tfm_log_printf(const char *fmt, ...)
+{
+    va_list args;
+    int len;
+
+    va_start(args, fmt);
+    len = vprintf(fmt, args);
+    va_end(args);
+
+    return len;
+}
+
+/*!
+ * \brief Completes the transfer in progress, as the UART interrupt would
+ *
+ * \return 1 if a transfer was completed, 0 if the UART was idle
+ */
+static int uart_complete(void)
+{
+    uint32_t num = uart_tx_num;
+
+    if (uart_tx_data == NULL) {
+        return 0;
+    }
+
+    if (num > (UART_OUT_SIZE - uart_out_len)) {
+        num = UART_OUT_SIZE - uart_out_len;
+    }
+    memcpy(&uart_out[uart_out_len], uart_tx_data, num);
+    uart_out_len += num;
+
+    uart_tx_data = NULL;
+    uart_cb_event(ARM_USART_EVENT_SEND_COMPLETE);
+
+    return 1;
+}
+
+/*!
+ * \brief Completes the transfers until the transmit ring is empty
+ */
+static void uart_drain(void)
+{
+    while (uart_complete()) {
+    }
+}
+
+static void test_reset_output(void)
+{
+    uart_out_len = 0;
+    expected_len = 0;
+    uart_num_sends = 0;
+}
+
+static void expect_string(const char *str)
+{
+    uint32_t len = strlen(str);
+
+    memcpy(&expected[expected_len], str, len);
+    expected_len += len;
+}
+
+/*!
+ * \brief Adds a record of payload_size bytes to the log
+ *
+ * \param[in] id           ID of the record, also the seed of its payload
+ * \param[in] payload_size Size of the payload, a multiple of 4
+ * \param[in] sent         Whether the record is expected on the UART, in
+ *                         which case it is appended to the expected output
+ *
+ * \return Returns values as specified by the \ref psa_status_t
+ */
+static psa_status_t test_add_record(uint32_t id, uint32_t payload_size,
+                                    int sent)
+{
+    static uint32_t record_buf[TEST_LOG_SIZE / sizeof(uint32_t)];
+    static uint8_t entry[TEST_LOG_SIZE];
+    struct psa_audit_record *record = (struct psa_audit_record *)record_buf;
+    uint32_t num_records, stored_size, record_index, idx;
+    psa_invec in_vec[2];
+    psa_outvec out_vec[2];
+    psa_status_t status;
+
+    record->size = LOG_MIN_SIZE + payload_size;
+    record->id = id;
+    for (idx = 0; idx < payload_size; idx++) {
+        record->payload[idx] = (uint8_t)(id + idx);
+    }
+
+    in_vec[0].base = record;
+    in_vec[0].len = sizeof(struct psa_audit_record);
+    status = audit_core_add_record(in_vec, 1, NULL, 0);
+    if ((status != PSA_SUCCESS) || !sent) {
+        return status;
+    }
+
+    /* The UART sends the entry as it is in the log, the newest record */
+    out_vec[0].base = &num_records;
+    out_vec[0].len = sizeof(num_records);
+    out_vec[1].base = &stored_size;
+    out_vec[1].len = sizeof(stored_size);
+    status = audit_core_get_info(NULL, 0, out_vec, 2);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    record_index = num_records - 1;
+    in_vec[0].base = &record_index;
+    in_vec[0].len = sizeof(record_index);
+    in_vec[1].base = NULL;
+    in_vec[1].len = 0;
+    out_vec[0].base = entry;
+    out_vec[0].len = sizeof(entry);
+    status = audit_core_retrieve_record(in_vec, 2, out_vec, 1);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    for (idx = 0; idx < out_vec[0].len; idx++) {
+        expected[expected_len++] = hex_digits[entry[idx] >> 4];
+        expected[expected_len++] = hex_digits[entry[idx] & 0xF];
+        expected[expected_len++] = ' ';
+    }
+    expect_string("\r\n");
+
+    return PSA_SUCCESS;
+}
+
+static int test_output_matches(void)
+{
+    return (uart_out_len == expected_len) &&
+           (memcmp(uart_out, expected, expected_len) == 0);
+}
+
+/* List of tests */
+static void tfm_audit_test_2001(struct test_result_t *ret);
+static void tfm_audit_test_2002(struct test_result_t *ret);
+static void tfm_audit_test_2003(struct test_result_t *ret);
+static void tfm_audit_test_2004(struct test_result_t *ret);
+static void tfm_audit_test_2005(struct test_result_t *ret);
+
+static struct test_t audit_uart_tests[] = {
+    {&tfm_audit_test_2001, "TFM_AUDIT_TEST_2001",
+     "Record sent in the background", {TEST_PASSED} },
+    {&tfm_audit_test_2002, "TFM_AUDIT_TEST_2002",
+     "Records staged while the UART is busy", {TEST_PASSED} },
+    {&tfm_audit_test_2003, "TFM_AUDIT_TEST_2003",
+     "Records dropped when the ring is full", {TEST_PASSED} },
+    {&tfm_audit_test_2004, "TFM_AUDIT_TEST_2004",
+     "Transfers split at the end of the ring", {TEST_PASSED} },
+    {&tfm_audit_test_2005, "TFM_AUDIT_TEST_2005",
+     "Transfer retried after a failed send", {TEST_PASSED} },
+};
+
+static void register_testsuite_audit_uart(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(audit_uart_tests) / sizeof(audit_uart_tests[0]));
+
+    set_testsuite("AuditLog UART redirection host test (TFM_AUDIT_TEST_2XXX)",
+                  audit_uart_tests, list_size, p_test_suite);
+}
+
+/**
+ * \brief Adding a record with the UART idle starts a transfer and returns
+ *        without waiting for it
+ */
+static void tfm_audit_test_2001(struct test_result_t *ret)
+{
+    test_reset_output();
+
+    if (test_add_record(0x2001, 16, 1) != PSA_SUCCESS) {
+        TEST_FAIL("Record should be added to the log");
+        return;
+    }
+
+    if ((uart_num_sends != 1) || (uart_out_len != 0)) {
+        TEST_FAIL("Record should be sending, and not sent yet");
+        return;
+    }
+
+    uart_drain();
+
+    if (!test_output_matches()) {
+        TEST_FAIL("UART output should be the hex values of the entry");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Records added during a transfer are sent in order once it completes
+ */
+static void tfm_audit_test_2002(struct test_result_t *ret)
+{
+    uint32_t id;
+
+    test_reset_output();
+
+    for (id = 0x2020; id < 0x2024; id++) {
+        if (test_add_record(id, (id & 0x3) * 4, 1) != PSA_SUCCESS) {
+            TEST_FAIL("Record should be added to the log");
+            return;
+        }
+    }
+
+    if (uart_num_sends != 1) {
+        TEST_FAIL("Records should wait for the transfer in progress");
+        return;
+    }
+
+    uart_drain();
+
+    if (!test_output_matches()) {
+        TEST_FAIL("UART output should be the entries in order");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief A record which does not fit in the free space of the ring is dropped
+ *        as a whole, and the drops are reported before the next record sent
+ */
+static void tfm_audit_test_2003(struct test_result_t *ret)
+{
+    test_reset_output();
+
+    /* The ring holds a record of the size of the whole log */
+    if (test_add_record(0x2030, MAX_PAYLOAD_SIZE, 1) != PSA_SUCCESS) {
+        TEST_FAIL("Largest record should be added to the log");
+        return;
+    }
+
+    /* The record being sent leaves no space for two more of its size */
+    if ((test_add_record(0x2031, MAX_PAYLOAD_SIZE, 0) != PSA_SUCCESS) ||
+        (test_add_record(0x2032, MAX_PAYLOAD_SIZE, 0) != PSA_SUCCESS)) {
+        TEST_FAIL("Records should be added even if the ring is full");
+        return;
+    }
+
+    uart_drain();
+
+    /* No entry was dropped before this test */
+    expect_string("DROPPED 00000002\r\n");
+    if (test_add_record(0x2033, MAX_PAYLOAD_SIZE, 1) != PSA_SUCCESS) {
+        TEST_FAIL("Record should be added to the log");
+        return;
+    }
+
+    uart_drain();
+
+    if (!test_output_matches()) {
+        TEST_FAIL("UART output should report the dropped entries");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Entries crossing the end of the ring are sent in two transfers
+ */
+static void tfm_audit_test_2004(struct test_result_t *ret)
+{
+    uint32_t id;
+
+    test_reset_output();
+
+    for (id = 0x2040; id < 0x2045; id++) {
+        if (test_add_record(id, MAX_PAYLOAD_SIZE, 1) != PSA_SUCCESS) {
+            TEST_FAIL("Record should be added to the log");
+            return;
+        }
+        uart_drain();
+    }
+
+    /* More than a ring of characters was sent, so the ring has wrapped */
+    if (uart_num_sends <= (id - 0x2040)) {
+        TEST_FAIL("An entry should have been split at the end of the ring");
+        return;
+    }
+
+    if (!test_output_matches()) {
+        TEST_FAIL("UART output should be the entries in order");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief An entry whose transfer could not be started stays in the ring, and
+ *        is sent with the next entry
+ */
+static void tfm_audit_test_2005(struct test_result_t *ret)
+{
+    test_reset_output();
+
+    uart_fail_sends = 1;
+    if (test_add_record(0x2050, 8, 1) != PSA_SUCCESS) {
+        TEST_FAIL("Record should be added to the log");
+        return;
+    }
+
+    if ((uart_num_sends != 0) || (uart_fail_sends != 0)) {
+        TEST_FAIL("Transfer should have been refused");
+        return;
+    }
+
+    if (test_add_record(0x2051, 8, 1) != PSA_SUCCESS) {
+        TEST_FAIL("Record should be added to the log");
+        return;
+    }
+
+    uart_drain();
+
+    if (!test_output_matches()) {
+        TEST_FAIL("UART output should hold both entries");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+int main(void)
+{
+    struct test_suite_t suite = {&register_testsuite_audit_uart, 0, 0, 0};
+
+    if (audit_core_init() != PSA_SUCCESS) {
+        printf("Audit core initialization failed\n");
+        return 2;
+    }
+
+    suite.freg(&suite);
+
+    return run_testsuite(&suite) == TEST_SUITE_ERR_NO_ERROR ? 0 : 1;
+}
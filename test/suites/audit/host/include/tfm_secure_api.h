@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_SECURE_API_H__
+#define __TFM_SECURE_API_H__
+
+/* The part of the secure API used by the audit core built for the host. The
+ * caller ID is set by the test, see audit_uart_host_test.c.
+ */
+
+#include <stdint.h>
+#include "cmsis_compiler.h"
+#include "tfm_api.h"
+
+int32_t tfm_core_get_caller_client_id(int32_t *caller_client_id);
+
+#endif /* __TFM_SECURE_API_H__ */
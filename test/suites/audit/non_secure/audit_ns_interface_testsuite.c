@@ -204,6 +204,97 @@ static void tfm_audit_test_1001(struct test_result_t *ret)
         return;
     }
 
+    /* Retrieve the full contents of the log in a single request */
+    status = psa_audit_retrieve_records(0,
+                                        INITIAL_LOG_RECORDS,
+                                        LOCAL_BUFFER_SIZE,
+                                        &local_buffer[0],
+                                        &num_records,
+                                        &retrieved_size);
+
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Bulk log retrieval from NS returned error");
+        return;
+    }
+
+    if ((num_records != INITIAL_LOG_RECORDS) ||
+        (retrieved_size != INITIAL_LOG_SIZE)) {
+        TEST_FAIL("Bulk retrieval must return the full contents of the log");
+        return;
+    }
+
+    retrieved_buffer = (struct psa_audit_record *)
+        &local_buffer[STANDARD_LOG_ENTRY_SIZE + offsetof(struct log_hdr, size)];
+
+    if (retrieved_buffer->id != SECOND_ELEMENT_EXPECTED_CONTENT) {
+        TEST_FAIL("Unexpected argument in the second bulk retrieved entry");
+        return;
+    }
+
+    /* Retrieve into a buffer which can hold a single element only. The
+     * request must return the first element only
+     */
+    status = psa_audit_retrieve_records(0,
+                                        INITIAL_LOG_RECORDS,
+                                        STANDARD_LOG_ENTRY_SIZE + 4,
+                                        &local_buffer[0],
+                                        &num_records,
+                                        &retrieved_size);
+
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Bulk log retrieval from NS returned error");
+        return;
+    }
+
+    if ((num_records != SINGLE_RETRIEVED_LOG_ITEMS) ||
+        (retrieved_size != SINGLE_RETRIEVED_LOG_SIZE)) {
+        TEST_FAIL("Bulk retrieval must return whole records only");
+        return;
+    }
+
+    /* Verify the chain of MACs of the log */
+    status = psa_audit_verify_records(0, INITIAL_LOG_RECORDS);
+#ifdef AUDIT_RECORD_MAC
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Verification of the log records has failed");
+        return;
+    }
+#else
+    if (status != PSA_ERROR_NOT_SUPPORTED) {
+        TEST_FAIL("Verification must not be supported without record MACs");
+        return;
+    }
+#endif
+
+    /* Read the oldest record of the persistent copy of the log */
+    status = psa_audit_get_record_info(PSA_AUDIT_STORED_RECORD, &stored_size);
+#ifdef AUDIT_PERSISTENT_LOG
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Getting the info of a stored record has returned error");
+        return;
+    }
+
+    status = psa_audit_retrieve_records(PSA_AUDIT_STORED_RECORD,
+                                        1,
+                                        LOCAL_BUFFER_SIZE,
+                                        &local_buffer[0],
+                                        &num_records,
+                                        &retrieved_size);
+
+    if ((status != PSA_SUCCESS) ||
+        (num_records != SINGLE_RETRIEVED_LOG_ITEMS) ||
+        (retrieved_size != stored_size)) {
+        TEST_FAIL("Stored record retrieval from NS returned error");
+        return;
+    }
+#else
+    if (status != PSA_ERROR_NOT_SUPPORTED) {
+        TEST_FAIL("Stored records must not be supported without a persistent "
+                  "log");
+        return;
+    }
+#endif
+
     /* Delete oldest element in the log */
     status = psa_audit_delete_record(0, NULL, 0);
     if (status != PSA_SUCCESS) {
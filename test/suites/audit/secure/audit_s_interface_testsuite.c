@@ -69,8 +69,8 @@ static void tfm_audit_test_1001(struct test_result_t *ret)
     uint32_t num_records, stored_size, record_size;
     struct psa_audit_record *retrieved_buffer;
 
-    /* Fill the log with 36 records, each record is 28 bytes
-     * we end up filling the log without wrapping
+    /* Fill the log with standard size records (36 records of 28 bytes
+     * without record MACs), we end up filling the log without wrapping
      */
     for (idx=0; idx<INITIAL_LOGGING_REQUESTS; idx++) {
         record->size = sizeof(struct psa_audit_record) - 4;
@@ -393,5 +393,24 @@ static void tfm_audit_test_1001(struct test_result_t *ret)
         return;
     }
 
+    /* Write the records added so far to the persistent log */
+    status = psa_audit_flush();
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Flushing the log has returned an error");
+        return;
+    }
+
+    /* The log is not changed by the flush */
+    status = psa_audit_get_info(&num_records, &stored_size);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Getting log info has returned error");
+        return;
+    }
+
+    if (num_records != FINAL_LOGGING_REQUESTS) {
+        TEST_FAIL("Expected log records are " STR(FINAL_LOGGING_REQUESTS));
+        return;
+    }
+
     ret->val = TEST_PASSED;
 }
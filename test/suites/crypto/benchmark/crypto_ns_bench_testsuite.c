@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string.h>
+
+#include "crypto_bench_tests.h"
+#include "test/framework/bench_framework.h"
+#include "test/framework/test_framework_helpers.h"
+#include "psa/crypto.h"
+
+/* Largest input of any of the benchmarks */
+#define BENCH_MAX_DATA_SIZE     (4096u)
+#define BENCH_AEAD_NONCE_SIZE   (12u)
+#define BENCH_AEAD_ALG          PSA_ALG_GCM
+#define BENCH_SIGN_ALG          PSA_ALG_ECDSA(PSA_ALG_SHA_256)
+#define BENCH_SIGN_CURVE_BITS   (256u)
+
+static const uint32_t bench_hash_sizes[] = {BENCH_HASH_SIZES};
+static const uint32_t bench_aead_sizes[] = {BENCH_AEAD_SIZES};
+static const uint32_t bench_sign_sizes[] = {BENCH_SIGN_SIZES};
+
+static uint8_t bench_input[BENCH_MAX_DATA_SIZE];
+static uint8_t bench_output[PSA_AEAD_ENCRYPT_OUTPUT_SIZE(BENCH_AEAD_ALG,
+                                                         BENCH_MAX_DATA_SIZE)];
+
+static void tfm_crypto_bench_3001(struct test_result_t *ret);
+static void tfm_crypto_bench_3002(struct test_result_t *ret);
+static void tfm_crypto_bench_3003(struct test_result_t *ret);
+
+static struct test_t crypto_ns_benchs[] = {
+    {&tfm_crypto_bench_3001, "TFM_CRYPTO_BENCH_3001",
+     "SHA-256 multipart hash, per input size"},
+    {&tfm_crypto_bench_3002, "TFM_CRYPTO_BENCH_3002",
+     "AES-128-GCM AEAD encrypt, per plaintext size"},
+    {&tfm_crypto_bench_3003, "TFM_CRYPTO_BENCH_3003",
+     "SHA-256 and ECDSA P-256 sign, per message size"},
+};
+
+void register_testsuite_ns_crypto_bench(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(crypto_ns_benchs) / sizeof(crypto_ns_benchs[0]));
+
+    set_testsuite("Crypto NS benchmarks (TFM_CRYPTO_BENCH_3XXX)",
+                  crypto_ns_benchs, list_size, p_test_suite);
+}
+
+/**
+ * \brief Hashes a message with a multipart operation, as the crypto service
+ *        does not implement psa_hash_compute
+ *
+ * \param[in]  input       Message to hash
+ * \param[in]  input_len   Size of the message
+ * \param[out] hash        Buffer for the hash
+ * \param[in]  hash_size   Size of the buffer
+ * \param[out] hash_len    Size of the hash
+ *
+ * \return Returns the status of the failing step, or PSA_SUCCESS
+ */
+static psa_status_t bench_hash_sha256(const uint8_t *input, size_t input_len,
+                                      uint8_t *hash, size_t hash_size,
+                                      size_t *hash_len)
+{
+    psa_hash_operation_t handle = psa_hash_operation_init();
+    psa_status_t status;
+
+    status = psa_hash_setup(&handle, PSA_ALG_SHA_256);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = psa_hash_update(&handle, input, input_len);
+    if (status == PSA_SUCCESS) {
+        status = psa_hash_finish(&handle, hash, hash_size, hash_len);
+    }
+    if (status != PSA_SUCCESS) {
+        (void)psa_hash_abort(&handle);
+    }
+
+    return status;
+}
+
+/**
+ * \brief Times hashing with psa_hash_setup, psa_hash_update and
+ *        psa_hash_finish
+ */
+static void tfm_crypto_bench_3001(struct test_result_t *ret)
+{
+    psa_status_t status = PSA_SUCCESS;
+    size_t hash_len;
+    uint32_t i, j;
+
+    memset(bench_input, 0xA5, sizeof(bench_input));
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_hash_sizes); i++) {
+        if (bench_hash_sizes[i] > BENCH_MAX_DATA_SIZE) {
+            TEST_FAIL("Hash benchmark size is too big");
+            return;
+        }
+
+        bench_case_begin("size", bench_hash_sizes[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            BENCH_TIME(status = bench_hash_sha256(bench_input,
+                                                  bench_hash_sizes[i],
+                                                  bench_output,
+                                                  sizeof(bench_output),
+                                                  &hash_len));
+        }
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error computing the hash");
+            return;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Times psa_aead_encrypt, with an imported key
+ */
+static void tfm_crypto_bench_3002(struct test_result_t *ret)
+{
+    static const uint8_t key_data[] = "THIS IS MY KEY1";
+    static const uint8_t nonce[BENCH_AEAD_NONCE_SIZE] = {0};
+    static const uint8_t associated_data[] = "This is associated data";
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+    psa_key_handle_t key_handle;
+    psa_status_t status;
+    size_t out_len;
+    uint32_t i, j;
+
+    psa_set_key_usage_flags(&key_attributes, PSA_KEY_USAGE_ENCRYPT);
+    psa_set_key_algorithm(&key_attributes, BENCH_AEAD_ALG);
+    psa_set_key_type(&key_attributes, PSA_KEY_TYPE_AES);
+
+    status = psa_import_key(&key_attributes, key_data, 16, &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error importing a key");
+        return;
+    }
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_aead_sizes); i++) {
+        if (bench_aead_sizes[i] > BENCH_MAX_DATA_SIZE) {
+            TEST_FAIL("AEAD benchmark size is too big");
+            goto destroy_key;
+        }
+
+        bench_case_begin("size", bench_aead_sizes[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            BENCH_TIME(status = psa_aead_encrypt(key_handle, BENCH_AEAD_ALG,
+                                                 nonce, sizeof(nonce),
+                                                 associated_data,
+                                                 sizeof(associated_data),
+                                                 bench_input,
+                                                 bench_aead_sizes[i],
+                                                 bench_output,
+                                                 sizeof(bench_output),
+                                                 &out_len));
+        }
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error performing AEAD encryption");
+            goto destroy_key;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+
+destroy_key:
+    (void)psa_destroy_key(key_handle);
+}
+
+/**
+ * \brief Times hashing a message and signing the hash, with a generated key
+ */
+static void tfm_crypto_bench_3003(struct test_result_t *ret)
+{
+    psa_key_attributes_t key_attributes = psa_key_attributes_init();
+    psa_key_handle_t key_handle;
+    uint8_t hash[PSA_HASH_SIZE(PSA_ALG_SHA_256)];
+    uint8_t signature[PSA_ECDSA_SIGNATURE_SIZE(BENCH_SIGN_CURVE_BITS)];
+    size_t hash_len, signature_len;
+    psa_status_t status;
+    uint32_t i, j;
+
+    psa_set_key_usage_flags(&key_attributes, PSA_KEY_USAGE_SIGN_HASH);
+    psa_set_key_algorithm(&key_attributes, BENCH_SIGN_ALG);
+    psa_set_key_type(&key_attributes,
+                     PSA_KEY_TYPE_ECC_KEY_PAIR(PSA_ECC_CURVE_SECP256R1));
+    psa_set_key_bits(&key_attributes, BENCH_SIGN_CURVE_BITS);
+
+    status = psa_generate_key(&key_attributes, &key_handle);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Error generating a key");
+        return;
+    }
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_sign_sizes); i++) {
+        if (bench_sign_sizes[i] > BENCH_MAX_DATA_SIZE) {
+            TEST_FAIL("Sign benchmark size is too big");
+            goto destroy_key;
+        }
+
+        bench_case_begin("size", bench_sign_sizes[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            BENCH_TIME(
+                status = bench_hash_sha256(bench_input, bench_sign_sizes[i],
+                                           hash, sizeof(hash), &hash_len);
+                if (status == PSA_SUCCESS) {
+                    status = psa_sign_hash(key_handle, BENCH_SIGN_ALG, hash,
+                                           hash_len, signature,
+                                           sizeof(signature), &signature_len);
+                });
+        }
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Error hashing and signing the message");
+            goto destroy_key;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+
+destroy_key:
+    (void)psa_destroy_key(key_handle);
+}
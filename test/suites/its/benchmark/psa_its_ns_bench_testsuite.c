@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string.h>
+
+#include "its_bench_tests.h"
+#include "test/framework/bench_framework.h"
+#include "test/framework/test_framework_helpers.h"
+#include "psa/internal_trusted_storage.h"
+
+/* UID of the asset the benchmarks work on, apart from those of the tests */
+#define BENCH_ITS_UID           ((psa_storage_uid_t)0xBE000001u)
+#define BENCH_ITS_MAX_SIZE      (512u)
+
+static const uint32_t bench_its_sizes[] = {BENCH_ITS_SIZES};
+static uint8_t bench_its_data[BENCH_ITS_MAX_SIZE];
+
+static void tfm_its_bench_1001(struct test_result_t *ret);
+static void tfm_its_bench_1002(struct test_result_t *ret);
+static void tfm_its_bench_1003(struct test_result_t *ret);
+
+static struct test_t psa_its_ns_benchs[] = {
+    {&tfm_its_bench_1001, "TFM_ITS_BENCH_1001",
+     "Set interface, per data size"},
+    {&tfm_its_bench_1002, "TFM_ITS_BENCH_1002",
+     "Get interface, per data size"},
+    {&tfm_its_bench_1003, "TFM_ITS_BENCH_1003",
+     "Remove interface, per data size"},
+};
+
+void register_testsuite_ns_psa_its_bench(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(psa_its_ns_benchs) / sizeof(psa_its_ns_benchs[0]));
+
+    set_testsuite("PSA internal trusted storage NS benchmarks "
+                  "(TFM_ITS_BENCH_1XXX)",
+                  psa_its_ns_benchs, list_size, p_test_suite);
+}
+
+/**
+ * \brief Times psa_its_set of an asset, replacing the one already there
+ */
+static void tfm_its_bench_1001(struct test_result_t *ret)
+{
+    psa_status_t status = PSA_SUCCESS;
+    uint32_t i, j;
+
+    memset(bench_its_data, 0xA5, sizeof(bench_its_data));
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_its_sizes); i++) {
+        if (bench_its_sizes[i] > BENCH_ITS_MAX_SIZE) {
+            TEST_FAIL("ITS benchmark size is too big");
+            return;
+        }
+
+        bench_case_begin("size", bench_its_sizes[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            BENCH_TIME(status = psa_its_set(BENCH_ITS_UID, bench_its_sizes[i],
+                                            bench_its_data,
+                                            PSA_STORAGE_FLAG_NONE));
+        }
+        (void)psa_its_remove(BENCH_ITS_UID);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Set should not fail with valid UID");
+            return;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Times psa_its_get of a whole asset
+ */
+static void tfm_its_bench_1002(struct test_result_t *ret)
+{
+    psa_status_t status;
+    size_t read_len;
+    uint32_t i, j;
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_its_sizes); i++) {
+        if (bench_its_sizes[i] > BENCH_ITS_MAX_SIZE) {
+            TEST_FAIL("ITS benchmark size is too big");
+            return;
+        }
+
+        status = psa_its_set(BENCH_ITS_UID, bench_its_sizes[i],
+                             bench_its_data, PSA_STORAGE_FLAG_NONE);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Set should not fail with valid UID");
+            return;
+        }
+
+        bench_case_begin("size", bench_its_sizes[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            BENCH_TIME(status = psa_its_get(BENCH_ITS_UID, 0,
+                                            bench_its_sizes[i],
+                                            bench_its_data, &read_len));
+        }
+        (void)psa_its_remove(BENCH_ITS_UID);
+        if (status != PSA_SUCCESS || read_len != bench_its_sizes[i]) {
+            TEST_FAIL("Get should not fail with valid UID");
+            return;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Times psa_its_remove; the asset is set again, untimed, before each
+ *        remove
+ */
+static void tfm_its_bench_1003(struct test_result_t *ret)
+{
+    psa_status_t status = PSA_SUCCESS;
+    uint32_t i, j;
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_its_sizes); i++) {
+        if (bench_its_sizes[i] > BENCH_ITS_MAX_SIZE) {
+            TEST_FAIL("ITS benchmark size is too big");
+            return;
+        }
+
+        bench_case_begin("size", bench_its_sizes[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            status = psa_its_set(BENCH_ITS_UID, bench_its_sizes[i],
+                                 bench_its_data, PSA_STORAGE_FLAG_NONE);
+            if (status == PSA_SUCCESS) {
+                BENCH_TIME(status = psa_its_remove(BENCH_ITS_UID));
+            }
+        }
+        (void)psa_its_remove(BENCH_ITS_UID);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Set and remove should not fail with valid UID");
+            return;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+}
@@ -1049,3 +1049,114 @@ void tfm_its_test_common_019(struct test_result_t *ret)
 
     ret->val = TEST_PASSED;
 }
+
+void tfm_its_test_common_020(struct test_result_t *ret)
+{
+    psa_status_t status;
+    const psa_storage_uid_t uid_1 = TEST_UID_1;
+    const psa_storage_uid_t uid_2 = TEST_UID_2;
+    const psa_storage_uid_t uid_3 = TEST_UID_3;
+    const psa_storage_create_flags_t flags = PSA_STORAGE_FLAG_NONE;
+    const size_t data_len = WRITE_DATA_SIZE;
+    const size_t offset = 0;
+    const uint8_t write_data[] = WRITE_DATA;
+    const uint8_t write_data_3[] = "ONE_MORE_ASSET";
+    uint8_t read_data[] = READ_DATA;
+    size_t read_data_length = 0;
+    int comp_result;
+
+    /* Set UID 1 with no data */
+    status = psa_its_set(uid_1, 0, write_data, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail for UID 1 with no data");
+        return;
+    }
+
+    /* Set UID 2, its data starts where UID 1 would have its data */
+    status = psa_its_set(uid_2, data_len, write_data, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail for UID 2");
+        return;
+    }
+
+    /* Remove UID 1. UID 2 must be kept when the block is compacted */
+    status = psa_its_remove(uid_1);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail for UID 1");
+        return;
+    }
+
+    status = psa_its_get(uid_2, offset, data_len,
+                         read_data + HALF_PADDING_SIZE, &read_data_length);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Get should not fail for UID 2");
+        return;
+    }
+
+#if DOMAIN_NS == 1U
+    comp_result = memcmp(read_data, RESULT_DATA, sizeof(read_data));
+#else
+    comp_result = tfm_memcmp(read_data, RESULT_DATA, sizeof(read_data));
+#endif
+    if (comp_result != 0) {
+        TEST_FAIL("Read buffer has incorrect data for UID 2");
+        return;
+    }
+
+    /* Set UID 3 in the space freed by UID 1 */
+    status = psa_its_set(uid_3, sizeof(write_data_3), write_data_3, flags);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Set should not fail for UID 3");
+        return;
+    }
+
+    status = psa_its_get(uid_3, offset, sizeof(write_data_3), read_data,
+                         &read_data_length);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Get should not fail for UID 3");
+        return;
+    }
+
+#if DOMAIN_NS == 1U
+    comp_result = memcmp(read_data, write_data_3, sizeof(write_data_3));
+#else
+    comp_result = tfm_memcmp(read_data, write_data_3, sizeof(write_data_3));
+#endif
+    if (comp_result != 0) {
+        TEST_FAIL("Read buffer has incorrect data for UID 3");
+        return;
+    }
+
+    /* UID 2 must not have been overwritten by UID 3 */
+    status = psa_its_get(uid_2, offset, data_len, read_data,
+                         &read_data_length);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Get should not fail for UID 2 after set of UID 3");
+        return;
+    }
+
+#if DOMAIN_NS == 1U
+    comp_result = memcmp(read_data, write_data, data_len);
+#else
+    comp_result = tfm_memcmp(read_data, write_data, data_len);
+#endif
+    if (comp_result != 0) {
+        TEST_FAIL("UID 2 has been corrupted by the set of UID 3");
+        return;
+    }
+
+    /* Remove UID 2 and UID 3 to clean up storage for the next test */
+    status = psa_its_remove(uid_2);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail for UID 2");
+        return;
+    }
+
+    status = psa_its_remove(uid_3);
+    if (status != PSA_SUCCESS) {
+        TEST_FAIL("Remove should not fail for UID 3");
+        return;
+    }
+
+    ret->val = TEST_PASSED;
+}
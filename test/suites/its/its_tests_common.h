@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2020, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -230,6 +230,17 @@ void tfm_its_test_common_018(struct test_result_t *ret);
  */
 void tfm_its_test_common_019(struct test_result_t *ret);
 
+/**
+ * \brief Tests data block compact feature with an empty asset.
+ *        Set UID 1 with no data, then set UID 2, which starts at the same
+ *        position in the block. Remove UID 1 and check that UID 2 is still
+ *        read back correctly, then that the space freed can be used by UID 3
+ *        without corrupting UID 2.
+ *
+ * \param[out] ret  Test result
+ */
+void tfm_its_test_common_020(struct test_result_t *ret);
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,10 +8,34 @@
 #include "platform_ns_tests.h"
 #include "tfm_platform_api.h"
 #include "platform_tests_common.h"
+#include "tfm_spm_trace_defs.h"
+#include "tfm_mem_profile_defs.h"
+#include "tfm_boot_profile_defs.h"
+#include "psa_manifest/pid.h"
+
+/* Number of SPM trace events read at once by the tests */
+#define TRACE_TEST_EVENTS (16)
+
+/* Number of partitions of the memory profile read by the tests */
+#define MEM_PROFILE_TEST_ENTRIES (16)
+
+/* Number of boot phases read by the tests */
+#define BOOT_PROFILE_TEST_ENTRIES (32)
+
+/* List of tests */
+static void tfm_platform_test_2002(struct test_result_t *ret);
+static void tfm_platform_test_2003(struct test_result_t *ret);
+static void tfm_platform_test_2004(struct test_result_t *ret);
 
 static struct test_t platform_interface_tests[] = {
     {&tfm_platform_test_common_001, "TFM_PLATFORM_TEST_2001",
      "Minimal platform service test", {TEST_PASSED} },
+    {&tfm_platform_test_2002, "TFM_PLATFORM_TEST_2002",
+     "Read the SPM trace", {TEST_PASSED} },
+    {&tfm_platform_test_2003, "TFM_PLATFORM_TEST_2003",
+     "Read the memory profile of the partitions", {TEST_PASSED} },
+    {&tfm_platform_test_2004, "TFM_PLATFORM_TEST_2004",
+     "Read the boot profile", {TEST_PASSED} },
 };
 
 void
@@ -26,3 +50,189 @@ register_testsuite_ns_platform_interface(struct test_suite_t *p_test_suite)
                   "(TFM_PLATFORM_TEST_2XXX)",
                   platform_interface_tests, list_size, p_test_suite);
 }
+
+/**
+ * \brief Reads the SPM trace through the platform service
+ *
+ * \note Connecting to the service leaves events in the trace, so there is
+ *       always at least one to read when the trace is built in.
+ */
+static void tfm_platform_test_2002(struct test_result_t *ret)
+{
+    struct tfm_spm_trace_event_t events[TRACE_TEST_EVENTS];
+    enum tfm_platform_err_t err;
+    size_t size_read;
+#ifdef TFM_SPM_TRACE
+    uint32_t i;
+#endif
+
+    err = tfm_platform_trace_read(events, sizeof(events), &size_read);
+#ifdef TFM_SPM_TRACE
+    if (err != TFM_PLATFORM_ERR_SUCCESS) {
+        TEST_FAIL("Trace read should succeed");
+        return;
+    }
+
+    if (size_read == 0 || size_read > sizeof(events) ||
+        (size_read % sizeof(events[0])) != 0) {
+        TEST_FAIL("At least one whole event should be read");
+        return;
+    }
+
+    for (i = 0; i < size_read / sizeof(events[0]); i++) {
+        if (events[i].event_id > TFM_SPM_TRACE_EV_DROPPED) {
+            TEST_FAIL("Trace event is not a known event");
+            return;
+        }
+    }
+#else
+    if (err != TFM_PLATFORM_ERR_NOT_SUPPORTED || size_read != 0) {
+        TEST_FAIL("Trace read should not be supported");
+        return;
+    }
+#endif
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Reads the memory profile of the partitions through the platform
+ *        service
+ *
+ * \note The platform partition serves the read, so its painted stack is in
+ *       use and its peak cannot be 0.
+ */
+static void tfm_platform_test_2003(struct test_result_t *ret)
+{
+    struct tfm_mem_profile_t profile[MEM_PROFILE_TEST_ENTRIES];
+    enum tfm_platform_err_t err;
+    size_t size_read;
+#ifdef TFM_MEM_PROFILE
+    uint32_t i;
+    bool found = false;
+#endif
+
+    err = tfm_platform_mem_profile_read(profile, sizeof(profile), &size_read);
+#ifdef TFM_MEM_PROFILE
+    if (err != TFM_PLATFORM_ERR_SUCCESS) {
+        TEST_FAIL("Memory profile read should succeed");
+        return;
+    }
+
+    if (size_read == 0 || size_read > sizeof(profile) ||
+        (size_read % sizeof(profile[0])) != 0) {
+        TEST_FAIL("At least one whole partition entry should be read");
+        return;
+    }
+
+    for (i = 0; i < size_read / sizeof(profile[0]); i++) {
+        if (profile[i].stack_peak > profile[i].stack_size ||
+            profile[i].scratch_peak > profile[i].scratch_size) {
+            TEST_FAIL("Peak should not be larger than the memory measured");
+            return;
+        }
+        if (profile[i].partition_id == TFM_SP_PLATFORM) {
+            if (profile[i].stack_peak == 0) {
+                TEST_FAIL("Platform partition stack peak should not be 0");
+                return;
+            }
+            found = true;
+        }
+    }
+
+    if (!found) {
+        TEST_FAIL("Platform partition should be in the memory profile");
+        return;
+    }
+#else
+    if (err != TFM_PLATFORM_ERR_NOT_SUPPORTED || size_read != 0) {
+        TEST_FAIL("Memory profile read should not be supported");
+        return;
+    }
+#endif
+
+    ret->val = TEST_PASSED;
+}
+
+#if defined(TFM_BOOT_PROFILE) && defined(TFM_PSA_API)
+/**
+ * \brief Finds the first entry of a boot phase
+ *
+ * \return Index of the entry, or num_entries if the phase is not there
+ */
+static uint32_t find_boot_phase(const struct tfm_boot_profile_entry_t *entries,
+                                uint32_t num_entries, uint16_t phase)
+{
+    uint32_t i;
+
+    for (i = 0; i < num_entries; i++) {
+        if (entries[i].phase == phase) {
+            break;
+        }
+    }
+
+    return i;
+}
+#endif
+
+/**
+ * \brief Reads the boot profile through the platform service
+ *
+ * \note The non-secure image has started by the time the tests run, so its
+ *       phase is in the profile. The phases of BL2 are there when BL2 passes
+ *       them in the shared data area, before those of the SPE.
+ */
+static void tfm_platform_test_2004(struct test_result_t *ret)
+{
+    struct tfm_boot_profile_entry_t entries[BOOT_PROFILE_TEST_ENTRIES];
+    enum tfm_platform_err_t err;
+    size_t size_read;
+#if defined(TFM_BOOT_PROFILE) && defined(TFM_PSA_API)
+    uint32_t num_entries, spe_start;
+#endif
+
+    err = tfm_platform_boot_profile_read(entries, sizeof(entries), &size_read);
+#if defined(TFM_BOOT_PROFILE) && defined(TFM_PSA_API)
+    if (err != TFM_PLATFORM_ERR_SUCCESS) {
+        TEST_FAIL("Boot profile read should succeed");
+        return;
+    }
+
+    if (size_read == 0 || size_read > sizeof(entries) ||
+        (size_read % sizeof(entries[0])) != 0) {
+        TEST_FAIL("At least one whole boot phase should be read");
+        return;
+    }
+    num_entries = size_read / sizeof(entries[0]);
+
+    spe_start = find_boot_phase(entries, num_entries,
+                                TFM_BOOT_PHASE_SPE_START);
+    if (spe_start == num_entries) {
+        TEST_FAIL("Boot profile should have the SPE start phase");
+        return;
+    }
+
+    if (find_boot_phase(entries, num_entries,
+                        TFM_BOOT_PHASE_NS_START) == num_entries) {
+        TEST_FAIL("Boot profile should have the NS start phase");
+        return;
+    }
+
+#ifdef BOOT_DATA_AVAILABLE
+    if (find_boot_phase(entries, num_entries,
+                        TFM_BOOT_PHASE_BL2_START) >= spe_start ||
+        find_boot_phase(entries, num_entries,
+                        TFM_BOOT_PHASE_BL2_JUMP) >= spe_start) {
+        TEST_FAIL("Boot profile should start with the phases of BL2");
+        return;
+    }
+#endif
+#else
+    if (err != TFM_PLATFORM_ERR_NOT_SUPPORTED || size_read != 0) {
+        TEST_FAIL("Boot profile read should not be supported");
+        return;
+    }
+#endif
+
+    ret->val = TEST_PASSED;
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __PS_BENCH_TESTS_H__
+#define __PS_BENCH_TESTS_H__
+
+#include "test/framework/test_framework.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Register benchmark suite for the PSA protected storage NS interface.
+ *
+ * \param[in] p_test_suite  The benchmark suite to be executed.
+ */
+void register_testsuite_ns_psa_ps_bench(struct test_suite_t *p_test_suite);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PS_BENCH_TESTS_H__ */
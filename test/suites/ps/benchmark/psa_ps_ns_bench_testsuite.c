@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string.h>
+
+#include "ps_bench_tests.h"
+#include "test/framework/bench_framework.h"
+#include "test/framework/test_framework_helpers.h"
+#include "psa/protected_storage.h"
+
+/* UID of the asset the benchmarks time; the other objects of a case are
+ * stored from BENCH_PS_FILLER_UID on.
+ */
+#define BENCH_PS_UID            ((psa_storage_uid_t)0xBE000100u)
+#define BENCH_PS_FILLER_UID     ((psa_storage_uid_t)0xBE000101u)
+
+static const uint32_t bench_ps_counts[] = {BENCH_PS_OBJECT_COUNTS};
+static uint8_t bench_ps_data[BENCH_PS_OBJECT_SIZE];
+
+static void tfm_ps_bench_2001(struct test_result_t *ret);
+static void tfm_ps_bench_2002(struct test_result_t *ret);
+static void tfm_ps_bench_2003(struct test_result_t *ret);
+
+static struct test_t psa_ps_ns_benchs[] = {
+    {&tfm_ps_bench_2001, "TFM_PS_BENCH_2001",
+     "Set interface, per number of objects stored"},
+    {&tfm_ps_bench_2002, "TFM_PS_BENCH_2002",
+     "Get interface, per number of objects stored"},
+    {&tfm_ps_bench_2003, "TFM_PS_BENCH_2003",
+     "Remove interface, per number of objects stored"},
+};
+
+void register_testsuite_ns_psa_ps_bench(struct test_suite_t *p_test_suite)
+{
+    uint32_t list_size;
+
+    list_size = (sizeof(psa_ps_ns_benchs) / sizeof(psa_ps_ns_benchs[0]));
+
+    set_testsuite("PSA protected storage NS benchmarks (TFM_PS_BENCH_2XXX)",
+                  psa_ps_ns_benchs, list_size, p_test_suite);
+}
+
+/**
+ * \brief Stores count objects besides the one being timed
+ *
+ * \return Returns PSA_SUCCESS if they all were stored
+ */
+static psa_status_t bench_ps_fill(uint32_t count)
+{
+    psa_status_t status = PSA_SUCCESS;
+    uint32_t i;
+
+    memset(bench_ps_data, 0x5A, sizeof(bench_ps_data));
+    for (i = 0; i < count && status == PSA_SUCCESS; i++) {
+        status = psa_ps_set(BENCH_PS_FILLER_UID + i, sizeof(bench_ps_data),
+                            bench_ps_data, PSA_STORAGE_FLAG_NONE);
+    }
+
+    return status;
+}
+
+/**
+ * \brief Removes the objects stored by bench_ps_fill, and the timed one
+ */
+static void bench_ps_clean(uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++) {
+        (void)psa_ps_remove(BENCH_PS_FILLER_UID + i);
+    }
+    (void)psa_ps_remove(BENCH_PS_UID);
+}
+
+/**
+ * \brief Times psa_ps_set of an asset, replacing the one already there
+ */
+static void tfm_ps_bench_2001(struct test_result_t *ret)
+{
+    psa_status_t status;
+    uint32_t i, j;
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_ps_counts); i++) {
+        status = bench_ps_fill(bench_ps_counts[i]);
+
+        bench_case_begin("objects", bench_ps_counts[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            BENCH_TIME(status = psa_ps_set(BENCH_PS_UID, sizeof(bench_ps_data),
+                                           bench_ps_data,
+                                           PSA_STORAGE_FLAG_NONE));
+        }
+        bench_ps_clean(bench_ps_counts[i]);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Set should not fail with valid UID");
+            return;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Times psa_ps_get of a whole asset
+ */
+static void tfm_ps_bench_2002(struct test_result_t *ret)
+{
+    psa_status_t status;
+    size_t read_len = 0;
+    uint32_t i, j;
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_ps_counts); i++) {
+        status = bench_ps_fill(bench_ps_counts[i]);
+        if (status == PSA_SUCCESS) {
+            status = psa_ps_set(BENCH_PS_UID, sizeof(bench_ps_data),
+                                bench_ps_data, PSA_STORAGE_FLAG_NONE);
+        }
+
+        bench_case_begin("objects", bench_ps_counts[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            BENCH_TIME(status = psa_ps_get(BENCH_PS_UID, 0,
+                                           sizeof(bench_ps_data),
+                                           bench_ps_data, &read_len));
+        }
+        bench_ps_clean(bench_ps_counts[i]);
+        if (status != PSA_SUCCESS || read_len != sizeof(bench_ps_data)) {
+            TEST_FAIL("Get should not fail with valid UID");
+            return;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+}
+
+/**
+ * \brief Times psa_ps_remove; the asset is set again, untimed, before each
+ *        remove
+ */
+static void tfm_ps_bench_2003(struct test_result_t *ret)
+{
+    psa_status_t status;
+    uint32_t i, j;
+
+    for (i = 0; i < BENCH_ARRAY_SIZE(bench_ps_counts); i++) {
+        status = bench_ps_fill(bench_ps_counts[i]);
+
+        bench_case_begin("objects", bench_ps_counts[i]);
+        for (j = 0; j < bench_iterations() && status == PSA_SUCCESS; j++) {
+            status = psa_ps_set(BENCH_PS_UID, sizeof(bench_ps_data),
+                                bench_ps_data, PSA_STORAGE_FLAG_NONE);
+            if (status == PSA_SUCCESS) {
+                BENCH_TIME(status = psa_ps_remove(BENCH_PS_UID));
+            }
+        }
+        bench_ps_clean(bench_ps_counts[i]);
+        if (status != PSA_SUCCESS) {
+            TEST_FAIL("Set and remove should not fail with valid UID");
+            return;
+        }
+        bench_case_end();
+    }
+
+    ret->val = TEST_PASSED;
+}
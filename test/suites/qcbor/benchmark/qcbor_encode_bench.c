@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Host benchmark of the fast path encoder of qcbor_fast_encode.h against the
+ * general QCBOR encoder. Both encode the same maps, shaped like the claims of
+ * the initial attestation token, and the outputs are compared byte by byte
+ * before the encoders are timed.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "qcbor.h"
+#include "qcbor_fast_encode.h"
+
+#define BENCH_DEFAULT_ITERATIONS (1000000u)
+
+/* Labels of the initial attestation token claims */
+#define BENCH_LABEL_BASE            (-75000)
+#define BENCH_LABEL_CLIENT_ID       (BENCH_LABEL_BASE - 1)
+#define BENCH_LABEL_SECURITY_LC     (BENCH_LABEL_BASE - 2)
+#define BENCH_LABEL_IMPL_ID         (BENCH_LABEL_BASE - 3)
+#define BENCH_LABEL_BOOT_SEED       (BENCH_LABEL_BASE - 4)
+#define BENCH_LABEL_CHALLENGE       (BENCH_LABEL_BASE - 8)
+#define BENCH_LABEL_INSTANCE_ID     (BENCH_LABEL_BASE - 9)
+
+/* The claims which are different in each token */
+static const qcbor_fast_field_t dynamic_shape[] = {
+    QCBOR_FAST_FIELD(BENCH_LABEL_CHALLENGE, QCBOR_FAST_TYPE_BYTES),
+    QCBOR_FAST_FIELD(BENCH_LABEL_CLIENT_ID, QCBOR_FAST_TYPE_INT64),
+};
+
+/* All the fixed size claims of the token */
+static const qcbor_fast_field_t claims_shape[] = {
+    QCBOR_FAST_FIELD(BENCH_LABEL_CHALLENGE, QCBOR_FAST_TYPE_BYTES),
+    QCBOR_FAST_FIELD(BENCH_LABEL_BOOT_SEED, QCBOR_FAST_TYPE_BYTES),
+    QCBOR_FAST_FIELD(BENCH_LABEL_INSTANCE_ID, QCBOR_FAST_TYPE_BYTES),
+    QCBOR_FAST_FIELD(BENCH_LABEL_IMPL_ID, QCBOR_FAST_TYPE_BYTES),
+    QCBOR_FAST_FIELD(BENCH_LABEL_CLIENT_ID, QCBOR_FAST_TYPE_INT64),
+    QCBOR_FAST_FIELD(BENCH_LABEL_SECURITY_LC, QCBOR_FAST_TYPE_INT64),
+};
+
+#define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+struct bench_case {
+    const char *name;
+    const qcbor_fast_field_t *shape;
+    size_t num_fields;
+    qcbor_fast_value_t values[ARRAY_SIZE(claims_shape)];
+};
+
+static uint8_t challenge[64];
+static uint8_t boot_seed[32];
+static uint8_t instance_id[33];
+static uint8_t impl_id[32];
+
+/* Keeps the compiler from dropping the encoding loops */
+static volatile size_t bench_sink;
+
+static double bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static UsefulBufC bench_encode_qcbor(const struct bench_case *c,
+                                     UsefulBuf buf)
+{
+    QCBOREncodeContext ctx;
+    UsefulBufC encoded;
+    size_t i;
+
+    QCBOREncode_Init(&ctx, buf);
+    QCBOREncode_OpenMap(&ctx);
+    for (i = 0; i < c->num_fields; i++) {
+        if (c->shape[i].type == QCBOR_FAST_TYPE_BYTES) {
+            QCBOREncode_AddBytesToMapN(&ctx, c->shape[i].label,
+                                       c->values[i].bytes);
+        } else {
+            QCBOREncode_AddInt64ToMapN(&ctx, c->shape[i].label,
+                                       c->values[i].int64);
+        }
+    }
+    QCBOREncode_CloseMap(&ctx);
+    if (QCBOREncode_Finish(&ctx, &encoded) != QCBOR_SUCCESS) {
+        return NULLUsefulBufC;
+    }
+
+    return encoded;
+}
+
+/* Compares the heads written by both encoders at the size boundaries */
+static int bench_check_heads(void)
+{
+    static const int64_t ints[] = {
+        0, 23, 24, 255, 256, 65535, 65536, 0xFFFFFFFF, 0x100000000,
+        INT64_MAX, -1, -24, -25, -256, -257, -65536, -65537,
+        -0x100000000, -0x100000001, INT64_MIN,
+    };
+    static const size_t lens[] = {0, 23, 24, 255, 256, 300};
+    static uint8_t bytes[300];
+    struct bench_case c;
+    qcbor_fast_field_t shape[2] = {
+        QCBOR_FAST_FIELD(0, QCBOR_FAST_TYPE_INT64),
+        QCBOR_FAST_FIELD(0, QCBOR_FAST_TYPE_BYTES),
+    };
+    uint8_t ref_buf[512];
+    uint8_t fast_buf[512];
+    UsefulBufC ref;
+    UsefulBufC fast;
+    size_t i;
+    size_t j;
+
+    memset(&c, 0, sizeof(c));
+    c.name = "heads";
+    c.shape = shape;
+    c.num_fields = 2;
+
+    for (i = 0; i < ARRAY_SIZE(ints); i++) {
+        for (j = 0; j < ARRAY_SIZE(lens); j++) {
+            shape[0].label = ints[i];
+            shape[0].label_size = QCBOR_FAST_HEAD_SIZE(
+                                      QCBOR_FAST_INT_ARG(ints[i]));
+            shape[1].label = -ints[i] / 2;
+            shape[1].label_size = QCBOR_FAST_HEAD_SIZE(
+                                      QCBOR_FAST_INT_ARG(shape[1].label));
+            c.values[0].int64 = ints[ARRAY_SIZE(ints) - 1 - i];
+            c.values[1].bytes = (UsefulBufC){bytes, lens[j]};
+
+            ref = bench_encode_qcbor(&c, (UsefulBuf){ref_buf,
+                                                     sizeof(ref_buf)});
+            fast = qcbor_fast_encode_map((UsefulBuf){fast_buf,
+                                                     sizeof(fast_buf)},
+                                         shape, c.values, 2, 0);
+            if (ref.len == 0 || ref.len != fast.len ||
+                memcmp(ref.ptr, fast.ptr, ref.len) != 0) {
+                printf("heads: the encodings differ for %lld, %zu\n",
+                       (long long)ints[i], lens[j]);
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int bench_run(const struct bench_case *c, unsigned int iterations)
+{
+    uint8_t ref_buf[256];
+    uint8_t fast_buf[256];
+    UsefulBuf ref_out = {ref_buf, sizeof(ref_buf)};
+    UsefulBuf fast_out = {fast_buf, sizeof(fast_buf)};
+    UsefulBufC ref;
+    UsefulBufC fast;
+    double start;
+    double qcbor_ns;
+    double fast_ns;
+    unsigned int i;
+
+    ref = bench_encode_qcbor(c, ref_out);
+    fast = qcbor_fast_encode_map(fast_out, c->shape, c->values,
+                                 c->num_fields, 0);
+    if (ref.len == 0 || ref.len != fast.len ||
+        memcmp(ref.ptr, fast.ptr, ref.len) != 0) {
+        printf("%s: the encodings differ\n", c->name);
+        return 1;
+    }
+
+    /* The size only calculation and the bounds check */
+    fast_out.ptr = NULL;
+    if (qcbor_fast_encode_map(fast_out, c->shape, c->values,
+                              c->num_fields, 0).len != ref.len) {
+        printf("%s: wrong size calculation\n", c->name);
+        return 1;
+    }
+    fast_out.ptr = fast_buf;
+    fast_out.len = ref.len - 1;
+    if (qcbor_fast_encode_map(fast_out, c->shape, c->values,
+                              c->num_fields, 0).ptr != NULL) {
+        printf("%s: buffer overflow not detected\n", c->name);
+        return 1;
+    }
+    fast_out.len = sizeof(fast_buf);
+
+    start = bench_now_ns();
+    for (i = 0; i < iterations; i++) {
+        bench_sink += bench_encode_qcbor(c, ref_out).len;
+    }
+    qcbor_ns = (bench_now_ns() - start) / iterations;
+
+    start = bench_now_ns();
+    for (i = 0; i < iterations; i++) {
+        bench_sink += qcbor_fast_encode_map(fast_out, c->shape, c->values,
+                                            c->num_fields, 0).len;
+    }
+    fast_ns = (bench_now_ns() - start) / iterations;
+
+    printf("%-16s %4zu bytes: qcbor %7.1f ns, fast %7.1f ns (x%.2f)\n",
+           c->name, ref.len, qcbor_ns, fast_ns, qcbor_ns / fast_ns);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int iterations = BENCH_DEFAULT_ITERATIONS;
+    struct bench_case cases[2];
+    int ret = 0;
+    size_t i;
+
+    if (argc > 1) {
+        iterations = (unsigned int)strtoul(argv[1], NULL, 0);
+        if (iterations == 0) {
+            printf("Usage: %s [iterations]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    for (i = 0; i < sizeof(challenge); i++) {
+        challenge[i] = (uint8_t)i;
+    }
+    memset(boot_seed, 0xA5, sizeof(boot_seed));
+    memset(instance_id, 0x01, sizeof(instance_id));
+    memset(impl_id, 0xBB, sizeof(impl_id));
+
+    memset(cases, 0, sizeof(cases));
+
+    cases[0].name = "dynamic claims";
+    cases[0].shape = dynamic_shape;
+    cases[0].num_fields = ARRAY_SIZE(dynamic_shape);
+    cases[0].values[0].bytes = (UsefulBufC){challenge, sizeof(challenge)};
+    cases[0].values[1].int64 = -1;
+
+    cases[1].name = "fixed claims";
+    cases[1].shape = claims_shape;
+    cases[1].num_fields = ARRAY_SIZE(claims_shape);
+    cases[1].values[0].bytes = (UsefulBufC){challenge, sizeof(challenge)};
+    cases[1].values[1].bytes = (UsefulBufC){boot_seed, sizeof(boot_seed)};
+    cases[1].values[2].bytes = (UsefulBufC){instance_id, sizeof(instance_id)};
+    cases[1].values[3].bytes = (UsefulBufC){impl_id, sizeof(impl_id)};
+    cases[1].values[4].int64 = 0x10000;
+    cases[1].values[5].int64 = 0x3000;
+
+    if (bench_check_heads() != 0) {
+        return 1;
+    }
+
+    for (i = 0; i < ARRAY_SIZE(cases); i++) {
+        ret |= bench_run(&cases[i], iterations);
+    }
+
+    return ret;
+}
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Simulated NOR flash behind the CMSIS flash driver interface. Every driver
+ * call advances a virtual clock according to the timing model, so the time of
+ * a bootloader flow can be measured on the host. Programming follows the NOR
+ * rules: bits can only be cleared and programming an already programmed
+ * location with a different value is reported as an error.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "flash_layout.h"
+#include "flash_sim.h"
+
+#define FLASH_SIM_ERASED_VAL    (0xFF)
+#define FLASH_SIM_PROGRAM_UNIT  (4)
+
+#define ARM_FLASH_DRV_VERSION   ARM_DRIVER_VERSION_MAJOR_MINOR(1, 0)
+
+static uint8_t flash_mem[FLASH_TOTAL_SIZE];
+static struct flash_sim_timing sim_timing;
+static struct flash_sim_stats sim_stats;
+/* Completion time of the erase running in the background, if any */
+static uint64_t erase_done_ns;
+
+static const ARM_DRIVER_VERSION DriverVersion = {
+    ARM_FLASH_API_VERSION,
+    ARM_FLASH_DRV_VERSION
+};
+
+static ARM_FLASH_CAPABILITIES DriverCapabilities = {
+    0, /* event_ready */
+    0, /* data_width = 0:8-bit, 1:16-bit, 2:32-bit */
+    1  /* erase_chip */
+};
+
+static ARM_FLASH_INFO FlashInfo = {
+    .sector_info  = NULL, /* Uniform sector layout */
+    .sector_count = FLASH_TOTAL_SIZE / FLASH_AREA_IMAGE_SECTOR_SIZE,
+    .sector_size  = FLASH_AREA_IMAGE_SECTOR_SIZE,
+    .page_size    = 256,
+    .program_unit = FLASH_SIM_PROGRAM_UNIT,
+    .erased_value = FLASH_SIM_ERASED_VAL,
+};
+
+static int is_busy(void)
+{
+    return sim_stats.now_ns < erase_done_ns;
+}
+
+static int is_range_valid(uint32_t addr, uint32_t cnt)
+{
+    return (addr <= FLASH_TOTAL_SIZE) && (cnt <= FLASH_TOTAL_SIZE - addr);
+}
+
+void flash_sim_init(const struct flash_sim_timing *timing)
+{
+    sim_timing = *timing;
+    DriverCapabilities.event_ready = timing->async ? 1 : 0;
+    memset(flash_mem, FLASH_SIM_ERASED_VAL, sizeof(flash_mem));
+    flash_sim_reset_stats();
+}
+
+void flash_sim_reset_stats(void)
+{
+    memset(&sim_stats, 0, sizeof(sim_stats));
+    erase_done_ns = 0;
+}
+
+const struct flash_sim_stats *flash_sim_get_stats(void)
+{
+    return &sim_stats;
+}
+
+uint8_t *flash_sim_mem(void)
+{
+    return flash_mem;
+}
+
+static ARM_DRIVER_VERSION ARM_Flash_GetVersion(void)
+{
+    return DriverVersion;
+}
+
+static ARM_FLASH_CAPABILITIES ARM_Flash_GetCapabilities(void)
+{
+    return DriverCapabilities;
+}
+
+static int32_t ARM_Flash_Initialize(ARM_Flash_SignalEvent_t cb_event)
+{
+    (void)cb_event;
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_Uninitialize(void)
+{
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_PowerControl(ARM_POWER_STATE state)
+{
+    (void)state;
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_ReadData(uint32_t addr, void *data, uint32_t cnt)
+{
+    if (!is_range_valid(addr, cnt)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    if (is_busy() && !sim_timing.rww) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    memcpy(data, &flash_mem[addr], cnt);
+
+    sim_stats.now_ns += sim_timing.cmd_ns +
+                        (uint64_t)cnt * sim_timing.read_byte_ns;
+    sim_stats.reads++;
+    sim_stats.bytes_read += cnt;
+
+    /* Reads always complete synchronously */
+    return (int32_t)cnt;
+}
+
+static int32_t ARM_Flash_ProgramData(uint32_t addr, const void *data,
+                                     uint32_t cnt)
+{
+    const uint8_t *src = data;
+    uint32_t first_page;
+    uint32_t last_page;
+    uint32_t i;
+
+    if (!is_range_valid(addr, cnt) ||
+        (addr % FLASH_SIM_PROGRAM_UNIT) != 0 ||
+        (cnt % FLASH_SIM_PROGRAM_UNIT) != 0) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    if (is_busy()) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    for (i = 0; i < cnt; i++) {
+        if ((flash_mem[addr + i] & src[i]) != src[i]) {
+            fprintf(stderr, "flash_sim: programming a non-erased location at "
+                    "0x%x\n", addr + i);
+            return ARM_DRIVER_ERROR;
+        }
+        flash_mem[addr + i] &= src[i];
+    }
+
+    if (cnt != 0) {
+        first_page = addr / sim_timing.page_size;
+        last_page = (addr + cnt - 1) / sim_timing.page_size;
+        sim_stats.now_ns += (uint64_t)(last_page - first_page + 1) *
+                            sim_timing.page_program_ns;
+    }
+    sim_stats.now_ns += sim_timing.cmd_ns;
+    sim_stats.programs++;
+    sim_stats.bytes_programmed += cnt;
+
+    return (int32_t)cnt;
+}
+
+static int32_t ARM_Flash_EraseSector(uint32_t addr)
+{
+    uint32_t sector_off;
+
+    if (addr >= FLASH_TOTAL_SIZE) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    if (is_busy()) {
+        return ARM_DRIVER_ERROR_BUSY;
+    }
+
+    sector_off = addr - (addr % FLASH_AREA_IMAGE_SECTOR_SIZE);
+    memset(&flash_mem[sector_off], FLASH_SIM_ERASED_VAL,
+           FLASH_AREA_IMAGE_SECTOR_SIZE);
+
+    sim_stats.now_ns += sim_timing.cmd_ns;
+    sim_stats.erases++;
+
+    if (sim_timing.async) {
+        /* The erase runs in the background, completion is polled */
+        erase_done_ns = sim_stats.now_ns + sim_timing.sector_erase_ns;
+        return ARM_DRIVER_OK;
+    }
+
+    sim_stats.now_ns += sim_timing.sector_erase_ns;
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t ARM_Flash_EraseChip(void)
+{
+    uint32_t addr;
+    int32_t rc;
+
+    for (addr = 0; addr < FLASH_TOTAL_SIZE;
+         addr += FLASH_AREA_IMAGE_SECTOR_SIZE) {
+        sim_stats.now_ns = (erase_done_ns > sim_stats.now_ns) ?
+                           erase_done_ns : sim_stats.now_ns;
+        rc = ARM_Flash_EraseSector(addr);
+        if (rc != ARM_DRIVER_OK) {
+            return rc;
+        }
+    }
+
+    return ARM_DRIVER_OK;
+}
+
+static ARM_FLASH_STATUS ARM_Flash_GetStatus(void)
+{
+    ARM_FLASH_STATUS status = {0};
+
+    /* Polling until the erase has completed costs the remaining time */
+    if (is_busy()) {
+        sim_stats.erase_wait_ns += erase_done_ns - sim_stats.now_ns;
+        sim_stats.now_ns = erase_done_ns;
+    }
+
+    status.busy = 0;
+    status.error = 0;
+
+    return status;
+}
+
+static ARM_FLASH_INFO *ARM_Flash_GetInfo(void)
+{
+    return &FlashInfo;
+}
+
+ARM_DRIVER_FLASH Driver_FLASH0 = {
+    ARM_Flash_GetVersion,
+    ARM_Flash_GetCapabilities,
+    ARM_Flash_Initialize,
+    ARM_Flash_Uninitialize,
+    ARM_Flash_PowerControl,
+    ARM_Flash_ReadData,
+    ARM_Flash_ProgramData,
+    ARM_Flash_EraseSector,
+    ARM_Flash_EraseChip,
+    ARM_Flash_GetStatus,
+    ARM_Flash_GetInfo
+};
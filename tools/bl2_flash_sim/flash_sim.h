@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_SIM_H__
+#define __FLASH_SIM_H__
+
+#include <stdint.h>
+#include "Driver_Flash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \struct flash_sim_timing
+ *
+ * \brief Timing model of the simulated flash device.
+ */
+struct flash_sim_timing {
+    uint32_t cmd_ns;          /* Fixed cost of every driver call */
+    uint32_t read_byte_ns;    /* Cost of reading one byte */
+    uint32_t page_size;       /* Size of a program page in bytes */
+    uint32_t page_program_ns; /* Cost of programming one (partial) page */
+    uint32_t sector_erase_ns; /* Cost of erasing one sector */
+    uint8_t  async;           /* Erase completes in the background */
+    uint8_t  rww;             /* Reads are allowed while an erase is running */
+};
+
+/*!
+ * \struct flash_sim_stats
+ *
+ * \brief Operation counters of the simulated flash device.
+ */
+struct flash_sim_stats {
+    uint64_t now_ns;          /* Simulated time */
+    uint64_t erase_wait_ns;   /* Time spent waiting for erases to complete */
+    uint32_t reads;
+    uint32_t programs;
+    uint32_t erases;
+    uint64_t bytes_read;
+    uint64_t bytes_programmed;
+};
+
+/*!
+ * \brief Sets the timing model and erases the whole simulated flash.
+ *
+ * \param[in] timing  Timing model to use
+ */
+void flash_sim_init(const struct flash_sim_timing *timing);
+
+/*!
+ * \brief Clears the operation counters and the simulated time.
+ */
+void flash_sim_reset_stats(void);
+
+/*!
+ * \brief Returns the operation counters.
+ */
+const struct flash_sim_stats *flash_sim_get_stats(void);
+
+/*!
+ * \brief Returns a pointer to the simulated flash memory, for direct access
+ *        by the test harness. Accesses through it are not timed.
+ */
+uint8_t *flash_sim_mem(void);
+
+extern ARM_DRIVER_FLASH Driver_FLASH0;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FLASH_SIM_H__ */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_LAYOUT_H__
+#define __FLASH_LAYOUT_H__
+
+/* Flash layout of the simulated device (single image boot):
+ *
+ * 0x0000_0000 Primary image area   (SIM_SLOT_SIZE)
+ * SIM_SLOT_SIZE Secondary image area (SIM_SLOT_SIZE)
+ * 2 * SIM_SLOT_SIZE Scratch area     (SIM_SCRATCH_SIZE)
+ *
+ * The sizes can be overridden from the command line of the compiler.
+ */
+
+#ifndef SIM_SECTOR_SIZE
+#define SIM_SECTOR_SIZE                 (0x1000)    /* 4 KB */
+#endif
+
+#ifndef SIM_SLOT_SIZE
+#define SIM_SLOT_SIZE                   (0x80000)   /* 512 KB */
+#endif
+
+#ifndef SIM_SCRATCH_SIZE
+#define SIM_SCRATCH_SIZE                (SIM_SLOT_SIZE)
+#endif
+
+/* Sector size of the simulated flash */
+#define FLASH_AREA_IMAGE_SECTOR_SIZE    (SIM_SECTOR_SIZE)
+#define FLASH_TOTAL_SIZE                (2 * SIM_SLOT_SIZE + SIM_SCRATCH_SIZE)
+
+/* The simulated flash is not memory-mapped */
+#define FLASH_BASE_ADDRESS              (0x0)
+
+/* Primary slot */
+#define FLASH_AREA_0_ID            (1)
+#define FLASH_AREA_0_OFFSET        (0x0)
+#define FLASH_AREA_0_SIZE          (SIM_SLOT_SIZE)
+/* Secondary slot */
+#define FLASH_AREA_2_ID            (FLASH_AREA_0_ID + 1)
+#define FLASH_AREA_2_OFFSET        (FLASH_AREA_0_OFFSET + FLASH_AREA_0_SIZE)
+#define FLASH_AREA_2_SIZE          (SIM_SLOT_SIZE)
+/* Scratch area */
+#define FLASH_AREA_SCRATCH_ID      (FLASH_AREA_2_ID + 1)
+#define FLASH_AREA_SCRATCH_OFFSET  (FLASH_AREA_2_OFFSET + FLASH_AREA_2_SIZE)
+#define FLASH_AREA_SCRATCH_SIZE    (SIM_SCRATCH_SIZE)
+/* The maximum number of status entries supported by the bootloader. */
+#define MCUBOOT_STATUS_MAX_ENTRIES (SIM_SLOT_SIZE / FLASH_AREA_SCRATCH_SIZE)
+/* Maximum number of image sectors supported by the bootloader, BL2 requires
+ * at least 32.
+ */
+#define MCUBOOT_MAX_IMG_SECTORS    ((SIM_SLOT_SIZE / SIM_SECTOR_SIZE) > 32 ? \
+                                    (SIM_SLOT_SIZE / SIM_SECTOR_SIZE) : 32)
+
+#define FLASH_DEV_NAME Driver_FLASH0
+
+/* Built with RWW=1, the loader overlaps the erase of a sector with reads */
+#ifdef SIM_READ_WHILE_ERASE
+#define FLASH_DEV_READ_WHILE_ERASE
+#endif
+
+#endif /* __FLASH_LAYOUT_H__ */
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __MCUBOOT_CONFIG_H__
+#define __MCUBOOT_CONFIG_H__
+
+/*
+ * MCUBoot configuration of the flash simulator. It replaces the header that
+ * is generated from mcuboot_config.h.in by the BL2 build. The upgrade
+ * strategy and the copy buffer size are selected by the Makefile.
+ */
+
+#define MCUBOOT_VALIDATE_PRIMARY_SLOT
+#define MCUBOOT_USE_FLASH_AREA_GET_SECTORS
+#define MCUBOOT_TARGET_CONFIG "flash_layout.h"
+
+#ifndef MCUBOOT_COPY_BUF_SIZE
+#define MCUBOOT_COPY_BUF_SIZE   1024
+#endif
+
+#define MAX_BOOT_RECORD_SZ      (100u)
+
+#define MCUBOOT_HAVE_LOGGING    1
+#ifndef MCUBOOT_LOG_LEVEL
+#define MCUBOOT_LOG_LEVEL       0 /* MCUBOOT_LOG_LEVEL_OFF */
+#endif
+
+#define MCUBOOT_WATCHDOG_FEED()     \
+    do {                            \
+        /* Do nothing. */           \
+    } while (0)
+
+#endif /* __MCUBOOT_CONFIG_H__ */
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __REGION_DEFS_H__
+#define __REGION_DEFS_H__
+
+#include <stdint.h>
+
+/* Shared data area between the bootloader and the runtime firmware, it is
+ * a plain array on the host.
+ */
+extern uint8_t sim_shared_data[];
+
+#define BOOT_TFM_SHARED_DATA_BASE ((uintptr_t)sim_shared_data)
+#define BOOT_TFM_SHARED_DATA_SIZE (0x400)
+
+#endif /* __REGION_DEFS_H__ */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Runs a BL2 image upgrade on the simulated flash and reports the simulated
+ * time it took. Two images are placed in the primary and the secondary slot,
+ * a test upgrade is requested and boot_go() performs it with the upgrade
+ * strategy the simulator was built for. The result is checked byte by byte.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "flash_layout.h"
+#include "flash_sim.h"
+#include "bootutil/bootutil.h"
+#include "bootutil/image.h"
+#include "mcuboot_config/mcuboot_config.h"
+
+#define SIM_IMAGE_HDR_SIZE  (0x400)
+
+struct sim_image {
+    uint32_t off;   /* Offset of the slot */
+    uint32_t size;  /* Size of the payload */
+    uint8_t  seed;  /* Seed of the payload pattern */
+};
+
+static uint32_t sim_image_total_size(const struct sim_image *img)
+{
+    return SIM_IMAGE_HDR_SIZE + img->size + sizeof(struct image_tlv_info);
+}
+
+static uint8_t sim_image_byte(const struct sim_image *img, uint32_t i)
+{
+    return (uint8_t)((i * 31u) ^ (i >> 8) ^ img->seed);
+}
+
+static void sim_image_write(const struct sim_image *img)
+{
+    uint8_t *mem = flash_sim_mem() + img->off;
+    struct image_header hdr;
+    struct image_tlv_info info;
+    uint32_t i;
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.ih_magic = IMAGE_MAGIC;
+    hdr.ih_hdr_size = SIM_IMAGE_HDR_SIZE;
+    hdr.ih_img_size = img->size;
+    hdr.ih_ver.iv_major = img->seed;
+
+    memset(mem, 0, SIM_IMAGE_HDR_SIZE);
+    memcpy(mem, &hdr, sizeof(hdr));
+    for (i = 0; i < img->size; i++) {
+        mem[SIM_IMAGE_HDR_SIZE + i] = sim_image_byte(img, i);
+    }
+
+    info.it_magic = IMAGE_TLV_INFO_MAGIC;
+    info.it_tlv_tot = sizeof(info);
+    memcpy(&mem[SIM_IMAGE_HDR_SIZE + img->size], &info, sizeof(info));
+}
+
+/* Checks that the slot at off holds img */
+static int sim_image_check(const struct sim_image *img, uint32_t off)
+{
+    const uint8_t *mem = flash_sim_mem() + off;
+    const struct image_header *hdr = (const struct image_header *)mem;
+    uint32_t i;
+
+    if (hdr->ih_magic != IMAGE_MAGIC || hdr->ih_img_size != img->size ||
+        hdr->ih_ver.iv_major != img->seed) {
+        return -1;
+    }
+
+    for (i = 0; i < img->size; i++) {
+        if (mem[SIM_IMAGE_HDR_SIZE + i] != sim_image_byte(img, i)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [options]\n"
+           "  -s <bytes>  size of the image payloads\n"
+           "  -c <ns>     fixed cost of a driver call\n"
+           "  -r <ns>     read time per byte\n"
+           "  -p <us>     page program time\n"
+           "  -e <us>     sector erase time\n"
+           "  -a          erase completes asynchronously\n"
+           "  -w          reads are allowed while erasing (implies -a)\n",
+           name);
+}
+
+int main(int argc, char *argv[])
+{
+    struct flash_sim_timing timing = {
+        .cmd_ns          = 2000,
+        .read_byte_ns    = 10,
+        .page_size       = 256,
+        .page_program_ns = 400000,
+        .sector_erase_ns = 45000000,
+        .async           = 0,
+        .rww             = 0,
+    };
+    const struct flash_sim_stats *stats;
+    struct sim_image old_img = { FLASH_AREA_0_OFFSET, 0x60000, 0x11 };
+    struct sim_image new_img = { FLASH_AREA_2_OFFSET, 0x5f000, 0x22 };
+    struct boot_rsp rsp;
+    int opt;
+    int rc;
+
+    while ((opt = getopt(argc, argv, "s:c:r:p:e:awh")) != -1) {
+        switch (opt) {
+        case 's':
+            old_img.size = strtoul(optarg, NULL, 0);
+            new_img.size = old_img.size - FLASH_AREA_IMAGE_SECTOR_SIZE;
+            break;
+        case 'c':
+            timing.cmd_ns = strtoul(optarg, NULL, 0);
+            break;
+        case 'r':
+            timing.read_byte_ns = strtoul(optarg, NULL, 0);
+            break;
+        case 'p':
+            timing.page_program_ns = strtoul(optarg, NULL, 0) * 1000;
+            break;
+        case 'e':
+            timing.sector_erase_ns = strtoul(optarg, NULL, 0) * 1000;
+            break;
+        case 'a':
+            timing.async = 1;
+            break;
+        case 'w':
+            timing.async = 1;
+            timing.rww = 1;
+            break;
+        default:
+            usage(argv[0]);
+            return (opt == 'h') ? 0 : 1;
+        }
+    }
+
+    if (sim_image_total_size(&old_img) + FLASH_AREA_IMAGE_SECTOR_SIZE >
+        FLASH_AREA_0_SIZE) {
+        printf("Image does not fit in the slot\n");
+        return 1;
+    }
+
+    flash_sim_init(&timing);
+    sim_image_write(&old_img);
+    sim_image_write(&new_img);
+
+    rc = boot_set_pending(0);
+    if (rc != 0) {
+        printf("Failed to request the upgrade: %d\n", rc);
+        return 1;
+    }
+
+    flash_sim_reset_stats();
+    rc = boot_go(&rsp);
+    if (rc != 0) {
+        printf("boot_go() failed: %d\n", rc);
+        return 1;
+    }
+    stats = flash_sim_get_stats();
+
+    if (sim_image_check(&new_img, FLASH_AREA_0_OFFSET) != 0) {
+        printf("FAIL: the primary slot does not hold the new image\n");
+        return 1;
+    }
+#ifndef MCUBOOT_OVERWRITE_ONLY
+    if (sim_image_check(&old_img, FLASH_AREA_2_OFFSET) != 0) {
+        printf("FAIL: the secondary slot does not hold the old image\n");
+        return 1;
+    }
+#endif
+
+    printf("copy_buf=%u sector=%u image=%u async=%u rww=%u: "
+           "%.1f ms (erase wait %.1f ms), "
+           "%u reads (%llu B), %u programs (%llu B), %u erases\n",
+           (unsigned)MCUBOOT_COPY_BUF_SIZE,
+           (unsigned)FLASH_AREA_IMAGE_SECTOR_SIZE,
+           (unsigned)old_img.size, timing.async, timing.rww,
+           stats->now_ns / 1e6, stats->erase_wait_ns / 1e6,
+           stats->reads, (unsigned long long)stats->bytes_read,
+           stats->programs, (unsigned long long)stats->bytes_programmed,
+           stats->erases);
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Stand-ins for the BL2 services which are not part of the upgrade flow being
+ * measured. Image validation is not simulated: every image is accepted, so
+ * the reported time only covers the flash operations of the upgrade.
+ */
+
+#include <stdint.h>
+#include "region_defs.h"
+#include "bootutil/image.h"
+#include "flash_map/flash_map.h"
+#include "security_cnt.h"
+#include "bl2/include/boot_record.h"
+
+uint8_t sim_shared_data[BOOT_TFM_SHARED_DATA_SIZE];
+
+int bootutil_img_validate(int image_index,
+                          struct image_header *hdr,
+                          const struct flash_area *fap,
+                          uint8_t *tmp_buf, uint32_t tmp_buf_sz,
+                          uint8_t *seed, int seed_len, uint8_t *out_hash)
+{
+    (void)image_index;
+    (void)fap;
+    (void)tmp_buf;
+    (void)tmp_buf_sz;
+    (void)seed;
+    (void)seed_len;
+    (void)out_hash;
+
+    return (hdr->ih_magic == IMAGE_MAGIC) ? 0 : -1;
+}
+
+int32_t bootutil_get_img_security_cnt(struct image_header *hdr,
+                                      const struct flash_area *fap,
+                                      uint32_t *security_cnt)
+{
+    (void)hdr;
+    (void)fap;
+
+    *security_cnt = 0;
+
+    return 0;
+}
+
+int32_t boot_nv_security_counter_get(uint32_t image_id, uint32_t *security_cnt)
+{
+    (void)image_id;
+
+    *security_cnt = 0;
+
+    return 0;
+}
+
+int32_t boot_nv_security_counter_update(uint32_t image_id,
+                                        uint32_t img_security_cnt)
+{
+    (void)image_id;
+    (void)img_security_cnt;
+
+    return 0;
+}
+
+enum boot_status_err_t
+boot_save_boot_status(uint8_t sw_module,
+                      const struct image_header *hdr,
+                      const struct flash_area *fap)
+{
+    (void)sw_module;
+    (void)hdr;
+    (void)fap;
+
+    return BOOT_STATUS_OK;
+}
@@ -0,0 +1,110 @@
+# -----------------------------------------------------------------------------
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# -----------------------------------------------------------------------------
+
+"""
+Batch token support.
+
+The CHALLENGE claim of a batch token is the root of the RFC 6962 Merkle Hash
+Tree of the challenges of the batch:
+
+    leaf hash: SHA-256(0x00 || challenge)
+    node hash: SHA-256(0x01 || left || right)
+
+An inclusion proof is the index of a challenge, the number of challenges and
+the audit path of RFC 6962 (section 2.1.1) from the leaf to the root.
+"""
+
+import hashlib
+import json
+
+LEAF_PREFIX = b'\x00'
+NODE_PREFIX = b'\x01'
+
+
+def leaf_hash(challenge):
+    return hashlib.sha256(LEAF_PREFIX + challenge).digest()
+
+
+def node_hash(left, right):
+    return hashlib.sha256(NODE_PREFIX + left + right).digest()
+
+
+def _split(n):
+    # Largest power of two smaller than n
+    k = 1
+    while k << 1 < n:
+        k <<= 1
+    return k
+
+
+def merkle_root(challenges):
+    if not challenges:
+        raise ValueError('The batch must contain at least one challenge')
+    if len(challenges) == 1:
+        return leaf_hash(challenges[0])
+    k = _split(len(challenges))
+    return node_hash(merkle_root(challenges[:k]), merkle_root(challenges[k:]))
+
+
+def inclusion_proof(challenges, index):
+    """Returns the audit path of the challenge at index, leaf first."""
+    if not 0 <= index < len(challenges):
+        raise ValueError('Challenge index out of range: {}'.format(index))
+    if len(challenges) == 1:
+        return []
+    k = _split(len(challenges))
+    if index < k:
+        return (inclusion_proof(challenges[:k], index) +
+                [merkle_root(challenges[k:])])
+    return (inclusion_proof(challenges[k:], index - k) +
+            [merkle_root(challenges[:k])])
+
+
+def verify_inclusion(challenge, index, size, path, root):
+    """Checks an inclusion proof, see RFC 9162 section 2.1.3.2."""
+    if not 0 <= index < size:
+        return False
+    fn = index
+    sn = size - 1
+    r = leaf_hash(challenge)
+    for p in path:
+        if sn == 0:
+            return False
+        if fn & 1 or fn == sn:
+            r = node_hash(p, r)
+            while not fn & 1 and fn != 0:
+                fn >>= 1
+                sn >>= 1
+        else:
+            r = node_hash(r, p)
+        fn >>= 1
+        sn >>= 1
+    return sn == 0 and r == root
+
+
+def read_challenges(path):
+    """Reads the challenges from a file, one hex string per line."""
+    with open(path) as fh:
+        lines = [line.strip() for line in fh]
+    return [bytes.fromhex(line) for line in lines if line]
+
+
+def read_proof(path):
+    """Reads an inclusion proof from a JSON file."""
+    with open(path) as fh:
+        raw = json.load(fh)
+    return (bytes.fromhex(raw['challenge']), raw['index'], raw['size'],
+            [bytes.fromhex(p) for p in raw['path']])
+
+
+def proof_to_json(challenges, index):
+    return {
+        'challenge': challenges[index].hex(),
+        'index': index,
+        'size': len(challenges),
+        'path': [p.hex() for p in inclusion_proof(challenges, index)],
+    }
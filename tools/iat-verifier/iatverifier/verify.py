@@ -16,7 +16,7 @@ import cbor
 from ecdsa import SigningKey
 from pycose.sign1message import Sign1Message
 
-from iatverifier import const
+from iatverifier import batch, const
 from iatverifier.util import extract_iat_from_cose, recursive_bytes_to_strings
 
 
@@ -262,6 +262,22 @@ def decode_and_validate_iat(encoded_iat, keep_going=False, strict=False):
     return token
 
 
+def verify_batch(token, challenges_file=None, proof_file=None):
+    root = token.get('CHALLENGE')
+    if not isinstance(root, bytes):
+        error('Invalid batch token: CHALLENGE must be a bytes string')
+
+    if challenges_file:
+        challenges = batch.read_challenges(challenges_file)
+        if batch.merkle_root(challenges) != root:
+            error('Batch challenges do not match the CHALLENGE claim')
+
+    if proof_file:
+        challenge, index, size, path = batch.read_proof(proof_file)
+        if not batch.verify_inclusion(challenge, index, size, path, root):
+            error('Invalid inclusion proof for challenge {}'.format(index))
+
+
 def main():
     parser = argparse.ArgumentParser(
         description='''
@@ -294,6 +310,23 @@ def main():
                         Specify how this token is wrapped -- whether Sign1Message or
                         Mac0Message COSE structure is used.
                         ''')
+    parser.add_argument('-b', '--batch-challenges',
+                        help='''
+                        Path to a file containing the challenges of a batch
+                        token, one hex string per line. Checks that the
+                        CHALLENGE claim is their Merkle root.
+                        ''')
+    parser.add_argument('--batch-proof',
+                        help='''
+                        Path to a JSON file containing the inclusion proof of
+                        a challenge in a batch token. Checks the proof against
+                        the CHALLENGE claim.
+                        ''')
+    parser.add_argument('--print-proofs', action='store_true',
+                        help='''
+                        Print the inclusion proofs of the challenges given
+                        with --batch-challenges in JSON format.
+                        ''')
     args = parser.parse_args()
 
     logging.basicConfig(level=logging.INFO)
@@ -315,6 +348,22 @@ def main():
         logger.error('Could not validate IAT:\n\t{}'.format(e))
         sys.exit(1)
 
+    if args.batch_challenges or args.batch_proof:
+        try:
+            verify_batch(token, args.batch_challenges, args.batch_proof)
+            print('Batch OK')
+        except (ValueError, KeyError, OSError) as e:
+            logger.error('Could not verify batch:\n\t{}'.format(e))
+            sys.exit(1)
+
+    if args.print_proofs and args.batch_challenges:
+        challenges = batch.read_challenges(args.batch_challenges)
+        print('Proofs:')
+        json.dump([batch.proof_to_json(challenges, i)
+                   for i in range(len(challenges))],
+                  sys.stdout, indent=4)
+        print('')
+
     if args.print_iat:
         print('Token:')
         json.dump(recursive_bytes_to_strings(token, in_place=True),
@@ -0,0 +1,53 @@
+# -----------------------------------------------------------------------------
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# -----------------------------------------------------------------------------
+
+import hashlib
+import unittest
+
+from iatverifier.batch import (leaf_hash, node_hash, merkle_root,
+                               inclusion_proof, verify_inclusion)
+
+
+def make_challenges(count, size=32):
+    return [bytes([i]) * size for i in range(count)]
+
+
+class TestBatch(unittest.TestCase):
+
+    def test_single_challenge(self):
+        challenge = bytes(range(32))
+        expected = hashlib.sha256(b'\x00' + challenge).digest()
+        self.assertEqual(merkle_root([challenge]), expected)
+        self.assertEqual(inclusion_proof([challenge], 0), [])
+        self.assertTrue(verify_inclusion(challenge, 0, 1, [], expected))
+
+    def test_unbalanced_tree(self):
+        c = make_challenges(3)
+        expected = node_hash(node_hash(leaf_hash(c[0]), leaf_hash(c[1])),
+                             leaf_hash(c[2]))
+        self.assertEqual(merkle_root(c), expected)
+
+    def test_inclusion_proofs(self):
+        for count in range(1, 9):
+            challenges = make_challenges(count, 64)
+            root = merkle_root(challenges)
+            for index, challenge in enumerate(challenges):
+                path = inclusion_proof(challenges, index)
+                self.assertTrue(verify_inclusion(challenge, index, count,
+                                                 path, root))
+
+    def test_invalid_proofs(self):
+        challenges = make_challenges(5)
+        root = merkle_root(challenges)
+        path = inclusion_proof(challenges, 2)
+
+        self.assertFalse(verify_inclusion(challenges[3], 2, 5, path, root))
+        self.assertFalse(verify_inclusion(challenges[2], 3, 5, path, root))
+        self.assertFalse(verify_inclusion(challenges[2], 2, 4, path, root))
+        self.assertFalse(verify_inclusion(challenges[2], 2, 5, path[:-1],
+                                          root))
+        self.assertFalse(verify_inclusion(challenges[2], 5, 5, path, root))
@@ -0,0 +1,277 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2020, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+"""
+Decodes the SPM trace (TFM_SPM_TRACE), as read by tfm_platform_trace_read(),
+into the latency of each stage of the PSA calls, and optionally into a Chrome
+trace (chrome://tracing, or https://ui.perfetto.dev) of the partitions.
+
+The input is the raw events, either binary or as hex text (whitespace is
+ignored), in the layout of struct tfm_spm_trace_event_t of
+interface/include/tfm_spm_trace_defs.h.
+"""
+
+import sys
+import json
+import string
+import struct
+import argparse
+
+EVENT_FORMAT = '<IHHII'
+EVENT_SIZE = struct.calcsize(EVENT_FORMAT)
+
+# enum tfm_spm_trace_event_id_t
+EVENT_NAMES = [
+    'SVC_ENTER',
+    'SVC_EXIT',
+    'CALL_ENTER',
+    'CALL_CHECKED',
+    'CALL_DISPATCH',
+    'SCHEDULE',
+    'MSG_GET',
+    'REPLY',
+    'DROPPED',
+]
+(EV_SVC_ENTER, EV_SVC_EXIT, EV_CALL_ENTER, EV_CALL_CHECKED, EV_CALL_DISPATCH,
+ EV_SCHEDULE, EV_MSG_GET, EV_REPLY, EV_DROPPED) = range(len(EVENT_NAMES))
+
+# The stages of a call, and the events they end with
+STAGES = [
+    ('mem_check', 'checked'),   # CALL_ENTER    -> CALL_CHECKED
+    ('queue', 'dispatch'),      # CALL_CHECKED  -> CALL_DISPATCH
+    ('schedule', 'msg_get'),    # CALL_DISPATCH -> MSG_GET
+    ('service', 'reply'),       # MSG_GET       -> REPLY
+    ('return', 'resume'),       # REPLY         -> caller scheduled again
+]
+
+
+class Event(object):
+    def __init__(self, timestamp, event_id, partition_id, sid, handle):
+        self.timestamp = timestamp
+        self.event_id = event_id
+        self.partition_id = partition_id
+        self.sid = sid
+        self.handle = handle
+
+    def name(self):
+        if self.event_id < len(EVENT_NAMES):
+            return EVENT_NAMES[self.event_id]
+        return 'EVENT_{}'.format(self.event_id)
+
+
+class Call(object):
+    """The events of one psa_call(), keyed by their connection handle"""
+    def __init__(self, event):
+        self.sid = event.sid
+        self.handle = event.handle
+        self.client = event.partition_id
+        self.service = None
+        self.times = {'enter': event.timestamp}
+
+    def complete(self):
+        return 'resume' in self.times
+
+    def stage_times(self):
+        """Duration of each stage, in timestamp ticks"""
+        start = self.times['enter']
+        durations = []
+        for stage, end in STAGES:
+            durations.append((stage, start, self.times[end] - start))
+            start = self.times[end]
+        return durations
+
+
+def read_events(data):
+    """Parses the raw trace, binary or hex text, into a list of Events"""
+    text = data.decode('ascii', errors='replace')
+    if text and all(c in string.hexdigits or c.isspace() for c in text):
+        data = bytes.fromhex(''.join(text.split()))
+
+    if len(data) % EVENT_SIZE:
+        sys.stderr.write('warning: ignoring {} trailing bytes\n'
+                         .format(len(data) % EVENT_SIZE))
+        data = data[:len(data) - len(data) % EVENT_SIZE]
+
+    events = []
+    for fields in struct.iter_unpack(EVENT_FORMAT, data):
+        events.append(Event(*fields))
+
+    # The 32-bit timestamps wrap around, the events are in order
+    wraps = 0
+    last = None
+    for event in events:
+        if last is not None and event.timestamp < last:
+            wraps += 1
+        last = event.timestamp
+        event.timestamp += wraps << 32
+
+    return events
+
+
+def correlate(events):
+    """Follows each call through its events, returns the calls completed, the
+    SVC spans and the number of events dropped"""
+    calls = []
+    open_calls = {}     # handle -> Call
+    replied = []        # Calls waiting for their client to be scheduled
+    svc_open = {}       # partition -> SVC_ENTER event
+    svc_spans = []
+    dropped = 0
+
+    for event in events:
+        eid = event.event_id
+        call = open_calls.get(event.handle)
+
+        if eid == EV_CALL_ENTER:
+            # Calls on a connection are serialised, a new one ends the last
+            open_calls[event.handle] = Call(event)
+        elif eid == EV_CALL_CHECKED and call and len(call.times) == 1:
+            call.times['checked'] = event.timestamp
+        elif eid == EV_CALL_DISPATCH and call and 'checked' in call.times:
+            call.times['dispatch'] = event.timestamp
+            call.service = event.partition_id
+        elif eid == EV_MSG_GET and call and 'dispatch' in call.times and \
+                'msg_get' not in call.times:
+            call.times['msg_get'] = event.timestamp
+        elif eid == EV_REPLY and call and 'msg_get' in call.times:
+            call.times['reply'] = event.timestamp
+            del open_calls[event.handle]
+            replied.append(call)
+        elif eid == EV_SCHEDULE:
+            for call in [c for c in replied
+                         if c.client == event.partition_id]:
+                call.times['resume'] = event.timestamp
+                replied.remove(call)
+                calls.append(call)
+        elif eid == EV_SVC_ENTER:
+            svc_open[event.partition_id] = event
+        elif eid == EV_SVC_EXIT:
+            enter = svc_open.pop(event.partition_id, None)
+            if enter is not None and enter.sid == event.sid:
+                svc_spans.append((enter, event))
+        elif eid == EV_DROPPED:
+            dropped += event.handle
+            # The calls in flight have lost some of their events
+            open_calls.clear()
+            del replied[:]
+
+    return calls, svc_spans, dropped
+
+
+def print_summary(calls, svc_spans, dropped, unit, out):
+    by_sid = {}
+    for call in calls:
+        by_sid.setdefault(call.sid, []).append(call)
+
+    out.write('{} calls, {} SVCs, {} events dropped\n'
+              .format(len(calls), len(svc_spans), dropped))
+    if not calls:
+        return
+
+    out.write('\nMean (min-max) latency of each stage, in {}:\n'.format(unit))
+    out.write('{:>10} {:>6}'.format('SID', 'calls'))
+    for stage, _ in STAGES:
+        out.write(' {:>20}'.format(stage))
+    out.write(' {:>20}\n'.format('total'))
+
+    for sid in sorted(by_sid):
+        sid_calls = by_sid[sid]
+        out.write('0x{:08x} {:>6}'.format(sid, len(sid_calls)))
+        columns = [[d for _, _, d in c.stage_times()] for c in sid_calls]
+        columns = list(zip(*columns))
+        columns.append([sum(c) for c in zip(*columns)])
+        for values in columns:
+            out.write(' {:>20}'.format('{} ({}-{})'.format(
+                sum(values) // len(values), min(values), max(values))))
+        out.write('\n')
+
+
+def chrome_trace(events, calls, svc_spans, scale):
+    """The trace in the Chrome trace event format, one thread per partition.
+    Timestamps are in microseconds."""
+    trace = []
+
+    def ts(ticks):
+        return ticks / scale
+
+    for call in calls:
+        for stage, start, duration in call.stage_times():
+            tid = call.service if stage in ('schedule', 'service') \
+                else call.client
+            trace.append({
+                'name': stage, 'cat': 'psa_call', 'ph': 'X',
+                'pid': 0, 'tid': tid,
+                'ts': ts(start), 'dur': ts(duration),
+                'args': {'sid': '0x{:08x}'.format(call.sid),
+                         'handle': '0x{:08x}'.format(call.handle)},
+            })
+
+    for enter, leave in svc_spans:
+        trace.append({
+            'name': 'SVC {}'.format(enter.sid), 'cat': 'svc', 'ph': 'X',
+            'pid': 0, 'tid': enter.partition_id,
+            'ts': ts(enter.timestamp),
+            'dur': ts(leave.timestamp - enter.timestamp),
+        })
+
+    for event in events:
+        if event.event_id in (EV_SCHEDULE, EV_DROPPED):
+            args = {}
+            if event.event_id == EV_DROPPED:
+                args['dropped'] = event.handle
+            trace.append({
+                'name': event.name(), 'cat': 'spm', 'ph': 'i', 's': 'g',
+                'pid': 0, 'tid': event.partition_id,
+                'ts': ts(event.timestamp), 'args': args,
+            })
+
+    partitions = set(e.partition_id for e in events)
+    for pid in sorted(partitions):
+        trace.append({
+            'name': 'thread_name', 'ph': 'M', 'pid': 0, 'tid': pid,
+            'args': {'name': 'Partition {}'.format(pid)},
+        })
+
+    return {'traceEvents': trace, 'displayTimeUnit': 'ns'}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('trace', help='Trace file, binary or hex text')
+    parser.add_argument('-f', '--freq', type=float, default=None,
+                        help='Frequency of the timestamp counter, in MHz. '
+                             'Without it, latencies are in counter ticks')
+    parser.add_argument('-c', '--chrome', metavar='FILE',
+                        help='Write a Chrome trace (JSON) to FILE')
+    parser.add_argument('-d', '--dump', action='store_true',
+                        help='Print the raw events')
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        events = read_events(f.read())
+
+    if args.dump:
+        for e in events:
+            sys.stdout.write('{:>12} {:<14} {:>5} 0x{:08x} 0x{:08x}\n'.format(
+                e.timestamp, e.name(), e.partition_id, e.sid, e.handle))
+        sys.stdout.write('\n')
+
+    calls, svc_spans, dropped = correlate(events)
+    print_summary(calls, svc_spans, dropped,
+                  'ticks' if args.freq is None else 'ticks of {} MHz'
+                  .format(args.freq), sys.stdout)
+
+    if args.chrome:
+        # Without a frequency, one tick is shown as one microsecond
+        scale = args.freq if args.freq else 1.0
+        with open(args.chrome, 'w') as f:
+            json.dump(chrome_trace(events, calls, svc_spans, scale), f)
+
+
+if __name__ == '__main__':
+    main()
@@ -87,7 +87,7 @@ key_asset::key_asset (void)
     // Randomize key type:
     key_type = rand_key_type();
     // Randomize lifetime:
-    lifetime_str = ((rand() % 2) == 1)?
+    lifetime_str = ((rand_int() % 2) == 1)?
                        "PSA_KEY_LIFETIME_VOLATILE" : "PSA_KEY_LIFETIME_PERSISTENT";
 }
 
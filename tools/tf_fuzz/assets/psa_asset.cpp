@@ -8,6 +8,7 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "data_blocks.hpp"
@@ -48,3 +49,249 @@ psa_asset::~psa_asset (void)
 /**********************************************************************************
    End of methods of class psa_asset.
 **********************************************************************************/
+
+
+/**********************************************************************************
+   Methods of class psa_asset_list follow:
+**********************************************************************************/
+
+psa_asset_list::iterator::iterator (void)  // (constructor)
+{
+    list = nullptr;
+    entry = 0;
+}
+
+psa_asset_list::iterator::iterator (psa_asset_list *in_list, long at_entry)
+{
+    list = in_list;
+    entry = at_entry;
+}
+
+psa_asset *&psa_asset_list::iterator::operator* (void) const
+{
+    return list->slots[list->entry_slot[entry]].asset;
+}
+
+psa_asset_list::iterator &psa_asset_list::iterator::operator++ (void)
+{
+    entry = list->entry_at (list->count_before (entry) + 1);
+    return *this;
+}
+
+psa_asset_list::iterator psa_asset_list::iterator::operator++ (int)
+{
+    iterator was = *this;
+
+    ++*this;
+    return was;
+}
+
+psa_asset_list::iterator &psa_asset_list::iterator::operator-- (void)
+{
+    entry = list->entry_at (list->count_before (entry) - 1);
+    return *this;
+}
+
+psa_asset_list::iterator psa_asset_list::iterator::operator-- (int)
+{
+    iterator was = *this;
+
+    --*this;
+    return was;
+}
+
+psa_asset_list::iterator psa_asset_list::iterator::operator+ (long n) const
+{
+    return iterator (list, list->entry_at (list->count_before (entry) + n));
+}
+
+bool psa_asset_list::iterator::operator== (const iterator &other) const
+{
+    return list == other.list && entry == other.entry;
+}
+
+bool psa_asset_list::iterator::operator!= (const iterator &other) const
+{
+    return !(*this == other);
+}
+
+psa_asset_list::iterator psa_asset_list::begin (void)
+{
+    return iterator (this, entry_at (0));
+}
+
+psa_asset_list::iterator psa_asset_list::end (void)
+{
+    return iterator (this, next_entry_no);
+}
+
+size_t psa_asset_list::size (void)
+{
+    return num_assets;
+}
+
+long psa_asset_list::count_before (long entry)
+{
+    long count = 0;
+
+    for (long i = entry;  i > 0;  i -= i & -i) {
+        count += live[i];
+    }
+    return count;
+}
+
+long psa_asset_list::entry_at (long position)
+{
+    long top = live.size() - 1;  // (live[0] is not used)
+    long step = 1;
+    long entry = 0;
+
+    if (position < 0 || position >= (long) num_assets) {
+        return next_entry_no;  // i.e., end()
+    }
+    while (step * 2 <= top) {
+        step *= 2;
+    }
+    // Walk down the tree to the last entry with no more than position before it:
+    for (;  step > 0;  step /= 2) {
+        if (entry + step <= top && live[entry + step] <= position) {
+            entry += step;
+            position -= live[entry];
+        }
+    }
+    return entry;
+}
+
+void psa_asset_list::index (asset_slot &slot)
+{
+    slot.indexed_name = slot.asset->asset_id.get_name();
+    slot.indexed_id = slot.asset->asset_id.id_n;
+    by_name[slot.indexed_name].insert (slot.entry);
+    by_id[slot.indexed_id].insert (slot.entry);
+}
+
+void psa_asset_list::unindex (asset_slot &slot)
+{
+    auto name_entries = by_name.find (slot.indexed_name);
+    auto id_entries = by_id.find (slot.indexed_id);
+
+    name_entries->second.erase (slot.entry);
+    if (name_entries->second.empty()) {
+        by_name.erase (name_entries);
+    }
+    id_entries->second.erase (slot.entry);
+    if (id_entries->second.empty()) {
+        by_id.erase (id_entries);
+    }
+}
+
+void psa_asset_list::push_back (psa_asset *asset)
+{
+    long entry = next_entry_no++;
+    long node = entry + 1;
+    size_t slot_no;
+
+    if (free_slots.empty()) {
+        slot_no = slots.size();
+        slots.push_back (asset_slot());
+    } else {
+        slot_no = free_slots.back();
+        free_slots.pop_back();
+    }
+    slots[slot_no].asset = asset;
+    slots[slot_no].entry = entry;
+    entry_slot.push_back (slot_no);
+    index (slots[slot_no]);
+    by_serial.insert (make_pair (asset->asset_ser_no, entry));
+        // (keeps the first, should an asset somehow go in twice)
+    // The new tree node counts itself, plus the listed entries it spans before it:
+    live.push_back (1 + count_before (entry) - count_before (node - (node & -node)));
+    num_assets++;
+}
+
+psa_asset_list::iterator psa_asset_list::erase (iterator position)
+{
+    long entry = position.entry;
+    size_t slot_no = entry_slot[entry];
+    asset_slot &slot = slots[slot_no];
+    auto serial = by_serial.find (slot.asset->asset_ser_no);
+
+    unindex (slot);
+    if (serial != by_serial.end() && serial->second == entry) {
+        by_serial.erase (serial);
+    }
+    slot.asset = nullptr;
+    free_slots.push_back (slot_no);
+    for (size_t node = entry + 1;  node < live.size();  node += node & -node) {
+        live[node]--;
+    }
+    num_assets--;
+    // The asset after the erased one now has the erased one's position:
+    return iterator (this, entry_at (count_before (entry)));
+}
+
+psa_asset_list::iterator psa_asset_list::find (
+    psa_asset_search criterion,  // what to search on
+    string target_name,  // ignored if not searching on name
+    uint64_t target_id,  // also ignored if not searching on ID (e.g., SST UID)
+    long serial_no  // ignored if not searching on serial number
+) {
+    switch (criterion) {
+        case psa_asset_search::name:  // human-meaningful name
+            {
+                auto entries = by_name.find (target_name);
+                if (entries != by_name.end()) {
+                    return iterator (this, *entries->second.begin());
+                }
+            }
+            break;
+        case psa_asset_search::id:  // ID#
+            {
+                auto entries = by_id.find (target_id);
+                if (entries != by_id.end()) {
+                    return iterator (this, *entries->second.begin());
+                }
+            }
+            break;
+        default:  // psa_asset_search::serial
+            {
+                auto entry = by_serial.find (serial_no);
+                if (entry != by_serial.end()) {
+                    return iterator (this, entry->second);
+                }
+            }
+            break;
+    }
+    return end();
+}
+
+void psa_asset_list::reindex (psa_asset *asset)
+{
+    auto entry = by_serial.find (asset->asset_ser_no);
+
+    if (entry == by_serial.end()) {
+        return;  // not in this list
+    }
+    asset_slot &slot = slots[entry_slot[entry->second]];
+    if (   slot.indexed_name != asset->asset_id.get_name()
+        || slot.indexed_id != asset->asset_id.id_n) {
+        unindex (slot);
+        index (slot);
+    }
+}
+
+psa_asset_list::psa_asset_list (void)  // (constructor)
+{
+    next_entry_no = 0;
+    num_assets = 0;
+    live.push_back (0);  // (the tree counts from 1)
+}
+
+psa_asset_list::~psa_asset_list (void)
+{
+    return;  // just to have something to pin a breakpoint onto
+}
+
+/**********************************************************************************
+   End of methods of class psa_asset_list.
+**********************************************************************************/
@@ -43,14 +43,15 @@ public:
         void set_name (string set_val);
         string get_name (void);
         psa_asset();  // (constructor)
-        ~psa_asset();
+        virtual ~psa_asset();
 
 protected:
     // Data members:
         // These are initially copied over from the call (or possibly template line):
         string data;  // String describing current data value.
         string asset_name;  // human-meaningful name
-        static long unique_id_counter;  // counts off unique IDs for assets
+        static thread_local long unique_id_counter;
+            // counts off unique IDs for assets (per thread, see tf_fuzz_batch.hpp)
     // Methods:
 
 private:
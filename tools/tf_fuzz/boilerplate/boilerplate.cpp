@@ -8,6 +8,7 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "data_blocks.hpp"
@@ -10,9 +10,9 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
-#include "randomization.hpp"
 #include "string_ops.hpp"
 #include "data_blocks.hpp"
 #include "psa_asset.hpp"
@@ -23,6 +23,7 @@
 #include "psa_call.hpp"
 #include "crypto_call.hpp"
 #include "sst_asset.hpp"
+#include "target_model.hpp"
 
 
 
@@ -70,10 +71,10 @@ key_call::key_call (tf_fuzz_info *test_state,    // (constructor)
     // Randomize key type:
     key_type = rand_key_type();
     // Randomize lifetime:
-    lifetime_str = ((rand() % 2) == 1)?
+    lifetime_str = ((rand_int() % 2) == 1)?
                        "PSA_KEY_LIFETIME_VOLATILE" : "PSA_KEY_LIFETIME_PERSISTENT";
     // Choose a random expected key size in bits:
-    expected_n_bits = to_string(rand()%10000);
+    expected_n_bits = to_string(rand_int()%10000);
     delete gib;
 }
 key_call::~key_call (void)
@@ -108,6 +109,12 @@ policy_set_call::~policy_set_call (void)
     return;  // just to have something to pin a breakpoint onto
 }
 
+void policy_set_call::simulate (void)
+{
+    expect.set_pf_modeled (test_state->model->policy_set (
+        asset_id.get_name(), policy_usage, policy_algorithm));
+}
+
 void policy_set_call::fill_in_prep_code (void)
 {
     // No prep code required.
@@ -116,7 +123,7 @@ void policy_set_call::fill_in_prep_code (void)
 
 void policy_set_call::fill_in_command (void)
 {
-    vector<psa_asset*>::iterator found_asset;
+    psa_asset_list::iterator found_asset;
 
     // Is this search really needed?
     // Find the call by serial number (must search;  may have moved).
@@ -164,6 +171,11 @@ policy_get_call::~policy_get_call (void)
     return;  // just to have something to pin a breakpoint onto
 }
 
+void policy_get_call::simulate (void)
+{
+    expect.set_pf_modeled (test_state->model->policy_get (asset_id.get_name()));
+}
+
 void policy_get_call::fill_in_prep_code (void)
 {
     return;  // just to have something to pin a breakpoint onto
@@ -202,6 +214,12 @@ set_key_call::~set_key_call (void)
 {
 }
 
+void set_key_call::simulate (void)
+{
+    expect.set_pf_modeled (test_state->model->key_create (asset_id.get_name(),
+                                                          lifetime_str));
+}
+
 void set_key_call::fill_in_prep_code (void)
 {
     // Create declaration of lifetime's holder variable:
@@ -242,12 +260,17 @@ get_key_info_call::~get_key_info_call (void)
 {
 }
 
+void get_key_info_call::simulate (void)
+{
+    expect.set_pf_modeled (test_state->model->key_use (asset_id.get_name()));
+}
+
 void get_key_info_call::fill_in_prep_code (void)
 {
     // Create declaration of size_t variable to accept #bits info into:
     find_replace_1st ("$type", "size_t", prep_code);
     find_replace_1st ("$var", handle_str + "_n_bits", prep_code);
-    find_replace_1st ("$init", to_string(rand()%10000), prep_code);
+    find_replace_1st ("$init", to_string(rand_int()%10000), prep_code);
 }
 
 void get_key_info_call::fill_in_command (void)
@@ -292,6 +315,11 @@ destroy_key_call::~destroy_key_call (void)
     return;  // just to have something to pin a breakpoint onto
 }
 
+void destroy_key_call::simulate (void)
+{
+    expect.set_pf_modeled (test_state->model->key_destroy (asset_id.get_name()));
+}
+
 void destroy_key_call::fill_in_prep_code (void)
 {
     // No prep code required.
@@ -74,6 +74,7 @@ class policy_set_call : public policy_call
 public:
     // Data members:
     // Methods:
+        void simulate (void);
         void fill_in_prep_code (void);
         void fill_in_command (void);
         policy_set_call (tf_fuzz_info *test_state, long &asset_ser_no,
@@ -95,6 +96,7 @@ class policy_get_call : public policy_call
 public:
     // Data members:
     // Methods:
+        void simulate (void);
         void fill_in_prep_code (void);
         void fill_in_command (void);
         policy_get_call (tf_fuzz_info *test_state, long &asset_ser_no,
@@ -117,6 +119,7 @@ class set_key_call : public key_call
 public:
     // Data members:
     // Methods:
+        void simulate (void);
         void fill_in_prep_code (void);
         void fill_in_command (void);
         set_key_call (tf_fuzz_info *test_state, long &asset_ser_no,
@@ -138,6 +141,7 @@ class get_key_info_call : public key_call
 public:
     // Data members:
     // Methods:
+        void simulate (void);
         void fill_in_prep_code (void);
         void fill_in_command (void);
         get_key_info_call (tf_fuzz_info *test_state, long &asset_ser_no,
@@ -159,6 +163,7 @@ class destroy_key_call : public key_call
 public:
     // Data members:
     // Methods:
+        void simulate (void);
         void fill_in_prep_code (void);
         void fill_in_command (void);
         destroy_key_call (tf_fuzz_info *test_state, long &asset_ser_no,
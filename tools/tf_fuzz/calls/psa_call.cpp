@@ -8,6 +8,7 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "string_ops.hpp"
@@ -49,6 +50,12 @@ psa_call::~psa_call (void)
     return;  // just to have something to pin a breakpoint onto
 }
 
+void psa_call::simulate (void)
+{
+    // Calls that aren't PSA calls as such have no effect on the target.
+    return;  // just to have something to pin a breakpoint onto
+}
+
 void psa_call::write_out_prep_code (ofstream &test_file)
 {
     test_file << prep_code;
@@ -80,8 +87,9 @@ void psa_call::write_out_check_code (ofstream &test_file)
 /* calc_result_code() fills in the check_code string member with the correct
    result code (e.g., "PSA_SUCCESS" or whatever).
 
-   This is a big part of where the target modeling -- error modeling -- occurs,
-   so lots of room for further refinement here. */
+   Unless the template says what to expect, that's what the model of the target
+   worked out in simulate().  The how_asset_found cases below are only for calls
+   the model couldn't tell about. */
 void sst_call::calc_result_code (void)
 {
     if (!expect.pf_nothing) {
@@ -93,6 +101,9 @@ void sst_call::calc_result_code (void)
             if (expect.pf_specified) {
                 find_replace_all ("$expect", expect.pf_result_string,
                                   check_code);
+            } else if (expect.pf_modeled) {
+                find_replace_all ("$expect", expect.pf_modeled_string,
+                                  check_code);
             } else {
                 // Figure out what the message should read:
                 switch (how_asset_found) {
@@ -145,10 +156,11 @@ sst_call::~sst_call (void)
 **********************************************************************************/
 
 /* calc_result_code() fills in the check_code string member with the correct
-   result code (e.g., "PSA_SUCCESS" or whatever).  This "modeling" needs to be
-   improved and expanded upon *massively* more or less mirroring what is seen in
-   .../test/suites/crypto/crypto_tests_common.c in the psa_key_interface_test()
-   method, (starting around line 20ish). */
+   result code (e.g., "PSA_SUCCESS" or whatever).  Unless the template says what
+   to expect, that's what the model of the target worked out in simulate(), if it
+   could.  The model of keys and policies needs to be expanded upon, more or less
+   mirroring what is seen in .../test/suites/crypto/crypto_tests_common.c in the
+   psa_key_interface_test() method, (starting around line 20ish). */
 void crypto_call::calc_result_code (void)
 {
     if (!expect.pf_nothing) {
@@ -158,6 +170,9 @@ void crypto_call::calc_result_code (void)
             if (expect.pf_specified) {
                 find_replace_1st ("$expect", expect.pf_result_string,
                                   check_code);
+            } else if (expect.pf_modeled) {
+                find_replace_all ("$expect", expect.pf_modeled_string,
+                                  check_code);
             } else {
                 // Figure out what the message should read:
                 switch (how_asset_found) {
@@ -40,6 +40,9 @@ public:
         string flags_string;
             // creation flags, nominally for SST but have to be in a vector of base-class
     // Methods:
+        virtual void simulate (void);
+            /* works out, from the model of the target, what this call should
+               return;  before fill_in_prep_code() */
         virtual void fill_in_prep_code (void) = 0;
         virtual void fill_in_command (void) = 0;
         void write_out_prep_code (ofstream &test_file);
@@ -47,14 +50,15 @@ public:
         void write_out_check_code (ofstream &test_file);
         psa_call (tf_fuzz_info *test_state, long &asset_ser_no,
                   asset_search how_asset_found);  // (constructor)
-        ~psa_call (void);
+        virtual ~psa_call (void);
 
 protected:
     // Data members:
         string prep_code;  // declarations and such prior to all of the calls
         string call_code;  // for the call itself
         string check_code;  // for the code to check success of the call
-        static long unique_id_counter;  // counts off unique IDs for assets
+        static thread_local long unique_id_counter;
+            // counts off unique IDs for assets (per thread, see tf_fuzz_batch.hpp)
     // Methods:
         virtual void calc_result_code (void) = 0;
 
@@ -10,9 +10,9 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
-#include "randomization.hpp"
 #include "string_ops.hpp"
 #include "data_blocks.hpp"
 #include "psa_asset.hpp"
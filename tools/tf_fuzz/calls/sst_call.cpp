@@ -8,6 +8,7 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "string_ops.hpp"
@@ -21,6 +22,7 @@
 #include "sst_call.hpp"
 #include "sst_asset.hpp"
 #include "crypto_asset.hpp"
+#include "target_model.hpp"
 
 
 
@@ -43,6 +45,12 @@ sst_set_call::~sst_set_call (void)
     return;  // just to have something to pin a breakpoint onto
 }
 
+void sst_set_call::simulate (void)
+{
+    expect.set_pf_modeled (test_state->model->sst_set (
+        asset_id.id_n, set_data.get(), !set_data.file_specified, flags_string));
+}
+
 void sst_set_call::fill_in_prep_code (void)
 {
     // Single string of two lines declaring string data and its length:
@@ -107,6 +115,7 @@ sst_get_call::sst_get_call (tf_fuzz_info *test_state,    // (constructor)
                             asset_search how_asset_found)
                                  : sst_call(test_state, call_ser_no, how_asset_found)
 {
+    offset = data_length = 0;  // (data_length is worked out in simulate())
     // Copy the boilerplate text into local buffers:
     prep_code.assign ("");
     call_code.assign (test_state->bplate->bplate_string[get_sst_call]);
@@ -118,6 +127,25 @@ sst_get_call::~sst_get_call (void)
     return;  // just to have something to pin a breakpoint onto
 }
 
+void sst_get_call::simulate (void)
+{
+    string data;
+    bool data_known;
+
+    /* Templates don't say how much to read, so read all that the model says the
+       UID holds (or as much as fits into the buffer): */
+    expect.set_pf_modeled (test_state->model->sst_get (
+        asset_id.id_n, sst_get_buffer_size, data, data_known));
+    data_length = data.length();
+    /* Unless the template says what data to expect, check the data read against
+       what the model says it should be: */
+    if (   expect.pf_modeled_string == "PSA_SUCCESS" && data_known
+        && !expect.data_specified && !expect.data_var_specified) {
+        expect.data = data;
+        expect.data_modeled = true;
+    }
+}
+
 void sst_get_call::fill_in_prep_code (void)
 {
     string var_name, temp_string;
@@ -130,20 +158,20 @@ void sst_get_call::fill_in_prep_code (void)
         /* bogus data to prefill actual data with in order to distinguish
            whether actual data was provided. */
 
-    gib->sentence (gib_buff, gib_buff + 100 + (rand() % 800));
+    gib->sentence (gib_buff, gib_buff + 100 + (rand_int() % 800));
         // TODO:  Sizes of random data needs to be strategized better
     wrong_data = gib_buff;
     // Expected data:
-    if (expect.data_specified) {
-        /* Template specified expected verbatim, literal data.  Put that into a
-           variable: */
+    if (expect.data_specified || expect.data_modeled) {
+        /* Template specified expected verbatim, literal data, or the model of the
+           target knows what it is.  Put that into a variable: */
         var_name.assign (asset_id.get_name() + "_exp_data");
     } else if (expect.data_var_specified) {
         // Template specified a variable name for expected data;  use that:
         var_name.assign (expect.data_var);
     }
     // Expected data:
-    if (!(print_data || hash_data)) {
+    if (var_name != "" && (expect.data_modeled || !(print_data || hash_data))) {
         prep_code.assign(test_state->bplate->bplate_string[declare_string]);
         find_replace_1st("$var", var_name, prep_code);
         find_replace_1st("$init", expect.data, prep_code);
@@ -208,9 +236,16 @@ void sst_get_call::fill_in_command (void)
         find_replace_1st (" $data_source", "", call_code);
     }
 */    // Fill in the call itself:
-    if (assign_data_var_specified || print_data || hash_data) {
+    if (expect.data_modeled) {
+        // Check the data against what the model of the target says it should be:
+        check_code.assign (test_state->bplate->bplate_string[get_sst_check_all]);
+    } else if (assign_data_var_specified || print_data || hash_data) {
         // Dump to variable;  no data-check code needed:
         check_code.assign (test_state->bplate->bplate_string[get_sst_check]);
+    } else if (   !expect.pf_pass && !expect.pf_specified && expect.pf_modeled
+               && expect.pf_modeled_string != "PSA_SUCCESS") {
+        // The read is expected to fail, so there's no data to check:
+        check_code.assign (test_state->bplate->bplate_string[get_sst_check]);
     } else {
         // Check either against literal or variable, so need data-check code:
         check_code.assign (test_state->bplate->bplate_string[get_sst_check_all]);
@@ -219,7 +254,7 @@ void sst_get_call::fill_in_command (void)
               and check-data cases, because the boilerplate for the former is just an
               abbreviated version of the latter.  The find_replace_1st() calls for
               the check-data stuff will just simply not have any effect. */
-    if (expect.data_specified) {
+    if (expect.data_specified || expect.data_modeled) {
         exp_var_name.assign (asset_id.get_name() + "_exp_data");
     } else {
         // whether expect.data_var_specified is true or not:
@@ -237,7 +272,7 @@ void sst_get_call::fill_in_command (void)
     id_string = to_string((long) asset_id.id_n);
     // Fill in the PSA command itself:
     find_replace_1st ("$uid", id_string, call_code);
-    find_replace_all ("$length", to_string(set_data.get().length()), call_code);
+    find_replace_all ("$length", to_string(data_length), call_code);
     find_replace_1st ("$offset", "0", call_code);
     find_replace_1st ("$exp_data", exp_var_name, call_code);
     find_replace_all ("$act_data", act_var_name, call_code);
@@ -287,6 +322,11 @@ sst_remove_call::~sst_remove_call (void)
     return;  // just to have something to pin a breakpoint onto
 }
 
+void sst_remove_call::simulate (void)
+{
+    expect.set_pf_modeled (test_state->model->sst_remove (asset_id.id_n));
+}
+
 void sst_remove_call::fill_in_prep_code (void)
 {
     // No prep-code.
@@ -22,11 +22,15 @@
 
 using namespace std;
 
+const size_t sst_get_buffer_size = 2048;
+    // size of the buffer psa_ps_get() reads into (see declare_big_string)
+
 class sst_set_call : public sst_call
 {
 public:
     // Data members:
     // Methods:
+        void simulate (void);
         void fill_in_prep_code (void);
         void fill_in_command (void);
         sst_set_call (tf_fuzz_info *test_state, long &asset_ser_no,
@@ -51,6 +55,7 @@ public:
         uint32_t data_length;
         string data_var_name;
     // Methods:
+        void simulate (void);
         void fill_in_prep_code (void);
         void fill_in_command (void);
         sst_get_call (tf_fuzz_info *test_state, long &asset_ser_no,
@@ -71,6 +76,7 @@ class sst_remove_call : public sst_call
 public:
     // Data members:
     // Methods:
+        void simulate (void);
         void fill_in_prep_code (void);
         void fill_in_command (void);
         sst_remove_call (tf_fuzz_info *test_state, long &asset_ser_no,
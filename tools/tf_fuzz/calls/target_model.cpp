@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "class_forwards.hpp"
+#include "target_model.hpp"
+
+
+using namespace std;
+
+/**********************************************************************************
+   Methods of class target_model follow:
+**********************************************************************************/
+
+string target_model::sst_set (uint64_t uid, string data, bool data_known,
+                              string flags)
+{
+    if (uid == 0) {
+        return "PSA_ERROR_INVALID_ARGUMENT";
+    }
+    auto found = sst.find (uid);
+    if (found == sst.end()) {
+        sst_order.push_back (uid);
+        found = sst.insert ({uid, sst_uid_state()}).first;
+    } else if (found->second.exists && found->second.write_once) {
+        return "PSA_ERROR_NOT_PERMITTED";  // (and the data is left as it was)
+    }
+    found->second.exists = true;
+    found->second.write_once =
+        flags.find ("PSA_STORAGE_FLAG_WRITE_ONCE") != string::npos;
+    found->second.data_known = data_known;
+    found->second.data = data;
+    return "PSA_SUCCESS";
+}
+
+string target_model::sst_get (uint64_t uid, size_t length, string &data,
+                              bool &data_known)
+{
+    data_known = false;
+    if (uid == 0) {
+        return "PSA_ERROR_INVALID_ARGUMENT";
+    }
+    auto found = sst.find (uid);
+    if (found == sst.end() || !found->second.exists) {
+        return "PSA_ERROR_DOES_NOT_EXIST";
+    }
+    // Reads are from offset 0, so return as much of the data as asked for:
+    data_known = found->second.data_known;
+    data = found->second.data.substr (0, length);
+    return "PSA_SUCCESS";
+}
+
+string target_model::sst_remove (uint64_t uid)
+{
+    if (uid == 0) {
+        return "PSA_ERROR_INVALID_ARGUMENT";
+    }
+    auto found = sst.find (uid);
+    if (found == sst.end() || !found->second.exists) {
+        return "PSA_ERROR_DOES_NOT_EXIST";
+    }
+    if (found->second.write_once) {
+        return "PSA_ERROR_NOT_PERMITTED";
+    }
+    found->second.exists = false;
+    return "PSA_SUCCESS";
+}
+
+string target_model::key_create (string name, string lifetime)
+{
+    if (name == "") {
+        return "";  // no telling which key this is
+    }
+    key_state &key = keys[name];  // (a new key_state is zeroed, so not existing)
+    if (key.exists && key.persistent) {
+        return "PSA_ERROR_ALREADY_EXISTS";
+    }
+    key.exists = true;
+    key.persistent = lifetime.find ("PERSISTENT") != string::npos;
+    return "PSA_SUCCESS";
+}
+
+string target_model::key_use (string name)
+{
+    auto found = keys.find (name);
+
+    if (found == keys.end()) {
+        return "";  // could be a key made outside the test;  no telling
+    }
+    return found->second.exists?  "PSA_SUCCESS" : "PSA_ERROR_INVALID_HANDLE";
+}
+
+string target_model::key_destroy (string name)
+{
+    string result = key_use (name);
+
+    if (result == "PSA_SUCCESS") {
+        keys[name].exists = false;
+    }
+    return result;
+}
+
+string target_model::policy_set (string name, string usage, string algorithm)
+{
+    if (name == "") {
+        return "";
+    }
+    policy_state &policy = policies[name];
+    policy.set = true;
+    policy.usage = usage;
+    policy.algorithm = algorithm;
+    return "PSA_SUCCESS";
+}
+
+string target_model::policy_get (string name)
+{
+    auto found = policies.find (name);
+
+    if (found == policies.end() || !found->second.set) {
+        return "";
+    }
+    return "PSA_SUCCESS";
+}
+
+vector<uint64_t> target_model::sst_uids (void)
+{
+    return sst_order;
+}
+
+bool target_model::sst_exists (uint64_t uid)
+{
+    auto found = sst.find (uid);
+    return found != sst.end() && found->second.exists;
+}
+
+bool target_model::sst_write_once (uint64_t uid)
+{
+    auto found = sst.find (uid);
+    return found != sst.end() && found->second.exists && found->second.write_once;
+}
+
+void target_model::reset (void)
+{
+    sst.clear();
+    sst_order.clear();
+    keys.clear();
+    policies.clear();
+}
+
+target_model::target_model (void)  // (constructor)
+{
+    return;  // just to have something to pin a breakpoint onto
+}
+
+target_model::~target_model (void)
+{
+    return;  // just to have something to pin a breakpoint onto
+}
+
+/**********************************************************************************
+   End of methods of class target_model.
+**********************************************************************************/
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef TARGET_MODEL_HPP
+#define TARGET_MODEL_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+
+/* This project's header files #including other project headers quickly becomes
+   unrealistically complicated.  The only solution is for each .cpp to include
+   the headers it needs.  This one, however, is not dependent upon other classes.
+*/
+
+using namespace std;
+
+/* class target_model is a state-machine model of the PSA services under test, as
+   the test's calls find them.  Before the test is written out, each call, in the
+   order they are made, is "simulated" against it (see psa_call::simulate()):  The
+   model works out the PSA status the call should return, and for reads, the data
+   it should return, then changes its state as the call would change the target's.
+   This is what lets TF-Fuzz check the result of every call, rather than only those
+   with "expect" clauses, or where the parser's own asset tracking can tell.
+
+   The model is of what the PSA Protected Storage and Crypto APIs specify:
+   *  Protected Storage:  Each UID is absent until set, and is absent again after
+      being removed.  A UID set with PSA_STORAGE_FLAG_WRITE_ONCE can be neither set
+      again nor removed.  UID 0 is invalid.  Reads return the data last set, up to
+      the length asked for.
+   *  Keys:  A key exists from its creation until it is destroyed.  Creating a
+      persistent key that already exists fails.
+   *  Key policies:  Have no status, as such, once set.
+   Anything the model does not know about (such as keys it has never seen, or that
+   have no name), it returns "" for, in which case the call falls back to working
+   out its expected result for itself. */
+
+class sst_uid_state
+{
+public:  // (just a record of what the target holds for this UID)
+    // Data members:
+        bool exists;
+        bool write_once;  // set with PSA_STORAGE_FLAG_WRITE_ONCE
+        bool data_known;  // false if set from something TF-Fuzz can't see
+        string data;
+};
+
+class key_state
+{
+public:
+    // Data members:
+        bool exists;
+        bool persistent;  // (as opposed to volatile)
+};
+
+class policy_state
+{
+public:
+    // Data members:
+        bool set;
+        string usage;
+        string algorithm;
+};
+
+
+class target_model
+{
+public:
+    // Data members:
+    // Methods:
+        /* Each of these makes the modeled target's state transition for one call,
+           and returns the PSA status that call should return: */
+        string sst_set (uint64_t uid, string data, bool data_known, string flags);
+        string sst_get (uint64_t uid, size_t length, string &data, bool &data_known);
+            // data returns what the read should find, if data_known
+        string sst_remove (uint64_t uid);
+        string key_create (string name, string lifetime);
+        string key_use (string name);
+        string key_destroy (string name);
+        string policy_set (string name, string usage, string algorithm);
+        string policy_get (string name);
+        /* What the target holds at the end of the test, for tearing it down: */
+        vector<uint64_t> sst_uids (void);  // all UIDs ever set, in order first set
+        bool sst_exists (uint64_t uid);
+        bool sst_write_once (uint64_t uid);
+        void reset (void);  // back to the target as it is before a test
+        target_model (void);  // (constructor)
+        ~target_model (void);
+
+protected:
+    // Data members:
+        unordered_map<uint64_t, sst_uid_state> sst;
+        vector<uint64_t> sst_order;  // UIDs, in the order first set
+        unordered_map<string, key_state> keys;  // by asset name
+        unordered_map<string, policy_state> policies;  // by asset name
+    // Methods:
+
+private:
+    // Data members:
+    // Methods:
+};
+
+#endif  // #ifndef TARGET_MODEL_HPP
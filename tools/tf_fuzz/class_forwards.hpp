@@ -55,9 +55,18 @@ class set_key_call;
 class get_key_info_call;
 class destroy_key_call;
 
+// target_model.hpp:
+class sst_uid_state;
+class key_state;
+class policy_state;
+class target_model;
+
 // psa_asset.hpp:
 class psa_asset;
 
+// find_or_create_asset.hpp:
+class psa_asset_list;
+
 // sst_asset.hpp:
 class sst_asset;
 
@@ -74,7 +83,23 @@ class boilerplate;
 // gibberish.hpp:
 class gibberish;
 
+// randomization.hpp:
+class fast_rand;
+
 // tf_fuzz.hpp:
 class tf_fuzz_info;
 
+// tf_fuzz_batch.hpp:
+class batch_test_info;
+class tf_fuzz_batch;
+
+// tf_fuzz_reduce.hpp:
+class reduce_statement;
+class reduce_block;
+class tf_fuzz_reduce;
+
+// lexed_template.hpp:
+class template_token;
+class lexed_template;
+
 #endif  // #ifndef CLASS_FORWARDS_HPP
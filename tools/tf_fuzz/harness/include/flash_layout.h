@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_LAYOUT_H__
+#define __FLASH_LAYOUT_H__
+
+/* Storage layout of the host SPE. Both file systems are kept in RAM
+ * (ITS_RAM_FS and PS_RAM_FS), so the area addresses are only used as
+ * offsets. The defaults are the ones of the AN521 platform and can be
+ * overridden from the command line of the compiler to fuzz other
+ * geometries.
+ */
+
+#ifndef HOST_SECTOR_SIZE
+#define HOST_SECTOR_SIZE                (0x1000)    /* 4 KB */
+#endif
+
+#define FLASH_AREA_IMAGE_SECTOR_SIZE    (HOST_SECTOR_SIZE)
+
+/* Protected Storage (PS) Service definitions */
+#define PS_FLASH_DEV_NAME Driver_FLASH0
+#define PS_FLASH_AREA_ADDR      (0x0)
+#ifndef PS_FLASH_AREA_SIZE
+#define PS_FLASH_AREA_SIZE      (0x5000)   /* 20 KB */
+#endif
+#define PS_SECTOR_SIZE          FLASH_AREA_IMAGE_SECTOR_SIZE
+/* Number of PS_SECTOR_SIZE per block */
+#define PS_SECTORS_PER_BLOCK    (0x1)
+/* Specifies the smallest flash programmable unit in bytes */
+#ifndef PS_FLASH_PROGRAM_UNIT
+#define PS_FLASH_PROGRAM_UNIT   (0x1)
+#endif
+/* The maximum asset size to be stored in the PS area */
+#ifndef PS_MAX_ASSET_SIZE
+#define PS_MAX_ASSET_SIZE       (2048)
+#endif
+/* The maximum number of assets to be stored in the PS area */
+#ifndef PS_NUM_ASSETS
+#define PS_NUM_ASSETS           (10)
+#endif
+
+/* Internal Trusted Storage (ITS) Service definitions */
+#define ITS_FLASH_DEV_NAME Driver_FLASH0
+#define ITS_FLASH_AREA_ADDR     (PS_FLASH_AREA_ADDR + PS_FLASH_AREA_SIZE)
+#ifndef ITS_FLASH_AREA_SIZE
+#define ITS_FLASH_AREA_SIZE     (0x4000)   /* 16 KB */
+#endif
+#define ITS_SECTOR_SIZE         FLASH_AREA_IMAGE_SECTOR_SIZE
+/* Number of ITS_SECTOR_SIZE per block */
+#define ITS_SECTORS_PER_BLOCK   (0x1)
+/* Specifies the smallest flash programmable unit in bytes */
+#ifndef ITS_FLASH_PROGRAM_UNIT
+#define ITS_FLASH_PROGRAM_UNIT  (0x1)
+#endif
+/* The maximum asset size to be stored in the ITS area */
+#ifndef ITS_MAX_ASSET_SIZE
+#define ITS_MAX_ASSET_SIZE      (512)
+#endif
+/* The maximum number of assets to be stored in the ITS area */
+#ifndef ITS_NUM_ASSETS
+#define ITS_NUM_ASSETS          (10)
+#endif
+
+#endif /* __FLASH_LAYOUT_H__ */
@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * libFuzzer target running sequences of ITS and PS calls against the host
+ * SPE. Each input is decoded into a sequence of calls, see
+ * tfz_fuzz_target.h for the format. The storage is erased before each
+ * input, so that every input runs from the same state.
+ *
+ * The results of the calls are checked against a shadow copy of the assets
+ * stored by the sequence: data read back must be the data written, a write
+ * once asset must not be modified or removed, and an asset must survive a
+ * reboot. A failed check aborts, which libFuzzer reports as a crash.
+ */
+
+#include "tfz_fuzz_target.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "flash_layout.h"
+#include "tfz_host_spe.h"
+
+#define TFZ_MAX(a, b) (((a) > (b)) ? (a) : (b))
+#define TFZ_MAX_DATA_SIZE TFZ_MAX(ITS_MAX_ASSET_SIZE, PS_MAX_ASSET_SIZE)
+
+/* Large enough for requests a bit over the maximum asset size */
+#define TFZ_BUF_SIZE (TFZ_MAX_DATA_SIZE + 64)
+
+#define TFZ_NUM_UIDS (sizeof(uid_pool) / sizeof(uid_pool[0]))
+
+/* UIDs used by the sequences, a small pool so that the calls of a sequence
+ * hit the same assets. UID 0 is invalid.
+ */
+static const psa_storage_uid_t uid_pool[] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 0x7FFFFFFF, 0xFFFFFFFFFFFFFFFF,
+};
+
+/* Shadow copy of an asset */
+struct tfz_shadow_t {
+    uint8_t exists;
+    uint8_t unknown;        /* Read back before the next call on the UID */
+    psa_storage_create_flags_t flags;
+    size_t size;
+    uint8_t data[TFZ_MAX_DATA_SIZE];
+};
+
+/* Shadow copies of the ITS assets, then of the PS assets */
+static struct tfz_shadow_t shadow[2][TFZ_NUM_UIDS];
+
+static uint8_t set_buf[TFZ_BUF_SIZE];
+static uint8_t get_buf[TFZ_BUF_SIZE];
+
+/* Index of the call being run, for the failure messages */
+static size_t call_idx;
+
+#define TFZ_CHECK(cond, msg)                                              \
+    do {                                                                  \
+        if (!(cond)) {                                                    \
+            fprintf(stderr, "tfz: call %zu: %s (%s:%d)\n", call_idx,      \
+                    (msg), __FILE__, __LINE__);                           \
+            abort();                                                      \
+        }                                                                 \
+    } while (0)
+
+struct tfz_service_t {
+    psa_status_t (*set)(psa_storage_uid_t uid, size_t data_length,
+                        const void *p_data,
+                        psa_storage_create_flags_t create_flags);
+    psa_status_t (*get)(psa_storage_uid_t uid, size_t data_offset,
+                        size_t data_size, void *p_data,
+                        size_t *p_data_length);
+    psa_status_t (*get_info)(psa_storage_uid_t uid,
+                             struct psa_storage_info_t *p_info);
+    psa_status_t (*remove)(psa_storage_uid_t uid);
+    size_t max_size;
+};
+
+static const struct tfz_service_t services[2] = {
+    {psa_its_set, psa_its_get, psa_its_get_info, psa_its_remove,
+     ITS_MAX_ASSET_SIZE},
+    {psa_ps_set, psa_ps_get, psa_ps_get_info, psa_ps_remove,
+     PS_MAX_ASSET_SIZE},
+};
+
+/**
+ * \brief Reads the asset back after a call whose effect on it is not
+ *        known, such as a failed set.
+ */
+static void resync_shadow(const struct tfz_service_t *svc,
+                          psa_storage_uid_t uid,
+                          struct tfz_shadow_t *sh)
+{
+    struct psa_storage_info_t info;
+    size_t len;
+    psa_status_t status;
+
+    sh->unknown = 0;
+    status = svc->get_info(uid, &info);
+    if (status == PSA_ERROR_DOES_NOT_EXIST) {
+        sh->exists = 0;
+        return;
+    }
+    TFZ_CHECK(status == PSA_SUCCESS, "get_info failed on resync");
+    TFZ_CHECK(info.size <= TFZ_MAX_DATA_SIZE, "asset bigger than the max");
+
+    status = svc->get(uid, 0, info.size, sh->data, &len);
+    TFZ_CHECK(status == PSA_SUCCESS, "get failed on resync");
+    TFZ_CHECK(len == info.size, "get length differs from get_info size");
+
+    sh->exists = 1;
+    sh->flags = info.flags;
+    sh->size = info.size;
+}
+
+static void run_set(const struct tfz_service_t *svc, psa_storage_uid_t uid,
+                    struct tfz_shadow_t *sh, const uint8_t *args)
+{
+    psa_storage_create_flags_t flags = args[0] & 0x0F;
+    size_t len = ((size_t)args[1] | ((size_t)args[2] << 8)) % TFZ_BUF_SIZE;
+    psa_status_t status;
+
+    /* The content does not steer the services, so a pattern will do */
+    memset(set_buf, (int)(call_idx ^ args[1]), len);
+
+    status = svc->set(uid, len, set_buf, flags);
+    if (uid == 0) {
+        TFZ_CHECK(status == PSA_ERROR_INVALID_ARGUMENT, "set of UID 0");
+        return;
+    }
+    if (status == PSA_SUCCESS) {
+        TFZ_CHECK(!(sh->exists && (sh->flags & PSA_STORAGE_FLAG_WRITE_ONCE)),
+                  "write once asset modified");
+        TFZ_CHECK(len <= svc->max_size, "set of an oversized asset");
+        sh->exists = 1;
+        sh->unknown = 0;
+        sh->flags = flags;
+        sh->size = len;
+        memcpy(sh->data, set_buf, len);
+    } else if (status == PSA_ERROR_NOT_PERMITTED) {
+        TFZ_CHECK(sh->exists && (sh->flags & PSA_STORAGE_FLAG_WRITE_ONCE),
+                  "set not permitted on a writable asset");
+    } else {
+        /* The old asset may or may not have been removed */
+        sh->unknown = 1;
+    }
+}
+
+static void run_get(const struct tfz_service_t *svc, psa_storage_uid_t uid,
+                    struct tfz_shadow_t *sh, const uint8_t *args)
+{
+    size_t offset = args[0];
+    size_t size = ((size_t)args[1] | ((size_t)args[2] << 8)) % TFZ_BUF_SIZE;
+    size_t len = 0;
+    psa_status_t status;
+
+    status = svc->get(uid, offset, size, get_buf, &len);
+    if (uid == 0) {
+        TFZ_CHECK(status == PSA_ERROR_INVALID_ARGUMENT, "get of UID 0");
+        return;
+    }
+    if (status == PSA_SUCCESS) {
+        TFZ_CHECK(sh->exists, "get of a removed asset");
+        TFZ_CHECK(offset <= sh->size, "get beyond the end of the asset");
+        TFZ_CHECK(len == ((size < sh->size - offset) ? size
+                                                     : sh->size - offset),
+                  "wrong get length");
+        TFZ_CHECK(memcmp(get_buf, sh->data + offset, len) == 0,
+                  "data read differs from data written");
+    } else if (status == PSA_ERROR_DOES_NOT_EXIST) {
+        TFZ_CHECK(!sh->exists, "stored asset not found");
+    } else {
+        TFZ_CHECK(sh->exists && offset > sh->size, "get failed");
+    }
+}
+
+static void run_get_info(const struct tfz_service_t *svc,
+                         psa_storage_uid_t uid, struct tfz_shadow_t *sh)
+{
+    struct psa_storage_info_t info;
+    psa_status_t status;
+
+    status = svc->get_info(uid, &info);
+    if (uid == 0) {
+        TFZ_CHECK(status == PSA_ERROR_INVALID_ARGUMENT, "get_info of UID 0");
+        return;
+    }
+    if (status == PSA_SUCCESS) {
+        TFZ_CHECK(sh->exists, "get_info of a removed asset");
+        TFZ_CHECK(info.size == sh->size, "wrong asset size");
+        TFZ_CHECK(info.flags == sh->flags, "wrong asset flags");
+    } else {
+        TFZ_CHECK(status == PSA_ERROR_DOES_NOT_EXIST && !sh->exists,
+                  "get_info failed");
+    }
+}
+
+static void run_remove(const struct tfz_service_t *svc,
+                       psa_storage_uid_t uid, struct tfz_shadow_t *sh)
+{
+    psa_status_t status;
+
+    status = svc->remove(uid);
+    if (uid == 0) {
+        TFZ_CHECK(status == PSA_ERROR_INVALID_ARGUMENT, "remove of UID 0");
+        return;
+    }
+    if (status == PSA_SUCCESS) {
+        TFZ_CHECK(sh->exists, "remove of a removed asset");
+        TFZ_CHECK(!(sh->flags & PSA_STORAGE_FLAG_WRITE_ONCE),
+                  "write once asset removed");
+        sh->exists = 0;
+    } else if (status == PSA_ERROR_NOT_PERMITTED) {
+        TFZ_CHECK(sh->exists && (sh->flags & PSA_STORAGE_FLAG_WRITE_ONCE),
+                  "remove not permitted on a writable asset");
+    } else {
+        TFZ_CHECK(status == PSA_ERROR_DOES_NOT_EXIST && !sh->exists,
+                  "remove failed");
+    }
+}
+
+int tfz_run_sequence(const uint8_t *data, size_t size)
+{
+    const struct tfz_service_t *svc;
+    struct tfz_shadow_t *sh;
+    const uint8_t *call;
+    size_t uid_idx;
+    uint8_t op;
+    size_t i;
+
+    TFZ_CHECK(tfz_host_spe_reset() == PSA_SUCCESS, "SPE reset failed");
+    memset(shadow, 0, sizeof(shadow));
+
+    for (call_idx = 0; (call_idx + 1) * TFZ_CALL_SIZE <= size; call_idx++) {
+        call = data + call_idx * TFZ_CALL_SIZE;
+        op = call[0] % TFZ_OP_COUNT;
+
+        if (op == TFZ_OP_REBOOT) {
+            TFZ_CHECK(tfz_host_spe_reboot() == PSA_SUCCESS,
+                      "SPE reboot failed");
+            continue;
+        }
+
+        svc = &services[op / TFZ_OPS_PER_SERVICE];
+        uid_idx = call[1] % TFZ_NUM_UIDS;
+        sh = &shadow[op / TFZ_OPS_PER_SERVICE][uid_idx];
+        if (sh->unknown && uid_idx != 0) {
+            resync_shadow(svc, uid_pool[uid_idx], sh);
+        }
+
+        switch (op % TFZ_OPS_PER_SERVICE) {
+        case TFZ_OP_ITS_SET:
+            run_set(svc, uid_pool[uid_idx], sh, &call[2]);
+            break;
+        case TFZ_OP_ITS_GET:
+            run_get(svc, uid_pool[uid_idx], sh, &call[2]);
+            break;
+        case TFZ_OP_ITS_GET_INFO:
+            run_get_info(svc, uid_pool[uid_idx], sh);
+            break;
+        default:
+            run_remove(svc, uid_pool[uid_idx], sh);
+            break;
+        }
+    }
+
+    /* Everything stored must still be there at the end */
+    for (i = 0; i < 2 * TFZ_NUM_UIDS; i++) {
+        sh = &shadow[i / TFZ_NUM_UIDS][i % TFZ_NUM_UIDS];
+        if (sh->unknown) {
+            resync_shadow(&services[i / TFZ_NUM_UIDS],
+                          uid_pool[i % TFZ_NUM_UIDS], sh);
+        } else if (sh->exists) {
+            run_get_info(&services[i / TFZ_NUM_UIDS],
+                         uid_pool[i % TFZ_NUM_UIDS], sh);
+        }
+    }
+
+    return 0;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    return tfz_run_sequence(data, size);
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFZ_FUZZ_TARGET_H__
+#define __TFZ_FUZZ_TARGET_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Format of the fuzzer input: a sequence of calls of TFZ_CALL_SIZE bytes
+ * each, trailing bytes are ignored.
+ *
+ *   byte 0     operation, modulo TFZ_OP_COUNT
+ *   byte 1     UID, index in a small pool of UIDs which includes UID 0
+ *   byte 2     set: create flags (4 bits, one of them unsupported)
+ *              get: data offset
+ *   bytes 3-4  set: data length, get: data size (little endian)
+ *
+ * The operations of ITS come first, the ones of PS follow in the same
+ * order.
+ */
+#define TFZ_CALL_SIZE 5
+
+enum tfz_op_t {
+    TFZ_OP_ITS_SET = 0,
+    TFZ_OP_ITS_GET,
+    TFZ_OP_ITS_GET_INFO,
+    TFZ_OP_ITS_REMOVE,
+    TFZ_OP_PS_SET,
+    TFZ_OP_PS_GET,
+    TFZ_OP_PS_GET_INFO,
+    TFZ_OP_PS_REMOVE,
+    TFZ_OP_REBOOT,          /* Initializes both services from storage */
+    TFZ_OP_COUNT
+};
+
+#define TFZ_OPS_PER_SERVICE (TFZ_OP_PS_SET - TFZ_OP_ITS_SET)
+
+/**
+ * \brief Runs a sequence of calls from an erased storage and checks the
+ *        results. Aborts if a check fails.
+ *
+ * \param[in] data  Encoded sequence of calls
+ * \param[in] size  Size of the sequence in bytes
+ *
+ * \return 0
+ */
+int tfz_run_sequence(const uint8_t *data, size_t size);
+
+/* Entry point of libFuzzer, calls tfz_run_sequence() */
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFZ_FUZZ_TARGET_H__ */
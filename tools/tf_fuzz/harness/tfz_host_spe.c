@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "tfz_host_spe.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "flash/its_flash.h"
+#include "psa_manifest/pid.h"
+#include "tfm_internal_trusted_storage.h"
+#include "tfm_its_req_mngr.h"
+#include "tfm_protected_storage.h"
+#include "tfm_ps_req_mngr.h"
+
+/* Caller buffers of the request in progress, in place of the iovecs of the
+ * request managers. The ITS service reads and writes them in chunks, so
+ * the current position is kept as well.
+ */
+struct host_iovec_t {
+    const uint8_t *in;
+    uint8_t *out;
+};
+
+static struct host_iovec_t its_iovec;
+static struct host_iovec_t ps_iovec;
+
+/* Client ID seen by ITS. PS stores its objects in ITS, so the ITS calls
+ * made while a PS request is in progress come from the PS partition.
+ */
+static int32_t its_client_id = TFZ_HOST_NS_CLIENT_ID;
+
+static uint8_t spe_is_init;
+
+size_t its_req_mngr_read(uint8_t *buf, size_t num_bytes)
+{
+    memcpy(buf, its_iovec.in, num_bytes);
+    its_iovec.in += num_bytes;
+
+    return num_bytes;
+}
+
+void its_req_mngr_write(const uint8_t *buf, size_t num_bytes)
+{
+    memcpy(its_iovec.out, buf, num_bytes);
+    its_iovec.out += num_bytes;
+}
+
+psa_status_t ps_req_mngr_read_asset_data(uint8_t *out_data, uint32_t size)
+{
+    memcpy(out_data, ps_iovec.in, size);
+
+    return PSA_SUCCESS;
+}
+
+void ps_req_mngr_write_asset_data(const uint8_t *in_data, uint32_t size)
+{
+    memcpy(ps_iovec.out, in_data, size);
+}
+
+static psa_status_t erase_storage(enum its_flash_id_t id)
+{
+    const struct its_flash_info_t *info = its_flash_get_info(id);
+    uint32_t block_id;
+    psa_status_t status;
+
+    for (block_id = 0; block_id < info->num_blocks; block_id++) {
+        status = info->erase(info, block_id);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfz_host_spe_reboot(void)
+{
+    psa_status_t status;
+
+    spe_is_init = 0;
+
+    status = tfm_its_init();
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    its_client_id = TFM_SP_PS;
+    status = tfm_ps_init();
+    its_client_id = TFZ_HOST_NS_CLIENT_ID;
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    spe_is_init = 1;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfz_host_spe_reset(void)
+{
+    psa_status_t status;
+
+    status = erase_storage(ITS_FLASH_ID_INTERNAL);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    status = erase_storage(ITS_FLASH_ID_EXTERNAL);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    return tfz_host_spe_reboot();
+}
+
+/* ITS client functions */
+
+psa_status_t psa_its_set(psa_storage_uid_t uid,
+                         size_t data_length,
+                         const void *p_data,
+                         psa_storage_create_flags_t create_flags)
+{
+    struct host_iovec_t saved = its_iovec;
+    psa_status_t status;
+
+    if (!spe_is_init && its_client_id == TFZ_HOST_NS_CLIENT_ID) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    its_iovec.in = (const uint8_t *)p_data;
+    status = tfm_its_set(its_client_id, uid, data_length, create_flags);
+    its_iovec = saved;
+
+    return status;
+}
+
+psa_status_t psa_its_get(psa_storage_uid_t uid,
+                         size_t data_offset,
+                         size_t data_size,
+                         void *p_data,
+                         size_t *p_data_length)
+{
+    struct host_iovec_t saved = its_iovec;
+    size_t out_len = data_size;
+    psa_status_t status;
+
+    if (p_data_length == NULL) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!spe_is_init && its_client_id == TFZ_HOST_NS_CLIENT_ID) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    its_iovec.out = (uint8_t *)p_data;
+    status = tfm_its_get(its_client_id, uid, data_offset, data_size,
+                         &out_len);
+    its_iovec = saved;
+
+    *p_data_length = out_len;
+
+    return status;
+}
+
+psa_status_t psa_its_get_info(psa_storage_uid_t uid,
+                              struct psa_storage_info_t *p_info)
+{
+    if (p_info == NULL) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!spe_is_init && its_client_id == TFZ_HOST_NS_CLIENT_ID) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return tfm_its_get_info(its_client_id, uid, p_info);
+}
+
+psa_status_t psa_its_remove(psa_storage_uid_t uid)
+{
+    if (!spe_is_init && its_client_id == TFZ_HOST_NS_CLIENT_ID) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    return tfm_its_remove(its_client_id, uid);
+}
+
+/* PS client functions */
+
+psa_status_t psa_ps_set(psa_storage_uid_t uid,
+                        size_t data_length,
+                        const void *p_data,
+                        psa_storage_create_flags_t create_flags)
+{
+    psa_status_t status;
+
+    if (!spe_is_init) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    ps_iovec.in = (const uint8_t *)p_data;
+    its_client_id = TFM_SP_PS;
+    status = tfm_ps_set(TFZ_HOST_NS_CLIENT_ID, uid, data_length,
+                        create_flags);
+    its_client_id = TFZ_HOST_NS_CLIENT_ID;
+
+    return status;
+}
+
+psa_status_t psa_ps_get(psa_storage_uid_t uid,
+                        size_t data_offset,
+                        size_t data_size,
+                        void *p_data,
+                        size_t *p_data_length)
+{
+    size_t out_len = data_size;
+    psa_status_t status;
+
+    if (p_data_length == NULL) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!spe_is_init) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    ps_iovec.out = (uint8_t *)p_data;
+    its_client_id = TFM_SP_PS;
+    status = tfm_ps_get(TFZ_HOST_NS_CLIENT_ID, uid, data_offset, data_size,
+                        &out_len);
+    its_client_id = TFZ_HOST_NS_CLIENT_ID;
+
+    *p_data_length = out_len;
+
+    return status;
+}
+
+psa_status_t psa_ps_get_info(psa_storage_uid_t uid,
+                             struct psa_storage_info_t *p_info)
+{
+    psa_status_t status;
+
+    if (p_info == NULL) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (!spe_is_init) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    its_client_id = TFM_SP_PS;
+    status = tfm_ps_get_info(TFZ_HOST_NS_CLIENT_ID, uid, p_info);
+    its_client_id = TFZ_HOST_NS_CLIENT_ID;
+
+    return status;
+}
+
+psa_status_t psa_ps_remove(psa_storage_uid_t uid)
+{
+    psa_status_t status;
+
+    if (!spe_is_init) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+
+    its_client_id = TFM_SP_PS;
+    status = tfm_ps_remove(TFZ_HOST_NS_CLIENT_ID, uid);
+    its_client_id = TFZ_HOST_NS_CLIENT_ID;
+
+    return status;
+}
+
+psa_status_t psa_ps_create(psa_storage_uid_t uid, size_t size,
+                           psa_storage_create_flags_t create_flags)
+{
+    (void)uid;
+    (void)size;
+    (void)create_flags;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_ps_set_extended(psa_storage_uid_t uid, size_t data_offset,
+                                 size_t data_length, const void *p_data)
+{
+    (void)uid;
+    (void)data_offset;
+    (void)data_length;
+    (void)p_data;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+uint32_t psa_ps_get_support(void)
+{
+    return tfm_ps_get_support();
+}
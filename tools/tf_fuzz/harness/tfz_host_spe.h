@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFZ_HOST_SPE_H__
+#define __TFZ_HOST_SPE_H__
+
+#include <stdint.h>
+#include "psa/error.h"
+#include "psa/internal_trusted_storage.h"
+#include "psa/protected_storage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Host build of the ITS and PS partitions. The partition code is linked
+ * into the calling process and the client functions of
+ * psa/internal_trusted_storage.h and psa/protected_storage.h call the
+ * service functions directly, without the IPC or library model glue. Both
+ * file systems are kept in RAM.
+ */
+
+/* Client ID of the non-secure callers */
+#define TFZ_HOST_NS_CLIENT_ID (-1)
+
+/**
+ * \brief Erases the storage of both services and initializes them again.
+ *
+ * \return PSA_SUCCESS, or the error of the ITS or PS initialization.
+ */
+psa_status_t tfz_host_spe_reset(void);
+
+/**
+ * \brief Initializes both services again from the current content of the
+ *        storage, as after a reset of the device.
+ *
+ * \return PSA_SUCCESS, or the error of the ITS or PS initialization.
+ */
+psa_status_t tfz_host_spe_reboot(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFZ_HOST_SPE_H__ */
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFZ_HOST_TEST_H__
+#define __TFZ_HOST_TEST_H__
+
+/* Included by the tests written by tfz with tfm_host_boilerplate.txt, in
+ * place of the headers of the TF-M test framework.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "psa/protected_storage.h"
+#include "tfm_memory_utils.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum test_status_t {
+    TEST_PASSED = 0,
+    TEST_FAILED = 1,
+};
+
+struct test_result_t {
+    enum test_status_t val;
+    const char *info_msg;
+    const char *filename;
+    uint32_t line;
+};
+
+#define TEST_FAIL(msg)                  \
+    do {                                \
+        ret->val = TEST_FAILED;         \
+        ret->info_msg = (msg);          \
+        ret->filename = __FILE__;       \
+        ret->line = __LINE__;           \
+    } while (0)
+
+#define TEST_LOG(...) printf(__VA_ARGS__)
+
+/* The test written by tfz */
+void test_thread(struct test_result_t *ret);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFZ_HOST_TEST_H__ */
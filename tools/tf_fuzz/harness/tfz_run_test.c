@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Runs a test written by tfz with tfm_host_boilerplate.txt against the host
+ * SPE, so that the PSA calls of the test are direct calls to the ITS and PS
+ * partitions.
+ */
+
+#include "tfz_host_spe.h"
+#include "tfz_host_test.h"
+
+int main(void)
+{
+    struct test_result_t ret = {TEST_FAILED, "Test did not complete", "", 0};
+
+    if (tfz_host_spe_reset() != PSA_SUCCESS) {
+        printf("\nHost SPE initialization failed\n");
+        return 2;
+    }
+
+    test_thread(&ret);
+
+    if (ret.val != TEST_PASSED) {
+        printf("\nTEST FAILED: %s (%s:%u)\n", ret.info_msg, ret.filename,
+               (unsigned int)ret.line);
+        return 1;
+    }
+
+    printf("\nTEST PASSED\n");
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Driver of the fuzz target for builds without libFuzzer. It either runs
+ * the inputs given as files, to reproduce the crashes found by libFuzzer
+ * on a machine without clang, or runs random inputs, which gives the
+ * execution rate of the target but no coverage feedback.
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "tfz_fuzz_target.h"
+
+#define TFZ_DEFAULT_RUNS    (100000u)
+#define TFZ_DEFAULT_CALLS   (32u)
+#define TFZ_MAX_INPUT_SIZE  (1u << 20)
+#define TFZ_CRASH_FILE      "tfz-crash"
+
+static uint8_t input[TFZ_MAX_INPUT_SIZE];
+static size_t input_size;
+
+static uint64_t rand_state;
+
+/* xorshift64*, so that a seed gives the same inputs everywhere */
+static uint64_t rand_next(void)
+{
+    rand_state ^= rand_state >> 12;
+    rand_state ^= rand_state << 25;
+    rand_state ^= rand_state >> 27;
+    return rand_state * 0x2545F4914F6CDD1DULL;
+}
+
+/* Saves the random input which failed a check, so that it can be run
+ * again from the file.
+ */
+static void on_abort(int sig)
+{
+    FILE *f = fopen(TFZ_CRASH_FILE, "wb");
+
+    if (f != NULL) {
+        fwrite(input, 1, input_size, f);
+        fclose(f);
+        fprintf(stderr, "Input written to " TFZ_CRASH_FILE "\n");
+    }
+
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+static int run_file(const char *path)
+{
+    FILE *f;
+
+    f = fopen(path, "rb");
+    if (f == NULL) {
+        perror(path);
+        return 1;
+    }
+    input_size = fread(input, 1, sizeof(input), f);
+    fclose(f);
+
+    printf("Running %s (%zu bytes)\n", path, input_size);
+    tfz_run_sequence(input, input_size);
+
+    return 0;
+}
+
+static void run_random(unsigned long runs, unsigned long max_calls)
+{
+    struct timespec start;
+    struct timespec end;
+    unsigned long calls = 0;
+    unsigned long i;
+    size_t j;
+    double secs;
+
+    signal(SIGABRT, on_abort);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < runs; i++) {
+        input_size = (size_t)(rand_next() % (max_calls + 1)) * TFZ_CALL_SIZE;
+        for (j = 0; j < input_size; j++) {
+            input[j] = (uint8_t)(rand_next() >> 56);
+        }
+        tfz_run_sequence(input, input_size);
+        calls += input_size / TFZ_CALL_SIZE;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    secs = (double)(end.tv_sec - start.tv_sec) +
+           (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    printf("%lu inputs, %lu calls in %.2f s: %.0f exec/s, %.0f calls/s\n",
+           runs, calls, secs, runs / secs, calls / secs);
+}
+
+static void usage(const char *name)
+{
+    printf("Usage: %s [-n runs] [-c max_calls] [-s seed] [input ...]\n",
+           name);
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long runs = TFZ_DEFAULT_RUNS;
+    unsigned long max_calls = TFZ_DEFAULT_CALLS;
+    int ret = 0;
+    int opt;
+
+    rand_state = (uint64_t)time(NULL);
+
+    while ((opt = getopt(argc, argv, "n:c:s:h")) != -1) {
+        switch (opt) {
+        case 'n':
+            runs = strtoul(optarg, NULL, 0);
+            break;
+        case 'c':
+            max_calls = strtoul(optarg, NULL, 0);
+            if (max_calls * TFZ_CALL_SIZE > sizeof(input)) {
+                max_calls = sizeof(input) / TFZ_CALL_SIZE;
+            }
+            break;
+        case 's':
+            rand_state = strtoull(optarg, NULL, 0);
+            break;
+        default:
+            usage(argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (rand_state == 0) {
+        /* xorshift does not leave the all zero state */
+        rand_state = 1;
+    }
+
+    if (optind < argc) {
+        for (; optind < argc; optind++) {
+            ret |= run_file(argv[optind]);
+        }
+        return ret;
+    }
+
+    printf("Seed: %llu\n", (unsigned long long)rand_state);
+    run_random(runs, max_calls);
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <iostream>
+#include "class_forwards.hpp"
+#include "boilerplate.hpp"
+#include "randomization.hpp"
+#include "gibberish.hpp"
+#include "compute.hpp"
+#include "string_ops.hpp"
+#include "data_blocks.hpp"
+#include "psa_asset.hpp"
+#include "find_or_create_asset.hpp"
+#include "template_line.hpp"
+#include "tf_fuzz.hpp"
+#include "sst_asset.hpp"
+#include "crypto_asset.hpp"
+#include "psa_call.hpp"
+#include "tf_fuzz_grammar.tab.hpp"
+#include "lexed_template.hpp"
+
+
+/* These items are defined in tf_fuzz_grammar.lex.c. */
+extern FILE* yyin;  // telling lex which file to read
+extern int yylineno;
+extern char yytext[];
+extern YYSTYPE yylval;
+extern YYLTYPE yylloc;
+int lex_template_token (void);  // the lexer's yylex()
+
+using namespace std;
+
+/* What this thread's parser is reading from: */
+static thread_local const lexed_template *replay_template = nullptr;
+static thread_local size_t replay_next = 0;  // index of the next token to read
+static thread_local const template_token *replay_token = nullptr;
+    // the token last read
+static thread_local string replay_text_buff;
+    /* the text of replay_token, in a buffer of this thread's that the grammar
+       can have a (char *) to, as it could to the lexer's yytext */
+
+/**********************************************************************************
+   Methods of class lexed_template follow:
+**********************************************************************************/
+
+void lexed_template::lex (FILE *template_file)
+{
+    template_token tok;
+
+    tokens.clear();
+    yyin = template_file;
+    do {
+        tok.token = lex_template_token();
+        tok.text = yytext;
+        tok.value_n = (tok.token == NUMBER_TOK)?  yylval.valueN : 0;
+        tok.line_no = yylineno;
+        tok.first_line = yylloc.first_line;
+        tok.first_column = yylloc.first_column;
+        tok.last_line = yylloc.last_line;
+        tok.last_column = yylloc.last_column;
+        tokens.push_back (tok);
+    } while (tok.token != 0);
+}
+
+int lexed_template::parse (tf_fuzz_info *rsrc) const
+{
+    replay_template = this;
+    replay_next = 0;
+    replay_token = nullptr;
+    /* The parser state was once static, and so was constructed, drawing random
+       numbers, before main() seeded rand().  Doing the same here keeps the test
+       made from a given seed what it always was: */
+    seed_rand (1);
+    init_parse_state();
+    seed_rand ((unsigned int) rsrc->rand_seed);
+    return yyparse (rsrc);
+}
+
+lexed_template::lexed_template (string template_file_name)  // (constructor)
+{
+    file_name = template_file_name;
+}
+
+lexed_template::~lexed_template (void)
+{
+    return;  // just to have something to pin a breakpoint onto
+}
+
+/**********************************************************************************
+   End of methods of class lexed_template.
+**********************************************************************************/
+
+
+/* The parser's yylex():  returns the next token of the template being parsed on
+   this thread.  At the end, it keeps returning the end (type-0) token. */
+int yylex (YYSTYPE *lvalp, YYLTYPE *llocp)
+{
+    if (replay_template == nullptr || replay_template->tokens.empty()) {
+        cerr << "\nError:  Tool-internal:  Please report error "
+             << "#1601 to the TF-Fuzz developers." << endl;
+        exit(1601);
+    }
+    replay_token = &replay_template->tokens[replay_next];
+    if (replay_next + 1 < replay_template->tokens.size()) {
+        ++replay_next;
+    }
+    replay_text_buff = replay_token->text;
+    if (replay_token->token == NUMBER_TOK) {
+        lvalp->valueN = replay_token->value_n;
+    } else {
+        lvalp->str = &replay_text_buff[0];
+    }
+    llocp->first_line = replay_token->first_line;
+    llocp->first_column = replay_token->first_column;
+    llocp->last_line = replay_token->last_line;
+    llocp->last_column = replay_token->last_column;
+    return replay_token->token;
+}
+
+void yyerror (YYLTYPE *, tf_fuzz_info *, const char *str)
+    /* not sure why it sends the yyparse() argument to yyerror(), but OK... */
+{
+    fprintf (stderr, "tf_fuzz template on line %d, at text = \"%s\":  %s\n",
+             replay_line_no(), replay_text(), str);
+    exit (1);
+}
+
+const char *replay_text (void)
+{
+    return (replay_token == nullptr)?  "" : replay_text_buff.c_str();
+}
+
+int replay_line_no (void)
+{
+    return (replay_token == nullptr)?  1 : replay_token->line_no;
+}
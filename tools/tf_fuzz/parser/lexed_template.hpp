@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/* lexed_template.*pp holds a test template as the list of tokens read from it by
+   the lexer.  The template file is lexed once, then each test is made by feeding
+   the tokens to the parser, whose actions make the random choices and build the
+   test.  The lexer is not reentrant, but the parser is, so with a lexed_template
+   tests can be made on several threads at once (see tf_fuzz_batch.hpp). */
+
+#ifndef LEXED_TEMPLATE_HPP
+#define LEXED_TEMPLATE_HPP
+
+#include <string>
+#include <vector>
+#include <cstdio>
+
+
+using namespace std;
+
+class template_token
+{
+public:  // (just a record of what the lexer returned)
+    // Data members:
+        int token;  // token type; 0 at the end of the template
+        string text;  // yytext, as it was after the lexer returned the token
+        int value_n;  // the number, for NUMBER_TOK
+        int line_no;  // yylineno, as it was after the lexer returned the token
+        int first_line, first_column, last_line, last_column;  // yylloc
+};
+
+
+class lexed_template
+{
+public:
+    // Data members:
+        string file_name;
+        vector<template_token> tokens;  // ends in a token of type 0
+    // Methods:
+        void lex (FILE *template_file);
+            /* reads all of the tokens of the template;  must only be called from
+               one thread at a time */
+        int parse (tf_fuzz_info *rsrc) const;
+            /* makes one test from the tokens, into *rsrc, with the random numbers
+               seeded from rsrc->rand_seed;  returns what yyparse() does */
+        lexed_template (string template_file_name);  // (constructor)
+        ~lexed_template (void);
+
+protected:
+    // Data members:
+    // Methods:
+
+private:
+    // Data members:
+    // Methods:
+};
+
+/* The text and line number of the token last read by this thread's parser, for
+   the grammar actions, in place of the lexer's yytext and yylineno: */
+const char *replay_text (void);
+int replay_line_no (void);
+
+#endif  // #ifndef LEXED_TEMPLATE_HPP
@@ -13,6 +13,7 @@
 #include "class_forwards.hpp"
 #include "data_blocks.hpp"
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "string_ops.hpp"
@@ -30,22 +31,16 @@
 #include "sst_template_line.hpp"
 #include "crypto_template_line.hpp"
 
-/* These items are defined in tf_fuzz_grammar.l.  Note, however that, because
-   of "name mangling," defining them as extern "C" may or may not be ideal,
-   depending upon which compiler -- gcc vs. g++, compiles the output from lex.
-   So far, it seems best without the extern "C", including also compiling
-   under Visual Studio. */
-/* extern "C"
-{ */
-  extern int yylineno;
-  int yywrap() {return 1;}
-  extern char yytext[];
-  extern int yyleng;
-/* } */
-
-int yylex (void);
-void yyerror (tf_fuzz_info *, const char *);
-    /* not sure why it sends the yyparse() argument to yyerror(), but OK... */
+#include "lexed_template.hpp"
+
+/* The parser doesn't read from the lexer itself, but from the tokens of a
+   lexed_template, so that the template is lexed only once however many tests are
+   made from it, and so that tests can be made on several threads at once.  (For
+   the same reason, the parser is pure, and the state below is thread_local.)
+   These stand in for the lexer's globals, for the token last read by the parser: */
+#define yytext (replay_text())
+#define yylineno (replay_line_no())
+int yywrap() {return 1;}
 
 /* A few consts just to make code more comprehensible: */
 const bool yes_fill_in_template = true;
@@ -53,102 +48,110 @@ const bool dont_fill_in_template = false;
 const bool yes_create_call = true;
 const bool dont_create_call = false;
 
-tf_fuzz_info *rsrc;
+thread_local tf_fuzz_info *rsrc;
 
 /* These are object pointers used to parse the template and create the test.  Ac-
    tually, probably only templateLin will be used. */
-template_line                   *templateLin = nullptr;
-  sst_template_line             *sstTemplateLin = nullptr;
-    set_sst_template_line       *setSstTemplateLin = nullptr;
-    read_sst_template_line      *reaSstTemplateLin = nullptr;
-    remove_sst_template_line    *remSstTemplateLin = nullptr;
-  policy_template_line          *polTemplateLin = nullptr;
-    set_policy_template_line    *setPolTemplateLin = nullptr;
-    read_policy_template_line   *reaPolTemplateLin = nullptr;
-  key_template_line             *keyTemplateLin = nullptr;
-    set_key_template_line       *setKeyTemplateLin = nullptr;
-    read_key_template_line      *reaKeyTemplateLin = nullptr;
-    remove_key_template_line    *remKeyTemplateLin = nullptr;
-  security_template_line        *secTemplateLin = nullptr;
-    security_hash_template_line *secHasTemplateLin = nullptr;
+thread_local template_line                   *templateLin = nullptr;
+thread_local   sst_template_line             *sstTemplateLin = nullptr;
+thread_local     set_sst_template_line       *setSstTemplateLin = nullptr;
+thread_local     read_sst_template_line      *reaSstTemplateLin = nullptr;
+thread_local     remove_sst_template_line    *remSstTemplateLin = nullptr;
+thread_local   policy_template_line          *polTemplateLin = nullptr;
+thread_local     set_policy_template_line    *setPolTemplateLin = nullptr;
+thread_local     read_policy_template_line   *reaPolTemplateLin = nullptr;
+thread_local   key_template_line             *keyTemplateLin = nullptr;
+thread_local     set_key_template_line       *setKeyTemplateLin = nullptr;
+thread_local     read_key_template_line      *reaKeyTemplateLin = nullptr;
+thread_local     remove_key_template_line    *remKeyTemplateLin = nullptr;
+thread_local   security_template_line        *secTemplateLin = nullptr;
+thread_local     security_hash_template_line *secHasTemplateLin = nullptr;
 /* Call and asset objects are presumably not immediately needed, because the objects of
    these types are within the resource object, *rsrc, but even if just to show class
    hierarchy: */
-psa_call                        *psaCal = nullptr;
-  sst_call                      *sstCal = nullptr;
-    sst_set_call                *sstSetCal = nullptr;
-    sst_get_call                *sstGetCal = nullptr;
-    sst_remove_call             *sstRemCal = nullptr;
-  crypto_call                   *cryCal = nullptr;
-    policy_call                 *polCal = nullptr;
-      policy_set_call           *polSetCal = nullptr;
-      policy_get_call           *polGetCal = nullptr;
-    key_call                    *keyCal = nullptr;
-      get_key_info_call         *getKeyInfCal = nullptr;
-      set_key_call              *makKeyCal = nullptr;
-      destroy_key_call          *desKeyCal = nullptr;
-psa_asset                       *psaAst = nullptr;
-  sst_asset                     *sstAst = nullptr;
-  crypto_asset                  *cryAst = nullptr;
-    policy_asset                *polAst = nullptr;
-    key_asset                   *keyAst = nullptr;
+thread_local psa_call                        *psaCal = nullptr;
+thread_local   sst_call                      *sstCal = nullptr;
+thread_local     sst_set_call                *sstSetCal = nullptr;
+thread_local     sst_get_call                *sstGetCal = nullptr;
+thread_local     sst_remove_call             *sstRemCal = nullptr;
+thread_local   crypto_call                   *cryCal = nullptr;
+thread_local     policy_call                 *polCal = nullptr;
+thread_local       policy_set_call           *polSetCal = nullptr;
+thread_local       policy_get_call           *polGetCal = nullptr;
+thread_local     key_call                    *keyCal = nullptr;
+thread_local       get_key_info_call         *getKeyInfCal = nullptr;
+thread_local       set_key_call              *makKeyCal = nullptr;
+thread_local       destroy_key_call          *desKeyCal = nullptr;
+thread_local psa_asset                       *psaAst = nullptr;
+thread_local   sst_asset                     *sstAst = nullptr;
+thread_local   crypto_asset                  *cryAst = nullptr;
+thread_local     policy_asset                *polAst = nullptr;
+thread_local     key_asset                   *keyAst = nullptr;
 
 /* For generating random, but readable/memorable, data: */
-gibberish gib;
-char gib_buff[4096];  // spew gibberish into here
-int rand_data_length = 0;
+thread_local gibberish gib;
+thread_local char gib_buff[4096];  // spew gibberish into here
+thread_local int rand_data_length = 0;
 
 /* General-utility variables: */
-string purp_str;  /* test purpose */
-psa_asset_usage random_asset = psa_asset_usage::all;  /* pick what type of asset at random */
-bool random_name;  /* template didn't specify name, so it's generated randomly */
-string literal_data;  /* literal data for an asset value */
+thread_local string purp_str;  /* test purpose */
+thread_local psa_asset_usage random_asset = psa_asset_usage::all;  /* pick what type of asset at random */
+thread_local bool random_name;  /* template didn't specify name, so it's generated randomly */
+thread_local string literal_data;  /* literal data for an asset value */
 
 /* Holders for state in read commands: */
-expect_info expect;  /* everything about expected results and data */
-set_data_info set_data;  /* everything about setting the value of PSA-asset data */
-asset_name_id_info asset_id;  /* everything about identifying assets */
-bool assign_data_var_specified;
-string assign_data_var;
-bool print_data;  /* true to just print asset data to the test log */
-bool hash_data;  /* true to just print asset data to the test log */
+thread_local expect_info expect;  /* everything about expected results and data */
+thread_local set_data_info set_data;  /* everything about setting the value of PSA-asset data */
+thread_local asset_name_id_info asset_id;  /* everything about identifying assets */
+thread_local bool assign_data_var_specified;
+thread_local string assign_data_var;
+thread_local bool print_data;  /* true to just print asset data to the test log */
+thread_local bool hash_data;  /* true to just print asset data to the test log */
 
 /* The following are more tied to the template syntax than to the resulting PSA calls */
-string literal;  /* temporary holder for all string literals */
-string identifier;  /* temporary holder for strings representing identifiers */
-string var_name;  /* a variable name */
-string asset_name;  /* as parsed, not yet put into asset_id */
-string aid;  /* string-typed holder for an asset ID in a list thereof */
-int nid;  /* same idea as aid, but for asset ID# lists */
-size_t strFind1, strFind2;  /* for searching through strings */
+thread_local string literal;  /* temporary holder for all string literals */
+thread_local string identifier;  /* temporary holder for strings representing identifiers */
+thread_local string var_name;  /* a variable name */
+thread_local string asset_name;  /* as parsed, not yet put into asset_id */
+thread_local string aid;  /* string-typed holder for an asset ID in a list thereof */
+thread_local int nid;  /* same idea as aid, but for asset ID# lists */
+thread_local size_t strFind1, strFind2;  /* for searching through strings */
 
 /* Because of the parsing order, psa_calls of the specific type have to be
    push_back()ed onto rsrc->calls before their expected results are known.  Therefore,
    inject those results after parsing the expected results.  add_expect is a vector
    index of where to start "back-filling" the expect information. */
-unsigned int add_expect = 0;
+thread_local unsigned int add_expect = 0;
 
 /* Temporaries: */
-vector<psa_asset*>::iterator t_sst_asset;
-vector<psa_asset*>::iterator t_key_asset;
-vector<psa_asset*>::iterator t_policy_asset;
-sst_call *t_sst_call = nullptr;
-key_call *t_key_call = nullptr;
-policy_call *t_policy_call = nullptr;
-long number;  /* temporary holder for a number, e.g., sting form of UID */
-int i, j, k;
+thread_local psa_asset_list::iterator t_sst_asset;
+thread_local psa_asset_list::iterator t_key_asset;
+thread_local psa_asset_list::iterator t_policy_asset;
+thread_local sst_call *t_sst_call = nullptr;
+thread_local key_call *t_key_call = nullptr;
+thread_local policy_call *t_policy_call = nullptr;
+thread_local long number;  /* temporary holder for a number, e.g., sting form of UID */
+thread_local int i, j, k;
 
 /* Relating to template-statement blocks: */
-vector<template_line*> template_block_vector;  /* (must be *pointers to* templates) */
-vector<int> block_order;  /* "statisticalized" order of template lines in a block */
-int nesting_level = 0;
+thread_local vector<template_line*> template_block_vector;  /* (must be *pointers to* templates) */
+thread_local vector<int> block_order;  /* "statisticalized" order of template lines in a block */
+thread_local int nesting_level = 0;
     /* how many levels deep in { } nesting currently.  Initially only 0 or 1. */
-bool shuffle_not_pick;
+thread_local bool shuffle_not_pick;
     /* true to shuffle statements in a block, rather than pick so-and-so
        number of them at random. */
-int low_nmbr_lines = 1;  /* if picking so-and-so number of template lines from a ... */
-int high_nmbr_lines = 1; /*    ... block at random, these are fewest and most lines. */
-int exact_nmbr_lines = 1;
+thread_local int low_nmbr_lines = 1;  /* if picking so-and-so number of template lines from a ... */
+thread_local int high_nmbr_lines = 1; /*    ... block at random, these are fewest and most lines. */
+thread_local int exact_nmbr_lines = 1;
+
+/* init_parse_state() constructs this thread's parser state, above, before the
+   random numbers are seeded for the test (see lexed_template::parse()).  Of the
+   state, only asset_id draws a random number (its default ID) when constructed. */
+void init_parse_state (void)
+{
+    asset_id.id_n = asset_id.id_n;  // (any use of it will construct it)
+}
 
 /* Shortcuts, to reduce code clutter, and reduce risk of coding errors. */
 #define IVM(content) if(rsrc->verbose_mode){content}  /* IVM = "If Verbose Mode" */
@@ -178,7 +181,7 @@ void randomize_template_lines (
         /* Choose a random order in which to generate all of the
            template lines in the block: */
         while (template_used.size() < template_block_vector.size()) {
-            i = rand() % template_block_vector.size();
+            i = rand_int() % template_block_vector.size();
             if (template_used.find (i) == template_used.end()) {
                 /* This template not already shuffled in. */
                 block_order.push_back (i);
@@ -192,12 +195,12 @@ void randomize_template_lines (
                 /* just in case the template says "3 to 3 of"... */
         } else {
             exact_nmbr_lines =   low_nmbr_lines
-                               + (rand() % (  high_nmbr_lines
+                               + (rand_int() % (  high_nmbr_lines
                                             - low_nmbr_lines + 1 )  );
         }
         for (int j = 0;  j < exact_nmbr_lines;  ++j) {
             /* Repeatedly choose a random template line from the block: */
-            i = rand() % template_block_vector.size();
+            i = rand_int() % template_block_vector.size();
             block_order.push_back (i);
         }
     }
@@ -221,8 +224,8 @@ void interpret_template_line (
         /* if further differentiation to the names or IDs is needed, make this >0 */
 ) {
     const bool yes_fill_in_template = true;  // just to clarify a call
-    vector<psa_asset*> *active_asset, *deleted_asset;
-    vector<psa_asset*>::iterator t_psa_asset;
+    psa_asset_list *active_asset, *deleted_asset;
+    psa_asset_list::iterator t_psa_asset;
 
     if (fill_in_template) {
         /* Set basic parameters from the template line: */
@@ -280,7 +283,7 @@ void interpret_template_line (
         /* != psa_asset_usage::all means to choose some known asset at random: */
         if (templateLin->random_asset == psa_asset_usage::active) {
             if (active_asset->size() > 0) {
-                i = rand() % active_asset->size();
+                i = rand_int() % active_asset->size();
                 t_psa_asset = active_asset->begin() + i;
                 templateLin->how_asset_found = asset_search::found_active;
                 templateLin->asset_id.id_n = (*t_psa_asset)->asset_id.id_n;
@@ -310,7 +313,7 @@ void interpret_template_line (
             }
         } else if (templateLin->random_asset == psa_asset_usage::deleted) {
             if (deleted_asset->size() > 0) {
-                i = rand() % deleted_asset->size();
+                i = rand_int() % deleted_asset->size();
                 t_psa_asset = deleted_asset->begin() + i;
                 templateLin->how_asset_found = asset_search::found_deleted;
                 templateLin->asset_id.id_n = (*t_psa_asset)->asset_id.id_n;
@@ -358,6 +361,10 @@ void interpret_template_line (
                     /* Set asset's ID to what's being searched for (whether it's
                        already that because it's been found, or was just created): */
                     (*t_psa_asset)->asset_id.id_n = templateLin->asset_id.id_n;
+                    if (templateLin->how_asset_found != asset_search::not_found) {
+                        rsrc->reindex_psa_asset (templateLin->asset_type,
+                                                 *t_psa_asset);
+                    }
                     templateLin->expect.data_var = var_name;
                     if (!set_data.literal_data_not_file) {
                         templateLin->set_data.set_file (set_data.file_path);
@@ -387,7 +394,7 @@ void interpret_template_line (
                                 create_asset_bool, t_psa_asset   );
                 if (!templateLin->is_remove) {
                     /* Give each occurrence a different UID: */
-                    templateLin->asset_id.set_id_n (100 + (rand() % 10000));
+                    templateLin->asset_id.set_id_n (100 + (rand_int() % 10000));
                         /* TODO:  unlikely, but this could alias! */
                     if (templateLin->how_asset_found != asset_search::not_found) {
                         templateLin->asset_id.id_n = (*t_psa_asset)->asset_id.id_n;
@@ -423,8 +430,8 @@ void interpret_template_line (
             /* Move asset from active vector to deleted vector: */
             if (   create_call_bool  /* don't do this if just parsing */
                 && templateLin->how_asset_found == asset_search::found_active) {
-                rsrc->deleted_sst_asset.push_back(*t_psa_asset);
-                rsrc->active_sst_asset.erase(t_psa_asset);
+                deleted_asset->push_back(*t_psa_asset);
+                active_asset->erase(t_psa_asset);
             }  /* if not active, deem the call expected to fail. */
         }
     }
@@ -444,9 +451,17 @@ void interpret_template_line (
 %token <tokenN> SEMICOLON SHUFFLE TO OF OPEN_BRACE CLOSE_BRACE  /* block structure */
 
 %define parse.error verbose
+%define api.pure full
 %locations
 %parse-param {tf_fuzz_info *rsrc}
 
+%code provides {
+int yylex (YYSTYPE *, YYLTYPE *);  /* in lexed_template.cpp */
+void yyerror (YYLTYPE *, tf_fuzz_info *, const char *);
+    /* not sure why it sends the yyparse() argument to yyerror(), but OK... */
+void init_parse_state (void);
+}
+
 %%
 
   /* Top-level syntax: */
@@ -758,7 +773,7 @@ sst_set_args:
             IVM(cout << "SST-create from random data" << endl;)
             set_data.random_data = true;
             set_data.literal_data_not_file = true;
-            rand_data_length = 40 + (rand() % 256);  /* Note:  Multiple assets do get different data */
+            rand_data_length = 40 + (rand_int() % 256);  /* Note:  Multiple assets do get different data */
             gib.sentence (gib_buff, gib_buff + rand_data_length - 1);
             set_data.set (gib_buff);
             literal.assign (gib_buff);  /* just in case something uses literal */
@@ -863,7 +878,7 @@ sst_asset_name:
       | NAME STAR {
             IVM(cout << "SST-asset random identifier:  \"" << flush;)
             random_name = true;
-            rand_data_length = 2 + (rand() % 10);
+            rand_data_length = 2 + (rand_int() % 10);
             gib.word (false, gib_buff, gib_buff + rand_data_length - 1);
             aid.assign (gib_buff);
             asset_id.asset_name_vector.push_back (aid);
@@ -883,7 +898,7 @@ sst_asset_name:
             IVM(cout << "SST-asset random UID:  \"" << flush;)
             asset_id.id_n_not_name = true;
             random_name = false;
-            nid = 100 + (rand() % 10000);
+            nid = 100 + (rand_int() % 10000);
             asset_id.asset_id_n_vector.push_back (nid);
             random_asset = psa_asset_usage::all;  /* don't use random asset */
             IVM(cout << yytext << "\"" << endl;)
@@ -61,7 +61,7 @@ void test_thread (struct test_result_t *ret) {
         return;
     }
 
-    sst_status = psa_ps_get(@@@001@@@, 0, 0, snortwaggle_act_data
+    sst_status = psa_ps_get(@@@001@@@, 0, ********, snortwaggle_act_data
                             &snortwaggle_act_length);
     if (sst_status != PSA_SUCCESS) {
         TEST_FAIL("psa_ps_get() expected PSA_SUCCESS.");
@@ -75,7 +75,7 @@ void test_thread (struct test_result_t *ret) {
 
 
     /* Removing assets left over from testing: */
-    psa_ps_remove(@@@001@@@);
+    sst_status = psa_ps_remove(@@@001@@@);
     if (sst_status != PSA_SUCCESS) {
         TEST_FAIL("Failed to tear down an SST asset upon test completion.");
         return;
@@ -49,6 +49,7 @@ void test_thread (struct test_result_t *ret) {
     static uint8_t a_variable[] = "";
     static uint8_t greebledorf_act_data[2048] = "********";
     static int greebledorf_act_length = 0;
+    static uint8_t greebledorf_exp_data[] = "@@002@10@@********";
     static uint8_t greebledorf_act_data[2048] = "********";
     static int greebledorf_act_length = 0;
 
@@ -63,7 +64,7 @@ void test_thread (struct test_result_t *ret) {
         return;
     }
 
-    sst_status = psa_ps_get(@@@001@@@, 0, 0, greebledorf_act_data,
+    sst_status = psa_ps_get(@@@001@@@, 0, ********, greebledorf_act_data,
                             &greebledorf_act_length);
     if (sst_status != PSA_SUCCESS) {
         TEST_FAIL("psa_ps_get() expected PSA_SUCCESS.");
@@ -75,17 +76,22 @@ void test_thread (struct test_result_t *ret) {
         return;
     }
 
-    sst_status = psa_ps_get(@@@001@@@, 0, 0, greebledorf_act_data,
+    sst_status = psa_ps_get(@@@001@@@, 0, ********, greebledorf_act_data,
                             &greebledorf_act_length);
     if (sst_status != PSA_SUCCESS) {
         TEST_FAIL("psa_ps_get() expected PSA_SUCCESS.");
         return;
     }
+    /* Check that the data is correct */
+    if (tfm_memcmp(greebledorf_act_data, greebledorf_exp_data, ********) != 0) {
+        TEST_FAIL("Read data should be equal to result data");
+        return;
+    }
     TEST_LOG(greebledorf_act_data);
 
 
     /* Removing assets left over from testing: */
-    psa_ps_remove(@@@001@@@);
+    sst_status = psa_ps_remove(@@@001@@@);
     if (sst_status != PSA_SUCCESS) {
         TEST_FAIL("Failed to tear down an SST asset upon test completion.");
         return;
@@ -113,12 +113,12 @@ void test_thread (struct test_result_t *ret) {
 
 
     /* Removing assets left over from testing: */
-    psa_ps_remove(4661);
+    sst_status = psa_ps_remove(4661);
     if (sst_status != PSA_PS_SUCCESS) {
         TEST_FAIL("Failed to tear down an SST asset upon test completion!");
         return;
     }
-    psa_ps_remove(5446);
+    sst_status = psa_ps_remove(5446);
     if (sst_status != PSA_PS_SUCCESS) {
         TEST_FAIL("Failed to tear down an SST asset upon test completion!");
         return;
@@ -8,6 +8,7 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "data_blocks.hpp"
@@ -43,13 +44,12 @@ bool set_policy_template_line::copy_template_to_asset (void)
 
 bool set_policy_template_line::copy_template_to_call (void)
 {
-    for (auto call : test_state->calls) {
-        if (call->call_ser_no == call_ser_no && call->expect.pf_info_incomplete) {
-            call->asset_id.set_just_name (asset_id.get_name());
-            call->asset_id.id_n = asset_id.id_n;
-            call->expect.pf_info_incomplete = true;
-            return true;
-        }
+    psa_call *call = test_state->find_call (call_ser_no);
+    if (call != nullptr && call->expect.pf_info_incomplete) {
+        call->asset_id.set_just_name (asset_id.get_name());
+        call->asset_id.id_n = asset_id.id_n;
+        call->expect.pf_info_incomplete = true;
+        return true;
     }
     return false;  // failed to find the call
 }
@@ -80,7 +80,7 @@ read_policy_template_line::read_policy_template_line (tf_fuzz_info *resources)
 
 bool read_policy_template_line::copy_template_to_asset (void)
 {
-    vector<psa_asset*>::iterator found_asset;
+    psa_asset_list::iterator found_asset;
     sst_asset* this_asset;
     // Find the call by serial number (must search;  may have moved).
     asset_search how_found = test_state->find_or_create_sst_asset (
@@ -106,13 +106,12 @@ bool read_policy_template_line::copy_template_to_asset (void)
 
 bool read_policy_template_line::copy_template_to_call (void)
 {
-    for (auto call : test_state->calls) {
-        if (call->call_ser_no == call_ser_no && call->expect.pf_info_incomplete) {
-            call->asset_id.set_just_name (asset_id.get_name());
-            call->asset_id.id_n = asset_id.id_n;
-            call->expect.pf_info_incomplete = true;
-            return true;
-        }
+    psa_call *call = test_state->find_call (call_ser_no);
+    if (call != nullptr && call->expect.pf_info_incomplete) {
+        call->asset_id.set_just_name (asset_id.get_name());
+        call->asset_id.id_n = asset_id.id_n;
+        call->expect.pf_info_incomplete = true;
+        return true;
     }
     return false;  // failed to find the call
 }
@@ -143,7 +142,7 @@ set_key_template_line::set_key_template_line (tf_fuzz_info *resources)
 
 bool set_key_template_line::copy_template_to_asset (void)
 {
-    vector<psa_asset*>::iterator found_asset;
+    psa_asset_list::iterator found_asset;
     key_asset* this_asset;
 
     // Find the asset by serial number (must search;  may have moved).
@@ -171,20 +170,19 @@ bool set_key_template_line::copy_template_to_asset (void)
 bool set_key_template_line::copy_template_to_call (void)
 {
     // Find the call by serial number (must search;  may have moved).
-    for (auto call : test_state->calls) {
-        if (call->call_ser_no == call_ser_no) {
-            // Copy asset info to call object for creation code:
-            call->asset_id.set_just_name (asset_id.get_name());
-            call->asset_id.id_n = asset_id.id_n;
-            call->set_data.string_specified = set_data.string_specified;
-            call->set_data.set (set_data.get());  call->asset_ser_no = asset_ser_no;
-            call->set_data.file_specified = set_data.file_specified;
-            call->set_data.file_path = set_data.file_path;
-            call->flags_string = flags_string;
-            call->how_asset_found = how_asset_found;
-            call->expect.pf_info_incomplete = true;
-            return true;
-        }
+    psa_call *call = test_state->find_call (call_ser_no);
+    if (call != nullptr) {
+        // Copy asset info to call object for creation code:
+        call->asset_id.set_just_name (asset_id.get_name());
+        call->asset_id.id_n = asset_id.id_n;
+        call->set_data.string_specified = set_data.string_specified;
+        call->set_data.set (set_data.get());  call->asset_ser_no = asset_ser_no;
+        call->set_data.file_specified = set_data.file_specified;
+        call->set_data.file_path = set_data.file_path;
+        call->flags_string = flags_string;
+        call->how_asset_found = how_asset_found;
+        call->expect.pf_info_incomplete = true;
+        return true;
     }
     return false;  // somehow didn't find it the call.
 }
@@ -215,7 +213,7 @@ remove_key_template_line::remove_key_template_line (tf_fuzz_info *resources)
 
 bool remove_key_template_line::copy_template_to_asset (void)
 {
-    vector<psa_asset*>::iterator found_asset;
+    psa_asset_list::iterator found_asset;
     sst_asset* this_asset;
     // Find the call by serial number (must search;  may have moved).
     asset_search how_found = test_state->find_or_create_sst_asset (
@@ -242,18 +240,17 @@ bool remove_key_template_line::copy_template_to_asset (void)
 bool remove_key_template_line::copy_template_to_call (void)
 {
     // Find the call by serial number (must search;  may have moved).
-    for (auto call : test_state->calls) {
-        if (call->call_ser_no == call_ser_no) {
-            call->asset_id.set_just_name (asset_id.get_name());
-            call->asset_id.id_n = asset_id.id_n;
-            call->expect.pf_nothing = expect.pf_nothing;
-            call->expect.pf_pass = expect.pf_pass;  call->asset_ser_no = asset_ser_no;
-            call->expect.pf_specified = expect.pf_specified;
-            call->expect.pf_result_string = expect.pf_result_string;
-            call->how_asset_found = how_asset_found;
-            call->expect.pf_info_incomplete = true;
-            return true;
-        }
+    psa_call *call = test_state->find_call (call_ser_no);
+    if (call != nullptr) {
+        call->asset_id.set_just_name (asset_id.get_name());
+        call->asset_id.id_n = asset_id.id_n;
+        call->expect.pf_nothing = expect.pf_nothing;
+        call->expect.pf_pass = expect.pf_pass;  call->asset_ser_no = asset_ser_no;
+        call->expect.pf_specified = expect.pf_specified;
+        call->expect.pf_result_string = expect.pf_result_string;
+        call->how_asset_found = how_asset_found;
+        call->expect.pf_info_incomplete = true;
+        return true;
     }
     return false;  // somehow didn't find it the call.
 }
@@ -281,20 +278,20 @@ read_key_template_line::read_key_template_line (tf_fuzz_info *resources)
 {
     char gibberish_buffer[4096];  string databuff;
     int data_length;
-    set_data.string_specified = (rand()%2) == 1?  true : false;
+    set_data.string_specified = (rand_int()%2) == 1?  true : false;
 
     // Go ahead and create a literal-data string even if not ultimately used:
     data_length = test_state->gibbergen.pick_sentence_len();
     test_state->gibbergen.sentence (gibberish_buffer, gibberish_buffer + data_length);
     databuff = gibberish_buffer;  set_data.set (databuff);
 
-    set_data.file_specified = (!set_data.string_specified && (rand()%2) == 1)?  true : false;
+    set_data.file_specified = (!set_data.string_specified && (rand_int()%2) == 1)?  true : false;
     set_data.file_path = "";  // can't really devise a random path
 }
 
 bool read_key_template_line::copy_template_to_asset (void)
 {
-    vector<psa_asset*>::iterator found_asset;
+    psa_asset_list::iterator found_asset;
     sst_asset* this_asset;
     // Find the call by serial number (must search;  may have moved).
     asset_search how_found = test_state->find_or_create_sst_asset (
@@ -321,21 +318,20 @@ bool read_key_template_line::copy_template_to_asset (void)
 bool read_key_template_line::copy_template_to_call (void)
 {
     // Find the call by serial number (must search;  may have moved).
-    for (auto call : test_state->calls) {
-        if (call->call_ser_no == call_ser_no) {
-            // Copy expected results to the call object, to check:
-            call->asset_id.set_just_name (asset_id.get_name());
-            call->asset_id.id_n = asset_id.id_n;
-            call->set_data.string_specified = set_data.string_specified;
-            call->set_data.set (set_data.get());  call->asset_ser_no = asset_ser_no;
-            call->set_data.file_specified = set_data.file_specified;
-            call->set_data.file_path = set_data.file_path;
-            call->flags_string = flags_string;
-            call->set_data.string_specified = set_data.string_specified;
-            call->how_asset_found = how_asset_found;
-            call->expect.pf_info_incomplete = true;
-            return true;
-        }
+    psa_call *call = test_state->find_call (call_ser_no);
+    if (call != nullptr) {
+        // Copy expected results to the call object, to check:
+        call->asset_id.set_just_name (asset_id.get_name());
+        call->asset_id.id_n = asset_id.id_n;
+        call->set_data.string_specified = set_data.string_specified;
+        call->set_data.set (set_data.get());  call->asset_ser_no = asset_ser_no;
+        call->set_data.file_specified = set_data.file_specified;
+        call->set_data.file_path = set_data.file_path;
+        call->flags_string = flags_string;
+        call->set_data.string_specified = set_data.string_specified;
+        call->how_asset_found = how_asset_found;
+        call->expect.pf_info_incomplete = true;
+        return true;
     }
     return false;  // somehow didn't find it the call.
 }
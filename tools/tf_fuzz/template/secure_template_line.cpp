@@ -8,6 +8,7 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "data_blocks.hpp"
@@ -41,25 +42,24 @@ bool security_hash_template_line::copy_template_to_asset (void)
 bool security_hash_template_line::copy_template_to_call (void)
 {
     // Find the call by serial number (must search;  may have moved).
-    for (auto call : test_state->calls) {
-        if (call->call_ser_no == call_ser_no) {
-            // Copy asset info to call object for creation code -- the entire vector:
-            for (auto as_name : asset_id.asset_name_vector) {
-                /* Also copy into template line object's local vector: */
-                call->asset_id.asset_name_vector.push_back (as_name);
-            }
-            call->asset_id.id_n = asset_id.id_n;
-                // this call is currently limited to name-based
-            call->asset_id.name_specified = true;
-            call->set_data.string_specified = false;  // shouldn't matter, but...
-            call->set_data.file_specified = false;
-            call->set_data.file_path.assign("");
-            call->asset_ser_no = asset_ser_no;  // TODO:  Does this make sense?
-            call->flags_string.assign ("");  call->set_data.set("");
-            call->how_asset_found = asset_search::found_active;
-            call->expect.pf_info_incomplete = true;
-            return true;
+    psa_call *call = test_state->find_call (call_ser_no);
+    if (call != nullptr) {
+        // Copy asset info to call object for creation code -- the entire vector:
+        for (auto as_name : asset_id.asset_name_vector) {
+            /* Also copy into template line object's local vector: */
+            call->asset_id.asset_name_vector.push_back (as_name);
         }
+        call->asset_id.id_n = asset_id.id_n;
+            // this call is currently limited to name-based
+        call->asset_id.name_specified = true;
+        call->set_data.string_specified = false;  // shouldn't matter, but...
+        call->set_data.file_specified = false;
+        call->set_data.file_path.assign("");
+        call->asset_ser_no = asset_ser_no;  // TODO:  Does this make sense?
+        call->flags_string.assign ("");  call->set_data.set("");
+        call->how_asset_found = asset_search::found_active;
+        call->expect.pf_info_incomplete = true;
+        return true;
     }
     return false;  // somehow didn't find it the call.
 }
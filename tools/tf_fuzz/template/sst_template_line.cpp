@@ -8,6 +8,7 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "data_blocks.hpp"
@@ -32,7 +33,7 @@
 
 string set_sst_template_line::rand_creation_flags (void)
 {
-    return ((rand() % 2) == 1)?
+    return ((rand_int() % 2) == 1)?
         "PSA_STORAGE_FLAG_WRITE_ONCE" : "PSA_STORAGE_FLAG_NONE";
     /* TODO:  There's seems to be some uncertainty as to how many creation-flag
        values are actually used, so for now only using PSA_STORAGE_FLAG_WRITE_ONCE
@@ -40,10 +41,10 @@ string set_sst_template_line::rand_creation_flags (void)
        resurrect the commented-out code below to assign them:
     string result = "";
     const int most_flags = 3,
-    int n_flags = (rand() % most_flags);
+    int n_flags = (rand_int() % most_flags);
 
     for (int i = 0;  i < ;  i < n_flags;  ++i) {
-        switch (rand() % 5) {
+        switch (rand_int() % 5) {
             case 0:
                 result += "PSA_STORAGE_FLAG_WRITE_ONCE";
                 break;
@@ -74,7 +75,7 @@ set_sst_template_line::set_sst_template_line (tf_fuzz_info *resources)
 
 bool set_sst_template_line::copy_template_to_asset (void)
 {
-    vector<psa_asset*>::iterator found_asset;
+    psa_asset_list::iterator found_asset;
     sst_asset* this_asset;
     // Find the call by serial number (must search;  may have moved).
     asset_search how_found = test_state->find_or_create_sst_asset (
@@ -97,6 +98,7 @@ bool set_sst_template_line::copy_template_to_asset (void)
         this_asset->set_uid (asset_id.id_n);
         this_asset->asset_id.name_specified = asset_id.name_specified;
         this_asset->asset_id.set_name (asset_id.get_name());
+        test_state->reindex_psa_asset (psa_asset_type::sst, this_asset);
     }
     return true;
 }
@@ -104,23 +106,22 @@ bool set_sst_template_line::copy_template_to_asset (void)
 bool set_sst_template_line::copy_template_to_call (void)
 {
     // Find the call by serial number (must search;  may have moved).
-    for (auto call : test_state->calls) {
-        if (call->call_ser_no == call_ser_no) {
-            // Copy asset info to call object for creation code:
-            call->asset_id.set_just_name (asset_id.get_name());
-                // TODO:  Question:  Just call->asset_id = asset_id?
-            call->asset_id.id_n = asset_id.id_n;
-            call->asset_id.name_specified = asset_id.name_specified;
-            call->set_data.string_specified =   set_data.string_specified
-                                             || set_data.random_data;
-            call->set_data.file_specified = set_data.file_specified;
-            call->set_data.file_path = set_data.file_path;
-            call->asset_ser_no = asset_ser_no;
-            call->flags_string = flags_string;  call->set_data.set (set_data.get());
-            call->how_asset_found = how_asset_found;
-            call->expect.pf_info_incomplete = true;
-            return true;
-        }
+    psa_call *call = test_state->find_call (call_ser_no);
+    if (call != nullptr) {
+        // Copy asset info to call object for creation code:
+        call->asset_id.set_just_name (asset_id.get_name());
+            // TODO:  Question:  Just call->asset_id = asset_id?
+        call->asset_id.id_n = asset_id.id_n;
+        call->asset_id.name_specified = asset_id.name_specified;
+        call->set_data.string_specified =   set_data.string_specified
+                                         || set_data.random_data;
+        call->set_data.file_specified = set_data.file_specified;
+        call->set_data.file_path = set_data.file_path;
+        call->asset_ser_no = asset_ser_no;
+        call->flags_string = flags_string;  call->set_data.set (set_data.get());
+        call->how_asset_found = how_asset_found;
+        call->expect.pf_info_incomplete = true;
+        return true;
     }
     return false;  // somehow didn't find it the call.
 }
@@ -152,7 +153,7 @@ remove_sst_template_line::remove_sst_template_line (tf_fuzz_info *resources)
 
 bool remove_sst_template_line::copy_template_to_asset (void)
 {
-    vector<psa_asset*>::iterator found_asset;
+    psa_asset_list::iterator found_asset;
     sst_asset* this_asset;
     // Find the call by serial number (must search;  may have moved).
     asset_search how_found = test_state->find_or_create_sst_asset (
@@ -180,18 +181,17 @@ bool remove_sst_template_line::copy_template_to_asset (void)
 bool remove_sst_template_line::copy_template_to_call (void)
 {
     // Find the call by serial number (must search;  may have moved).
-    for (auto call : test_state->calls) {
-        if (call->call_ser_no == call_ser_no) {
-            call->asset_id.set_just_name (asset_id.get_name());
-            call->asset_id.id_n = asset_id.id_n;
-            call->set_data.string_specified = false;
-            call->set_data.set ("");  call->id_string = asset_name;
-            call->set_data.file_specified = false;
-            call->set_data.file_path = "";  call->asset_ser_no = asset_ser_no;
-            call->how_asset_found = how_asset_found;
-            call->expect.pf_info_incomplete = true;
-            return true;
-        }
+    psa_call *call = test_state->find_call (call_ser_no);
+    if (call != nullptr) {
+        call->asset_id.set_just_name (asset_id.get_name());
+        call->asset_id.id_n = asset_id.id_n;
+        call->set_data.string_specified = false;
+        call->set_data.set ("");  call->id_string = asset_name;
+        call->set_data.file_specified = false;
+        call->set_data.file_path = "";  call->asset_ser_no = asset_ser_no;
+        call->how_asset_found = how_asset_found;
+        call->expect.pf_info_incomplete = true;
+        return true;
     }
     return false;  // somehow didn't find it the call.
 }
@@ -219,20 +219,20 @@ read_sst_template_line::read_sst_template_line (tf_fuzz_info *resources)
 {
     char gibberish_buffer[4096];  string databuff;
     int data_length;
-    set_data.string_specified = (rand()%2) == 1?  true : false;
+    set_data.string_specified = (rand_int()%2) == 1?  true : false;
 
     // Go ahead and create a literal-data string even if not needed:
     data_length = test_state->gibbergen.pick_sentence_len();
     test_state->gibbergen.sentence (gibberish_buffer, gibberish_buffer + data_length);
     databuff = gibberish_buffer;  set_data.set (databuff);
 
-    set_data.file_specified = (!set_data.string_specified && (rand()%2) == 1)?  true : false;
+    set_data.file_specified = (!set_data.string_specified && (rand_int()%2) == 1)?  true : false;
     set_data.file_path = "";  // can't really devise a random path
 }
 
 bool read_sst_template_line::copy_template_to_asset (void)
 {
-    vector<psa_asset*>::iterator found_asset;
+    psa_asset_list::iterator found_asset;
     sst_asset* this_asset;
     // Find the call by serial number (must search;  may have moved).
     asset_search how_found = test_state->find_or_create_sst_asset (
@@ -260,30 +260,29 @@ bool read_sst_template_line::copy_template_to_asset (void)
 bool read_sst_template_line::copy_template_to_call (void)
 {
     // Find the call by serial number (must search;  may have moved).
-    for (auto call : test_state->calls) {
-        if (call->call_ser_no == call_ser_no) {
-            call->asset_id.set_just_name (asset_id.get_name());
-            call->asset_id.id_n = asset_id.id_n;
-            call->set_data.string_specified
-                    = set_data.string_specified || set_data.random_data;
-            call->set_data.set(set_data.get());
-            call->assign_data_var = assign_data_var;
-            call->assign_data_var_specified = assign_data_var_specified;
-            // TODO:  Just copy entire expect object?  call->expect = expect;
-            call->expect.data_var = expect.data_var;
-            call->expect.data_var_specified = expect.data_var_specified;
-            call->expect.data_specified = expect.data_specified;
-            call->expect.data.assign(expect.data);
-            call->expect.pf_info_incomplete = true;
-            call->id_string = asset_name;  // data = expected
-            call->set_data.file_specified = set_data.file_specified;
-            call->set_data.file_path = set_data.file_path;  call->asset_ser_no = asset_ser_no;
-            call->flags_string = flags_string;
-            call->how_asset_found = how_asset_found;
-            call->print_data = print_data;
-            call->hash_data = hash_data;
-            return true;
-        }
+    psa_call *call = test_state->find_call (call_ser_no);
+    if (call != nullptr) {
+        call->asset_id.set_just_name (asset_id.get_name());
+        call->asset_id.id_n = asset_id.id_n;
+        call->set_data.string_specified
+                = set_data.string_specified || set_data.random_data;
+        call->set_data.set(set_data.get());
+        call->assign_data_var = assign_data_var;
+        call->assign_data_var_specified = assign_data_var_specified;
+        // TODO:  Just copy entire expect object?  call->expect = expect;
+        call->expect.data_var = expect.data_var;
+        call->expect.data_var_specified = expect.data_var_specified;
+        call->expect.data_specified = expect.data_specified;
+        call->expect.data.assign(expect.data);
+        call->expect.pf_info_incomplete = true;
+        call->id_string = asset_name;  // data = expected
+        call->set_data.file_specified = set_data.file_specified;
+        call->set_data.file_path = set_data.file_path;  call->asset_ser_no = asset_ser_no;
+        call->flags_string = flags_string;
+        call->how_asset_found = how_asset_found;
+        call->print_data = print_data;
+        call->hash_data = hash_data;
+        return true;
     }
     return false;  // somehow didn't find it the call
 }
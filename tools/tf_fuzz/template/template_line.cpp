@@ -114,10 +114,10 @@ key_template_line::key_template_line (tf_fuzz_info *resources) : template_line (
     // Randomize key type:
     key_type = rand_key_type();
     // Randomize lifetime:
-    lifetime_str = ((rand() % 2) == 1)?
+    lifetime_str = ((rand_int() % 2) == 1)?
                        "PSA_KEY_LIFETIME_VOLATILE" : "PSA_KEY_LIFETIME_PERSISTENT";
     // Choose a random expected key size in bits:
-    expected_n_bits = to_string(rand()%10000);
+    expected_n_bits = to_string(rand_int()%10000);
 }
 
 // Create ID-based name:
@@ -9,10 +9,11 @@
 #include <string>
 #include <vector>
 #include <iostream>
-#include <cstdlib>  // for srand() and rand()
+#include <cstdlib>
 #include <cstdio>  // for template lex&yacc input file
 #include "class_forwards.hpp"
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "string_ops.hpp"
@@ -24,15 +25,17 @@
 #include "sst_asset.hpp"
 #include "crypto_asset.hpp"
 #include "psa_call.hpp"
+#include "target_model.hpp"
 #include "tf_fuzz_grammar.tab.hpp"
+#include "lexed_template.hpp"
+#include "tf_fuzz_batch.hpp"
+#include "tf_fuzz_reduce.hpp"
 
 
-extern FILE* yyin;  // telling lex&yacc which file to parse
-
 using namespace std;
 
-long psa_asset::unique_id_counter = 10;  // counts unique IDs for assets
-long psa_call::unique_id_counter = 10;  // counts unique IDs for assets
+thread_local long psa_asset::unique_id_counter = 10;  // counts unique IDs for assets
+thread_local long psa_call::unique_id_counter = 10;  // counts unique IDs for assets
     /* FYI:  Must initialize these class variables outside the class.  If
              initialized inside the class, g++ requires they be const. */
 
@@ -47,7 +50,7 @@ asset_search tf_fuzz_info::find_or_create_sst_asset (
     uint64_t target_id,  // also ignored if not searching on ID (e.g., SST UID)
     long &serial_no,  // search by asset's unique serial number
     bool create_asset,  // true to create the asset if it doesn't exist
-    vector<psa_asset*>::iterator &asset  // returns a pointer to requested asset
+    psa_asset_list::iterator &asset  // returns a pointer to requested asset
 ) {
     return generic_find_or_create_asset<sst_asset>(
                active_sst_asset, deleted_sst_asset,
@@ -63,7 +66,7 @@ asset_search tf_fuzz_info::find_or_create_key_asset (
     uint64_t target_id,  // also ignored if not searching on ID (e.g., SST UID)
     long &serial_no,  // search by asset's unique serial number
     bool create_asset,  // true to create the asset if it doesn't exist
-    vector<psa_asset*>:: iterator &asset  // returns iterator to requested asset
+    psa_asset_list::iterator &asset  // returns iterator to requested asset
 ) {
     return generic_find_or_create_asset<key_asset>(
                active_key_asset, deleted_key_asset,
@@ -79,7 +82,7 @@ asset_search tf_fuzz_info::find_or_create_policy_asset (
     uint64_t target_id,  // also ignored unless searching on ID (e.g., SST UID)
     long &serial_no,  // search by asset's unique serial number
     bool create_asset,  // true to create the asset if it doesn't exist
-    vector<psa_asset*>::iterator &asset  // returns iterator to requested asset
+    psa_asset_list::iterator &asset  // returns iterator to requested asset
 ) {
     return generic_find_or_create_asset<policy_asset>(
                active_policy_asset, deleted_policy_asset,
@@ -96,7 +99,7 @@ asset_search tf_fuzz_info::find_or_create_psa_asset (
     uint64_t target_id,  // also ignored if not searching on ID (e.g., SST UID)
     long &serial_no,  // search by asset's unique serial number
     bool create_asset,  // true to create the asset if it doesn't exist
-    vector<psa_asset*>::iterator &asset  // returns iterator to asset
+    psa_asset_list::iterator &asset  // returns iterator to asset
 ) {
     switch (asset_type) {
         case psa_asset_type::sst:
@@ -121,14 +124,70 @@ asset_search tf_fuzz_info::find_or_create_psa_asset (
     }
 }
 
+void tf_fuzz_info::reindex_psa_asset (psa_asset_type asset_type, psa_asset *asset)
+{
+    switch (asset_type) {
+        case psa_asset_type::sst:
+            active_sst_asset.reindex (asset);
+            deleted_sst_asset.reindex (asset);
+            invalid_sst_asset.reindex (asset);
+            break;
+        case psa_asset_type::key:
+            active_key_asset.reindex (asset);
+            deleted_key_asset.reindex (asset);
+            invalid_key_asset.reindex (asset);
+            break;
+        case psa_asset_type::policy:
+            active_policy_asset.reindex (asset);
+            deleted_policy_asset.reindex (asset);
+            invalid_policy_asset.reindex (asset);
+            break;
+        default:
+            cerr << "\nError:  Internal:  Please report error "
+                 << "#1504 to TF-Fuzz developers." << endl;
+            exit (1500);
+    }
+}
+
+psa_call *tf_fuzz_info::find_call (long call_ser_no)
+{
+    /* The call sought is nearly always the one just added, so search from the end
+       of the list (otherwise, test generation goes quadratic in its calls): */
+    for (auto call = calls.rbegin();  call != calls.rend();  ++call) {
+        if (*call != nullptr && (*call)->call_ser_no == call_ser_no) {
+            return *call;
+        }
+    }
+    return nullptr;
+}
+
+/* Run the calls, in order, against the model of the target, for each to work out
+   what it should return. */
+void tf_fuzz_info::simulate_test (void)
+{
+    model->reset();
+    for (auto call : calls) {
+        call->simulate();
+    }
+}
+
 // Remove any PSA resources used in the test.  Returns success==true, fail==false.
 void tf_fuzz_info::teardown_test (void)
 {
     string call;
-    // Traverse through the SST-assets list, writing out remove commands:
-    for (auto &asset : active_sst_asset) {
+    /* Traverse through the SST UIDs the model of the target says are left at the
+       end of the test, writing out remove commands: */
+    for (auto uid : model->sst_uids()) {
+        if (!model->sst_exists (uid)) {
+            continue;
+        }
+        if (model->sst_write_once (uid)) {
+            output_C_file << "    /* (UID " << uid << " is write-once, so cannot be "
+                          << "removed.) */" << endl;
+            continue;
+        }
         call = bplate->bplate_string[teardown_sst];
-        find_replace_1st ("$uid", to_string(asset->asset_id.id_n), call);
+        find_replace_1st ("$uid", to_string(uid), call);
         call.append (bplate->bplate_string[teardown_sst_check]);
         output_C_file << call;
     }
@@ -163,6 +222,9 @@ void tf_fuzz_info::write_test (void)
     find_replace_all ("$purpose", test_purpose, work);
     output_C_file << work;
 
+    // Work out the expected results, which the calls' prep code may need:
+    simulate_test();
+
     output_C_file << "\n\n    /* Variables (etc.) to initialize and check PSA "
                   << "assets: */" << endl;
     for (auto call : calls) {
@@ -188,7 +250,27 @@ void tf_fuzz_info::write_test (void)
 
     // Close the template and test files:
     output_C_file.close();
-    fclose (template_file);
+    if (template_file != NULL) {  // (the tests of a batch don't open it)
+        fclose (template_file);
+        template_file = NULL;
+    }
+}
+
+
+/* Returns the number in a "name=value" command-line switch, or -1 if there is
+   none. */
+long switch_value (string cmd_line_switch)
+{
+    size_t equals = cmd_line_switch.find ('=');
+
+    if (equals == string::npos) {
+        return -1;
+    }
+    try {
+        return stol (cmd_line_switch.substr (equals + 1), 0, 0);
+    } catch (...) {
+        return -1;
+    }
 }
 
 
@@ -203,6 +285,7 @@ void tf_fuzz_info::parse_cmd_line_params (int argc, char* argv[])
         // counting off cmd_line_parameter and cmd_line_switches while parsing
     char testc;
 
+    program_name = argv[0];
     // Parse arguments into lists of strings:
     for (int i = 1;  i < argc;  ++i) {
         if (argv[i][0] == '-') {  // cmd_line_switch
@@ -227,20 +310,68 @@ void tf_fuzz_info::parse_cmd_line_params (int argc, char* argv[])
         if (cmd_line_switch[i] == "v") {
             verbose_mode = true;
         }
+        // Batch of tests:
+        if (cmd_line_switch[i].compare (0, 6, "batch=") == 0) {
+            batch_n_tests = switch_value (cmd_line_switch[i]);
+            if (batch_n_tests <= 0) {
+                cerr << "\nError:  Number of tests in --batch= must be a number "
+                     << "above 0." << endl;
+                exit_val = 15;
+            }
+        }
+        if (cmd_line_switch[i].compare (0, 8, "threads=") == 0) {
+            long n_threads = switch_value (cmd_line_switch[i]);
+            if (n_threads <= 0) {
+                cerr << "\nError:  Number of threads in --threads= must be a "
+                     << "number above 0." << endl;
+                exit_val = 15;
+            } else {
+                batch_n_threads = (unsigned int) n_threads;
+            }
+        }
+        if (cmd_line_switch[i].compare (0, 6, "shard=") == 0) {
+            batch_shard_size = switch_value (cmd_line_switch[i]);
+            if (batch_shard_size <= 0) {
+                cerr << "\nError:  Number of tests in --shard= must be a number "
+                     << "above 0." << endl;
+                exit_val = 15;
+            }
+        }
+        // Reduce the template, against a failure oracle:
+        if (cmd_line_switch[i].compare (0, 7, "reduce=") == 0) {
+            reduce_oracle = cmd_line_switch[i].substr (7);
+            if (reduce_oracle == "") {
+                cerr << "\nError:  --reduce= needs the command that tells if a "
+                     << "test fails." << endl;
+                exit_val = 15;
+            }
+        }
     }
     if (exit_val == 10) {  // -h switch
         cout << "\nHow to run TF-Fuzz:" << endl;
+    } else if (exit_val != 0) {
+        // (bad switch, already reported)
     } else if (n_parameters < 2) {
         cerr << "\nToo few command-line parameters." << endl;
         exit_val = 11;
     } else if (n_parameters > 3) {
         cerr << "\nToo many command-line parameters." << endl;
         exit_val = 12;
+    } else if (reduce_oracle != "" && batch_n_tests > 0) {
+        cerr << "\nError:  --reduce= and --batch= can't be used together." << endl;
+        exit_val = 15;
+    } else if (reduce_oracle != "" && n_parameters < 3) {
+        cerr << "\nError:  --reduce= needs the seed of the failing test." << endl;
+        exit_val = 11;
     } else {
         template_file_name = cmd_line_parameter[0];
         template_file = fopen (template_file_name.c_str(), "r");
         test_output_file_name = cmd_line_parameter[1];
-        output_C_file.open (test_output_file_name, ios::out);
+            /* (for a batch, the directory to write the tests into;  for a
+               reduction, the reduced template) */
+        if (batch_n_tests == 0 && reduce_oracle == "") {
+            output_C_file.open (test_output_file_name, ios::out);
+        }
         if (n_parameters == 3) {
             /* TODO:  The try-catch below doesn't always seem to work.  For now,
                manually "catch" the most basic problem: */
@@ -267,19 +398,20 @@ void tf_fuzz_info::parse_cmd_line_params (int argc, char* argv[])
                 cout << "Warning:  random seed, " << cmd_line_parameter[2]
                      << ", was not usable!" << endl;
             }
-            srand((unsigned int) time(0));  // TODO:  ideally, XOR or add in PID#
-            rand_seed = rand();
+            seed_rand((unsigned int) time(0));  // TODO:  ideally, XOR or add in PID#
+            rand_seed = rand_int();
                 /* doesn't really matter, but it just "feels better" when the
                    default seed value is itself more random. */
         }
         cout << endl << "Using seed value of " << dec << rand_seed << " " << hex
              << "(0x" << rand_seed << ")." << endl;
-        srand(rand_seed);
+        seed_rand((unsigned int) rand_seed);
         if (template_file == NULL) {
             cerr << "\nError:  Template file " << template_file_name
                  << " could not be opened." << endl;
             exit_val = 13;
-        } else if (!output_C_file.is_open()) {
+        } else if (   batch_n_tests == 0 && reduce_oracle == ""
+                   && !output_C_file.is_open()) {
             // If test-output file couldn't be opened
             cerr << "\nError:  Output C test file " << test_output_file_name
                  << " could not be opened." << endl;
@@ -295,15 +427,37 @@ void tf_fuzz_info::parse_cmd_line_params (int argc, char* argv[])
         cout << "    Basic cmd_line_parameter (positional, in order, "
              << "left-to-right):" << endl;
         cout << "        Test-template file" << endl;
-        cout << "        Test-output .c file" << endl;
-        cout << "        (optional) random seed value" << endl;
+        cout << "        Test-output .c file (directory, for --batch=;  reduced "
+             << "template, for --reduce=)" << endl;
+        cout << "        (optional) random seed value (first seed, for --batch=;  "
+             << "required, for --reduce=)" << endl;
         cout << "    Optional switches:" << endl;
         cout << "        -h or --h:  This help (command-line usage) summary."
              << endl;
         cout << "        -v or --v:  Verbose mode." << endl;
+        cout << "        --batch=N:  Make N tests, from consecutive seeds, into "
+             << "sub-directories" << endl;
+        cout << "                    of the output directory, with a manifest."
+             << endl;
+        cout << "        --threads=N:  Worker threads for --batch= (default, one "
+             << "per CPU)." << endl;
+        cout << "        --shard=N:  Tests per sub-directory for --batch= "
+             << "(default " << default_shard_size << ")." << endl;
+        cout << "        --reduce=\"command\":  Cut the template down to what still "
+             << "makes a test, from" << endl;
+        cout << "                    the seed, that fails.  The command exits with "
+             << "0 if the test" << endl;
+        cout << "                    (%t) fails;  %d is a directory to build it in."
+             << endl;
+        cout << "        --threads=N:  Also, candidates tried at once for --reduce=."
+             << endl;
         cout << "Examples:" << endl;
         cout << "    " << argv[0] << " -h" << endl;
         cout << "    " << argv[0] << " template.txt output_test.c 0x5EED" << endl;
+        cout << "    " << argv[0] << " --batch=10000 template.txt corpus 0x5EED"
+             << endl;
+        cout << "    " << argv[0] << " --reduce=\"./fails.sh %t\" template.txt "
+             << "reduced.txt 0x5EED" << endl;
         exit (exit_val);
     }
 }
@@ -311,15 +465,51 @@ void tf_fuzz_info::parse_cmd_line_params (int argc, char* argv[])
 tf_fuzz_info::tf_fuzz_info (void)  // (constructor)
 {
     this->bplate = new boilerplate();
+    model = new target_model();
     test_purpose = template_file_name = test_output_file_name = "";
+    template_file = NULL;
     rand_seed = 0;
     verbose_mode = false;
     include_hashing_code = false;  // default
+    batch_n_tests = 0;
+    batch_n_threads = 0;
+    batch_shard_size = default_shard_size;
+    reduce_oracle = program_name = "";
+}
+
+tf_fuzz_info::tf_fuzz_info (const boilerplate &bplate_lib)  // (constructor)
+{
+    this->bplate = new boilerplate (bplate_lib);
+    model = new target_model();
+    test_purpose = template_file_name = test_output_file_name = "";
+    template_file = NULL;
+    rand_seed = 0;
+    verbose_mode = false;
+    include_hashing_code = false;  // default
+    batch_n_tests = 0;
+    batch_n_threads = 0;
+    batch_shard_size = default_shard_size;
+    reduce_oracle = program_name = "";
 }
 
 tf_fuzz_info::~tf_fuzz_info (void)
 {
+    /* The calls and assets only belong to this test, and in a batch, many tests
+       are made in the one process: */
+    for (auto call : calls) {
+        delete call;
+    }
+    for (auto asset_list : {&active_sst_asset, &deleted_sst_asset,
+                            &invalid_sst_asset, &active_key_asset,
+                            &deleted_key_asset, &invalid_key_asset,
+                            &active_policy_asset, &deleted_policy_asset,
+                            &invalid_policy_asset}) {
+        for (auto asset : *asset_list) {
+            delete asset;
+        }
+    }
     delete bplate;
+    delete model;
 }
 
 /**********************************************************************************
@@ -337,9 +527,28 @@ int main(int argc, char* argv[])
     // Parse parameters and open files:
     rsrc->parse_cmd_line_params (argc, argv);
 
+    if (rsrc->reduce_oracle != "") {
+        /* (The reduction runs tfz again for each candidate template, so doesn't
+           read the template through the lexer here.) */
+        tf_fuzz_reduce reduction (rsrc);
+        int reduce_result = reduction.run();
+        cout << endl << "TF-Fuzz template reduction complete." << endl;
+        return reduce_result;
+    }
+
+    // Read in the test-template file:
+    lexed_template templ (rsrc->template_file_name);
+    templ.lex (rsrc->template_file);
+
+    if (rsrc->batch_n_tests > 0) {
+        tf_fuzz_batch batch (rsrc, &templ);
+        int batch_result = batch.run();
+        cout << endl << "TF-Fuzz test generation complete." << endl;
+        return batch_result;
+    }
+
     // Parse the test-template file:
-    yyin = rsrc->template_file;
-    int parse_result = yyparse (rsrc);
+    int parse_result = templ.parse (rsrc);
 
     if (parse_result == 1) {
         cerr << "\nError:  Template file has errors." << endl;
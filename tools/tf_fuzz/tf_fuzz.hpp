@@ -48,15 +48,17 @@ public:
         crc32 hashgen;  // simple 32-bit LFSR-based hashing generator
         /* Note:  The following asset-lists are kept in base-class type to allow a
                   common template-line processing function in tf_fuzz_grammar.y. */
-        vector<psa_asset*> active_sst_asset;  // list of known and usable SST assets
-        vector<psa_asset*> deleted_sst_asset;  // deleted SST assets
-        vector<psa_asset*> invalid_sst_asset;  // SST assets with invalid attributes
-        vector<psa_asset*> active_key_asset;  // list of known and usable keys
-        vector<psa_asset*> deleted_key_asset;  // deleted keys
-        vector<psa_asset*> invalid_key_asset;  // keys with invalid attributes
-        vector<psa_asset*> active_policy_asset;  // list of known, usable policies
-        vector<psa_asset*> deleted_policy_asset;  // deleted policies
-        vector<psa_asset*> invalid_policy_asset;  // policies with invalid attrs
+        psa_asset_list active_sst_asset;  // list of known and usable SST assets
+        psa_asset_list deleted_sst_asset;  // deleted SST assets
+        psa_asset_list invalid_sst_asset;  // SST assets with invalid attributes
+        psa_asset_list active_key_asset;  // list of known and usable keys
+        psa_asset_list deleted_key_asset;  // deleted keys
+        psa_asset_list invalid_key_asset;  // keys with invalid attributes
+        psa_asset_list active_policy_asset;  // list of known, usable policies
+        psa_asset_list deleted_policy_asset;  // deleted policies
+        psa_asset_list invalid_policy_asset;  // policies with invalid attrs
+        target_model *model;
+            // model of the target, to work out what the calls should return
         string test_purpose;  // one text substitution to be performed at the top level
         long rand_seed;  // the original random seed, whether passed in or defaulted
         string template_file_name, test_output_file_name;
@@ -68,6 +70,16 @@ public:
         ofstream output_C_file;  // handle to the output C test file
         bool verbose_mode;  // true to "think aloud"
         bool include_hashing_code;  // true to instantiate the hashing code
+        /* For making a batch of tests from consecutive seeds (see
+           tf_fuzz_batch.hpp), rather than just one: */
+        long batch_n_tests;  // number of tests in the batch;  0 for just one test
+        unsigned int batch_n_threads;  // worker threads;  0 for one per CPU
+        long batch_shard_size;  // number of tests per sub-directory
+        string reduce_oracle;
+            /* for reducing the template to what still makes a failing test (see
+               tf_fuzz_reduce.hpp), the command telling if a test fails;  "" if
+               not reducing */
+        string program_name;  // how tfz was run (argv[0]), to run it again
     // Methods:
         asset_search find_or_create_sst_asset (
             psa_asset_search criterion,  // what to search on
@@ -76,7 +88,7 @@ public:
             uint64_t target_id,  // ignored if not searching on ID (e.g., SST UID)
             long &serial_no,  // search by asset's unique serial number
             bool create_asset,  // true to create the asset if it doesn't exist
-            vector<psa_asset*>::iterator &asset  // returns a pointer to asset
+            psa_asset_list::iterator &asset  // returns a pointer to asset
         );
         asset_search find_or_create_key_asset (
             psa_asset_search criterion,  // what to search on
@@ -85,7 +97,7 @@ public:
             uint64_t target_id,  // also ignored if not searching on ID (e.g., SST UID)
             long &serial_no,  // search by asset's unique serial number
             bool create_asset,  // true to create the asset if it doesn't exist
-            vector<psa_asset*>:: iterator &asset  // returns iterator to asset
+            psa_asset_list::iterator &asset  // returns iterator to asset
         );
         asset_search find_or_create_policy_asset (
             psa_asset_search criterion,  // what to search on
@@ -94,7 +106,7 @@ public:
             uint64_t target_id,  // also ignored if not searching on ID (e.g., SST UID)
             long &serial_no,  // search by asset's unique serial number
             bool create_asset,  // true to create the asset if it doesn't exist
-            vector<psa_asset*>::iterator &asset  // returns iterator to asset
+            psa_asset_list::iterator &asset  // returns iterator to asset
         );
         asset_search find_or_create_psa_asset (
             psa_asset_type asset_type,  // what type of asset to find
@@ -104,13 +116,21 @@ public:
             uint64_t target_id,  // also ignored if not searching on ID (e.g., SST UID)
             long &serial_no,  // search by asset's unique serial number
             bool create_asset,  // true to create the asset if it doesn't exist
-            vector<psa_asset*>::iterator &asset  // returns iterator to asset
+            psa_asset_list::iterator &asset  // returns iterator to asset
         );
+        void reindex_psa_asset (psa_asset_type asset_type, psa_asset *asset);
+            // call after changing the name or ID of an asset in the lists above
+        psa_call *find_call (long call_ser_no);
+            // returns the call with that serial number, or nullptr if none
+        void simulate_test (void);
+            // works out, from the model of the target, what each call should return
         void teardown_test(void);  // removes any PSA resources used in the test
         void write_test (void);  // returns success==true, fail==false
         void parse_cmd_line_params (int argc, char* argv[]);
             // parse command-line parameters, and open files
         tf_fuzz_info (void);  // (constructor)
+        tf_fuzz_info (const boilerplate &bplate_lib);
+            // (constructor, with a copy of already-read boilerplate)
         ~tf_fuzz_info (void);
 
 protected:
@@ -142,7 +162,7 @@ void define_call (set_data_info set_data, bool random_data, bool fill_in_templat
     if (fill_in_template) {
         if (set_data.literal_data_not_file) {
             if (random_data) {
-                int rand_data_length = 10 + (rand() % 800);
+                int rand_data_length = 10 + (rand_int() % 800);
                 gib.sentence (gib_buff, gib_buff + rand_data_length - 1);
                 t_string = gib_buff;
                 temLin->set_data.set_calculated (t_string);
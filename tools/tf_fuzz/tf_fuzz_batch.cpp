@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <thread>
+#include <chrono>
+#include <cerrno>
+#ifdef _WIN32
+#include <direct.h>  // for _mkdir()
+#else
+#include <sys/stat.h>  // for mkdir()
+#endif
+#include "class_forwards.hpp"
+#include "boilerplate.hpp"
+#include "randomization.hpp"
+#include "gibberish.hpp"
+#include "compute.hpp"
+#include "string_ops.hpp"
+#include "data_blocks.hpp"
+#include "psa_asset.hpp"
+#include "find_or_create_asset.hpp"
+#include "template_line.hpp"
+#include "tf_fuzz.hpp"
+#include "sst_asset.hpp"
+#include "crypto_asset.hpp"
+#include "psa_call.hpp"
+#include "lexed_template.hpp"
+#include "tf_fuzz_batch.hpp"
+
+
+using namespace std;
+
+/* Creates a directory;  returns false if that failed, other than because it
+   already exists. */
+bool make_directory (string path)
+{
+#ifdef _WIN32
+    int result = _mkdir (path.c_str());
+#else
+    int result = mkdir (path.c_str(), 0777);
+#endif
+    return result == 0 || errno == EEXIST;
+}
+
+/**********************************************************************************
+   Methods of class tf_fuzz_batch follow:
+**********************************************************************************/
+
+string tf_fuzz_batch::shard_name (long shard_no)
+{
+    ostringstream name;
+
+    name << "shard_" << setw(4) << setfill('0') << shard_no;
+    return name.str();
+}
+
+bool tf_fuzz_batch::make_directories (void)
+{
+    if (!make_directory (output_dir)) {
+        cerr << "\nError:  Output directory " << output_dir
+             << " could not be created." << endl;
+        return false;
+    }
+    for (long shard_no = 0;  shard_no * shard_size < n_tests;  ++shard_no) {
+        if (!make_directory (output_dir + "/" + shard_name (shard_no))) {
+            cerr << "\nError:  Output directory " << output_dir << "/"
+                 << shard_name (shard_no) << " could not be created." << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Make one test, as a run of tfz for its seed would.
+void tf_fuzz_batch::make_test (long test_no)
+{
+    batch_test_info &test = tests[test_no];
+    tf_fuzz_info *rsrc = new tf_fuzz_info (*settings->bplate);
+
+    test.seed = first_seed + test_no;
+    test.file_name =   shard_name (test_no / shard_size) + "/test_"
+                     + to_string (test.seed) + ".c";
+    test.n_calls = 0;
+    test.parse_result = 0;
+    test.written = false;
+
+    rsrc->verbose_mode = settings->verbose_mode;
+    rsrc->rand_seed = test.seed;
+    rsrc->template_file_name = settings->template_file_name;
+    rsrc->test_output_file_name = output_dir + "/" + test.file_name;
+    rsrc->output_C_file.open (rsrc->test_output_file_name, ios::out);
+    if (!rsrc->output_C_file.is_open()) {
+        cerr << "\nError:  Output C test file " << rsrc->test_output_file_name
+             << " could not be opened." << endl;
+        delete rsrc;
+        return;
+    }
+    // Default (not entirely worthless) purpose of the test:
+    rsrc->test_purpose.assign (  "template = " + rsrc->template_file_name
+                               + ", seed = " + to_string (rsrc->rand_seed));
+
+    test.parse_result = templ->parse (rsrc);
+    if (test.parse_result == 1) {
+        cerr << "\nError:  Template file has errors (seed " << test.seed << ")."
+             << endl;
+    } else if (test.parse_result == 2) {
+        cerr << "\nError:  Sorry, TF-Fuzz ran out of memory (seed " << test.seed
+             << ")." << endl;
+    }
+    rsrc->write_test();
+    test.n_calls = rsrc->calls.size();
+    test.written = true;
+    delete rsrc;
+}
+
+void tf_fuzz_batch::worker (void)
+{
+    for (long test_no = next_test++;  test_no < n_tests;  test_no = next_test++) {
+        /* A thread of its own for each test, for fresh thread_local state: */
+        thread test_thread (&tf_fuzz_batch::make_test, this, test_no);
+        test_thread.join();
+    }
+}
+
+bool tf_fuzz_batch::write_manifest (void)
+{
+    string file_name = output_dir + "/manifest.txt";
+    ofstream manifest (file_name, ios::out);
+
+    if (!manifest.is_open()) {
+        cerr << "\nError:  Manifest file " << file_name
+             << " could not be opened." << endl;
+        return false;
+    }
+    manifest << "# TF-Fuzz batch:  template = " << settings->template_file_name
+             << ", seeds " << first_seed << " to " << first_seed + n_tests - 1
+             << endl;
+    manifest << "# seed  test file  PSA calls" << endl;
+    for (auto &test : tests) {
+        manifest << test.seed << "  " << test.file_name << "  ";
+        if (!test.written) {
+            manifest << "(not written)";
+        } else {
+            manifest << test.n_calls;
+            if (test.parse_result != 0) {
+                manifest << "  (template errors)";
+            }
+        }
+        manifest << endl;
+    }
+    manifest.close();
+    return true;
+}
+
+int tf_fuzz_batch::run (void)
+{
+    vector<thread> workers;
+    long n_failed = 0;
+
+    if (!make_directories()) {
+        return 16;
+    }
+    cout << dec << "Writing " << n_tests << " tests, seeds " << first_seed << " to "
+         << first_seed + n_tests - 1 << ", into " << output_dir << ", with "
+         << n_threads << " threads." << endl;
+
+    auto start = chrono::steady_clock::now();
+    tests.resize (n_tests);
+    next_test = 0;
+    for (unsigned int i = 0;  i < n_threads;  ++i) {
+        workers.push_back (thread (&tf_fuzz_batch::worker, this));
+    }
+    for (auto &worker_thread : workers) {
+        worker_thread.join();
+    }
+    chrono::duration<double> secs = chrono::steady_clock::now() - start;
+
+    for (auto &test : tests) {
+        if (!test.written || test.parse_result != 0) {
+            ++n_failed;
+        }
+    }
+    cout << "Wrote " << n_tests - n_failed << " tests in " << secs.count()
+         << " s (" << (double) n_tests / secs.count() << " tests/s)." << endl;
+    if (!write_manifest()) {
+        return 16;
+    }
+    return (n_failed == 0)?  0 : 17;
+}
+
+tf_fuzz_batch::tf_fuzz_batch (tf_fuzz_info *settings,
+                              const lexed_template *templ)  // (constructor)
+{
+    this->settings = settings;
+    this->templ = templ;
+    n_tests = settings->batch_n_tests;
+    first_seed = settings->rand_seed;
+    shard_size = settings->batch_shard_size;
+    n_threads = settings->batch_n_threads;
+    if (n_threads == 0) {
+        n_threads = thread::hardware_concurrency();
+        if (n_threads == 0) {  // (not known)
+            n_threads = 1;
+        }
+    }
+    output_dir = settings->test_output_file_name;
+    next_test = 0;
+}
+
+tf_fuzz_batch::~tf_fuzz_batch (void)
+{
+    return;  // just to have something to pin a breakpoint onto
+}
+
+/**********************************************************************************
+   End of methods of class tf_fuzz_batch.
+**********************************************************************************/
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef TF_FUZZ_BATCH_HPP
+#define TF_FUZZ_BATCH_HPP
+
+#include <string>
+#include <vector>
+#include <atomic>
+
+
+/* This project's header files #including other project headers quickly becomes
+   unrealistically complicated.  The only solution is for each .cpp to include
+   the headers it needs.
+#include "tf_fuzz.hpp"
+#include "lexed_template.hpp"
+*/
+
+using namespace std;
+
+const long default_shard_size = 1000;  // tests per sub-directory of a batch
+
+/* class tf_fuzz_batch makes a batch of tests, from one template and consecutive
+   seeds, as many separate runs of tfz would, but reading the template only once,
+   and on several threads at once.  The tests are written in sub-directories, or
+   "shards," of the output directory, shard_0000, shard_0001, and so on, each of
+   up to batch_shard_size tests, named test_<seed>.c.  The output directory also
+   gets a manifest listing, for each seed, the test file and number of PSA calls.
+
+   Each test is made on a new thread, so that it starts from fresh (thread_local)
+   parser state and random numbers;  a test from a batch is therefore the same as
+   what tfz writes when run alone with that seed. */
+
+class batch_test_info
+{
+public:  // (just what goes into the manifest)
+    // Data members:
+        long seed;
+        string file_name;  // relative to the output directory
+        size_t n_calls;  // number of PSA calls in the test
+        int parse_result;  // what yyparse() returned
+        bool written;  // false if the test file couldn't be written
+};
+
+
+class tf_fuzz_batch
+{
+public:
+    // Data members:
+        long n_tests;
+        long first_seed;
+        long shard_size;  // tests per sub-directory
+        unsigned int n_threads;
+        string output_dir;
+    // Methods:
+        int run (void);
+            /* makes all of the tests and writes the manifest;  returns 0 if all
+               went well, as main() does */
+        tf_fuzz_batch (tf_fuzz_info *settings, const lexed_template *templ);
+            // (constructor)
+        ~tf_fuzz_batch (void);
+
+protected:
+    // Data members:
+        tf_fuzz_info *settings;  // command-line settings, and the boilerplate
+        const lexed_template *templ;
+        atomic<long> next_test;  // index of the next test for a worker to take
+        vector<batch_test_info> tests;
+            // the outcome of each test;  each entry written by one thread only
+    // Methods:
+        void worker (void);  // makes tests until there are none left to make
+        void make_test (long test_no);
+        string shard_name (long shard_no);
+        bool make_directories (void);
+        bool write_manifest (void);
+
+private:
+    // Data members:
+    // Methods:
+};
+
+/* Creates a directory;  returns false if that failed, other than because it
+   already exists. */
+bool make_directory (string path);
+
+#endif  // #ifndef TF_FUZZ_BATCH_HPP
@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <string>
+#include <vector>
+#include <map>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <cstdlib>
+#include "class_forwards.hpp"
+#include "boilerplate.hpp"
+#include "randomization.hpp"
+#include "gibberish.hpp"
+#include "compute.hpp"
+#include "string_ops.hpp"
+#include "data_blocks.hpp"
+#include "psa_asset.hpp"
+#include "find_or_create_asset.hpp"
+#include "template_line.hpp"
+#include "tf_fuzz.hpp"
+#include "tf_fuzz_batch.hpp"
+#include "tf_fuzz_reduce.hpp"
+
+
+using namespace std;
+
+/* Returns str without leading or trailing white space. */
+static string trim (string str)
+{
+    size_t first = str.find_first_not_of (" \t\r\n");
+
+    if (first == string::npos) {
+        return "";
+    }
+    return str.substr (first, str.find_last_not_of (" \t\r\n") - first + 1);
+}
+
+/* Returns the oracle's command for one test:  %t is replaced by the test's path,
+   %d by the directory to build it in, and %% by %.  If there's no %t, the test's
+   path is added to the end of the command. */
+static string oracle_command (string oracle, string test_path, string dir)
+{
+    string command;
+    bool test_given = false;
+
+    for (size_t i = 0;  i < oracle.length();  ++i) {
+        if (oracle[i] == '%' && i + 1 < oracle.length()) {
+            switch (oracle[i+1]) {
+                case 't':  command += "\"" + test_path + "\"";
+                           test_given = true;
+                           ++i;  continue;
+                case 'd':  command += "\"" + dir + "\"";  ++i;  continue;
+                case '%':  command += "%";  ++i;  continue;
+            }
+        }
+        command += oracle[i];
+    }
+    if (!test_given) {
+        command += " \"" + test_path + "\"";
+    }
+    return command;
+}
+
+/* Reads a whole file into a string;  returns false if it couldn't be opened. */
+static bool read_file (string file_name, string &contents)
+{
+    ifstream in (file_name, ios::in | ios::binary);
+    ostringstream text;
+
+    if (!in.is_open()) {
+        return false;
+    }
+    text << in.rdbuf();
+    contents = text.str();
+    return true;
+}
+
+/**********************************************************************************
+   Methods of class tf_fuzz_reduce follow:
+**********************************************************************************/
+
+bool tf_fuzz_reduce::split_template (string text)
+{
+    string current;  // the statement so far
+    int block = -1;  // the block we're in, if any
+    size_t end;
+
+    for (size_t i = 0;  i < text.length();  ++i) {
+        char c = text[i];
+        if (c == '/' && i + 1 < text.length() && text[i+1] == '/') {
+            end = text.find ('\n', i);
+            i = (end == string::npos)?  text.length() : end;
+            c = ' ';  // (and fall through, to the white space)
+        } else if (c == '/' && i + 1 < text.length() && text[i+1] == '*') {
+            end = text.find ("*/", i + 2);
+            i = (end == string::npos)?  text.length() : end + 1;
+            c = ' ';
+        } else if (c == '"') {  // quoted literal:  copy it just as it is
+            end = text.find ('"', i + 1);
+            if (end == string::npos) {
+                end = text.length() - 1;
+            }
+            current += text.substr (i, end - i + 1);
+            i = end;
+            continue;
+        } else if (   trim (current) == "" && text.compare (i, 7, "purpose") == 0
+                   && i + 7 < text.length()
+                   && (text[i+7] == ' ' || text[i+7] == '\t')) {
+            /* The purpose is anything up to a semicolon, so it gets no further
+               splitting: */
+            end = text.find (';', i);
+            if (end == string::npos) {
+                end = text.length() - 1;
+            }
+            purpose = text.substr (i, end - i + 1);
+            i = end;
+            continue;
+        }
+        switch (c) {
+            case ' ':  case '\t':  case '\r':  case '\n':
+                if (current != "" && current.back() != ' ') {
+                    current += ' ';
+                }
+                break;
+            case '{':
+                if (block != -1) {
+                    return false;  // (only one level of nesting allowed anyway)
+                }
+                blocks.push_back (reduce_block());
+                blocks.back().header = trim (current);
+                block = blocks.size() - 1;
+                current = "";
+                break;
+            case '}':
+                if (block == -1) {
+                    return false;
+                }
+                if (trim (current) != "") {  // (a template error, but keep it)
+                    statements.push_back ({trim (current), block});
+                    blocks[block].statements.push_back (statements.size() - 1);
+                }
+                block = -1;
+                current = "";
+                break;
+            case ';':
+                statements.push_back ({trim (current) + ";", block});
+                if (block != -1) {
+                    blocks[block].statements.push_back (statements.size() - 1);
+                }
+                current = "";
+                break;
+            default:
+                current += c;
+        }
+    }
+    if (block != -1) {
+        return false;
+    }
+    if (trim (current) != "") {
+        statements.push_back ({trim (current), -1});
+    }
+    return true;
+}
+
+string tf_fuzz_reduce::make_template (const vector<size_t> &keep)
+{
+    vector<bool> kept (statements.size(), false);
+    vector<bool> block_written (blocks.size(), false);
+    string templ = purpose + "\n";
+
+    for (size_t i : keep) {
+        kept[i] = true;
+    }
+    for (size_t i = 0;  i < statements.size();  ++i) {
+        int block = statements[i].block;
+        if (!kept[i]) {
+            continue;
+        }
+        if (block == -1) {
+            templ += statements[i].text + "\n";
+        } else if (!block_written[block]) {
+            /* Write the whole block now;  it's left out if none of its statements
+               are kept: */
+            templ += blocks[block].header + " {\n";
+            for (size_t j : blocks[block].statements) {
+                if (kept[j]) {
+                    templ += "    " + statements[j].text + "\n";
+                }
+            }
+            templ += "}\n";
+            block_written[block] = true;
+        }
+    }
+    return templ;
+}
+
+string tf_fuzz_reduce::slot_dir (unsigned int slot)
+{
+    return work_dir + "/slot_" + to_string (slot);
+}
+
+bool tf_fuzz_reduce::fails (const vector<size_t> &keep, unsigned int slot)
+{
+    string templ = make_template (keep), test, command;
+    string dir = slot_dir (slot);
+    bool result;
+
+    {
+        lock_guard<mutex> lock (results_mutex);
+        auto found = template_results.find (templ);
+        if (found != template_results.end()) {
+            return found->second;
+        }
+        ++n_tfz_runs;
+    }
+    ofstream templ_file (dir + "/template", ios::out);
+    if (!templ_file.is_open()) {
+        cerr << "\nError:  Candidate template file " << dir << "/template"
+             << " could not be opened." << endl;
+        exit (18);
+    }
+    templ_file << templ;
+    templ_file.close();
+
+    // Make the test;  a template that tfz can't make a test from doesn't count:
+    command =   "\"" + settings->program_name + "\" \"" + dir + "/template\" \""
+              + dir + "/test.c\" " + to_string (seed) + " > \"" + dir
+              + "/tfz.log\" 2>&1";
+    if (system (command.c_str()) != 0 || !read_file (dir + "/test.c", test)) {
+        result = false;
+    } else {
+        {
+            lock_guard<mutex> lock (results_mutex);
+            auto found = test_results.find (test);
+            if (found != test_results.end()) {
+                template_results[templ] = found->second;
+                return found->second;
+            }
+            ++n_oracle_runs;
+        }
+        command =   "(" + oracle_command (oracle, dir + "/test.c", dir) + ") > \""
+                  + dir + "/oracle.log\" 2>&1";
+        result = (system (command.c_str()) == 0);
+        lock_guard<mutex> lock (results_mutex);
+        test_results[test] = result;
+    }
+    lock_guard<mutex> lock (results_mutex);
+    template_results[templ] = result;
+    return result;
+}
+
+long tf_fuzz_reduce::first_failing (const vector<vector<size_t>> &candidates)
+{
+    for (size_t start = 0;  start < candidates.size();  start += n_threads) {
+        size_t n_now = candidates.size() - start;
+        if (n_now > n_threads) {
+            n_now = n_threads;
+        }
+        vector<char> failed (n_now, false);  // (not vector<bool>;  see below)
+        vector<thread> workers;
+        /* Each thread writes only its own element of failed, which vector<bool>
+           would not allow, with its bits packed together: */
+        for (size_t k = 0;  k < n_now;  ++k) {
+            workers.push_back (thread ([this, &candidates, &failed, start, k] () {
+                failed[k] = fails (candidates[start + k], (unsigned int) k);
+            }));
+        }
+        for (auto &worker : workers) {
+            worker.join();
+        }
+        /* Take the first that failed, whichever finished first, so the result
+           is the same for any number of threads: */
+        for (size_t k = 0;  k < n_now;  ++k) {
+            if (failed[k]) {
+                return (long) (start + k);
+            }
+        }
+    }
+    return -1;
+}
+
+vector<size_t> tf_fuzz_reduce::ddmin (vector<size_t> keep)
+{
+    size_t n_chunks = 2;
+
+    while (keep.size() >= 2) {
+        vector<vector<size_t>> candidates;
+        /* Candidates are each chunk alone, then (if there are more than two
+           chunks) everything but each chunk: */
+        for (size_t c = 0;  c < n_chunks;  ++c) {
+            candidates.push_back (vector<size_t> (
+                keep.begin() + c * keep.size() / n_chunks,
+                keep.begin() + (c + 1) * keep.size() / n_chunks));
+        }
+        if (n_chunks > 2) {
+            for (size_t c = 0;  c < n_chunks;  ++c) {
+                vector<size_t> rest (keep.begin(),
+                                     keep.begin() + c * keep.size() / n_chunks);
+                rest.insert (rest.end(),
+                             keep.begin() + (c + 1) * keep.size() / n_chunks,
+                             keep.end());
+                candidates.push_back (rest);
+            }
+        }
+        long found = first_failing (candidates);
+        if (found >= 0 && (size_t) found < n_chunks) {
+            keep = candidates[found];
+            n_chunks = 2;
+        } else if (found >= 0) {
+            keep = candidates[found];
+            n_chunks = (n_chunks > 3)?  n_chunks - 1 : 2;
+        } else if (n_chunks < keep.size()) {
+            n_chunks = (2 * n_chunks < keep.size())?  2 * n_chunks : keep.size();
+            continue;
+        } else {
+            break;  // can't remove any one statement, so done
+        }
+        cout << "    " << keep.size() << " statements left." << endl;
+    }
+    return keep;
+}
+
+int tf_fuzz_reduce::run (void)
+{
+    string text;
+    vector<size_t> keep;
+
+    if (!read_file (settings->template_file_name, text)) {
+        cerr << "\nError:  Template file " << settings->template_file_name
+             << " could not be opened." << endl;
+        return 13;
+    }
+    if (!split_template (text)) {
+        cerr << "\nError:  The braces in template file "
+             << settings->template_file_name << " don't match up." << endl;
+        return 18;
+    }
+    if (purpose == "") {
+        /* Otherwise, the purpose written into the test would be the candidate
+           template's file name, different for each thread: */
+        purpose =   "purpose to reproduce a failure of "
+                  + settings->template_file_name + ", seed " + to_string (seed)
+                  + ";";
+    }
+    if (!make_directory (work_dir)) {
+        cerr << "\nError:  Work directory " << work_dir
+             << " could not be created." << endl;
+        return 16;
+    }
+    for (unsigned int slot = 0;  slot < n_threads;  ++slot) {
+        if (!make_directory (slot_dir (slot))) {
+            cerr << "\nError:  Work directory " << slot_dir (slot)
+                 << " could not be created." << endl;
+            return 16;
+        }
+    }
+    for (size_t i = 0;  i < statements.size();  ++i) {
+        keep.push_back (i);
+    }
+    cout << dec << "Reducing the " << statements.size() << " statements of "
+         << settings->template_file_name << ", seed " << seed << ", with "
+         << n_threads << " threads;  candidates are in " << work_dir << "."
+         << endl;
+    if (!fails (keep, 0)) {
+        cerr << "\nError:  The test made from the whole template does not fail "
+             << "(see " << slot_dir (0) << "), so there's nothing to reduce."
+             << endl;
+        return 19;
+    }
+
+    keep = ddmin (keep);
+
+    ofstream output (output_file_name, ios::out);
+    if (!output.is_open()) {
+        cerr << "\nError:  Reduced template file " << output_file_name
+             << " could not be opened." << endl;
+        return 14;
+    }
+    output << make_template (keep);
+    output.close();
+    cout << "Reduced to " << keep.size() << " of " << statements.size()
+         << " statements, with " << n_tfz_runs << " runs of tfz and "
+         << n_oracle_runs << " of the oracle;  written to " << output_file_name
+         << "." << endl;
+    return 0;
+}
+
+tf_fuzz_reduce::tf_fuzz_reduce (tf_fuzz_info *settings)  // (constructor)
+{
+    this->settings = settings;
+    oracle = settings->reduce_oracle;
+    seed = settings->rand_seed;
+    n_threads = settings->batch_n_threads;
+    if (n_threads == 0) {
+        n_threads = thread::hardware_concurrency();
+        if (n_threads == 0) {  // (not known)
+            n_threads = 1;
+        }
+    }
+    output_file_name = settings->test_output_file_name;
+    work_dir = output_file_name + ".work";
+    n_tfz_runs = n_oracle_runs = 0;
+}
+
+tf_fuzz_reduce::~tf_fuzz_reduce (void)
+{
+    return;  // just to have something to pin a breakpoint onto
+}
+
+/**********************************************************************************
+   End of methods of class tf_fuzz_reduce.
+**********************************************************************************/
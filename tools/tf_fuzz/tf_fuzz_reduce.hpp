@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2020, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef TF_FUZZ_REDUCE_HPP
+#define TF_FUZZ_REDUCE_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+
+
+/* This project's header files #including other project headers quickly becomes
+   unrealistically complicated.  The only solution is for each .cpp to include
+   the headers it needs.
+#include "tf_fuzz.hpp"
+*/
+
+using namespace std;
+
+/* class tf_fuzz_reduce cuts a template down to as few statements as still make,
+   from the same seed, a test that fails.  Whether a test fails is up to an
+   "oracle," a shell command that exits with 0 if the failure is still there, and
+   with anything else if it is not;  typically it builds the test against the host
+   SPE (see harness/README) and looks for the failure message.  In the command,
+   %t is replaced by the path of the test, %d by a directory of its own to build
+   it in, and %% by %.
+
+   The statements removed are the template's commands, including those inside
+   blocks ("shuffle {...}" and so on);  a block is removed along with the last of
+   its commands.  The purpose statement is kept.  The reduction is Zeller's
+   ddmin:  try ever smaller chunks of the statements, keeping just a chunk, or
+   everything but a chunk, whenever that still fails.  Each candidate template
+   is run through tfz as a separate process, since the parser exits upon
+   template errors.  Candidates are tried several at once, on threads of their
+   own, and the result of each distinct template, and of each distinct test, is
+   cached, so the oracle is never run twice on the same calls.  Of the
+   candidates that fail, the first in ddmin's order is always the one taken, so
+   the result does not depend upon the number of threads.
+
+   Note that removing statements changes the random choices the statements after
+   them make, so the reduced template does not necessarily make the very same
+   calls as the original did;  it does, however, make a test that fails. */
+
+class reduce_statement
+{
+public:  // (just a piece of the template)
+    // Data members:
+        string text;  // the statement, with comments removed
+        int block;  // index of the block it's in, or -1 if none
+};
+
+class reduce_block
+{
+public:
+    // Data members:
+        string header;  // e.g., "shuffle" or "2 to 4 of"
+        vector<size_t> statements;  // indices of the statements in it
+};
+
+
+class tf_fuzz_reduce
+{
+public:
+    // Data members:
+        string oracle;  // the command telling whether the failure is still there
+        long seed;
+        unsigned int n_threads;
+        string output_file_name;  // where to write the reduced template
+        string work_dir;  // where candidates are made and tested
+    // Methods:
+        int run (void);
+            /* reduces the template and writes it out;  returns 0 if all went well,
+               as main() does */
+        tf_fuzz_reduce (tf_fuzz_info *settings);  // (constructor)
+        ~tf_fuzz_reduce (void);
+
+protected:
+    // Data members:
+        tf_fuzz_info *settings;  // command-line settings
+        string purpose;  // the template's purpose statement, if any
+        vector<reduce_statement> statements;
+        vector<reduce_block> blocks;
+        map<string, bool> template_results;  // whether each template failed
+        map<string, bool> test_results;  // whether each test (its text) failed
+        mutex results_mutex;  // guards the two maps above, and the counts below
+        long n_tfz_runs, n_oracle_runs;
+    // Methods:
+        bool split_template (string text);
+            /* splits the template into statements;  returns false if its braces
+               don't match up */
+        string make_template (const vector<size_t> &keep);
+            // the template with only the statements (indices) in keep
+        bool fails (const vector<size_t> &keep, unsigned int slot);
+            /* true if the template with only the statements in keep still makes
+               a failing test;  slot is the thread's own number, for its files */
+        long first_failing (const vector<vector<size_t>> &candidates);
+            /* index of the first of the candidates that fails, tried n_threads at
+               a time, or -1 if none do */
+        vector<size_t> ddmin (vector<size_t> keep);
+        string slot_dir (unsigned int slot);
+
+private:
+    // Data members:
+    // Methods:
+};
+
+#endif  // #ifndef TF_FUZZ_REDUCE_HPP
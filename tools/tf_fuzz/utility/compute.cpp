@@ -11,13 +11,71 @@
 
 using namespace std;
 
+const uint32_t lfsr_polynomial = 0xb4bcd35c;  // (crc32::polynomial)
+const uint32_t lfsr_reseed = 0x55555555;  // what lfsr_1b() re-seeds zero to
+
+/* The tables for crc32::crc_1byte():
+
+   *  next[i] is the shift register after eight shifts from zero, factoring in the
+      eight bits of i.  Since the LFSR is linear, eight shifts from any value,
+      factoring in a byte, are then (reg >> 8) ^ next[(reg ^ byte) & 0xff] --
+      unless the shift register passes through zero along the way, which lfsr_1b()
+      would have re-seeded.
+
+   *  If it does pass through zero, with k shifts still to go, the table result is
+      then just what k shifts from zero give, factoring in the last k bits of the
+      byte, one of only 255 values.  may_have_hit_zero[] is a bit-map of the low
+      16 bits of those values;  a table result not in it can't have hit zero. */
+class crc32_tables
+{
+public:
+    // Data members:
+        uint32_t next[256];
+        uint32_t may_have_hit_zero[65536 / 32];
+    // Methods:
+        crc32_tables (void);  // (constructor)
+};
+
+crc32_tables::crc32_tables (void)
+{
+    uint32_t reg;
+
+    for (int i = 0;  i < 256;  ++i) {
+        reg = 0;
+        for (int bit = 0;  bit < 8;  ++bit) {
+            reg = ((reg ^ (i >> bit)) & 1)?  (reg >> 1) ^ lfsr_polynomial
+                                             : reg >> 1;
+        }
+        next[i] = reg;
+    }
+    for (auto &word : may_have_hit_zero) {
+        word = 0;
+    }
+    for (int n_shifts = 0;  n_shifts < 8;  ++n_shifts) {
+        for (int bits = 0;  bits < (1 << n_shifts);  ++bits) {
+            reg = 0;
+            for (int bit = 0;  bit < n_shifts;  ++bit) {
+                reg = ((reg ^ (bits >> bit)) & 1)?  (reg >> 1) ^ lfsr_polynomial
+                                                    : reg >> 1;
+            }
+            may_have_hit_zero[(reg & 0xffff) / 32] |= 1u << (reg % 32);
+        }
+    }
+}
+
+static const crc32_tables &tables (void)
+{
+    static const crc32_tables the_tables;  // (built once, thread-safely)
+    return the_tables;
+}
+
 /**********************************************************************************
    Methods of class crc32 follow:
 **********************************************************************************/
 
 crc32::crc32 (void)
 {
-    shift_reg = 0x55555555;  // just give it some default value
+    shift_reg = lfsr_reseed;  // just give it some default value
 }
 
 void crc32::seed_lfsr (uint32_t init_value)
@@ -39,34 +97,55 @@ uint32_t crc32::lfsr_1b (uint32_t a_bit)
     }
     if (shift_reg == 0) {
         // Theoretically should never happen, but precaution...
-        seed_lfsr (0x55555555);
+        seed_lfsr (lfsr_reseed);
     }
     return shift_reg;
 }
 
-uint32_t crc32::crc (uint8_t a_byte)
+/* crc_1byte() performs eight shifts of the LFSR, factoring in the bits of a byte,
+   low-order bit first, as eight lfsr_1b()s would. */
+void crc32::crc_1byte (uint8_t a_byte)
 {
-    for (int i = 0;  i < 8;  i++) {
-        lfsr_1b ((uint32_t) a_byte);
-        a_byte >>= 1;
+    const crc32_tables &tab = tables();
+    uint32_t result = (shift_reg >> 8) ^ tab.next[(shift_reg ^ a_byte) & 0xff];
+
+    if (tab.may_have_hit_zero[(result & 0xffff) / 32] & (1u << (result % 32))) {
+        // Rarely, but perhaps hit zero along the way, so do it the long way:
+        for (int i = 0;  i < 8;  i++) {
+            lfsr_1b ((uint32_t) a_byte);
+            a_byte >>= 1;
+        }
+    } else {
+        shift_reg = result;
     }
+}
+
+uint32_t crc32::crc (uint8_t a_byte)
+{
+    crc_1byte (a_byte);
     return shift_reg;
 }
 
 uint32_t crc32::crc (uint16_t a_halfword)
 {
-    for (int i = 0;  i < 16;  i++) {
-        lfsr_1b ((uint32_t) a_halfword);
-        a_halfword >>= 1;
-    }
+    crc_1byte ((uint8_t) a_halfword);
+    crc_1byte ((uint8_t) (a_halfword >> 8));
     return shift_reg;
 }
 
 uint32_t crc32::crc (uint32_t a_word)
 {
-    for (int i = 0;  i < 32;  i++) {
-        lfsr_1b ((uint32_t) a_word);
-        a_word >>= 1;
+    for (int i = 0;  i < 4;  i++) {
+        crc_1byte ((uint8_t) a_word);
+        a_word >>= 8;
+    }
+    return shift_reg;
+}
+
+uint32_t crc32::crc (const uint8_t *data, size_t length)
+{
+    for (size_t i = 0;  i < length;  i++) {
+        crc_1byte (data[i]);
     }
     return shift_reg;
 }
@@ -9,13 +9,16 @@
 #define COMPUTE_HPP
 
 #include <cstdlib>
+#include <cstdint>
 
 using namespace std;
 
 /* Arguably at least, this LFSR-based hashing code is run more commonly on the
    target itself -- included in the generated code -- than it is run here.
    However, it's available here too, such as to parallel-calculate expected hash
-   values. */
+   values.  Here, crc() runs the LFSR a byte at a time from a table, rather than
+   a bit at a time, but with exactly the same results as lfsr_1b() would give,
+   including its re-seeding should the shift register ever reach zero. */
 
 class crc32
 {
@@ -28,10 +31,13 @@ public:
     uint32_t crc (uint8_t a_byte);
     uint32_t crc (uint16_t a_halfword);
     uint32_t crc (uint32_t a_word);
+    // ... and for a whole buffer of bytes, first to last:
+    uint32_t crc (const uint8_t *data, size_t length);
     crc32 (void);
 private:
     const uint32_t polynomial = 0xb4bcd35c;
     uint32_t shift_reg;
+    void crc_1byte (uint8_t a_byte);  // eight lfsr_1b()s, but from the table
 };
 
 #endif /* COMPUTE_HPP */
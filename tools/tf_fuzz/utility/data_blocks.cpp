@@ -16,6 +16,7 @@
 #include "class_forwards.hpp"
 
 #include "boilerplate.hpp"
+#include "randomization.hpp"
 #include "gibberish.hpp"
 #include "compute.hpp"
 #include "string_ops.hpp"
@@ -43,6 +44,8 @@ expect_info::expect_info (void)  // (default constructor)
     data_specified = false;
     data.assign ("");
     pf_info_incomplete = true;
+    pf_modeled = data_modeled = false;
+    pf_modeled_string.assign ("");
 }
 expect_info::~expect_info (void)  // (destructor)
 {}
@@ -68,6 +71,12 @@ void expect_info::set_pf_error (string error)
     pf_pass = pf_nothing = false;
 }
 
+void expect_info::set_pf_modeled (string result)
+{
+    pf_modeled = (result != "");
+    pf_modeled_string.assign (result);
+}
+
 /* What the call expects is not available from the parser until the call has already
    been created.  The flag, pf_info_incomplete, that indicates whether or not the
    "expects" information has been filled in  If not, fill it in from the template,
@@ -166,7 +175,7 @@ bool set_data_info::set_file (string file_name)
 asset_name_id_info::asset_name_id_info (void)  // (default constructor)
 {
     id_n_not_name = false;  // (arbitrary)
-    id_n = 100 + (rand() % 10000);  // default to random ID# (e.g., SST UID)
+    id_n = 100 + (rand_int() % 10000);  // default to random ID# (e.g., SST UID)
     asset_name.assign ("");
     id_n_specified = name_specified = false;  // no ID info yet
     asset_name_vector.clear();
@@ -56,12 +56,18 @@ public:
         // Expected-result info:
         string pf_result_string;
             // if !pf_nothing && !pf_pass then this is expected result
+        bool pf_modeled;
+            /* if !pf_nothing && !pf_pass && !pf_specified, then true == the model
+               of the target (target_model.hpp) worked out the expected result: */
+        string pf_modeled_string;
+        bool data_modeled;  // true if data is what the model says a read returns
     // Methods:
         expect_info (void);  // (default constructor)
         ~expect_info (void);  // (destructor)
         void set_pf_pass (void);
         void set_pf_nothing (void);
         void set_pf_error (string error);
+        void set_pf_modeled (string result);  // "" if the model can't tell
         void copy_expect_to_call (psa_call *the_call);
 
 protected:
@@ -8,6 +8,21 @@
 #ifndef FIND_OR_CREATE_ASSET_HPP
 #define FIND_OR_CREATE_ASSET_HPP
 
+#include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <cstdint>
+#include <iterator>
+
+/* This project's header files #including other project headers quickly becomes
+   unrealistically complicated.  The only solution is for each .cpp to include
+   the headers it needs.
+#include "psa_asset.hpp"
+*/
+
+using namespace std;
+
 /* This enum defines possible results when asked to find an existing, or create a
    new PSA asset. */
 enum class asset_search
@@ -46,89 +61,135 @@ const bool yes_create_asset = true;
 const bool dont_create_asset = false;
 
 
+/* class psa_asset_list is one of the lists of known assets in tf_fuzz_info, such
+   as the active SST assets.  It is used much as a vector of the assets would be,
+   in the order the assets were added, since template lines can pick an asset at
+   random by its position in the list.  The assets are held in slots, which are
+   never moved;  an erased asset's slot goes on a free list, for the next asset
+   added to reuse.  So adding or erasing an asset doesn't move any other, and an
+   iterator stays valid until the asset it refers to is itself erased.  Positions
+   in the list are kept by a Fenwick (binary indexed) tree, over the order the
+   assets were entered, of which entries are still in the list, so stepping to an
+   asset by position takes log time.  Alongside, there are hash indices by name,
+   ID and serial number, so that finding an asset doesn't walk the whole list;
+   otherwise, test generation goes quadratic in the number of assets.  Anything
+   that changes the name or ID of a listed asset must then call reindex() (see
+   tf_fuzz_info::reindex_psa_asset()). */
+class psa_asset_list
+{
+public:
+    // Data members:
+    // Methods:
+        class iterator
+        {
+        public:
+            typedef bidirectional_iterator_tag iterator_category;
+            typedef psa_asset *value_type;
+            typedef long difference_type;
+            typedef psa_asset **pointer;
+            typedef psa_asset *&reference;
+            reference operator* (void) const;
+            iterator &operator++ (void);
+            iterator operator++ (int);
+            iterator &operator-- (void);
+            iterator operator-- (int);
+            iterator operator+ (long n) const;  // n positions on, as in a vector
+            bool operator== (const iterator &other) const;
+            bool operator!= (const iterator &other) const;
+            iterator (void);  // (constructor)
+        private:
+            friend class psa_asset_list;
+            psa_asset_list *list;
+            long entry;  // order of entry of the asset into the list
+            iterator (psa_asset_list *in_list, long at_entry);
+        };
+        iterator begin (void);
+        iterator end (void);
+        size_t size (void);
+        void push_back (psa_asset *asset);
+        iterator erase (iterator position);
+        iterator find (psa_asset_search criterion, string target_name,
+                       uint64_t target_id, long serial_no);
+            /* returns the first asset in the list that matches, as walking the list
+               would, or end() if none do */
+        void reindex (psa_asset *asset);
+            // if the asset is in the list, re-reads its name and ID into the indices
+        psa_asset_list (void);  // (constructor)
+        ~psa_asset_list (void);
+
+protected:
+    // Data members:
+        struct asset_slot
+        {   psa_asset *asset;
+            long entry;  // order of entry into the list
+            string indexed_name;  // the name and ID it is indexed under
+            uint64_t indexed_id;
+        };
+        vector<asset_slot> slots;
+        vector<size_t> free_slots;  // slots of erased assets, to be reused
+        vector<size_t> entry_slot;  // for each entry number, the slot it went into
+        vector<long> live;
+            /* Fenwick tree over entry numbers:  element i (from 1) counts how many
+               of entries i - (i & -i) to i - 1 are still in the list */
+        long next_entry_no;
+        size_t num_assets;
+        // The indices, each to the entry numbers of the assets with that key:
+        unordered_map<string, set<long>> by_name;
+        unordered_map<uint64_t, set<long>> by_id;
+        unordered_map<long, long> by_serial;  // (serial numbers are unique)
+    // Methods:
+        long count_before (long entry);  // how many entries before this are listed
+        long entry_at (long position);  // the entry at this position, or the end
+        void index (asset_slot &slot);  // indexes the slot under its name and ID
+        void unindex (asset_slot &slot);  // ... and takes it back out
+
+private:
+    // Data members:
+    // Methods:
+};
+
+
 /* There are several variants, by asset type, of this method.  So, C++ templating
-   is best.  Note that, while the vectors are pointers to the base, psa_asset type,
+   is best.  Note that, while the lists are of pointers to the base, psa_asset type,
    the individual entries are all of the same ASSET_TYPE type. */
 template <typename ASSET_TYPE>
 asset_search generic_find_or_create_asset (
-    vector<psa_asset*> &active_asset_vector,  // the three vectors of known assets
-    vector<psa_asset*> &deleted_asset_vector,
-    vector<psa_asset*> &invalid_asset_vector,
+    psa_asset_list &active_asset_list,  // the three lists of known assets
+    psa_asset_list &deleted_asset_list,
+    psa_asset_list &invalid_asset_list,
     psa_asset_search criterion,  // what to search on
     psa_asset_usage where,  // where to search
     string target_name,  // ignored if not searching on name
     uint64_t target_id,  // also ignored if not searching on ID (e.g., SST UID)
     long &serial_no,  // search on this if requested, but return serial regardless
     bool create_asset,  // true to create the asset if it doesn't exist
-    typename vector<psa_asset*>::iterator &asset
+    psa_asset_list::iterator &asset
         // returns iterator to the requested asset
 ) {
     ASSET_TYPE *new_asset;
-    bool match = false;  // match found
+    psa_asset_list::iterator as;
     // Look first in active assets:
     if (where == psa_asset_usage::active || where == psa_asset_usage::all) {
-        for (auto as = active_asset_vector.begin();  as < active_asset_vector.end();
-             ++as) {
-            psa_asset *pass = *as;
-            switch (criterion) {
-                case psa_asset_search::name:  // human-meaningful name
-                    match = (pass->asset_id.get_name() == target_name);
-                    break;
-                case psa_asset_search::id:  // ID#
-                    match = (pass->asset_id.id_n == target_id);
-                    break;
-                default:  // psa_asset_search::serial
-                    match = (pass->asset_ser_no == serial_no);
-                    break;
-            }
-            if (match) {
-                asset = as;
-                return asset_search::found_active;
-            }
+        as = active_asset_list.find (criterion, target_name, target_id, serial_no);
+        if (as != active_asset_list.end()) {
+            asset = as;
+            return asset_search::found_active;
         }
     }
     // Look then in deleted assets:
     if (where == psa_asset_usage::deleted || where == psa_asset_usage::all) {
-        for (auto as = deleted_asset_vector.begin();  as < deleted_asset_vector.end();
-             ++as) {
-            psa_asset *pass = *as;
-            switch (criterion) {
-                case psa_asset_search::name:  // human-meaningful name
-                    match = (pass->asset_id.get_name() == target_name);
-                    break;
-                case psa_asset_search::id:  // ID#
-                    match = (pass->asset_id.id_n == target_id);
-                    break;
-                default:  // psa_asset_search::serial
-                    match = (pass->asset_ser_no == serial_no);
-                    break;
-            }
-            if (match) {
-                asset = as;
-                return asset_search::found_deleted;
-            }
+        as = deleted_asset_list.find (criterion, target_name, target_id, serial_no);
+        if (as != deleted_asset_list.end()) {
+            asset = as;
+            return asset_search::found_deleted;
         }
     }
     // Look then in invalid assets:
     if (where == psa_asset_usage::invalid || where == psa_asset_usage::all) {
-        for (auto as = invalid_asset_vector.begin();  as < invalid_asset_vector.end();
-             ++as) {
-            psa_asset *pass = *as;
-            switch (criterion) {
-                case psa_asset_search::name:  // human-meaningful name
-                    match = (pass->asset_id.get_name() == target_name);
-                    break;
-                case psa_asset_search::id:  // ID#
-                    match = (pass->asset_id.id_n == target_id);
-                    break;
-                default:  // psa_asset_search::serial
-                    match = (pass->asset_ser_no == serial_no);
-                    break;
-            }
-            if (match) {
-                asset = as;
-                return asset_search::found_invalid;
-            }
+        as = invalid_asset_list.find (criterion, target_name, target_id, serial_no);
+        if (as != invalid_asset_list.end()) {
+            asset = as;
+            return asset_search::found_invalid;
         }
     }
     // Couldn't find it in any of the existing lists, so create it in active assets:
@@ -138,8 +199,8 @@ asset_search generic_find_or_create_asset (
             if (criterion == psa_asset_search::id) {
                 new_asset->asset_id.id_n = target_id;
             }  // TO DO:  probably should do the same for its name in a name search!
-            active_asset_vector.push_back(new_asset);
-            asset = prev(active_asset_vector.end());
+            active_asset_list.push_back(new_asset);
+            asset = prev(active_asset_list.end());
             return asset_search::created_new;
         }
         catch (std::bad_alloc& bad) {
@@ -14,8 +14,25 @@
  */
 
 #include <string>
+#include <cstdint>
 
-#include "gibberish.hpp"  // shouldn't need any other project headers
+#include "randomization.hpp"  // for rand_int() and fast_rand; no other project headers needed
+#include "gibberish.hpp"
+
+
+/* The characters are drawn 32 random bits at a time from rng, eight bits of that
+   per character, scaled to the number of choices (slightly uneven, but only for
+   gibberish), rather than as one rand_int() per character. */
+static const char vowels[] = "aeiou", consonants[] = "bcdfghjklmnpqrstvwxyz",
+                  letters[] = "abcdefghijklmnopqrstuvwxyz";
+
+static inline char pick (const char *choices, uint32_t n_choices, uint32_t &bits)
+{
+    char result = choices[((bits & 0xff) * n_choices) >> 8];
+
+    bits >>= 8;
+    return result;
+}
 
 
 /**
@@ -26,7 +43,7 @@
  */
 char gibberish::letter(void)
 {
-    return 'a' + (rand() % ('z'-'a' + 1));
+    return letters[rng.below (26)];
 }
 
 
@@ -38,9 +55,7 @@ char gibberish::letter(void)
  */
 char gibberish::vowel(void)
 {
-    char vowels[] = "aeiou";
-
-    return vowels[rand() % 5];
+    return vowels[rng.below (5)];
 }
 
 
@@ -52,13 +67,7 @@ char gibberish::vowel(void)
  */
 char gibberish::consonant(void)
 {
-    char candidate;
-
-    do {
-        candidate = letter();
-    } while (   candidate == 'a' || candidate == 'e' || candidate == 'i'
-             || candidate == 'o' || candidate == 'u');
-    return candidate;
+    return consonants[rng.below (21)];
 }
 
 
@@ -77,18 +86,23 @@ char gibberish::consonant(void)
 char *gibberish::syllable (char *string_ptr, char *stop)
 {
     char *parser;  /* points into string while building it */
+    uint32_t bits = rng.next();  /* enough for the whole syllable */
+    bool double_vowel;
 
     parser = string_ptr;
-    if ((rand() % 4) < 3) {
-        if (parser < stop) *parser++ = consonant();
-        if (parser < stop) *parser++ = vowel();
-        if (parser < stop) *parser++ = letter();
+    if ((bits & 3) < 3) {
+        bits >>= 2;
+        if (parser < stop) *parser++ = pick (consonants, 21, bits);
+        if (parser < stop) *parser++ = pick (vowels, 5, bits);
+        if (parser < stop) *parser++ = pick (letters, 26, bits);
     } else {
-        if (parser < stop) *parser++ = vowel();
-        if (((rand() % 4) < 1) && parser < stop) {
-            *parser++ = vowel();
+        double_vowel = ((bits >> 2) & 3) < 1;
+        bits >>= 4;
+        if (parser < stop) *parser++ = pick (vowels, 5, bits);
+        if (double_vowel && parser < stop) {
+            *parser++ = pick (vowels, 5, bits);
         }
-        if (parser < stop) *parser++ = consonant();
+        if (parser < stop) *parser++ = pick (consonants, 21, bits);
     }
     return parser;
 }
@@ -109,15 +123,23 @@ char *gibberish::syllable (char *string_ptr, char *stop)
  *
  */
 char *gibberish::word (bool initial_cap, char *string_ptr, char *stop)
+{
+    rng.seed ((uint32_t) rand_int());
+    return add_word (initial_cap, string_ptr, stop);
+}
+
+/* add_word() is word(), without re-seeding rng, for sentence(). */
+char *gibberish::add_word (bool initial_cap, char *string_ptr, char *stop)
 {
     int syllable_count;
     char *parser;  /* points into string while building it */
+    uint32_t bits = rng.next();  /* two bits per syllable-count decision */
 
     for (syllable_count = 0, parser = string_ptr;
             syllable_count < 4
-         && (rand() % 4) >= syllable_count
+         && (int) (bits & 3) >= syllable_count
          && parser < stop;
-         syllable_count++) {
+         syllable_count++, bits >>= 2) {
         parser = syllable (parser, stop);
     }
     if (initial_cap) {
@@ -131,6 +153,9 @@ char *gibberish::word (bool initial_cap, char *string_ptr, char *stop)
  * \brief Creates a mostly-pronounceable, random-gibberish quasi-sentence,
  *        stopping before the end of the string.
  *
+ * \details The whole sentence takes only one rand_int(), to seed rng, however
+ *          long it is.
+ *
  * \param[in] string_ptr Pointer to beginning of string for quasi-sentence.
  *
  * \param[in] stop       Pointer to last character in quasi-sentence.
@@ -141,14 +166,15 @@ void gibberish::sentence (char *string_ptr, char *stop)
     char *parser;  /* points into string while building it */
     char punctuation[] = ".?!";
 
+    rng.seed ((uint32_t) rand_int());
     *stop = '\0';  /* null-terminate the string */
     --stop;
-    parser = word (capitalize, string_ptr, stop);
+    parser = add_word (capitalize, string_ptr, stop);
     if (parser < stop) {
         *parser++ = ' ';
     }
     for (;  parser < stop; ) {
-        parser = word (dont_capitalize, parser, stop);
+        parser = add_word (dont_capitalize, parser, stop);
         if (parser < stop) {
             *parser++ = ' ';
         }
@@ -157,7 +183,7 @@ void gibberish::sentence (char *string_ptr, char *stop)
     if (*parser == ' ') {
         *parser = vowel();  // just to not have a blank at the end
     }
-    *stop = punctuation[rand() % 3];
+    *stop = punctuation[rng.below (3)];
 }
 
 
@@ -167,7 +193,7 @@ void gibberish::sentence (char *string_ptr, char *stop)
  */
 int gibberish::pick_sentence_len (void)
 {
-    return min_literal_data_len + (rand() % literal_data_len_span);
+    return min_literal_data_len + (rand_int() % literal_data_len_span);
 }
 
 
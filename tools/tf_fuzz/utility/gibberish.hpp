@@ -15,6 +15,13 @@
 #define GIBBERISH_HPP
 
 #include <cstdlib>
+#include <cstdint>
+
+/* This project's header files #including other project headers quickly becomes
+   unrealistically complicated.  The only solution is for each .cpp to include
+   the headers it needs.
+#include "randomization.hpp"  // for fast_rand
+*/
 
 using namespace std;
 
@@ -37,7 +44,11 @@ public:  // not much value in hiding these behind getters and setters
 
 protected:
     // Data members:
+        fast_rand rng;
+            /* the characters come from this, seeded from rand_int() once for each
+               word() or sentence() */
     // Methods:
+        char *add_word (bool initial_cap, char *string_ptr, char *stop);
 
 private:
     // Data members:
@@ -11,8 +11,129 @@
    and available to whomever needs them.
 **********************************************************************************/
 
+#include <cstdint>
+
 #include "randomization.hpp"
 
+/* State of glibc's default (TYPE_3) random-number generator:  an additive
+   lagged-Fibonacci generator, x[n] = x[n-31] + x[n-3], of 31 32-bit words. */
+const int rand_deg = 31, rand_sep = 3;
+struct rand_state {
+    uint32_t x[rand_deg];
+    int front, rear;  // indices of x[n-3] and x[n-31] in the ring
+    bool seeded;
+};
+
+static thread_local rand_state rand_st = {{0}, rand_sep, 0, false};
+
+/**
+ * \brief Seeds this thread's random numbers, as srand() does for rand().
+ *
+ * \details The table is filled in by the "minimal standard" LCG from the seed,
+ *          then the first 310 outputs are discarded, as glibc does.
+ *
+ */
+void seed_rand (unsigned int seed)
+{
+    int32_t word;
+
+    if (seed == 0) {
+        seed = 1;
+    }
+    rand_st.x[0] = seed;
+    word = seed;
+    for (int i = 1;  i < rand_deg;  ++i) {
+        /* word = (16807 * word) % 2147483647, without overflowing 31 bits: */
+        long hi = word / 127773;
+        long lo = word % 127773;
+        word = 16807 * lo - 2836 * hi;
+        if (word < 0) {
+            word += 2147483647;
+        }
+        rand_st.x[i] = word;
+    }
+    rand_st.front = rand_sep;
+    rand_st.rear = 0;
+    rand_st.seeded = true;
+    for (int i = 0;  i < rand_deg * 10;  ++i) {
+        rand_int();
+    }
+}
+
+/**
+ * \brief Returns this thread's next random number, in [0, RAND_MAX] (glibc).
+ *
+ */
+int rand_int (void)
+{
+    uint32_t val;
+
+    if (!rand_st.seeded) {
+        seed_rand (1);  // like rand() without srand()
+    }
+    val = rand_st.x[rand_st.front] += rand_st.x[rand_st.rear];
+    rand_st.front = (rand_st.front + 1) % rand_deg;
+    rand_st.rear = (rand_st.rear + 1) % rand_deg;
+    return (int) (val >> 1);
+}
+
+/**********************************************************************************
+   Methods of class fast_rand follow:
+**********************************************************************************/
+
+static inline uint32_t rotate_left (uint32_t word, int n_bits)
+{
+    return (word << n_bits) | (word >> (32 - n_bits));
+}
+
+/**
+ * \brief Seeds the generator, expanding the seed to its 128-bit state with
+ *        SplitMix64 (which never gives an all-zero state).
+ *
+ */
+void fast_rand::seed (uint32_t seed_val)
+{
+    uint64_t mix = seed_val, z;
+
+    for (int i = 0;  i < 4;  i += 2) {
+        z = (mix += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        z ^= z >> 31;
+        state[i] = (uint32_t) z;
+        state[i+1] = (uint32_t) (z >> 32);
+    }
+}
+
+uint32_t fast_rand::next (void)
+{
+    uint32_t result = rotate_left (state[1] * 5, 7) * 9;
+    uint32_t shifted = state[1] << 9;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= shifted;
+    state[3] = rotate_left (state[3], 11);
+    return result;
+}
+
+uint32_t fast_rand::below (uint32_t limit)
+{
+    // Scaling, rather than %, keeps the high-order (better) bits:
+    return (uint32_t) (((uint64_t) next() * limit) >> 32);
+}
+
+fast_rand::fast_rand (void)  // (constructor)
+{
+    seed (0);  // (to have some valid state;  users seed it from rand_int())
+}
+
+/**********************************************************************************
+   End of methods of class fast_rand.
+**********************************************************************************/
+
 /**
  * \brief Selects and returns a random key_usage_t value.
  *
@@ -23,7 +144,7 @@
  */
 string rand_key_usage (void)
 {
-    switch (rand() % 6) {
+    switch (rand_int() % 6) {
         case 0:  return "PSA_KEY_USAGE_EXPORT";
         case 1:  return "PSA_KEY_USAGE_ENCRYPT";
         case 2:  return "PSA_KEY_USAGE_DECRYPT";
@@ -46,7 +167,7 @@ string rand_key_usage (void)
    asymmetric, symmetric... */
 string rand_key_algorithm (void)
 {
-    switch (rand() % 47) {
+    switch (rand_int() % 47) {
         case  0:  return "PSA_ALG_VENDOR_FLAG";
         case  1:  return "PSA_ALG_CATEGORY_MASK";
         case  2:  return "PSA_ALG_CATEGORY_HASH";
@@ -109,7 +230,7 @@ string rand_key_algorithm (void)
  */
 string rand_key_type (void)
 {
-    switch (rand() % 22) {
+    switch (rand_int() % 22) {
         case 0:  return "PSA_KEY_TYPE_NONE";
         case 1:  return "PSA_KEY_TYPE_VENDOR_FLAG";
         case 2:  return "PSA_KEY_TYPE_CATEGORY_MASK";
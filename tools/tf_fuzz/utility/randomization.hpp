@@ -9,9 +9,38 @@
 #define RANDOMIZATION_HPP
 
 #include <string>
+#include <cstdint>
 
 using namespace std;
 
+/* The C library's rand() has a single state for the whole process, so it can't
+   be used by the worker threads of a batch run (see tf_fuzz_batch.hpp).  Each
+   thread instead has its own state, seeded by seed_rand().  rand_int() returns
+   the same sequence as glibc's rand() after srand() of the same seed, so a test
+   generated in a batch is the same as one generated alone with that seed. */
+void seed_rand (unsigned int seed);
+
+int rand_int (void);
+
+/* class fast_rand is a xoshiro128** generator, for filling buffers with random
+   data (see gibberish::sentence()), at a few operations per 32 random bits.  It
+   is seeded from rand_int(), so what it generates also follows from the seed. */
+class fast_rand
+{
+public:
+    // Data members:
+    // Methods:
+        void seed (uint32_t seed_val);
+        uint32_t next (void);  // the next 32 random bits
+        uint32_t below (uint32_t limit);  // a random number in [0, limit)
+        fast_rand (void);  // (constructor)
+
+private:
+    // Data members:
+        uint32_t state[4];
+    // Methods:
+};
+
 string rand_key_usage (void);
 
 string rand_key_algorithm (void);